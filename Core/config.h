@@ -80,7 +80,25 @@ public:
     std::string LocalHost()   const { return GetString("network", "local_host",  "127.0.0.1"); }
     std::string RemoteHost()  const { return GetString("network", "remote_host", "127.0.0.1"); }
     int         ServerPort()  const { return GetInt   ("network", "server_port", 7777); }
-    double      TickRate()    const { return GetDouble("server",  "tick_rate",   32.0); }
+    int         TickRate()    const { return GetInt   ("network", "tick_rate",   32); }
+    bool        SnapshotDelta() const { return GetBool("network", "snapshot_delta", true); }
+    bool        SnapshotEntropy() const { return GetBool("network", "snapshot_entropy", true); }
+    int         InputRedundancy() const { return GetInt("network", "input_redundancy", 3); }
+    bool        NetIoThread() const { return GetBool("network", "io_thread", false); }
+    int         BundleMtu() const { return GetInt("network", "bundle_mtu", 1200); }
+    bool        InterestManagement() const { return GetBool("network", "interest_management", true); }
+    int         SnapshotBudget() const { return GetInt("network", "snapshot_budget", 1024); }
+    int         LagCompensationMs() const { return GetInt("network", "lag_compensation_ms", 500); }
+    bool        AdaptiveInterpolation() const { return GetBool("network", "adaptive_interp", true); }
+    double      InterpLateTarget() const { return GetDouble("network", "interp_late_target", 0.01); }
+    bool        NetSimEnabled() const { return GetBool("netsim", "enabled", false); }
+    int         NetSimSeed() const { return GetInt("netsim", "seed", 1); }
+    std::string TraceRecordPath() const { return GetString("trace", "record", ""); }
+    std::string TraceReplayPath() const { return GetString("trace", "replay", "session.trace"); }
+    double      TraceReplaySpeed() const { return GetDouble("trace", "replay_speed", 1.0); }
+    std::string TelemetryPath() const { return GetString("telemetry", "path", ""); }
+    std::string TelemetryFormat() const { return GetString("telemetry", "format", "csv"); }
+    double      TelemetryInterval() const { return GetDouble("telemetry", "interval_s", 10.0); }
 
 private:
     Config() = default;
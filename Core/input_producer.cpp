@@ -8,6 +8,7 @@
 
 #include "input_producer.h"
 #include "i_network.h"
+#include "net_codec.h"
 #include "key_logger.h"
 #include "ms_logger.h"
 #include "player_cam_fps.h"
@@ -17,13 +18,14 @@ InputProducer* g_pInputProducer = nullptr;
 
 InputProducer::InputProducer()
     : m_pNetwork(nullptr)
-    , m_TargetTick(0)
     , m_MoveAxisX(0.0f)
     , m_MoveAxisY(0.0f)
     , m_Yaw(0.0f)
     , m_Pitch(0.0f)
     , m_Buttons(InputButtons::NONE)
     , m_JumpPending(false)
+    , m_LatchedButtons(InputButtons::NONE)
+    , m_ViewTimeMs(0)
     , m_LastCmd{}
 {
 }
@@ -31,13 +33,14 @@ InputProducer::InputProducer()
 void InputProducer::Initialize(INetwork* pNetwork)
 {
     m_pNetwork = pNetwork;
-    m_TargetTick = 0;
     m_MoveAxisX = 0.0f;
     m_MoveAxisY = 0.0f;
     m_Yaw = 0.0f;
     m_Pitch = 0.0f;
     m_Buttons = InputButtons::NONE;
     m_JumpPending = false;
+    m_LatchedButtons = InputButtons::NONE;
+    m_ViewTimeMs = 0;
     m_LastCmd = {};
     m_LastServerState = {};
     m_HasServerState = false;
@@ -52,8 +55,7 @@ void InputProducer::Finalize()
 // Update - Called every render frame
 // 
 // 1. Sample current input state
-// 2. Build InputCmd
-// 3. Send to server via MockNetwork
+// 2. Build InputCmd (sent per prediction tick by SendTickCmd)
 //-----------------------------------------------------------------------------
 void InputProducer::Update()
 {
@@ -62,13 +64,11 @@ void InputProducer::Update()
     // 1. Sample current input
     SampleInput();
 
-    // 2. Build command
-    m_LastCmd = BuildInputCmd();
+    // 2. Build command at wire precision, so client prediction simulates
+    //    exactly what the server will receive
+    m_LastCmd = NetCodec::RoundTrip(BuildInputCmd());
 
-    // 3. Send to server
-    m_pNetwork->SendInputCmd(m_LastCmd);
-
-    // 4. Clear sticky jump only when server confirms we're airborne
+    // 3. Clear sticky jump only when server confirms we're airborne
     //    This ensures jump isn't lost due to frame/tick timing
     if (m_JumpPending && m_HasServerState)
     {
@@ -79,10 +79,29 @@ void InputProducer::Update()
             m_JumpPending = false;
         }
     }
+}
 
-    // Increment target tick for next frame
-    // (Server will process commands in order)
-    m_TargetTick++;
+//-----------------------------------------------------------------------------
+// SendTickCmd - Send this frame's command for one prediction tick
+//
+// Frames without a tick send nothing, so trigger buttons (reload, inspect)
+// are latched in SampleInput and go out with the next tick, exactly once.
+//-----------------------------------------------------------------------------
+InputCmd InputProducer::SendTickCmd(uint32_t tickId)
+{
+    InputCmd cmd = m_LastCmd;
+    cmd.tickId = tickId;
+    cmd.buttons |= m_LatchedButtons;
+    m_LatchedButtons = InputButtons::NONE;
+
+    if (m_pNetwork) m_pNetwork->SendInputCmd(cmd);
+    return cmd;
+}
+
+void InputProducer::SetViewTime(double serverTime)
+{
+    // Rounded to the wire's 1ms; 0 is reserved for "not known"
+    m_ViewTimeMs = (serverTime > 0.0) ? static_cast<uint32_t>(serverTime * 1000.0 + 0.5) : 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -137,10 +156,10 @@ void InputProducer::SampleInput()
         m_Buttons |= InputButtons::ADS;
     
     if (KeyLogger_IsTrigger(KK_R))
-        m_Buttons |= InputButtons::RELOAD;
+        m_LatchedButtons |= InputButtons::RELOAD;
     
     if (KeyLogger_IsTrigger(KK_E))
-        m_Buttons |= InputButtons::INSPECT;
+        m_LatchedButtons |= InputButtons::INSPECT;
     
     if (KeyLogger_IsPressed(KK_LEFTSHIFT))
         m_Buttons |= InputButtons::SPRINT;
@@ -152,11 +171,12 @@ void InputProducer::SampleInput()
 InputCmd InputProducer::BuildInputCmd() const
 {
     InputCmd cmd;
-    cmd.tickId = m_TargetTick;
+    cmd.tickId = 0;             // Stamped per prediction tick in SendTickCmd
     cmd.moveAxisX = m_MoveAxisX;
     cmd.moveAxisY = m_MoveAxisY;
     cmd.yaw = m_Yaw;
     cmd.pitch = m_Pitch;
     cmd.buttons = m_Buttons;
+    cmd.viewTimeMs = m_ViewTimeMs;
     return cmd;
 }
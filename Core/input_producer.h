@@ -6,7 +6,11 @@
 // Client-side only - converts raw input into network-ready commands.
 //
 // Data Flow:
-//   KeyLogger/MSLogger → InputProducer → InputCmd → MockNetwork → Server
+//   KeyLogger/MSLogger → InputProducer → InputCmd → Player_Fps tick
+//                                         → SendTickCmd → INetwork → Server
+//
+// One command is sent per prediction tick, stamped with the client tick it
+// was simulated on, so the server's ackInputTick names a history entry.
 //=============================================================================
 
 #include "net_common.h"
@@ -23,10 +27,17 @@ public:
     void Finalize();
 
     //-------------------------------------------------------------------------
-    // Called every render frame - samples input and sends InputCmd
+    // Called every render frame - samples input and builds InputCmd
     //-------------------------------------------------------------------------
     void Update();
 
+    //-------------------------------------------------------------------------
+    // Send the current command for one prediction tick (called by Player_Fps
+    // once per fixed tick). Returns the command as sent, including any
+    // one-shot buttons latched since the previous tick.
+    //-------------------------------------------------------------------------
+    InputCmd SendTickCmd(uint32_t tickId);
+
     //-------------------------------------------------------------------------
     // Get current input state (for client-side prediction)
     //-------------------------------------------------------------------------
@@ -38,10 +49,11 @@ public:
     void SetLastServerState(const NetPlayerState& state) { m_LastServerState = state; m_HasServerState = true; }
 
     //-------------------------------------------------------------------------
-    // Target tick for synchronization
+    // Server time remote players are currently rendered at (server timeline
+    // minus interpolation delay), sent with each command so the server can
+    // rewind its hit test to what we saw. Negative = not known.
     //-------------------------------------------------------------------------
-    void SetTargetTick(uint32_t tick) { m_TargetTick = tick; }
-    uint32_t GetTargetTick() const { return m_TargetTick; }
+    void SetViewTime(double serverTime);
 
 private:
     //-------------------------------------------------------------------------
@@ -57,8 +69,6 @@ private:
 private:
     INetwork* m_pNetwork;
     
-    uint32_t m_TargetTick;      // Next server tick to target
-    
     // Cached input state
     float m_MoveAxisX;          // -1 to 1 (A/D)
     float m_MoveAxisY;          // -1 to 1 (S/W)
@@ -67,8 +77,10 @@ private:
     uint32_t m_Buttons;         // Button bitfield
     
     bool m_JumpPending;         // Sticky jump: persists until server processes
+    uint32_t m_LatchedButtons;  // Trigger buttons held until a tick sends them
+    uint32_t m_ViewTimeMs;      // InputCmd::viewTimeMs (0 = not known)
 
-    InputCmd m_LastCmd;         // Most recent command sent
+    InputCmd m_LastCmd;         // Most recent command built
 
     NetPlayerState m_LastServerState;  // Last received server state
     bool m_HasServerState;             // Whether we have received any server state
@@ -20,6 +20,11 @@
 #include "player_cam_fps.h"
 #include "player_fps.h"
 #include "i_network.h"
+#include "net_clock.h"
+#include "clock_sync.h"
+#include "jitter_buffer.h"
+#include "net_telemetry.h"
+#include "config.h"
 #include "remote_player.h"
 #include "input_producer.h"
 #include "sky_dome.h"
@@ -48,9 +53,35 @@ namespace{
 	// Correction state for debug display
 	const char* g_CorrectionMode = "NONE";
 	float g_CorrectionError = 0.0f;
+	uint32_t g_InputLead = 0;
+	float g_ServerInputDepth = 0.0f;
 
 	// Collision world
 	CollisionWorld g_CollisionWorld;
+
+	// Remote player missing from snapshots this long is treated as gone.
+	// Well above the interest manager's low-rate interval (125ms at every tick rate).
+	constexpr double REMOTE_PLAYER_ABSENT_TIMEOUT = 0.5;
+
+	// Server clock estimate; remote players interpolate on its timeline
+	ClockSync g_ClockSync;
+
+	// Interpolation delay from measured jitter/loss ([network] adaptive_interp)
+	JitterBuffer g_JitterBuffer;
+	bool g_AdaptiveInterp = true;
+
+	// INetwork::GetSessionEpoch of the snapshots consumed so far
+	uint32_t g_SessionEpoch = 0;
+
+	// Session network histograms, exported to [telemetry] path
+	NetTelemetry g_Telemetry;
+
+	// Hit marker from reliable HIT / KILL events: the crosshair turns red
+	uint8_t g_LocalPlayerId = 0xFF;
+	double g_HitMarkerTimer = 0.0;
+	bool g_HitMarkerKill = false;
+	constexpr double HIT_MARKER_TIME = 0.15;
+	constexpr double KILL_MARKER_TIME = 0.4;
 }
 
 // Global network debug info (populated from received snapshots)
@@ -69,6 +100,19 @@ void Game_Initialize()
 	
 	//g_pModel = ModelLoad("resource/model/test.fbx", 0.1f,false);
 	g_GameState = TITLE;
+	g_ClockSync.Reset();
+	g_AdaptiveInterp = Config::GetInstance().AdaptiveInterpolation();
+	g_JitterBuffer.SetLateTarget(Config::GetInstance().InterpLateTarget());
+	g_JitterBuffer.Reset();
+
+	g_Telemetry.Reset();
+	const std::string telemetryPath = Config::GetInstance().TelemetryPath();
+	if (!telemetryPath.empty())
+	{
+		const NetTelemetryFormat format = (Config::GetInstance().TelemetryFormat() == "json")
+			? NetTelemetryFormat::JSON : NetTelemetryFormat::CSV;
+		g_Telemetry.Open(telemetryPath.c_str(), format, Config::GetInstance().TelemetryInterval());
+	}
 
 	g_CrossHairTexId = Texture_LoadFromFile(L"resource/texture/arr.png");
 	g_CursorTexId    = Texture_LoadFromFile(L"resource/texture/cursor.png");
@@ -132,6 +176,23 @@ void Game_Update(double elapsed_time)
 		isDebugCollision = !isDebugCollision;
 	}
 
+	// Predict at the session's tick rate (the server's answer to ours)
+	extern INetwork* g_pNetwork;
+	if (g_pNetwork) g_PlayerFps->SetTickRate(g_pNetwork->GetTickRate());
+
+	// Reconnected to a new server session: its ticks and clock start over,
+	// so everything keyed by the old ones would reject or misplace them
+	if (g_pNetwork && g_pNetwork->GetSessionEpoch() != g_SessionEpoch)
+	{
+		g_SessionEpoch = g_pNetwork->GetSessionEpoch();
+		g_PlayerFps->ResetServerSession();
+		g_ClockSync.Reset();
+		g_JitterBuffer.Reset();
+		RemotePlayers_ResetSession();
+		g_LocalPlayerId = 0xFF;
+		g_NetDebugInfo.prevServerTick = 0;
+	}
+
 	g_PlayerFps->Update(elapsed_time);
 	
 	// ========================================================================
@@ -140,20 +201,35 @@ void Game_Update(double elapsed_time)
 	// Local player uses client-side prediction - NO interpolation (causes lag).
 	// Correction is handled via render offset inside Player_Fps.
 	// ========================================================================
-	extern INetwork* g_pNetwork;
-	extern RemotePlayer g_RemotePlayers[];
-	extern bool g_RemotePlayerActive[];
 	extern InputProducer* g_pInputProducer;
-	static double clientClock = 0.0;
+	// Snapshots are read in place from the network's pool (no copy)
+	SnapshotHandle snapHandle;
+	while (g_pNetwork && g_pNetwork->AcquireSnapshot(snapHandle))
+	{
+		const Snapshot& snap = *snapHandle;
+
+		// Sample the server clock at the snapshot's arrival time, not at the
+		// frame that happened to consume it
+		const double now = NetClock::Now();
+		double snapWait = 0.0;
+		double arrivalTime = snapHandle.GetArrivalTime();
+		if (arrivalTime >= 0.0)
+		{
+			snapWait = now - arrivalTime;
+			if (snapWait < 0.0) snapWait = 0.0;
+		}
+		g_ClockSync.AddSample(snap.serverTime, now - snapWait, g_pNetwork->GetRTT() / 1000.0);
+		g_JitterBuffer.AddSample(snap.tickId, snap.serverTime, g_ClockSync.GetArrivalTimeline(now - snapWait));
+		g_Telemetry.OnSnapshot(now - snapWait, snap.serverTime, g_pNetwork->GetRTT());
 
-	// Increment client clock EVERY FRAME for smooth interpolation
-	clientClock += elapsed_time;
+		g_LocalPlayerId = snap.localPlayerId;
 
-	Snapshot snap;
-	while (g_pNetwork && g_pNetwork->ReceiveSnapshot(snap))
-	{
 		// Apply server correction to local player
-		g_PlayerFps->ApplyServerCorrection(snap.localPlayer);
+		g_PlayerFps->ApplyServerCorrection(snap.localPlayer, snap.ackInputTick, snap.inputBufferDepth);
+		g_Telemetry.CountCorrectionMode(g_PlayerFps->GetCorrectionMode());
+		// Servers without an input buffer (no ack) leave the depth at 0;
+		// feeding it would run our tick clock fast for the whole session
+		if (snap.ackInputTick != 0) g_PlayerFps->SetServerInputDepth(snap.inputBufferDepth);
 		g_PlayerFps->SetTeam(snap.localPlayerTeam);
 
 		// Feed server state to InputProducer (for jump-pending logic)
@@ -170,19 +246,22 @@ void Game_Update(double elapsed_time)
 			if (rid < MAX_PLAYERS)
 			{
 				seenThisSnap[rid] = true;
-				g_RemotePlayerActive[rid] = true;
-				g_RemotePlayers[rid].SetActive(true);
-				g_RemotePlayers[rid].SetTeam(snap.remotePlayers[i].teamId);
-				g_RemotePlayers[rid].PushSnapshot(snap.remotePlayers[i].state, clientClock);
+				RemotePlayer& rp = RemotePlayers_Acquire(rid);
+				rp.SetActive(true);
+				rp.SetTeam(snap.remotePlayers[i].teamId);
+				rp.PushSnapshot(snap.remotePlayers[i].state, snap.serverTime);
 			}
 		}
-		// Deactivate players absent from this snapshot (disconnected)
-		for (int i = 0; i < MAX_PLAYERS; i++)
+		// Deactivate players that have been absent for a while. A single
+		// missing entry is normal: interest management sends players the
+		// viewer cannot see at a lower rate, or not at all when out of range.
+		for (size_t i = 0; i < g_RemotePlayers.size(); i++)
 		{
-			if (g_RemotePlayerActive[i] && !seenThisSnap[i])
+			RemotePlayer* rp = g_RemotePlayers[i].get();
+			if (rp && rp->IsActive() && !seenThisSnap[i] &&
+				snap.serverTime - rp->GetNewestSnapshotTime() > REMOTE_PLAYER_ABSENT_TIMEOUT)
 			{
-				g_RemotePlayerActive[i] = false;
-				g_RemotePlayers[i].SetActive(false);
+				rp->SetActive(false);
 			}
 		}
 
@@ -193,9 +272,31 @@ void Game_Update(double elapsed_time)
 		g_NetDebugInfo.lastServerTime = snap.serverTime;
 		g_NetDebugInfo.lastServerState = snap.localPlayer;
 		g_NetDebugInfo.hasData = true;
+		g_NetDebugInfo.snapshotWaitMs = snapWait * 1000.0;
 		g_NetDebugInfo.snapshotsThisSecond++;
 	}
 
+	// ========================================================================
+	// Gameplay events (reliable channel): hit marker for our own hits/kills
+	// ========================================================================
+	NetEvent netEvent;
+	while (g_pNetwork && g_pNetwork->ReceiveEvent(netEvent))
+	{
+		if (netEvent.playerId != g_LocalPlayerId) continue;
+
+		if (netEvent.type == NetEventType::KILL)
+		{
+			g_HitMarkerTimer = KILL_MARKER_TIME;
+			g_HitMarkerKill = true;
+		}
+		else if (netEvent.type == NetEventType::HIT && !(g_HitMarkerKill && g_HitMarkerTimer > 0.0))
+		{
+			g_HitMarkerTimer = HIT_MARKER_TIME;
+			g_HitMarkerKill = false;
+		}
+	}
+	if (g_HitMarkerTimer > 0.0) g_HitMarkerTimer -= elapsed_time;
+
 	// Update snapshot receive rate (once per second)
 	g_NetDebugInfo.snapshotRateTimer += elapsed_time;
 	if (g_NetDebugInfo.snapshotRateTimer >= 1.0)
@@ -208,6 +309,8 @@ void Game_Update(double elapsed_time)
 	// Update debug info from player correction
 	g_CorrectionMode = g_PlayerFps->GetCorrectionMode();
 	g_CorrectionError = g_PlayerFps->GetCorrectionError();
+	g_InputLead = g_PlayerFps->GetInputLead();
+	g_ServerInputDepth = g_PlayerFps->GetServerInputDepth();
 
 	SkyDome_SetPosition(g_PlayerFps->GetPosition());
 
@@ -224,13 +327,36 @@ void Game_Update(double elapsed_time)
 		MSLogger_SetUIMode(!MSLogger_IsUIMode());
 	}
 
-	// Update all active RemotePlayer instances (every frame for smooth interpolation)
-	for (int i = 0; i < MAX_PLAYERS; i++)
+	// Update all active RemotePlayer instances (every frame for smooth interpolation).
+	// They play back the server timeline, so snapshot timestamps line up
+	// exactly and only the clock estimate, not per-packet jitter, moves it.
+	// The jitter buffer's delay changes by time dilation, never in steps.
+	if (g_ClockSync.IsSynced())
 	{
-		if (g_RemotePlayerActive[i])
-			g_RemotePlayers[i].Update(elapsed_time, clientClock);
+		g_JitterBuffer.Update(elapsed_time);
+		const double serverTimeline = g_ClockSync.GetArrivalTimeline(NetClock::Now());
+		double viewDelay = -1.0;
+		for (const auto& rp : g_RemotePlayers)
+		{
+			if (!rp || !rp->IsActive()) continue;
+			if (g_AdaptiveInterp)
+			{
+				rp->SetInterpolationDelay(g_JitterBuffer.GetDelay());
+				rp->SetMaxExtrapolationTime(g_JitterBuffer.GetMaxExtrapolation());
+			}
+			rp->Update(elapsed_time, serverTimeline);
+			viewDelay = rp->GetInterpolationDelay();
+			g_Telemetry.CountSyncMode(rp->GetSyncMode());
+		}
+
+		// Server time the remote players on screen are at: the server rewinds
+		// its hit test to it (lag compensation)
+		if (g_pInputProducer)
+			g_pInputProducer->SetViewTime(viewDelay >= 0.0 ? serverTimeline - viewDelay : -1.0);
 	}
 
+	g_Telemetry.Update(NetClock::Now(), g_pNetwork);
+
 	Fade_Update(elapsed_time);
 }
 
@@ -295,12 +421,10 @@ void Game_Draw()
 	g_PlayerFps->Draw();
 
 	// Draw all active Remote Players
-	extern RemotePlayer g_RemotePlayers[];
-	extern bool g_RemotePlayerActive[];
-	for (int i = 0; i < MAX_PLAYERS; i++)
+	for (const auto& rp : g_RemotePlayers)
 	{
-		if (g_RemotePlayerActive[i])
-			g_RemotePlayers[i].Draw();
+		if (rp && rp->IsActive())
+			rp->Draw();
 	}
 
 	Cube_SetUVMode(CUBE_UV_PER_FACE);
@@ -319,12 +443,12 @@ void Game_Draw()
 		Collision_DebugDraw(playerCapsule, { 0.0f, 1.0f, 0.0f, 1.0f });
 
 		// Draw remote player capsules (red)
-		for (int i = 0; i < MAX_PLAYERS; i++)
+		for (const auto& rp : g_RemotePlayers)
 		{
-			if (g_RemotePlayerActive[i] && !g_RemotePlayers[i].IsDead())
+			if (rp && rp->IsActive() && !rp->IsDead())
 			{
-				XMFLOAT3 rpos = g_RemotePlayers[i].GetRenderPosition();
-				float height = g_RemotePlayers[i].GetHeight();
+				XMFLOAT3 rpos = rp->GetRenderPosition();
+				float height = rp->GetHeight();
 				float radius = 0.3f;
 				Capsule remoteCapsule;
 				remoteCapsule.pointA = { rpos.x, rpos.y + radius, rpos.z };
@@ -369,7 +493,11 @@ void Game_Draw()
 	float x = (sw - 120.0f) / 2.0f;
 	float y = (sh - 120.0f) / 2.0f;
 
-	Sprite_Draw(g_CrossHairTexId, x, y, 120.0f, 120.0f);
+	if (g_HitMarkerTimer > 0.0)
+		Sprite_Draw(g_CrossHairTexId, x, y, 120.0f, 120.0f,
+			g_HitMarkerKill ? XMFLOAT4{ 1.0f, 0.1f, 0.1f, 1.0f } : XMFLOAT4{ 1.0f, 0.6f, 0.6f, 1.0f });
+	else
+		Sprite_Draw(g_CrossHairTexId, x, y, 120.0f, 120.0f);
 
 	Direct3D_SetDepthEnable(false);
 
@@ -464,6 +592,7 @@ void Game_Draw()
 
 void Game_Finalize()
 {
+	g_Telemetry.Close();
 	Camera_Finalize();
 	//Player_Finalize();
 	PlayerCamTps_Finalize();
@@ -496,6 +625,26 @@ float Game_GetCorrectionError()
 	return g_CorrectionError;
 }
 
+uint32_t Game_GetInputLead()
+{
+	return g_InputLead;
+}
+
+float Game_GetServerInputDepth()
+{
+	return g_ServerInputDepth;
+}
+
+const ClockSync& Game_GetClockSync()
+{
+	return g_ClockSync;
+}
+
+const JitterBuffer& Game_GetJitterBuffer()
+{
+	return g_JitterBuffer;
+}
+
 CollisionWorld* Game_GetCollisionWorld()
 {
 	return &g_CollisionWorld;
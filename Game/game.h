@@ -32,10 +32,18 @@ GameState Game_GetState();
 // Correction debug info
 const char* Game_GetCorrectionMode();
 float Game_GetCorrectionError();
+uint32_t Game_GetInputLead();      // Sent inputs the server has not simulated yet
+float Game_GetServerInputDepth();  // Our inputs queued on the server (smoothed)
 
 // Collision world accessor (for MockServer initialization)
 CollisionWorld* Game_GetCollisionWorld();
 
+// Server clock estimate and interpolation jitter buffer (for debug display)
+class ClockSync;
+class JitterBuffer;
+const ClockSync& Game_GetClockSync();
+const JitterBuffer& Game_GetJitterBuffer();
+
 
 
 
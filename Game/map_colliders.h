@@ -45,6 +45,18 @@ static const int MAP_GRID[MAP_GRID_ROWS][MAP_GRID_COLS] =
 	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
 };
 
+//-----------------------------------------------------------------------------
+// World bounds (ground plane extents + jump headroom).
+// The network codec quantizes positions to this box (net_codec.h), so
+// growing the map here also widens the wire encoding on both sides.
+//-----------------------------------------------------------------------------
+static constexpr float MAP_WORLD_MIN_X = -128.0f;
+static constexpr float MAP_WORLD_MAX_X =  128.0f;
+static constexpr float MAP_WORLD_MIN_Y =   -1.0f;
+static constexpr float MAP_WORLD_MAX_Y =   31.0f;
+static constexpr float MAP_WORLD_MIN_Z = -128.0f;
+static constexpr float MAP_WORLD_MAX_Z =  128.0f;
+
 //-----------------------------------------------------------------------------
 // Collider definition (physics / hitscan)
 //-----------------------------------------------------------------------------
@@ -68,7 +80,8 @@ static const MapColliderDef MAP_COLLIDERS[] =
 	//  AABB min                  AABB max                ground
 
 	// --- Ground plane ---
-	{ -128.0f,-1.0f,-128.0f,   128.0f, 0.0f, 128.0f,   true  },
+	{ MAP_WORLD_MIN_X, MAP_WORLD_MIN_Y, MAP_WORLD_MIN_Z,
+	  MAP_WORLD_MAX_X, 0.0f,            MAP_WORLD_MAX_Z,   true  },
 
 	// --- Interior blocks (3x3 each, height 4) ---
 	// Block A: rows 5-7, cols 5-7
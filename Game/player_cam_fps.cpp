@@ -17,6 +17,10 @@
 #include "i_network.h"
 #include "input_producer.h"
 #include "remote_player.h"
+#include "mock_server.h"
+#include "netsim_network.h"
+#include "clock_sync.h"
+#include "jitter_buffer.h"
 #include "game.h"
 
 using namespace DirectX;
@@ -305,12 +309,40 @@ void PlayerCamFps_Debug(const Player_Fps& pf)
 		ss << "PacketLoss: " << std::fixed << std::setprecision(1) << lossPercent << "%\n";
 		ss << "InputsSent: " << g_pNetwork->GetTotalInputsSent() << "\n";
 		ss << "SnapQueue: " << g_pNetwork->GetSnapshotQueueSize() << "\n";
+		ss << "SnapBytes: " << g_pNetwork->GetLastSnapshotBytes() << "\n";
+		ss << "QueueDrops: in " << g_pNetwork->GetInputDropCount()
+		   << " / snap " << g_pNetwork->GetSnapshotDropCount()
+		   << " / event " << g_pNetwork->GetEventDropCount() << "\n";
+	}
+
+	extern NetSimNetwork* g_pNetSim;
+	if (g_pNetSim)
+	{
+		const NetSimStats& up = g_pNetSim->GetUpstreamStats();
+		const NetSimStats& down = g_pNetSim->GetDownstreamStats();
+		ss << "NetSim up: lost " << up.lost << " / dup " << up.duplicated
+		   << " / reord " << up.reordered << " / over " << up.overflowed << "\n";
+		ss << "NetSim down: lost " << down.lost << " / dup " << down.duplicated
+		   << " / reord " << down.reordered << " / over " << down.overflowed << "\n";
 	}
 	ss << "SnapRate: " << g_NetDebugInfo.snapshotsPerSecond << "/s (expect 32)\n";
 	ss << "TickDelta: " << g_NetDebugInfo.tickDelta << " (expect 1)\n";
+	ss << "SnapWait: " << std::fixed << std::setprecision(2) << g_NetDebugInfo.snapshotWaitMs << "ms\n";
+	const ClockSync& clockSync = Game_GetClockSync();
+	ss << "ClockSync: oneway " << std::setprecision(1) << (clockSync.GetOneWayDelay() * 1000.0)
+	   << "ms / drift " << std::setprecision(0) << (clockSync.GetDrift() * 1e6)
+	   << "ppm / jitter " << std::setprecision(1) << (clockSync.GetJitter() * 1000.0)
+	   << "ms / err " << (clockSync.GetLastError() * 1000.0)
+	   << "ms / steps " << clockSync.GetStepCount() << "\n";
+	const JitterBuffer& jitterBuffer = Game_GetJitterBuffer();
+	ss << "JitterBuf: delay " << std::setprecision(1) << (jitterBuffer.GetDelay() * 1000.0)
+	   << "ms (target " << (jitterBuffer.GetTargetDelay() * 1000.0)
+	   << ") / extrap " << (jitterBuffer.GetMaxExtrapolation() * 1000.0)
+	   << "ms / late " << (jitterBuffer.GetLateRate() * 100.0)
+	   << "% / loss " << (jitterBuffer.GetLossRate() * 100.0) << "%\n";
 
 	// ---- Server Info ----
-	ss << "\n=== Server (32Hz) ===\n";
+	ss << "\n=== Server (" << (g_pNetwork ? g_pNetwork->GetTickRate() : NetTickRate::DEFAULT) << "Hz) ===\n";
 	if (g_NetDebugInfo.hasData)
 	{
 		ss << "ServerTick: " << g_NetDebugInfo.lastServerTick << "\n";
@@ -328,10 +360,22 @@ void PlayerCamFps_Debug(const Player_Fps& pf)
 		ss << "Server: NO DATA\n";
 	}
 
+	extern MockServer* g_pMockServer;
+	if (g_pMockServer)
+	{
+		const InterestStats& is = g_pMockServer->GetInterestStats();
+		ss << "Interest: " << is.candidates << " cand / " << is.visible << " vis / "
+		   << (is.outsideView + is.occluded) << " low (" << is.deferred << " deferred) / "
+		   << is.culled << " culled\n";
+		ss << "  LowRate: view " << is.outsideView << " / occluded " << is.occluded << "\n";
+	}
+
 	// ---- Correction ----
 	ss << "\n=== Correction ===\n";
 	ss << "Mode: " << Game_GetCorrectionMode() << "\n";
 	ss << "Error: " << std::fixed << std::setprecision(3) << Game_GetCorrectionError() << "m\n";
+	ss << "Unacked inputs: " << Game_GetInputLead()
+	   << "  Server queue: " << std::setprecision(1) << Game_GetServerInputDepth() << "\n";
 
 	// ---- Input ----
 	ss << "\n=== Input (C->S) ===\n";
@@ -359,12 +403,10 @@ void PlayerCamFps_Debug(const Player_Fps& pf)
 	ss << "FireCounter: " << pf.GetFireCounter() << " (Srv: " << g_NetDebugInfo.lastServerState.fireCounter << ")\n";
 
 	// ---- Remote Players ----
-	extern RemotePlayer g_RemotePlayers[];
-	extern bool g_RemotePlayerActive[];
-	for (int rpi = 0; rpi < MAX_PLAYERS; rpi++)
+	for (size_t rpi = 0; rpi < g_RemotePlayers.size(); rpi++)
 	{
-		if (!g_RemotePlayerActive[rpi] || !g_RemotePlayers[rpi].IsActive()) continue;
-		RemotePlayer& rp = g_RemotePlayers[rpi];
+		if (!g_RemotePlayers[rpi] || !g_RemotePlayers[rpi]->IsActive()) continue;
+		RemotePlayer& rp = *g_RemotePlayers[rpi];
 		ss << "\n=== RemotePlayer[" << rpi << "] ===\n";
 		ss << "Team: " << (rp.GetTeam() == PlayerTeam::RED ? "RED" : "BLUE") << "\n";
 		ss << "SyncMode: " << rp.GetSyncMode();
@@ -20,9 +20,11 @@ Player_Fps::Player_Fps()
 	, m_CorrectionMode("NONE")
 	, m_CorrectionError(0.0f)
 	, m_LastServerTick(0)
-	, m_InputHistoryHead(0)
-	, m_InputHistoryCount(0)
+	, m_InputHistory{}
+	, m_InputHistoryFirstTick(0)
 	, m_CurrentClientTick(0)
+	, m_LastAckInputTick(0)
+	, m_ServerInputDepth(INPUT_DEPTH_LOW)
 	, m_ModelFront({ 0,0,1 })
 	, m_MoveDir({ 0,0,1 })
 	, m_CamRelativePos({ 0.0f, 0.0f,0.3f })
@@ -31,6 +33,8 @@ Player_Fps::Player_Fps()
 	, m_isJump(false)
 	, m_JumpPending(false)
 	, m_pCollisionWorld(nullptr)
+	, m_TickRate(NetTickRate::DEFAULT)
+	, m_TickDuration(1.0 / NetTickRate::DEFAULT)
 	, m_PhysicsAccumulator(0.0)
 	, m_PrevPhysicsPosition({ 0,0,0 })
 	, m_PhysicsAlpha(0.0f)
@@ -66,6 +70,8 @@ void Player_Fps::Initialize(const DirectX::XMFLOAT3& position, const DirectX::XM
 	m_CorrectionMode = "NONE";
 	m_CorrectionError = 0.0f;
 	m_LastServerTick = 0;
+	m_LastAckInputTick = 0;
+	m_ServerInputDepth = INPUT_DEPTH_LOW;
 	m_PhysicsAccumulator = 0.0;
 	m_PrevPhysicsPosition = position;
 	m_PhysicsAlpha = 0.0f;
@@ -149,22 +155,34 @@ void Player_Fps::Update(double elapsed_time)
 	m_RenderOffset.z *= decayFactor;
 
 	// ========================================================================
-	// Dead — skip all input and gameplay
+	// FIXED-TIMESTEP PHYSICS (must match the server's tick rate)
+	// Accumulator pattern: step physics at exactly m_TickDuration intervals
+	// This eliminates prediction divergence from frame-rate dependent dt
+	// ========================================================================
+	const double maxDelta = m_TickDuration * 4.0;  // Max 4 ticks per frame
+	double clampedDelta = (elapsed_time > maxDelta) ? maxDelta : elapsed_time;
+
+	// Lead adjustment: run the tick clock a few percent fast while the
+	// server starves for our inputs, slow while they pile up there
+	if (m_ServerInputDepth < INPUT_DEPTH_LOW)       clampedDelta *= 1.0 + LEAD_ADJUST_RATE;
+	else if (m_ServerInputDepth > INPUT_DEPTH_HIGH) clampedDelta *= 1.0 - LEAD_ADJUST_RATE;
+	m_PhysicsAccumulator += clampedDelta;
+
+	// ========================================================================
+	// Dead — skip gameplay, but keep one input per tick flowing so the
+	// server's input stream (and its ack) never stalls
 	// ========================================================================
 	if (m_IsDead)
 	{
+		while (m_PhysicsAccumulator >= m_TickDuration)
+		{
+			m_CurrentClientTick++;
+			if (g_pInputProducer) g_pInputProducer->SendTickCmd(m_CurrentClientTick);
+			m_PhysicsAccumulator -= m_TickDuration;
+		}
 		return;
 	}
 
-	// ========================================================================
-	// FIXED-TIMESTEP PHYSICS (must match server 32Hz tick rate)
-	// Accumulator pattern: step physics at exactly TICK_DURATION intervals
-	// This eliminates prediction divergence from frame-rate dependent dt
-	// ========================================================================
-	const double maxDelta = TICK_DURATION * 4.0;  // Max 4 ticks per frame
-	double clampedDelta = (elapsed_time > maxDelta) ? maxDelta : elapsed_time;
-	m_PhysicsAccumulator += clampedDelta;
-
 	// Sample input from InputProducer (already converted to InputCmd)
 	InputCmd currentCmd;
 	if (g_pInputProducer)
@@ -208,18 +226,19 @@ void Player_Fps::Update(double elapsed_time)
 	// ========================================================================
 	// PHYSICS TICK LOOP with Input History Recording
 	// ========================================================================
-	while (m_PhysicsAccumulator >= TICK_DURATION)
+	while (m_PhysicsAccumulator >= m_TickDuration)
 	{
 		// Save position before this tick (for sub-tick interpolation)
 		m_PrevPhysicsPosition = m_Position;
-		const float dt = static_cast<float>(TICK_DURATION);
+		const float dt = static_cast<float>(m_TickDuration);
 
-		// Increment client tick (sync with server tick on first snapshot)
+		// Increment client tick (purely client-side; the server acks it)
 		m_CurrentClientTick++;
 
-		// Update InputCmd tickId for this physics tick
+		// Send this tick's input, stamped with the tick it is simulated on
 		InputCmd tickCmd = currentCmd;
 		tickCmd.tickId = m_CurrentClientTick;
+		if (g_pInputProducer) tickCmd = g_pInputProducer->SendTickCmd(m_CurrentClientTick);
 
 		// Apply physics simulation with current input
 		ApplyPhysicsTick(worldInputX, worldInputZ, tickCmd.buttons, dt);
@@ -227,11 +246,11 @@ void Player_Fps::Update(double elapsed_time)
 		// Record input + resulting state in history buffer
 		RecordInputHistory(tickCmd, worldInputX, worldInputZ);
 
-		m_PhysicsAccumulator -= TICK_DURATION;
+		m_PhysicsAccumulator -= m_TickDuration;
 	}
 
 	// Sub-tick interpolation alpha (0.0 = at last tick, 1.0 = at next tick)
-	m_PhysicsAlpha = static_cast<float>(m_PhysicsAccumulator / TICK_DURATION);
+	m_PhysicsAlpha = static_cast<float>(m_PhysicsAccumulator / m_TickDuration);
 
 	// ========================================================================
 	// Update Player State for Animations — runs at FRAME RATE
@@ -508,38 +527,37 @@ DirectX::XMFLOAT3 Player_Fps::GetRenderPosition() const
 //-----------------------------------------------------------------------------
 // ApplyServerCorrection - Prediction + Correction (Server Reconciliation)
 //
-// Called when server snapshot is received.
-// Soft Correction: Small error -> apply visual offset, decay over time
+// Called when server snapshot is received. ackInputTick is the newest of our
+// inputs the server has simulated, so serverState is compared with the
+// history entry recorded after that same input, not with the current
+// (further predicted) position. An inputBufferDepth of 0 means the server
+// repeated the acked input (its buffer ran dry), so those repeats are
+// added to our history first.
+// Re-simulation: Mismatch -> rewind to the acked input, replay later ones
+// Soft Correction: No usable history -> visual offset, decay over time
 // Hard Snap: Large error -> teleport immediately
+// Without an ack (none yet, or a server that does not ack inputs) the
+// server state belongs to an unknown input, so only a hard snap applies.
 //-----------------------------------------------------------------------------
-void Player_Fps::ApplyServerCorrection(const NetPlayerState& serverState)
+void Player_Fps::ApplyServerCorrection(const NetPlayerState& serverState, uint32_t ackInputTick, uint8_t inputBufferDepth)
 {
 	// Skip if same tick already processed
 	if (serverState.tickId <= m_LastServerTick && m_LastServerTick != 0)
 		return;
 
-	// Initialize client tick from first server snapshot
-	if (m_CurrentClientTick == 0)
+	// Server ticks that repeated the acked input: every tick since the last
+	// snapshot while the ack stood still, else at least this one (the
+	// snapshot that first acked it was lost). Dead players do not move.
+	uint32_t repeats = 0;
+	if (inputBufferDepth == 0 && ackInputTick != 0 && !(serverState.stateFlags & NetStateFlags::IS_DEAD))
 	{
-		m_CurrentClientTick = serverState.tickId;
-	}
-	else
-	{
-		// Detect tick drift and force resync if too large
-		// This can happen due to frame rate variance or packet loss
-		int tickDrift = static_cast<int>(m_CurrentClientTick) - static_cast<int>(serverState.tickId);
-
-		// Expected drift: client is ahead by RTT/2 (~1-3 ticks for 30-100ms RTT)
-		// If drift is too large (>10 ticks = 312ms), force resync
-		if (tickDrift > 10 || tickDrift < -5)
-		{
-			// Abnormal drift detected - resync to server
-			m_CurrentClientTick = serverState.tickId;
-			ClearInputHistory();  // History is no longer valid
-		}
+		const bool sameAck = (ackInputTick == m_LastAckInputTick && m_LastServerTick != 0);
+		repeats = sameAck ? serverState.tickId - m_LastServerTick : 1;
+		if (repeats > INPUT_HISTORY_SIZE) repeats = INPUT_HISTORY_SIZE;
 	}
 
 	m_LastServerTick = serverState.tickId;
+	m_LastAckInputTick = ackInputTick;
 
 	// Correction thresholds with hysteresis to prevent rapid switching
 	// RESIM: Re-simulate when error exceeds threshold
@@ -549,10 +567,29 @@ void Player_Fps::ApplyServerCorrection(const NetPlayerState& serverState)
 	const float RESIM_THRESHOLD = wasCorrect ? 0.25f : 0.1f;  // Higher to enter, lower to stay
 	constexpr float HARD_SNAP_THRESHOLD = 4.0f;                // Full teleport
 
+	// Predicted state after the acked input (none before the first ack, or
+	// once it has aged out of the history)
+	InputHistoryEntry* ackEntry = (ackInputTick != 0) ? FindHistoryEntry(ackInputTick) : nullptr;
+
+	// Save original predicted position for visual offset calculation
+	const DirectX::XMFLOAT3 originalPredictedPos = m_Position;
+
+	// Not a misprediction: replay the server's repeats after the acked
+	// input and the later inputs on top, render offset keeps it smooth
+	if (ackEntry && repeats > 0)
+	{
+		ApplyServerRepeats(*ackEntry, ackInputTick, repeats);
+		m_RenderOffset.x += originalPredictedPos.x - m_Position.x;
+		m_RenderOffset.y += originalPredictedPos.y - m_Position.y;
+		m_RenderOffset.z += originalPredictedPos.z - m_Position.z;
+	}
+
+	const DirectX::XMFLOAT3& predicted = ackEntry ? ackEntry->position : m_Position;
+
 	// Calculate error between predicted and server position
-	float dx = m_Position.x - serverState.position.x;
-	float dy = m_Position.y - serverState.position.y;
-	float dz = m_Position.z - serverState.position.z;
+	float dx = predicted.x - serverState.position.x;
+	float dy = predicted.y - serverState.position.y;
+	float dz = predicted.z - serverState.position.z;
 	float error = sqrtf(dx * dx + dy * dy + dz * dz);
 
 	m_CorrectionError = error;
@@ -571,16 +608,19 @@ void Player_Fps::ApplyServerCorrection(const NetPlayerState& serverState)
 		// Clear input history on hard snap
 		ClearInputHistory();
 	}
+	else if (ackInputTick == 0)
+	{
+		// ===== NO ACK =====
+		// Our position is ahead by the inputs in flight; comparing it with
+		// the server's would flag every moving snapshot as an error
+		m_CorrectionMode = "NONE";
+	}
 	else if (error > RESIM_THRESHOLD)
 	{
-		// ===== RE-SIMULATION =====
-		// Find history entry for server tick
-		InputHistoryEntry* serverEntry = FindHistoryEntry(serverState.tickId);
-
-		if (!serverEntry)
+		if (!ackEntry)
 		{
-			// Tick not in history (too old or missing)
-			// Fall back to old soft correction behavior
+			// Acked input not in history (too old or none yet)
+			// Fall back to soft correction toward the server state
 			m_CorrectionMode = "SOFT";
 			m_RenderOffset.x += m_Position.x - serverState.position.x;
 			m_RenderOffset.y += m_Position.y - serverState.position.y;
@@ -588,35 +628,19 @@ void Player_Fps::ApplyServerCorrection(const NetPlayerState& serverState)
 		}
 		else
 		{
-			// Save original predicted position for visual offset calculation
-			DirectX::XMFLOAT3 originalPredictedPos = m_Position;
-
+			// ===== RE-SIMULATION =====
 			// Replace history entry with server authoritative state
-			serverEntry->position = serverState.position;
-			serverEntry->velocity = serverState.velocity;
-			serverEntry->stateFlags = serverState.stateFlags;
+			ackEntry->position = serverState.position;
+			ackEntry->velocity = serverState.velocity;
+			ackEntry->stateFlags = serverState.stateFlags;
 
-			// Reset current physics state to server state
+			// Rewind physics state to the acked input
 			m_Position = serverState.position;
 			m_Velocity = serverState.velocity;
 			m_isJump = !(serverState.stateFlags & NetStateFlags::IS_GROUNDED);
 
-			// Re-simulate all ticks from server tick to current tick
-			ResimulateFromTick(serverState.tickId);
-
-			// Verify re-simulation quality: check server tick position after re-sim
-			InputHistoryEntry* verifyEntry = FindHistoryEntry(serverState.tickId);
-			if (verifyEntry)
-			{
-				float vdx = verifyEntry->position.x - serverState.position.x;
-				float vdy = verifyEntry->position.y - serverState.position.y;
-				float vdz = verifyEntry->position.z - serverState.position.z;
-				float verifyError = sqrtf(vdx * vdx + vdy * vdy + vdz * vdz);
-
-				// Update displayed error to show post-resim accuracy
-				// (Should be near-zero if physics is deterministic)
-				m_CorrectionError = verifyError;
-			}
+			// Replay only the inputs the server has not simulated yet
+			ResimulateFromTick(ackInputTick);
 
 			// Calculate visual offset for smooth transition
 			// (originalPos - correctedPos) makes render position stay at originalPos initially
@@ -630,7 +654,7 @@ void Player_Fps::ApplyServerCorrection(const NetPlayerState& serverState)
 	else
 	{
 		// ===== NO CORRECTION =====
-		// Prediction is accurate (<0.1m error)
+		// Prediction matched the server at the acked input
 		m_CorrectionMode = "OK";
 	}
 
@@ -672,13 +696,41 @@ void Player_Fps::ApplyServerCorrection(const NetPlayerState& serverState)
 		m_AmmoReserve = MAX_RESERVE;
 		m_StateMachine->SetWeaponState(WeaponState::HIP);
 
-		// Clear input history and sync tick on respawn
+		// Clear input history on respawn (the tick counter keeps running;
+		// the server only accepts increasing input ticks)
 		ClearInputHistory();
-		m_CurrentClientTick = serverState.tickId;
 	}
 	m_WasDead = isDead;
 }
 
+void Player_Fps::SetServerInputDepth(uint8_t depth)
+{
+	m_ServerInputDepth += (static_cast<float>(depth) - m_ServerInputDepth) * INPUT_DEPTH_GAIN;
+}
+
+void Player_Fps::ResetServerSession()
+{
+	m_LastServerTick = 0;
+	m_LastAckInputTick = 0;
+	m_ServerInputDepth = INPUT_DEPTH_LOW;
+	m_RenderOffset = { 0.0f, 0.0f, 0.0f };
+	m_CorrectionMode = "NONE";
+	m_CorrectionError = 0.0f;
+	ClearInputHistory();
+}
+
+void Player_Fps::SetTickRate(uint32_t hz)
+{
+	hz = NetTickRate::Sanitize(hz);
+	if (hz == m_TickRate) return;
+
+	// Recorded ticks were stepped with the old dt; re-simulating them at the
+	// new one would not reproduce the server's result
+	m_TickRate = hz;
+	m_TickDuration = 1.0 / hz;
+	ClearInputHistory();
+}
+
 AABB Player_Fps::GetAABB() const
 {
 	return {
@@ -768,8 +820,8 @@ float Player_Fps::GetCurrentAniProgress() const
 
 void Player_Fps::RecordInputHistory(const InputCmd& cmd, float worldInputX, float worldInputZ)
 {
-	// Store input + resulting physics state in circular buffer
-	InputHistoryEntry& entry = m_InputHistory[m_InputHistoryHead];
+	// Store input + resulting physics state in its tick's slot
+	InputHistoryEntry& entry = m_InputHistory[cmd.tickId % INPUT_HISTORY_SIZE];
 	entry.cmd = cmd;
 	entry.worldInputX = worldInputX;
 	entry.worldInputZ = worldInputZ;
@@ -777,32 +829,24 @@ void Player_Fps::RecordInputHistory(const InputCmd& cmd, float worldInputX, floa
 	entry.velocity = m_Velocity;
 	entry.stateFlags = GetStateFlags();
 
-	// Advance circular buffer head
-	m_InputHistoryHead = (m_InputHistoryHead + 1) % INPUT_HISTORY_SIZE;
-
-	// Track count (max INPUT_HISTORY_SIZE)
-	if (m_InputHistoryCount < INPUT_HISTORY_SIZE)
-		m_InputHistoryCount++;
+	if (m_InputHistoryFirstTick == 0)
+		m_InputHistoryFirstTick = cmd.tickId;
 }
 
 InputHistoryEntry* Player_Fps::FindHistoryEntry(uint32_t tickId)
 {
-	// Linear search through circular buffer (only 10 entries, fast enough)
-	for (int i = 0; i < m_InputHistoryCount; i++)
-	{
-		int index = (m_InputHistoryHead - 1 - i + INPUT_HISTORY_SIZE) % INPUT_HISTORY_SIZE;
-		if (m_InputHistory[index].cmd.tickId == tickId)
-		{
-			return &m_InputHistory[index];
-		}
-	}
-	return nullptr;  // Tick not found (too old or not recorded)
+	// Direct lookup: a slot holding another tick was overwritten by a newer
+	// one, or its tick was never recorded (skipped while dead)
+	if (m_InputHistoryFirstTick == 0 || tickId < m_InputHistoryFirstTick)
+		return nullptr;  // Recorded before the last clear
+
+	InputHistoryEntry& entry = m_InputHistory[tickId % INPUT_HISTORY_SIZE];
+	return (entry.cmd.tickId == tickId) ? &entry : nullptr;
 }
 
 void Player_Fps::ClearInputHistory()
 {
-	m_InputHistoryHead = 0;
-	m_InputHistoryCount = 0;
+	m_InputHistoryFirstTick = 0;
 }
 
 uint32_t Player_Fps::GetStateFlags() const
@@ -816,13 +860,13 @@ uint32_t Player_Fps::GetStateFlags() const
 	return flags;
 }
 
-void Player_Fps::ResimulateFromTick(uint32_t serverTick)
+void Player_Fps::ResimulateFromTick(uint32_t ackTick)
 {
-	// Replay all ticks from serverTick+1 to m_CurrentClientTick
+	// Replay all ticks from ackTick+1 to m_CurrentClientTick
 	// This corrects client prediction based on server's authoritative state
-	const float dt = static_cast<float>(TICK_DURATION);
+	const float dt = static_cast<float>(m_TickDuration);
 
-	for (uint32_t tick = serverTick + 1; tick <= m_CurrentClientTick; tick++)
+	for (uint32_t tick = ackTick + 1; tick <= m_CurrentClientTick; tick++)
 	{
 		InputHistoryEntry* entry = FindHistoryEntry(tick);
 		if (!entry)
@@ -842,6 +886,28 @@ void Player_Fps::ResimulateFromTick(uint32_t serverTick)
 	}
 }
 
+void Player_Fps::ApplyServerRepeats(InputHistoryEntry& ackEntry, uint32_t ackTick, uint32_t repeats)
+{
+	// Step the acked input again from its recorded result, as the server's
+	// buffer did (one-shot buttons dropped), then rebuild the later ticks
+	const float dt = static_cast<float>(m_TickDuration);
+	const uint32_t buttons = ackEntry.cmd.buttons & ~InputButtons::ONE_SHOT;
+
+	m_Position = ackEntry.position;
+	m_Velocity = ackEntry.velocity;
+	m_isJump = !(ackEntry.stateFlags & NetStateFlags::IS_GROUNDED);
+	for (uint32_t i = 0; i < repeats; i++)
+	{
+		ApplyPhysicsTick(ackEntry.worldInputX, ackEntry.worldInputZ, buttons, dt);
+	}
+
+	ackEntry.position = m_Position;
+	ackEntry.velocity = m_Velocity;
+	ackEntry.stateFlags = GetStateFlags();
+
+	ResimulateFromTick(ackTick);
+}
+
 void Player_Fps::ApplyPhysicsTick(float worldInputX, float worldInputZ, uint32_t buttons, float dt)
 {
 	// ========================================================================
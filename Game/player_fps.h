@@ -17,6 +17,7 @@
 #include "mouse.h"
 #include "player_state_mechine.h"
 #include "net_common.h"
+#include "net_tick.h"
 
 //=============================================================================
 // InputHistoryEntry - Stores one tick of input + resulting physics state
@@ -56,7 +57,22 @@ public:
 	//-------------------------------------------------------------------------
 	// Server Reconciliation (Prediction + Correction)
 	//-------------------------------------------------------------------------
-	void ApplyServerCorrection(const NetPlayerState& serverState);
+	void ApplyServerCorrection(const NetPlayerState& serverState, uint32_t ackInputTick, uint8_t inputBufferDepth);
+
+	// Inputs the server had queued for us (Snapshot::inputBufferDepth).
+	// The tick clock runs slightly fast or slow to keep about one queued.
+	// Only meaningful with an ack; never fed, the lead adjustment stays idle.
+	void SetServerInputDepth(uint8_t depth);
+
+	// New server session (INetwork::GetSessionEpoch changed): its ticks
+	// restart, so the last server tick, acks and input history are dropped.
+	// The predicted position stays; the first snapshot corrects it.
+	void ResetServerSession();
+
+	// Session tick rate (INetwork::GetTickRate). Prediction steps at the
+	// server's rate; a change drops the history simulated at the old one.
+	void SetTickRate(uint32_t hz);
+	uint32_t GetTickRate() const { return m_TickRate; }
 	
 	AABB GetAABB() const;
 	Capsule GetCapsule() const;
@@ -91,6 +107,11 @@ public:
 	//-------------------------------------------------------------------------
 	const char* GetCorrectionMode() const { return m_CorrectionMode; }
 	float GetCorrectionError() const { return m_CorrectionError; }
+	uint32_t GetInputLead() const      // Inputs sent but not yet simulated by the server
+	{
+		return (m_LastAckInputTick && m_LastAckInputTick <= m_CurrentClientTick) ? m_CurrentClientTick - m_LastAckInputTick : 0;
+	}
+	float GetServerInputDepth() const { return m_ServerInputDepth; }     // Smoothed
 
 private:
 	// Logic State (authoritative for local player, predicted)
@@ -103,12 +124,20 @@ private:
 	float m_CorrectionError;
 	uint32_t m_LastServerTick;
 
-	// Input History for Reconciliation (Re-simulation)
-	static constexpr int INPUT_HISTORY_SIZE = 10;  // 312.5ms @ 32Hz
+	// Input History for Reconciliation (Re-simulation), indexed by tickId
+	static constexpr uint32_t INPUT_HISTORY_SIZE = NetTickRate::MAX;  // 1s @ 128Hz, must cover the unacked inputs (RTT + server buffering)
 	InputHistoryEntry m_InputHistory[INPUT_HISTORY_SIZE];
-	int m_InputHistoryHead;            // Next write index (circular buffer)
-	int m_InputHistoryCount;           // Current number of valid entries
-	uint32_t m_CurrentClientTick;      // Client-side tick counter (synced with server)
+	uint32_t m_InputHistoryFirstTick;  // Oldest tick recorded since the last clear (0 = empty)
+	uint32_t m_CurrentClientTick;      // Client-side tick counter, stamped on each sent input
+	uint32_t m_LastAckInputTick;       // Newest input the server has simulated
+	float m_ServerInputDepth;          // Smoothed server input queue depth
+
+	// Lead adjustment: depth is sampled before the server's playback, so 1
+	// means our input arrived just in time and 0 means the server repeated
+	static constexpr float INPUT_DEPTH_LOW    = 1.0f;   // Below: tick clock runs fast
+	static constexpr float INPUT_DEPTH_HIGH   = 2.5f;   // Above: tick clock runs slow
+	static constexpr float INPUT_DEPTH_GAIN   = 0.1f;   // Smoothing weight per snapshot
+	static constexpr double LEAD_ADJUST_RATE  = 0.03;   // Max speed change of the tick clock
 	
 	// Other members
 	DirectX::XMFLOAT3 m_ModelFront;
@@ -121,8 +150,8 @@ private:
 	CollisionWorld* m_pCollisionWorld;
 
 	// Fixed-timestep accumulator (must match server tick rate)
-	static constexpr double TICK_RATE = 32.0;
-	static constexpr double TICK_DURATION = 1.0 / TICK_RATE;
+	uint32_t m_TickRate;
+	double m_TickDuration;             // 1 / m_TickRate
 	double m_PhysicsAccumulator;
 	DirectX::XMFLOAT3 m_PrevPhysicsPosition;  // Position before accumulator loop (for sub-tick interpolation)
 	float m_PhysicsAlpha;                       // Remainder fraction for render interpolation
@@ -153,5 +182,6 @@ private:
 	void ClearInputHistory();
 	uint32_t GetStateFlags() const;
 	void ApplyPhysicsTick(float worldInputX, float worldInputZ, uint32_t buttons, float dt);
-	void ResimulateFromTick(uint32_t serverTick);
+	void ResimulateFromTick(uint32_t ackTick);
+	void ApplyServerRepeats(InputHistoryEntry& ackEntry, uint32_t ackTick, uint32_t repeats);
 };
@@ -0,0 +1,87 @@
+//=============================================================================
+// clock_sync.cpp
+//
+// Filtered NTP-style server clock estimate with drift and bounded slew.
+//=============================================================================
+
+#include "clock_sync.h"
+
+namespace {
+
+// Weight of one sample in the jitter average
+constexpr double JITTER_GAIN = 1.0 / 16.0;
+
+double Clamp(double value, double limit)
+{
+    if (value > limit) return limit;
+    if (value < -limit) return -limit;
+    return value;
+}
+
+} // namespace
+
+void ClockSync::Reset()
+{
+    *this = ClockSync();
+}
+
+double ClockSync::FilteredRaw() const
+{
+    double best = m_Raw[0];
+    for (size_t i = 1; i < m_RawCount; i++)
+    {
+        if (m_Raw[i] > best) best = m_Raw[i];
+    }
+    return best;
+}
+
+double ClockSync::GetArrivalTimeline(double localTime) const
+{
+    return m_BaseServer + (localTime - m_BaseLocal) * m_Rate;
+}
+
+void ClockSync::AddSample(double serverTime, double localArrival, double rtt)
+{
+    const double raw = serverTime - localArrival;
+    m_Raw[m_RawNext] = raw;
+    m_RawNext = (m_RawNext + 1) % FILTER_WINDOW;
+    if (m_RawCount < FILTER_WINDOW) m_RawCount++;
+
+    const double filtered = FilteredRaw();
+    m_OneWayDelay = (rtt > 0.0) ? rtt * 0.5 : 0.0;
+    m_Jitter += ((filtered - raw) - m_Jitter) * JITTER_GAIN;
+
+    // Samples are handled in arrival order, but never move the timeline's
+    // anchor backwards
+    const double anchor = (m_SampleCount > 0 && localArrival < m_BaseLocal) ? m_BaseLocal : localArrival;
+    const double target = anchor + filtered;
+
+    const double current = GetArrivalTimeline(anchor);
+    m_LastError = target - current;
+
+    if (m_SampleCount == 0 || m_LastError > STEP_THRESHOLD || m_LastError < -STEP_THRESHOLD)
+    {
+        // First sync or the server clock jumped: step
+        m_BaseLocal = anchor;
+        m_BaseServer = target;
+        m_Rate = 1.0 + m_Drift;
+        if (m_SampleCount > 0) m_StepCount++;
+    }
+    else
+    {
+        // Drift integrates only the small, steady part of the error
+        if (m_LastError < DRIFT_ERROR_LIMIT && m_LastError > -DRIFT_ERROR_LIMIT)
+        {
+            double dt = anchor - m_BaseLocal;
+            m_Drift = Clamp(m_Drift + m_LastError * dt / (SLEW_TIME * DRIFT_TIME), MAX_DRIFT);
+        }
+
+        // Keep the current value and steer the rate
+        double slew = Clamp(m_LastError / SLEW_TIME, MAX_SLEW);
+        m_BaseLocal = anchor;
+        m_BaseServer = current;
+        m_Rate = 1.0 + m_Drift + slew;
+    }
+
+    m_SampleCount++;
+}
@@ -0,0 +1,86 @@
+#pragma once
+//=============================================================================
+// clock_sync.h
+//
+// Client-side estimate of the server clock from snapshot timestamps.
+//
+// Every snapshot gives one NTP-style sample:
+//   raw = serverTime - localArrival = offset - oneWayDelay
+// Queueing and jitter only ever make the delay longer, so the least-delayed
+// sample of a short window (the largest raw) is the cleanest one (NTP clock
+// filter).
+//
+// That filtered value defines the arrival timeline: the server time of the
+// freshest snapshot that can have arrived by a given local time, which is
+// what interpolation plays back. It is published piecewise linear and
+// continuous: at each sample it keeps its current value and changes rate
+// (1 + drift + slew) to steer out the remaining error, with the slew bounded
+// so playback never visibly speeds up or slows down. Errors beyond
+// STEP_THRESHOLD (first sync, server restart) are stepped instead.
+//
+// Drift is the integral of small steering errors (PI loop); larger errors
+// are path changes, not clock frequency, and do not feed it.
+//
+// The server clock itself is the arrival timeline plus RTT / 2 (path
+// assumed symmetric), so it follows RTT changes as they are reported.
+//
+// Local times are NetClock seconds (net_clock.h); RTT in seconds.
+//=============================================================================
+
+#include <cstddef>
+#include <cstdint>
+
+class ClockSync
+{
+public:
+    void Reset();
+
+    // One snapshot: server timestamp, local arrival time, current RTT
+    void AddSample(double serverTime, double localArrival, double rtt);
+
+    bool IsSynced() const { return m_SampleCount > 0; }
+
+    // Server time of the freshest snapshot that can have arrived by
+    // localTime (continuous, monotonic): the interpolation timeline
+    double GetArrivalTimeline(double localTime) const;
+
+    // Estimated server clock at localTime
+    double GetServerTime(double localTime) const { return GetArrivalTimeline(localTime) + m_OneWayDelay; }
+
+    //-------------------------------------------------------------------------
+    // Debug
+    //-------------------------------------------------------------------------
+    double GetOneWayDelay() const { return m_OneWayDelay; }
+    double GetDrift() const { return m_Drift; }                // Server s per local s - 1
+    double GetJitter() const { return m_Jitter; }              // Mean delay above the filtered minimum
+    double GetLastError() const { return m_LastError; }        // Filtered - timeline at last sample
+    uint32_t GetStepCount() const { return m_StepCount; }
+
+    static constexpr size_t FILTER_WINDOW = 16;      // Samples (0.5s @ 32Hz, 125ms @ 128Hz)
+    static constexpr double STEP_THRESHOLD = 0.25;   // Seconds
+    static constexpr double MAX_SLEW = 0.05;         // Timeline rate within 1 +- 5%
+    static constexpr double SLEW_TIME = 0.5;         // Error steered out over ~0.5s
+    static constexpr double MAX_DRIFT = 0.001;       // 1000 ppm
+    static constexpr double DRIFT_TIME = 20.0;       // Integral time constant (s)
+    static constexpr double DRIFT_ERROR_LIMIT = 0.005; // Larger errors skip the integral
+
+private:
+    double FilteredRaw() const;
+
+    // Clock filter: last FILTER_WINDOW raw samples
+    double m_Raw[FILTER_WINDOW] = {};
+    size_t m_RawCount = 0;
+    size_t m_RawNext = 0;
+
+    // Published timeline: m_BaseServer at m_BaseLocal, then m_Rate
+    double m_BaseLocal = 0.0;
+    double m_BaseServer = 0.0;
+    double m_Rate = 1.0;
+
+    double m_OneWayDelay = 0.0;
+    double m_Drift = 0.0;
+    double m_Jitter = 0.0;
+    double m_LastError = 0.0;
+    uint32_t m_SampleCount = 0;
+    uint32_t m_StepCount = 0;
+};
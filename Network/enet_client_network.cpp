@@ -6,19 +6,98 @@
 
 // WinSock2.h must come before Windows.h to avoid winsock.h conflict
 #include <WinSock2.h>
+#include <mmsystem.h>
 #include <enet/enet.h>
 #include "enet_client_network.h"
 #include "net_packet.h"
+#include "net_clock.h"
+#include "net_allocator.h"
+#include "net_schema.h"
 #include <cstring>
 
+namespace {
+
+//-----------------------------------------------------------------------------
+// ENet memory hooks - route every ENet allocation through NetAllocator
+//-----------------------------------------------------------------------------
+void* ENET_CALLBACK NetMalloc(size_t size)
+{
+    return NetAllocator::Allocate(size);
+}
+
+void ENET_CALLBACK NetFree(void* memory)
+{
+    NetAllocator::Free(memory);
+}
+
+//-----------------------------------------------------------------------------
+// SendPooled - Wrap a NetAllocator buffer in an ENet packet without copying
+//
+// The packet owns the buffer from here on; it is returned to the pool when
+// ENet destroys the packet (or right away if the send is refused).
+//-----------------------------------------------------------------------------
+void ENET_CALLBACK FreePooledPayload(ENetPacket* packet)
+{
+    NetAllocator::Free(packet->data);
+}
+
+bool SendPooled(ENetPeer* peer, uint8_t* buffer, size_t size)
+{
+    ENetPacket* packet = enet_packet_create(
+        buffer,
+        size,
+        ENET_PACKET_FLAG_UNSEQUENCED | ENET_PACKET_FLAG_NO_ALLOCATE
+    );
+    if (!packet)
+    {
+        NetAllocator::Free(buffer);
+        return false;
+    }
+    packet->freeCallback = FreePooledPayload;
+
+    if (enet_peer_send(peer, NetChannel::SNAPSHOT, packet) < 0)
+    {
+        enet_packet_destroy(packet);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
 ENetClientNetwork::ENetClientNetwork()
     : m_pClient(nullptr)
     , m_pServerPeer(nullptr)
     , m_ServerHost("127.0.0.1")
     , m_ServerPort(7777)
-    , m_IsConnected(false)
+    , m_ServerAddress(0)
+    , m_State(ConnectionState::DISCONNECTED)
+    , m_DisconnectRequested(false)
+    , m_ReconnectCount(0)
+    , m_SessionEpoch(0)
+    , m_SchemaMismatch(false)
+    , m_RequestedTickRate(NetTickRate::DEFAULT)
+    , m_TickRate(NetTickRate::DEFAULT)
+    , m_ReconnectEnabled(true)
+    , m_StateDeadline(0.0)
+    , m_ReconnectTime(0.0)
+    , m_ReconnectDelay(RECONNECT_DELAY_MIN)
+    , m_IoThreadEnabled(false)
+    , m_IoThreadStop(false)
+    , m_SnapshotDeltaEnabled(true)
+    , m_LastAckSent(0)
+    , m_HasSentAck(false)
+    , m_ServerCaps(NetClientCaps::NONE)
     , m_TotalInputsSent(0)
     , m_TotalSnapshotsReceived(0)
+    , m_LastSnapshotBytes(0)
+    , m_RTT(0)
+    , m_PacketLoss(0)
+    , m_TotalBytesReceived(0)
+    , m_TotalBytesSent(0)
+    , m_TotalPacketsReceived(0)
+    , m_TotalPacketsSent(0)
+    , m_SendDropCount(0)
 {
 }
 
@@ -33,84 +112,87 @@ void ENetClientNetwork::SetServerAddress(const char* host, uint16_t port)
     m_ServerPort = port;
 }
 
+//-----------------------------------------------------------------------------
+// Initialize - Start connecting; returns without waiting for the server
+//-----------------------------------------------------------------------------
 void ENetClientNetwork::Initialize()
 {
-    if (enet_initialize() != 0)
+    ENetCallbacks callbacks = {};
+    callbacks.malloc = NetMalloc;
+    callbacks.free = NetFree;
+
+    if (enet_initialize_with_callbacks(ENET_VERSION, &callbacks) != 0)
     {
         return;
     }
 
-    // Create client host: no incoming connections, 1 outgoing, 2 channels
-    m_pClient = enet_host_create(nullptr, 1, 2, 0, 0);
+    // Create client host: no incoming connections, 1 outgoing, snapshot + event channels
+    m_pClient = enet_host_create(nullptr, 1, NetChannel::COUNT, 0, 0);
     if (!m_pClient)
     {
         enet_deinitialize();
         return;
     }
 
-    // Resolve server address
+    // Resolve once: reconnects must not stall the pump on a DNS lookup
     ENetAddress address;
-    enet_address_set_host(&address, m_ServerHost.c_str());
-    address.port = m_ServerPort;
-
-    // Initiate connection (2 channels, no extra data)
-    m_pServerPeer = enet_host_connect(m_pClient, &address, 2, 0);
-    if (!m_pServerPeer)
+    if (enet_address_set_host(&address, m_ServerHost.c_str()) != 0)
     {
         enet_host_destroy(m_pClient);
         m_pClient = nullptr;
         enet_deinitialize();
         return;
     }
+    m_ServerAddress = address.host;
 
-    // Wait up to 5 seconds for the connection to succeed
-    ENetEvent event;
-    if (enet_host_service(m_pClient, &event, 5000) > 0 &&
-        event.type == ENET_EVENT_TYPE_CONNECT)
-    {
-        m_IsConnected = true;
-    }
-    else
-    {
-        // Connection failed - reset peer
-        enet_peer_reset(m_pServerPeer);
-        m_pServerPeer = nullptr;
-    }
+    // Fresh queues for the new session
+    m_SnapshotPool.Reset();
+    m_OutgoingInputs.Clear();
+    m_IncomingEvents.Clear();
 
     m_TotalInputsSent = 0;
     m_TotalSnapshotsReceived = 0;
+    m_TotalBytesReceived = 0;
+    m_TotalBytesSent = 0;
+    m_TotalPacketsReceived = 0;
+    m_TotalPacketsSent = 0;
+    m_SendDropCount = 0;
+
+    m_DisconnectRequested = false;
+    m_ReconnectCount = 0;
+    m_SchemaMismatch = false;
+    m_ReconnectDelay = RECONNECT_DELAY_MIN;
+    BeginConnect(NetClock::Now());
+
+    // From here on only the IO thread touches ENet
+    if (m_IoThreadEnabled)
+    {
+        m_IoThreadStop = false;
+        m_IoThread = std::thread(&ENetClientNetwork::IoThreadMain, this);
+    }
 }
 
+//-----------------------------------------------------------------------------
+// Finalize - Tell the server we are leaving and tear down without waiting
+//-----------------------------------------------------------------------------
 void ENetClientNetwork::Finalize()
 {
-    if (m_pServerPeer && m_IsConnected)
+    // Stop the IO thread first so ENet is single-threaded again
+    if (m_IoThread.joinable())
     {
-        enet_peer_disconnect(m_pServerPeer, 0);
-
-        // Wait up to 3 seconds for graceful disconnect
-        ENetEvent event;
-        bool disconnected = false;
-        while (enet_host_service(m_pClient, &event, 3000) > 0)
-        {
-            if (event.type == ENET_EVENT_TYPE_DISCONNECT)
-            {
-                disconnected = true;
-                break;
-            }
-            if (event.type == ENET_EVENT_TYPE_RECEIVE)
-            {
-                enet_packet_destroy(event.packet);
-            }
-        }
+        m_IoThreadStop = true;
+        m_IoThread.join();
+    }
 
-        if (!disconnected && m_pServerPeer)
-        {
-            enet_peer_reset(m_pServerPeer);
-        }
+    // Sends the disconnect notice right away; the server times the peer out
+    // if it is lost
+    if (m_pServerPeer)
+    {
+        enet_peer_disconnect_now(m_pServerPeer, 0);
     }
 
     m_pServerPeer = nullptr;
-    m_IsConnected = false;
+    m_State = ConnectionState::DISCONNECTED;
 
     if (m_pClient)
     {
@@ -122,113 +204,560 @@ void ENetClientNetwork::Finalize()
 }
 
 //-----------------------------------------------------------------------------
-// PollEvents - Must be called every frame to pump ENet
+// PollEvents - Must be called every frame to pump ENet (game thread mode)
 //-----------------------------------------------------------------------------
 void ENetClientNetwork::PollEvents()
 {
-    if (!m_pClient) return;
+    if (!m_pClient || m_IoThread.joinable()) return;
+
+    UpdateConnection(NetClock::Now());
+
+    // Inputs queued since the last poll (plus its ack) leave in this service
+    FlushBundle();
+    ServiceHost(0);
+
+    // Ack the newest decoded snapshot once per poll
+    SendSnapshotAck();
+    UpdatePeerStats();
+}
 
+//-----------------------------------------------------------------------------
+// IoThreadMain - Dedicated ENet pump
+//
+// Blocks in enet_host_service for at most IO_SERVICE_TIMEOUT_MS, so a
+// snapshot is stamped within microseconds of reaching the socket and queued
+// inputs leave within ~1ms regardless of the render frame rate.
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::IoThreadMain()
+{
+    // 1ms scheduler granularity for the service timeout
+    timeBeginPeriod(1);
+
+    while (!m_IoThreadStop.load(std::memory_order_acquire))
+    {
+        UpdateConnection(NetClock::Now());
+        ServiceHost(IO_SERVICE_TIMEOUT_MS);
+
+        // Inputs queued while not connected are dropped by SendInputPacket
+        InputCmd cmd;
+        while (m_OutgoingInputs.Pop(cmd))
+        {
+            SendInputPacket(cmd);
+        }
+
+        SendSnapshotAck();
+        FlushBundle();
+        UpdatePeerStats();
+        enet_host_flush(m_pClient);
+    }
+
+    timeEndPeriod(1);
+}
+
+//-----------------------------------------------------------------------------
+// UpdateConnection - Timeouts, reconnect backoff and disconnect requests
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::UpdateConnection(double now)
+{
+    if (m_DisconnectRequested.exchange(false))
+    {
+        const ConnectionState state = m_State;
+        if (state == ConnectionState::CONNECTED)
+        {
+            enet_peer_disconnect(m_pServerPeer, 0);
+            m_State = ConnectionState::DISCONNECTING;
+            m_StateDeadline = now + DISCONNECT_TIMEOUT;
+        }
+        else if (state != ConnectionState::DISCONNECTING)
+        {
+            // Nothing to acknowledge: abandon a pending attempt or backoff
+            if (m_pServerPeer) enet_peer_reset(m_pServerPeer);
+            m_pServerPeer = nullptr;
+            m_State = ConnectionState::DISCONNECTED;
+        }
+        return;
+    }
+
+    switch (m_State.load())
+    {
+    case ConnectionState::CONNECTING:
+        if (now < m_StateDeadline) break;
+        enet_peer_reset(m_pServerPeer);
+        m_pServerPeer = nullptr;
+        ScheduleReconnect(now);
+        break;
+
+    case ConnectionState::DISCONNECTING:
+        if (now < m_StateDeadline) break;
+        enet_peer_reset(m_pServerPeer);
+        m_pServerPeer = nullptr;
+        m_State = ConnectionState::DISCONNECTED;
+        break;
+
+    case ConnectionState::RECONNECT_WAIT:
+        if (now < m_ReconnectTime) break;
+        m_ReconnectCount++;
+        BeginConnect(now);
+        break;
+
+    default:
+        break;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// BeginConnect - Send a connect request; the pump sees it through
+//
+// Each attempt is a new session on the server, so per-connection codec
+// state starts over. Snapshots already decoded stay with the game.
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::BeginConnect(double now)
+{
+    m_DeltaDecoder.Reset();
+    m_Reassembler.Reset();
+    m_HasSentAck = false;
+    m_InputEncoder.Reset();
+    m_Bundler.Clear();
+    m_ServerCaps = NetClientCaps::NONE;
+    m_TickRate = NetTickRate::DEFAULT;
+
+    ENetAddress address;
+    address.host = m_ServerAddress;
+    address.port = m_ServerPort;
+
+    // Connect data = client capabilities
+    uint32_t caps = NetClientCaps::GAME_EVENTS | NetClientCaps::SCHEMA_HASH | NetClientCaps::TICK_RATE;
+    if (m_SnapshotDeltaEnabled) caps |= NetClientCaps::SNAPSHOT_DELTA | NetClientCaps::SNAPSHOT_PARTS;
+    if (m_SnapshotDeltaEnabled && m_DeltaDecoder.IsEntropyCoding()) caps |= NetClientCaps::SNAPSHOT_ENTROPY;
+    if (m_InputEncoder.GetRedundancy() > 1) caps |= NetClientCaps::INPUT_BATCH;
+    if (m_Bundler.IsEnabled()) caps |= NetClientCaps::BUNDLE;
+
+    m_pServerPeer = enet_host_connect(m_pClient, &address, NetChannel::COUNT, caps);
+    if (!m_pServerPeer)
+    {
+        ScheduleReconnect(now);
+        return;
+    }
+
+    m_State = ConnectionState::CONNECTING;
+    m_StateDeadline = now + CONNECT_TIMEOUT;
+}
+
+//-----------------------------------------------------------------------------
+// ScheduleReconnect - Back off before the next attempt (or give up)
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::ScheduleReconnect(double now)
+{
+    if (!m_ReconnectEnabled)
+    {
+        m_State = ConnectionState::DISCONNECTED;
+        return;
+    }
+
+    m_ReconnectTime = now + m_ReconnectDelay;
+    m_ReconnectDelay *= 2.0;
+    if (m_ReconnectDelay > RECONNECT_DELAY_MAX) m_ReconnectDelay = RECONNECT_DELAY_MAX;
+    m_State = ConnectionState::RECONNECT_WAIT;
+}
+
+//-----------------------------------------------------------------------------
+// ServiceHost - Dispatch all pending ENet events
+//
+// Waits up to timeoutMs for the first event, then drains the rest.
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::ServiceHost(uint32_t timeoutMs)
+{
     ENetEvent event;
-    while (enet_host_service(m_pClient, &event, 0) > 0)
+    while (enet_host_service(m_pClient, &event, timeoutMs) > 0)
     {
         switch (event.type)
         {
         case ENET_EVENT_TYPE_CONNECT:
-            m_IsConnected = true;
+            m_State = ConnectionState::CONNECTED;
+            m_ReconnectDelay = RECONNECT_DELAY_MIN;
+            m_SessionEpoch++;
+            SendSchemaHash();
+            SendTickRateRequest();
             break;
 
         case ENET_EVENT_TYPE_DISCONNECT:
-            m_IsConnected = false;
+            // ENet has already reset the peer
             m_pServerPeer = nullptr;
+            if (m_State == ConnectionState::DISCONNECTING)
+                m_State = ConnectionState::DISCONNECTED;
+            else
+                ScheduleReconnect(NetClock::Now());
             break;
 
         case ENET_EVENT_TYPE_RECEIVE:
-        {
-            if (event.packet->dataLength >= 1)
-            {
-                PacketType type = static_cast<PacketType>(event.packet->data[0]);
-
-                if (type == PacketType::SNAPSHOT &&
-                    event.packet->dataLength == 1 + sizeof(Snapshot))
-                {
-                    Snapshot snap;
-                    std::memcpy(&snap, event.packet->data + 1, sizeof(Snapshot));
-
-                    std::lock_guard<std::mutex> lock(m_SnapshotMutex);
-                    m_SnapshotQueue.push(snap);
-                    m_TotalSnapshotsReceived++;
-                }
-            }
+            m_TotalBytesReceived += event.packet->dataLength;
+            m_TotalPacketsReceived++;
+            HandlePacket(event.packet->data, event.packet->dataLength, NetClock::Now());
             enet_packet_destroy(event.packet);
             break;
-        }
 
         default:
             break;
         }
+
+        timeoutMs = 0;
     }
 }
 
 //-----------------------------------------------------------------------------
-// SendInputCmd - Serialize and send to server (unreliable)
+// HandlePacket - Dispatch one datagram, unpacking bundles
 //-----------------------------------------------------------------------------
-void ENetClientNetwork::SendInputCmd(const InputCmd& cmd)
+void ENetClientNetwork::HandlePacket(const uint8_t* data, size_t size, double arrivalTime)
 {
-    if (!m_pServerPeer || !m_IsConnected) return;
+    if (size < 1) return;
 
-    uint8_t buffer[1 + sizeof(InputCmd)];
-    buffer[0] = static_cast<uint8_t>(PacketType::INPUT_CMD);
-    std::memcpy(buffer + 1, &cmd, sizeof(InputCmd));
+    switch (static_cast<PacketType>(data[0]))
+    {
+    case PacketType::BUNDLE:
+    {
+        BundleReader reader(data + 1, size - 1);
+        const uint8_t* message = nullptr;
+        size_t messageSize = 0;
+        while (reader.Next(message, messageSize))
+            HandlePacket(message, messageSize, arrivalTime);
+        break;
+    }
 
-    ENetPacket* packet = enet_packet_create(
-        buffer,
-        sizeof(buffer),
-        ENET_PACKET_FLAG_UNSEQUENCED
-    );
+    case PacketType::EVENT_BATCH:
+        HandleEventPacket(data, size);
+        break;
 
-    enet_peer_send(m_pServerPeer, 0, packet);
-    m_TotalInputsSent++;
+    case PacketType::SCHEMA:
+        HandleSchemaPacket(data, size, arrivalTime);
+        break;
+
+    case PacketType::TICK_RATE:
+        HandleTickRatePacket(data, size);
+        break;
+
+    case PacketType::CAPS:
+        HandleCapsPacket(data, size);
+        break;
+
+    default:
+        HandleSnapshotPacket(data, size, arrivalTime);
+        break;
+    }
 }
 
 //-----------------------------------------------------------------------------
-// ReceiveSnapshot - Pop from internal queue
+// HandleSnapshotPacket - Decode full, delta or split snapshot into a pool slot
 //-----------------------------------------------------------------------------
-bool ENetClientNetwork::ReceiveSnapshot(Snapshot& outSnapshot)
+void ENetClientNetwork::HandleSnapshotPacket(const uint8_t* data, size_t size, double arrivalTime)
 {
-    std::lock_guard<std::mutex> lock(m_SnapshotMutex);
-    if (m_SnapshotQueue.empty()) return false;
+    if (size < 1) return;
+
+    PacketType type = static_cast<PacketType>(data[0]);
+    const uint8_t* payload = data + 1;
+    size_t payloadSize = size - 1;
+    uint32_t wireBytes = static_cast<uint32_t>(size);
+
+    switch (type)
+    {
+    case PacketType::SNAPSHOT:
+    case PacketType::SNAPSHOT_DELTA:
+        break;
+
+    case PacketType::SNAPSHOT_PART:
+        // Nothing to decode until the last missing part arrives
+        if (!m_Reassembler.AddPart(payload, payloadSize)) return;
+
+        payload = m_Reassembler.GetPayload();
+        payloadSize = m_Reassembler.GetPayloadSize();
+        wireBytes = static_cast<uint32_t>(payloadSize +
+            m_Reassembler.GetPartCount() * (1 + SNAPSHOT_PART_HEADER_SIZE));
+        break;
+
+    default:
+        return;
+    }
+
+    // Game holds every slot: drop (counted by the pool)
+    SnapshotPool::Slot* slot = m_SnapshotPool.BeginWrite();
+    if (!slot) return;
+
+    if (type == PacketType::SNAPSHOT)
+    {
+        // Raw struct, trimmed after the last valid remote entry. Servers
+        // that send the full struct (e.g. the 4-player layout) also pass.
+        if (payloadSize > NetReflect::MAX_WIRE_SIZE<Snapshot>) return;
+        if (NetReflect::Read(payload, payloadSize, slot->snapshot) == 0) return;
+    }
+    else
+    {
+        if (!m_DeltaDecoder.Decode(payload, payloadSize, slot->snapshot)) return;
+    }
+
+    slot->arrivalTime = arrivalTime;
+    m_SnapshotPool.CommitWrite();
+    m_TotalSnapshotsReceived++;
+    m_LastSnapshotBytes = wireBytes;
+}
+
+//-----------------------------------------------------------------------------
+// HandleEventPacket - Decode one tick's gameplay events for the game
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::HandleEventPacket(const uint8_t* data, size_t size)
+{
+    if (size < 1 || static_cast<PacketType>(data[0]) != PacketType::EVENT_BATCH) return;
+
+    NetEvent events[NET_EVENT_BATCH_MAX_EVENTS];
+    size_t count = NetEvents::ReadBatch(data + 1, size - 1, events, NET_EVENT_BATCH_MAX_EVENTS);
+    for (size_t i = 0; i < count; i++)
+        m_IncomingEvents.Push(events[i]);     // Full (game not draining): dropped and counted
+}
+
+//-----------------------------------------------------------------------------
+// SendSchemaHash - Announce our NET_SCHEMA_HASH (reliable, events channel)
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::SendSchemaHash()
+{
+    uint8_t message[1 + sizeof(uint32_t)];
+    message[0] = static_cast<uint8_t>(PacketType::SCHEMA);
+    NetReflect::StoreLE(message + 1, NET_SCHEMA_HASH);
+    SendReliable(message, sizeof(message));
+}
 
-    outSnapshot = m_SnapshotQueue.front();
-    m_SnapshotQueue.pop();
+//-----------------------------------------------------------------------------
+// SendTickRateRequest - Ask for our configured tick rate (reliable, events
+// channel). The server answers with the rate the session will run at.
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::SendTickRateRequest()
+{
+    uint8_t message[1 + sizeof(uint16_t)];
+    message[0] = static_cast<uint8_t>(PacketType::TICK_RATE);
+    NetReflect::StoreLE(message + 1, static_cast<uint16_t>(m_RequestedTickRate));
+    SendReliable(message, sizeof(message));
+}
+
+//-----------------------------------------------------------------------------
+// SendReliable - One control message, reliable and ordered on the events
+// channel (never bundled: bundles are unreliable)
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::SendReliable(const uint8_t* message, size_t size)
+{
+    ENetPacket* packet = enet_packet_create(message, size, ENET_PACKET_FLAG_RELIABLE);
+    if (!packet) return;
+    if (enet_peer_send(m_pServerPeer, NetChannel::EVENTS, packet) < 0)
+    {
+        enet_packet_destroy(packet);
+        return;
+    }
+    m_TotalBytesSent += size;
+    m_TotalPacketsSent++;
+}
+
+//-----------------------------------------------------------------------------
+// HandleSchemaPacket - Leave a server whose raw structs differ from ours
+//
+// Servers without SCHEMA never answer; nothing is checked then.
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::HandleSchemaPacket(const uint8_t* data, size_t size, double now)
+{
+    if (size < 1 + sizeof(uint32_t)) return;
+    if (NetReflect::LoadLE<uint32_t>(data + 1) == NET_SCHEMA_HASH) return;
+    if (!m_pServerPeer || m_State != ConnectionState::CONNECTED) return;
+
+    m_SchemaMismatch = true;
+    enet_peer_disconnect(m_pServerPeer, 0);
+    m_State = ConnectionState::DISCONNECTING;
+    m_StateDeadline = now + DISCONNECT_TIMEOUT;
+}
+
+//-----------------------------------------------------------------------------
+// HandleTickRatePacket - Adopt the server's tick rate for this session
+//
+// Servers without TICK_RATE never answer and run NetTickRate::DEFAULT.
+// A rate we cannot simulate is ignored (the schema check covers real
+// version skew).
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::HandleTickRatePacket(const uint8_t* data, size_t size)
+{
+    if (size < 1 + sizeof(uint16_t)) return;
+    const uint32_t hz = NetReflect::LoadLE<uint16_t>(data + 1);
+    if (!NetTickRate::IsSupported(hz)) return;
+
+    m_TickRate = hz;
+}
+
+//-----------------------------------------------------------------------------
+// HandleCapsPacket - Note which of our caps the server honours
+//
+// Servers without CAPS never answer, so they never get a BUNDLE from us
+// (an older server would drop every bundled input and ack).
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::HandleCapsPacket(const uint8_t* data, size_t size)
+{
+    if (size < 1 + sizeof(uint32_t)) return;
+    m_ServerCaps = NetReflect::LoadLE<uint32_t>(data + 1);
+}
+
+//-----------------------------------------------------------------------------
+// SendSnapshotAck - Tell server which baseline it may delta against (unreliable)
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::SendSnapshotAck()
+{
+    if (!m_pServerPeer || !IsConnected()) return;
+    if (!m_DeltaDecoder.HasDecoded()) return;
+
+    uint32_t tickId = m_DeltaDecoder.GetNewestTick();
+    if (m_HasSentAck && tickId == m_LastAckSent) return;
+
+    uint8_t message[1 + sizeof(uint32_t)];
+    message[0] = static_cast<uint8_t>(PacketType::SNAPSHOT_ACK);
+    NetReflect::StoreLE(message + 1, tickId);
+
+    if (!QueueMessage(message, sizeof(message))) return;
+    m_LastAckSent = tickId;
+    m_HasSentAck = true;
+}
+
+//-----------------------------------------------------------------------------
+// QueueMessage - Add an upstream message to the pump's bundle (unreliable)
+//
+// With bundling off or not yet confirmed by the server, or for a message
+// too large to share a bundle, the message goes out as its own packet
+// (after the bundle, to keep order).
+//-----------------------------------------------------------------------------
+bool ENetClientNetwork::QueueMessage(const uint8_t* message, size_t size)
+{
+    if (m_Bundler.IsEnabled() && (m_ServerCaps & NetClientCaps::BUNDLE))
+    {
+        if (m_Bundler.Append(message, size)) return true;
+
+        FlushBundle();
+        if (m_Bundler.Append(message, size)) return true;
+    }
+
+    uint8_t* buffer = static_cast<uint8_t*>(NetAllocator::Allocate(size));
+    if (!buffer)
+    {
+        m_SendDropCount++;
+        return false;
+    }
+    std::memcpy(buffer, message, size);
+    if (!SendPooled(m_pServerPeer, buffer, size)) return false;
+    m_TotalBytesSent += size;
+    m_TotalPacketsSent++;
     return true;
 }
 
-size_t ENetClientNetwork::GetSnapshotQueueSize() const
+//-----------------------------------------------------------------------------
+// FlushBundle - Send the messages bundled so far as one packet
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::FlushBundle()
+{
+    if (m_Bundler.IsEmpty()) return;
+
+    const size_t size = m_Bundler.GetSize();
+    if (m_pServerPeer && IsConnected())
+    {
+        uint8_t* buffer = static_cast<uint8_t*>(NetAllocator::Allocate(size));
+        if (!buffer)
+        {
+            m_SendDropCount++;
+        }
+        else
+        {
+            std::memcpy(buffer, m_Bundler.GetData(), size);
+            if (SendPooled(m_pServerPeer, buffer, size))
+            {
+                m_TotalBytesSent += size;
+                m_TotalPacketsSent++;
+            }
+        }
+    }
+    m_Bundler.Clear();
+}
+
+//-----------------------------------------------------------------------------
+// UpdatePeerStats - Cache ENet peer stats for lock-free reads by the game
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::UpdatePeerStats()
+{
+    if (m_pServerPeer && IsConnected())
+    {
+        m_RTT = m_pServerPeer->roundTripTime;
+        m_PacketLoss = m_pServerPeer->packetLoss;  // ENet: fixed-point, /65536 for fraction
+    }
+    else
+    {
+        m_RTT = 0;
+        m_PacketLoss = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// SendInputCmd - Send to server, or hand to the IO thread
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::SendInputCmd(const InputCmd& cmd)
+{
+    if (m_IoThread.joinable())
+    {
+        m_OutgoingInputs.Push(cmd);
+        return;
+    }
+
+    SendInputPacket(cmd);
+}
+
+//-----------------------------------------------------------------------------
+// SendInputPacket - Serialize and send to server (unreliable)
+//
+// With redundancy > 1 every packet also repeats the previous commands, so
+// the server can recover a tick whose own packet was lost.
+//-----------------------------------------------------------------------------
+void ENetClientNetwork::SendInputPacket(const InputCmd& cmd)
 {
-    std::lock_guard<std::mutex> lock(m_SnapshotMutex);
-    return m_SnapshotQueue.size();
+    if (!m_pServerPeer || !IsConnected()) return;
+
+    uint8_t buffer[1 + INPUT_BATCH_MAX_SIZE];
+    static_assert(sizeof(buffer) >= 1 + NetReflect::WIRE_SIZE<InputCmd>, "Buffer must also fit a raw InputCmd");
+    size_t size = 0;
+
+    if (m_InputEncoder.GetRedundancy() > 1)
+    {
+        buffer[0] = static_cast<uint8_t>(PacketType::INPUT_BATCH);
+
+        size_t batchSize = m_InputEncoder.Encode(cmd, buffer + 1, sizeof(buffer) - 1);
+        if (batchSize == 0) return;
+        size = 1 + batchSize;
+    }
+    else
+    {
+        buffer[0] = static_cast<uint8_t>(PacketType::INPUT_CMD);
+        size = 1 + NetReflect::Write(cmd, buffer + 1, sizeof(buffer) - 1);
+    }
+
+    if (!QueueMessage(buffer, size)) return;
+    m_TotalInputsSent++;
 }
 
 //-----------------------------------------------------------------------------
-// Network quality stats from ENet peer
+// AcquireSnapshot - Oldest decoded snapshot, read in place from the pool
 //-----------------------------------------------------------------------------
-uint32_t ENetClientNetwork::GetRTT() const
+bool ENetClientNetwork::AcquireSnapshot(SnapshotHandle& outHandle)
+{
+    return m_SnapshotPool.Acquire(outHandle);
+}
+
+size_t ENetClientNetwork::GetSnapshotQueueSize() const
 {
-    if (m_pServerPeer && m_IsConnected)
-        return m_pServerPeer->roundTripTime;
-    return 0;
+    return m_SnapshotPool.GetReadyCount();
 }
 
-uint32_t ENetClientNetwork::GetPacketLoss() const
+size_t ENetClientNetwork::GetInputQueueSize() const
 {
-    if (m_pServerPeer && m_IsConnected)
-        return m_pServerPeer->packetLoss;  // ENet: fixed-point, /65536 for fraction
-    return 0;
+    return m_OutgoingInputs.Size();
 }
 
 //-----------------------------------------------------------------------------
 // No-ops on client side
 //-----------------------------------------------------------------------------
 bool ENetClientNetwork::ReceiveInputCmd(InputCmd&) { return false; }
-size_t ENetClientNetwork::GetInputQueueSize() const { return 0; }
 void ENetClientNetwork::SendSnapshot(const Snapshot&) {}
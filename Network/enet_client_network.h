@@ -4,18 +4,66 @@
 //
 // ENet-based client network implementation.
 // Connects to a remote game server and exchanges InputCmd/Snapshot packets.
+// Gameplay events arrive reliably on their own channel (see net_event.h).
+// Inputs and acks of one pump share a datagram (see net_bundle.h) once
+// the server's CAPS answer confirms it unpacks BUNDLE.
+// Raw INPUT_CMD / SNAPSHOT packets use the reflected layouts of
+// net_schema.h, whose hash both sides compare right after connecting.
+// The tick rate is requested at the same time; the session runs at the
+// rate the server answers with (see net_tick.h).
+//
+// Connection: Initialize() only starts connecting and returns at once; the
+// handshake, timeouts and reconnects all advance inside the ENet pump:
+//   CONNECTING      -> CONNECTED, or RECONNECT_WAIT after CONNECT_TIMEOUT
+//   CONNECTED       -> RECONNECT_WAIT when the server drops us, or
+//                      DISCONNECTING if its schema hash differs (no retry:
+//                      the next attempt would meet the same server)
+//   RECONNECT_WAIT  -> CONNECTING after a backoff that doubles per failed
+//                      attempt (RECONNECT_DELAY_MIN..MAX), reset on success
+//   DISCONNECTING   -> DISCONNECTED on the server's ack or DISCONNECT_TIMEOUT
+// Every CONNECTED starts a new server session and bumps GetSessionEpoch();
+// the old session's snapshots were received before the backoff, so the
+// game has drained them by the time the epoch changes.
+// Finalize() notifies the server without waiting for its ack.
+//
+// Threading:
+//   Default:   PollEvents() pumps ENet once per render frame on the game
+//              thread; SendInputCmd queues its packet, which leaves with
+//              the next poll.
+//   IO thread: a dedicated thread services ENet with a short timeout,
+//              timestamps snapshots on arrival and sends queued inputs.
+//              Game <-> IO thread traffic goes through SPSC rings only;
+//              PollEvents() becomes a no-op.
+//
+// Memory: snapshots are decoded in place into a SnapshotPool slot, and ENet
+// plus outgoing payloads allocate from NetAllocator, so steady-state
+// traffic performs no heap allocation.
 //=============================================================================
 
 #include "i_network.h"
-#include <queue>
-#include <mutex>
+#include "snapshot_delta.h"
+#include "snapshot_parts.h"
+#include "input_batch.h"
+#include "net_bundle.h"
+#include "spsc_ring.h"
+#include <atomic>
 #include <string>
+#include <thread>
 
 // Forward declarations for ENet types to avoid winsock.h / winsock2.h conflict.
 // ENet headers are only included in the .cpp file.
 typedef struct _ENetHost ENetHost;
 typedef struct _ENetPeer ENetPeer;
 
+enum class ConnectionState : uint8_t
+{
+    DISCONNECTED,       // Not started, Disconnect() done, or reconnect disabled
+    CONNECTING,         // Handshake in flight
+    CONNECTED,
+    DISCONNECTING,      // Disconnect(): waiting for the server's ack
+    RECONNECT_WAIT,     // Lost or failed: next attempt after the backoff
+};
+
 class ENetClientNetwork : public INetwork
 {
 public:
@@ -26,6 +74,13 @@ public:
     // Configuration (call before Initialize)
     //-------------------------------------------------------------------------
     void SetServerAddress(const char* host, uint16_t port);
+    void SetSnapshotDeltaEnabled(bool enabled) { m_SnapshotDeltaEnabled = enabled; }
+    void SetSnapshotEntropyEnabled(bool enabled) { m_DeltaDecoder.SetEntropyCoding(enabled); }
+    void SetInputRedundancy(int redundancy) { m_InputEncoder.SetRedundancy(redundancy); }
+    void SetIoThreadEnabled(bool enabled) { m_IoThreadEnabled = enabled; }
+    void SetBundleMtu(size_t mtu) { m_Bundler.SetMtu(mtu); }   // 0 = one packet per message
+    void SetReconnectEnabled(bool enabled) { m_ReconnectEnabled = enabled; }
+    void SetTickRate(uint32_t hz) { m_RequestedTickRate = NetTickRate::Sanitize(hz); }   // Requested, see GetTickRate
 
     //-------------------------------------------------------------------------
     // INetwork interface
@@ -36,26 +91,72 @@ public:
     // Client -> Server (Upstream)
     void SendInputCmd(const InputCmd& cmd) override;
     bool ReceiveInputCmd(InputCmd& outCmd) override;      // No-op on client
-    size_t GetInputQueueSize() const override;             // Always 0 on client
+    size_t GetInputQueueSize() const override;             // Outgoing inputs not yet sent
 
     // Server -> Client (Downstream)
     void SendSnapshot(const Snapshot& snapshot) override;  // No-op on client
-    bool ReceiveSnapshot(Snapshot& outSnapshot) override;
+    bool AcquireSnapshot(SnapshotHandle& outHandle) override;
     size_t GetSnapshotQueueSize() const override;
+    bool ReceiveEvent(NetEvent& outEvent) override { return m_IncomingEvents.Pop(outEvent); }
 
     // Statistics
     uint32_t GetTotalInputsSent() const override { return m_TotalInputsSent; }
     uint32_t GetTotalSnapshotsSent() const override { return m_TotalSnapshotsReceived; }
 
     // Network quality
-    uint32_t GetRTT() const override;
-    uint32_t GetPacketLoss() const override;
-    bool IsConnected() const override { return m_IsConnected; }
+    uint32_t GetRTT() const override { return m_RTT; }
+    uint32_t GetPacketLoss() const override { return m_PacketLoss; }
+    bool IsConnected() const override { return m_State == ConnectionState::CONNECTED; }
+    uint32_t GetTickRate() const override { return m_TickRate; }
+    uint32_t GetSessionEpoch() const override { return m_SessionEpoch; }
+    uint32_t GetLastSnapshotBytes() const override { return m_LastSnapshotBytes; }
+    uint64_t GetTotalBytesSent() const override { return m_TotalBytesSent; }
+    uint64_t GetTotalBytesReceived() const override { return m_TotalBytesReceived; }
+    uint64_t GetTotalPacketsSent() const override { return m_TotalPacketsSent; }
+    uint64_t GetTotalPacketsReceived() const override { return m_TotalPacketsReceived; }
+    uint32_t GetInputDropCount() const override { return m_OutgoingInputs.GetDropCount(); }
+    uint32_t GetSnapshotDropCount() const override { return m_SnapshotPool.GetDropCount(); }
+    uint32_t GetEventDropCount() const override { return m_IncomingEvents.GetDropCount(); }
 
     //-------------------------------------------------------------------------
     // ENet-specific
     //-------------------------------------------------------------------------
-    void PollEvents();
+    void PollEvents();     // Game thread pump; no-op while the IO thread runs
+    bool IsIoThreadRunning() const { return m_IoThread.joinable(); }
+
+    // Graceful disconnect, completed by the pump (no reconnect afterwards)
+    void Disconnect() { m_DisconnectRequested = true; }
+    ConnectionState GetConnectionState() const { return m_State; }
+    uint32_t GetReconnectCount() const { return m_ReconnectCount; }     // Attempts after the first
+    bool HasSchemaMismatch() const { return m_SchemaMismatch; }         // Server left over NET_SCHEMA_HASH
+    uint32_t GetSendDropCount() const { return m_SendDropCount; }       // Upstream packets with no buffer
+
+    static constexpr uint32_t IO_SERVICE_TIMEOUT_MS = 1;
+    static constexpr double CONNECT_TIMEOUT = 5.0;          // Seconds per attempt
+    static constexpr double DISCONNECT_TIMEOUT = 3.0;
+    static constexpr double RECONNECT_DELAY_MIN = 0.5;
+    static constexpr double RECONNECT_DELAY_MAX = 8.0;
+
+private:
+    void UpdateConnection(double now);
+    void BeginConnect(double now);
+    void ScheduleReconnect(double now);
+    void ServiceHost(uint32_t timeoutMs);
+    void HandlePacket(const uint8_t* data, size_t size, double arrivalTime);
+    void HandleSnapshotPacket(const uint8_t* data, size_t size, double arrivalTime);
+    void HandleEventPacket(const uint8_t* data, size_t size);
+    void HandleSchemaPacket(const uint8_t* data, size_t size, double now);
+    void HandleTickRatePacket(const uint8_t* data, size_t size);
+    void HandleCapsPacket(const uint8_t* data, size_t size);
+    void SendSchemaHash();
+    void SendTickRateRequest();
+    void SendReliable(const uint8_t* message, size_t size);
+    void SendInputPacket(const InputCmd& cmd);
+    void SendSnapshotAck();
+    bool QueueMessage(const uint8_t* message, size_t size);
+    void FlushBundle();
+    void UpdatePeerStats();
+    void IoThreadMain();
 
 private:
     ENetHost* m_pClient;
@@ -63,13 +164,63 @@ private:
 
     std::string m_ServerHost;
     uint16_t m_ServerPort;
-    bool m_IsConnected;
+    uint32_t m_ServerAddress;                   // Resolved once by Initialize
 
-    // Incoming snapshot queue (filled by PollEvents, consumed by ReceiveSnapshot)
-    std::queue<Snapshot> m_SnapshotQueue;
-    mutable std::mutex m_SnapshotMutex;
+    // Connection state machine (advanced by the ENet pump, read by the game)
+    std::atomic<ConnectionState> m_State;
+    std::atomic<bool> m_DisconnectRequested;
+    std::atomic<uint32_t> m_ReconnectCount;
+    std::atomic<uint32_t> m_SessionEpoch;       // Successful connects
+    std::atomic<bool> m_SchemaMismatch;
+    uint32_t m_RequestedTickRate;
+    std::atomic<uint32_t> m_TickRate;           // Server's answer (DEFAULT until then)
+    bool m_ReconnectEnabled;
+    double m_StateDeadline;                     // CONNECTING / DISCONNECTING timeout
+    double m_ReconnectTime;                     // RECONNECT_WAIT: next attempt
+    double m_ReconnectDelay;                    // Current backoff
 
-    // Statistics
-    uint32_t m_TotalInputsSent;
-    uint32_t m_TotalSnapshotsReceived;
+    // Incoming snapshots (decoded in place by the ENet pump, read in place by
+    // AcquireSnapshot). When the game holds every slot, new snapshots drop.
+    SnapshotPool m_SnapshotPool;
+
+    // Outgoing input queue (IO thread mode: SendInputCmd -> IO thread)
+    static constexpr size_t INPUT_QUEUE_CAPACITY = 128;
+    SpscRing<InputCmd, INPUT_QUEUE_CAPACITY, RingOverflow::DROP_OLDEST> m_OutgoingInputs;
+
+    // Incoming gameplay events (ENet pump -> game). When full the newest
+    // drop and are counted: older unseen events are never evicted.
+    static constexpr size_t EVENT_QUEUE_CAPACITY = 1024;
+    SpscRing<NetEvent, EVENT_QUEUE_CAPACITY, RingOverflow::DROP_NEWEST> m_IncomingEvents;
+
+    // IO thread
+    bool m_IoThreadEnabled;
+    std::thread m_IoThread;
+    std::atomic<bool> m_IoThreadStop;
+
+    // Delta snapshot decoding (baselines keyed by tickId; ENet pump only)
+    bool m_SnapshotDeltaEnabled;
+    SnapshotDeltaDecoder m_DeltaDecoder;
+    SnapshotReassembler m_Reassembler;
+    uint32_t m_LastAckSent;
+    bool m_HasSentAck;
+
+    // Redundant input batching (redundancy 1 = legacy INPUT_CMD; sender only)
+    InputBatchEncoder m_InputEncoder;
+
+    // Upstream messages of the current pump (ENet pump only). Used only
+    // once the server confirmed NetClientCaps::BUNDLE for this session.
+    PacketBundler m_Bundler;
+    uint32_t m_ServerCaps;                      // Server's CAPS answer (NONE until then)
+
+    // Statistics (written by the ENet pump, read by the game)
+    std::atomic<uint32_t> m_TotalInputsSent;
+    std::atomic<uint32_t> m_TotalSnapshotsReceived;
+    std::atomic<uint32_t> m_LastSnapshotBytes;
+    std::atomic<uint32_t> m_RTT;
+    std::atomic<uint32_t> m_PacketLoss;
+    std::atomic<uint64_t> m_TotalBytesReceived;
+    std::atomic<uint64_t> m_TotalBytesSent;
+    std::atomic<uint64_t> m_TotalPacketsReceived;
+    std::atomic<uint64_t> m_TotalPacketsSent;
+    std::atomic<uint32_t> m_SendDropCount;
 };
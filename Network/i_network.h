@@ -7,6 +7,9 @@
 //=============================================================================
 
 #include "net_common.h"
+#include "net_event.h"
+#include "net_tick.h"
+#include "snapshot_pool.h"
 #include <cstdint>
 
 class INetwork
@@ -28,9 +31,35 @@ public:
     // Server -> Client (Downstream)
     //-------------------------------------------------------------------------
     virtual void SendSnapshot(const Snapshot& snapshot) = 0;
-    virtual bool ReceiveSnapshot(Snapshot& outSnapshot) = 0;
     virtual size_t GetSnapshotQueueSize() const = 0;
 
+    // Oldest received snapshot, read in place from the network's pool
+    // (no copy). Release the handle (or reuse it) on the calling thread.
+    virtual bool AcquireSnapshot(SnapshotHandle& outHandle) = 0;
+
+    // Copying convenience wrapper around AcquireSnapshot
+    bool ReceiveSnapshot(Snapshot& outSnapshot)
+    {
+        SnapshotHandle handle;
+        if (!AcquireSnapshot(handle)) return false;
+        outSnapshot = *handle;
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+    // Server -> Client gameplay events (reliable, ordered; see net_event.h).
+    // Backends without an event channel drop them.
+    //-------------------------------------------------------------------------
+    // One tick's events for this client, sent as a single batch
+    virtual void SendEvents(uint32_t, const NetEvent*, size_t) {}
+
+    // Server's tick rate for this client (answers its TICK_RATE request;
+    // read back through GetTickRate). Backends without it stay at DEFAULT.
+    virtual void SendTickRate(uint32_t) {}
+
+    // Oldest received event (tick order, none missing)
+    virtual bool ReceiveEvent(NetEvent&) { return false; }
+
     //-------------------------------------------------------------------------
     // Debug / Statistics
     //-------------------------------------------------------------------------
@@ -41,4 +70,27 @@ public:
     virtual uint32_t GetRTT() const { return 0; }
     virtual uint32_t GetPacketLoss() const { return 0; }
     virtual bool IsConnected() const { return true; }
+
+    // Changes whenever a new server session starts (reconnect). Server
+    // ticks and times restart with it, so state keyed by them must too.
+    virtual uint32_t GetSessionEpoch() const { return 0; }
+
+    // Simulation rate of the session (Hz, see net_tick.h). NetTickRate::DEFAULT
+    // until the server has answered the client's request.
+    virtual uint32_t GetTickRate() const { return NetTickRate::DEFAULT; }
+
+    // Encoded size of the most recent snapshot on the wire (0 = not encoded)
+    virtual uint32_t GetLastSnapshotBytes() const { return 0; }
+
+    // Traffic through the socket since Initialize (payload bytes, ENet
+    // headers excluded; ENet only)
+    virtual uint64_t GetTotalBytesSent() const { return 0; }
+    virtual uint64_t GetTotalBytesReceived() const { return 0; }
+    virtual uint64_t GetTotalPacketsSent() const { return 0; }
+    virtual uint64_t GetTotalPacketsReceived() const { return 0; }
+
+    // Elements discarded because a local queue was full
+    virtual uint32_t GetInputDropCount() const { return 0; }
+    virtual uint32_t GetSnapshotDropCount() const { return 0; }
+    virtual uint32_t GetEventDropCount() const { return 0; }
 };
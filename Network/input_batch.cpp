@@ -0,0 +1,124 @@
+//=============================================================================
+// input_batch.cpp
+//
+// Redundant, delta-encoded InputCmd batches and server-side dedupe.
+// Field quantization and packing live in net_codec.cpp.
+//=============================================================================
+
+#include "input_batch.h"
+#include "net_bitstream.h"
+
+//=============================================================================
+// InputBatchEncoder
+//=============================================================================
+
+void InputBatchEncoder::Reset()
+{
+    m_Head = 0;
+    m_Count = 0;
+}
+
+void InputBatchEncoder::SetRedundancy(int redundancy)
+{
+    if (redundancy < 1) redundancy = 1;
+    if (redundancy > static_cast<int>(INPUT_BATCH_MAX_COMMANDS))
+        redundancy = static_cast<int>(INPUT_BATCH_MAX_COMMANDS);
+    m_Redundancy = redundancy;
+}
+
+size_t InputBatchEncoder::Encode(const InputCmd& cmd, uint8_t* out, size_t capacity)
+{
+    // Tick counter went backwards: older commands are meaningless now
+    if (m_Count > 0 && cmd.tickId <= m_History[m_Head].tickId)
+        Reset();
+
+    m_Head = (m_Count == 0) ? 0 : (m_Head + 1) % INPUT_BATCH_MAX_COMMANDS;
+    m_History[m_Head] = cmd;
+    if (m_Count < INPUT_BATCH_MAX_COMMANDS) m_Count++;
+
+    size_t count = static_cast<size_t>(m_Redundancy);
+    if (count > m_Count) count = m_Count;
+
+    BitWriter w(out, capacity);
+    w.WriteBits(static_cast<uint32_t>(count - 1), INPUT_BATCH_COUNT_BITS);
+    w.WriteVarint(cmd.tickId);
+    NetCodec::WriteInputCmd(w, cmd);
+
+    // Walk back through history, each entry relative to the one after it
+    const InputCmd* newer = &m_History[m_Head];
+    for (size_t i = 1; i < count; i++)
+    {
+        size_t slot = (m_Head + INPUT_BATCH_MAX_COMMANDS - i) % INPUT_BATCH_MAX_COMMANDS;
+        const InputCmd& older = m_History[slot];
+
+        uint32_t gap = newer->tickId - older.tickId;
+        w.WriteBool(gap == 1);
+        if (gap != 1) w.WriteVarint(gap);
+
+        NetCodec::WriteInputCmdDelta(w, older, *newer);
+        newer = &older;
+    }
+
+    return w.Finish();
+}
+
+//=============================================================================
+// InputBatchDecoder
+//=============================================================================
+
+void InputBatchDecoder::Reset()
+{
+    m_NewestTick = 0;
+    m_HasReceived = false;
+    m_DuplicateCount = 0;
+    m_RecoveredCount = 0;
+    m_LostCount = 0;
+}
+
+size_t InputBatchDecoder::Decode(const uint8_t* data, size_t size,
+                                 InputCmd* outCmds, size_t maxCmds)
+{
+    BitReader r(data, size);
+
+    // Decode newest to oldest into a scratch array first: a malformed
+    // packet must not half-advance the dedupe state
+    InputCmd cmds[INPUT_BATCH_MAX_COMMANDS];
+    size_t count = r.ReadBits(INPUT_BATCH_COUNT_BITS) + 1;
+
+    cmds[0] = {};
+    cmds[0].tickId = static_cast<uint32_t>(r.ReadVarint());
+    NetCodec::ReadInputCmd(r, cmds[0]);
+
+    for (size_t i = 1; i < count; i++)
+    {
+        uint32_t gap = 1;
+        if (!r.ReadBool()) gap = static_cast<uint32_t>(r.ReadVarint());
+        if (gap == 0 || gap > cmds[i - 1].tickId) return 0;
+
+        cmds[i].tickId = cmds[i - 1].tickId - gap;
+        NetCodec::ReadInputCmdDelta(r, cmds[i], cmds[i - 1]);
+    }
+
+    if (r.HasOverflow() || !r.IsAtEnd()) return 0;
+
+    // Keep only ticks newer than anything already delivered
+    size_t fresh = 0;
+    while (fresh < count && (!m_HasReceived || cmds[fresh].tickId > m_NewestTick))
+        fresh++;
+    m_DuplicateCount += static_cast<uint32_t>(count - fresh);
+    if (fresh > maxCmds) fresh = maxCmds;
+    if (fresh == 0) return 0;
+
+    // Ticks between the previous newest and the oldest fresh one never arrived
+    const uint32_t oldestFresh = cmds[fresh - 1].tickId;
+    if (m_HasReceived && oldestFresh > m_NewestTick + 1)
+        m_LostCount += oldestFresh - m_NewestTick - 1;
+    m_RecoveredCount += static_cast<uint32_t>(fresh - 1);
+
+    for (size_t i = 0; i < fresh; i++)
+        outCmds[i] = cmds[fresh - 1 - i];
+
+    m_NewestTick = cmds[0].tickId;
+    m_HasReceived = true;
+    return fresh;
+}
@@ -0,0 +1,101 @@
+#pragma once
+//=============================================================================
+// input_batch.h
+//
+// Redundant InputCmd packets so a single lost packet does not lose input.
+// Shared between game_client and game_server (maintain in sync).
+//
+// Protocol:
+//   Client: every INPUT_BATCH packet carries the newest command plus up to
+//           (redundancy - 1) previous ones. Older commands are delta-encoded
+//           against the next newer one, so repeats of held input cost a
+//           few bits each.
+//   Server: one InputBatchDecoder per client connection. It drops commands
+//           whose tickId was already received and returns the rest oldest
+//           first, so ProcessInputCmd sees each tick exactly once.
+//
+// Wire layout (bit-packed, see net_codec.h for field quantization):
+//   3 bits  count - 1                (1..INPUT_BATCH_MAX_COMMANDS)
+//   varint  tickId of newest command
+//   ...     newest command           (full)
+//   repeated count - 1 times, newest to oldest:
+//     1 bit   CONSECUTIVE            (tickId == newer tickId - 1)
+//     varint  newer tickId - tickId  only if !CONSECUTIVE
+//     ...     command                (delta vs. the newer command)
+//=============================================================================
+
+#include "net_common.h"
+#include "net_codec.h"
+#include <cstddef>
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+// Size limits
+//-----------------------------------------------------------------------------
+static constexpr size_t INPUT_BATCH_MAX_COMMANDS = 8;
+static constexpr int INPUT_BATCH_COUNT_BITS = 3;
+static constexpr int INPUT_BATCH_DEFAULT_REDUNDANCY = 3;
+
+static_assert(INPUT_BATCH_MAX_COMMANDS == (1u << INPUT_BATCH_COUNT_BITS),
+              "INPUT_BATCH_COUNT_BITS must cover INPUT_BATCH_MAX_COMMANDS");
+
+// Worst case: every command differs in every field and is non-consecutive
+static constexpr size_t INPUT_BATCH_MAX_SIZE =
+    (INPUT_BATCH_COUNT_BITS +
+     INPUT_BATCH_MAX_COMMANDS * (1 + NetCodec::VARINT32_MAX_BITS + NetCodec::INPUT_CMD_MAX_BITS) +
+     7) / 8;
+
+//-----------------------------------------------------------------------------
+// InputBatchEncoder - Client side
+//-----------------------------------------------------------------------------
+class InputBatchEncoder
+{
+public:
+    void Reset();
+
+    // Commands per packet including the newest (clamped to 1..MAX_COMMANDS)
+    void SetRedundancy(int redundancy);
+    int GetRedundancy() const { return m_Redundancy; }
+
+    // Record cmd and encode it with its predecessors into out[0..capacity).
+    // Returns bytes written, 0 on error. A tickId that does not increase
+    // (client restarted its tick counter) discards the history.
+    size_t Encode(const InputCmd& cmd, uint8_t* out, size_t capacity);
+
+private:
+    InputCmd m_History[INPUT_BATCH_MAX_COMMANDS] = {};  // Ring, newest at m_Head
+    size_t m_Head = 0;
+    size_t m_Count = 0;
+    int m_Redundancy = INPUT_BATCH_DEFAULT_REDUNDANCY;
+};
+
+//-----------------------------------------------------------------------------
+// InputBatchDecoder - Server side (one per client connection)
+//-----------------------------------------------------------------------------
+class InputBatchDecoder
+{
+public:
+    void Reset();
+
+    // Decode an INPUT_BATCH payload (without the PacketType byte).
+    // Writes commands not seen before to outCmds, oldest first, and returns
+    // how many. Returns 0 for malformed packets and pure duplicates.
+    size_t Decode(const uint8_t* data, size_t size,
+                  InputCmd* outCmds, size_t maxCmds);
+
+    bool HasReceived() const { return m_HasReceived; }
+    uint32_t GetNewestTick() const { return m_NewestTick; }
+
+    // Statistics
+    uint32_t GetDuplicateCount() const { return m_DuplicateCount; }  // Already-seen commands dropped
+    uint32_t GetRecoveredCount() const { return m_RecoveredCount; }  // Delivered only by redundancy
+    uint32_t GetLostCount() const { return m_LostCount; }            // Tick gaps no packet covered
+
+private:
+    uint32_t m_NewestTick = 0;
+    bool m_HasReceived = false;
+
+    uint32_t m_DuplicateCount = 0;
+    uint32_t m_RecoveredCount = 0;
+    uint32_t m_LostCount = 0;
+};
@@ -0,0 +1,161 @@
+//=============================================================================
+// interest_manager.cpp
+//
+// Per-client relevancy filtering of snapshot entries.
+//=============================================================================
+
+#include "interest_manager.h"
+#include "collision_world.h"
+#include <cmath>
+
+namespace {
+
+// Sight-line targets on a remote player: head and chest
+constexpr float TARGET_HEAD_HEIGHT = InterestManager::EYE_HEIGHT;
+constexpr float TARGET_CHEST_HEIGHT = 0.8f;
+
+//-----------------------------------------------------------------------------
+// Segment [from, to] vs AABB (slab method on t in [0, 1])
+//-----------------------------------------------------------------------------
+bool SegmentHitsAABB(const DirectX::XMFLOAT3& from, const DirectX::XMFLOAT3& to, const AABB& aabb)
+{
+    float tMin = 0.0f;
+    float tMax = 1.0f;
+
+    auto slab = [&](float o, float d, float lo, float hi) -> bool {
+        if (fabsf(d) < 1e-8f)
+            return (o >= lo && o <= hi);
+        float inv = 1.0f / d;
+        float t1 = (lo - o) * inv;
+        float t2 = (hi - o) * inv;
+        if (t1 > t2) { float tmp = t1; t1 = t2; t2 = tmp; }
+        if (t1 > tMin) tMin = t1;
+        if (t2 < tMax) tMax = t2;
+        return tMin <= tMax;
+    };
+
+    return slab(from.x, to.x - from.x, aabb.min.x, aabb.max.x) &&
+           slab(from.y, to.y - from.y, aabb.min.y, aabb.max.y) &&
+           slab(from.z, to.z - from.z, aabb.min.z, aabb.max.z);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// HasLineOfSight - Eye to the target's head or chest is unobstructed
+//-----------------------------------------------------------------------------
+bool InterestManager::HasLineOfSight(const DirectX::XMFLOAT3& eye, const DirectX::XMFLOAT3& feet) const
+{
+    if (!m_pCollisionWorld) return true;
+
+    DirectX::XMFLOAT3 head = { feet.x, feet.y + TARGET_HEAD_HEIGHT, feet.z };
+    DirectX::XMFLOAT3 chest = { feet.x, feet.y + TARGET_CHEST_HEIGHT, feet.z };
+    bool headClear = true;
+    bool chestClear = true;
+
+    for (const ColliderAABB& collider : m_pCollisionWorld->GetColliders())
+    {
+        if (headClear && SegmentHitsAABB(eye, head, collider.aabb)) headClear = false;
+        if (chestClear && SegmentHitsAABB(eye, chest, collider.aabb)) chestClear = false;
+        if (!headClear && !chestClear) return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Filter - Classify and compact snapshot.remotePlayers in place
+//-----------------------------------------------------------------------------
+void InterestManager::Filter(Snapshot& snapshot)
+{
+    InterestStats stats = {};
+    uint8_t count = snapshot.remotePlayerCount;
+    if (count > MAX_PLAYERS - 1) count = MAX_PLAYERS - 1;
+    stats.candidates = count;
+
+    if (!m_Enabled)
+    {
+        stats.visible = count;
+        m_LastStats = stats;
+        return;
+    }
+
+    const NetPlayerState& viewer = snapshot.localPlayer;
+    const DirectX::XMFLOAT3 eye = {
+        viewer.position.x,
+        viewer.position.y + EYE_HEIGHT,
+        viewer.position.z
+    };
+
+    // View direction from yaw/pitch (same convention as the hitscan ray)
+    const float cosPitch = cosf(viewer.pitch);
+    const DirectX::XMFLOAT3 forward = {
+        sinf(viewer.yaw) * cosPitch,
+        sinf(viewer.pitch),
+        cosf(viewer.yaw) * cosPitch
+    };
+
+    const float nearSq = m_Settings.nearRadius * m_Settings.nearRadius;
+    const float maxSq = m_Settings.maxDistance * m_Settings.maxDistance;
+    const float cosHalfAngle = cosf(m_Settings.viewHalfAngle);
+    const uint32_t interval = m_Settings.lowRateInterval > 0 ? m_Settings.lowRateInterval : 1;
+
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const RemotePlayerEntry& entry = snapshot.remotePlayers[i];
+        const DirectX::XMFLOAT3& feet = entry.state.position;
+
+        float dx = feet.x - eye.x;
+        float dy = feet.y + TARGET_CHEST_HEIGHT - eye.y;
+        float dz = feet.z - eye.z;
+        float distSq = dx * dx + dy * dy + dz * dz;
+
+        bool send = true;
+        if (distSq > maxSq)
+        {
+            stats.culled++;
+            send = false;
+        }
+        else if (distSq <= nearSq)
+        {
+            stats.visible++;
+        }
+        else
+        {
+            float dist = sqrtf(distSq);
+            float cosAngle = (dx * forward.x + dy * forward.y + dz * forward.z) / dist;
+
+            bool peripheral = false;
+            if (cosAngle < cosHalfAngle)
+            {
+                stats.outsideView++;
+                peripheral = true;
+            }
+            else if (!HasLineOfSight(eye, feet))
+            {
+                stats.occluded++;
+                peripheral = true;
+            }
+            else
+            {
+                stats.visible++;
+            }
+
+            // Stagger low-rate players across ticks so bandwidth stays even
+            if (peripheral && (snapshot.tickId + entry.playerId) % interval != 0)
+            {
+                stats.deferred++;
+                send = false;
+            }
+        }
+
+        if (send)
+        {
+            if (kept != i) snapshot.remotePlayers[kept] = entry;
+            kept++;
+        }
+    }
+
+    snapshot.remotePlayerCount = kept;
+    m_LastStats = stats;
+}
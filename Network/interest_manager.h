@@ -0,0 +1,84 @@
+#pragma once
+//=============================================================================
+// interest_manager.h
+//
+// Server-side relevancy pass run on each client's snapshot before encoding.
+// Shared between game_client (MockServer) and game_server (maintain in sync).
+//
+// Every remote player in the snapshot is classified against the viewer
+// (snapshot.localPlayer):
+//   CULLED      farther than maxDistance              -> not sent
+//   VISIBLE     within nearRadius, or inside the view  -> sent every tick
+//               cone with line of sight to the viewer's eye
+//   PERIPHERAL  in range but outside the view cone,    -> sent every
+//               or every sight line blocked by a          lowRateInterval ticks
+//               CollisionWorld AABB                       (staggered by playerId)
+//
+// Entries are removed in place, keeping their ascending playerId order, so
+// the delta encoder's cost and the client's decode work follow what the
+// viewer can actually see. Line of sight is only traced for candidates that
+// are in range and inside the cone.
+//
+// Clients must not treat a missing entry as a disconnect; they time out
+// players that have been absent for longer than a peripheral interval.
+//=============================================================================
+
+#include "net_common.h"
+#include <cstdint>
+
+class CollisionWorld;
+
+//-----------------------------------------------------------------------------
+// Tuning
+//-----------------------------------------------------------------------------
+struct InterestSettings
+{
+    float nearRadius = 10.0f;            // Always relevant: close enough to hear or bump into
+    float maxDistance = 200.0f;          // Hitscan range; anything farther cannot interact
+    float viewHalfAngle = 1.05f;         // Radians (~60°): widest FOV plus turning margin
+    uint32_t lowRateInterval = 4;        // Peripheral: every 4th tick (8Hz @ 32Hz; MockServer keeps 8Hz)
+};
+
+//-----------------------------------------------------------------------------
+// Debug counters for one pass (one client, one tick)
+//-----------------------------------------------------------------------------
+struct InterestStats
+{
+    uint32_t candidates;    // Remote players considered
+    uint32_t visible;       // Sent at full rate
+    uint32_t outsideView;   // Peripheral: outside the view cone
+    uint32_t occluded;      // Peripheral: in the cone but behind a collider
+    uint32_t deferred;      // Peripheral players skipped this tick
+    uint32_t culled;        // Beyond maxDistance
+};
+
+//-----------------------------------------------------------------------------
+// InterestManager - Server side (one per server; passes are independent)
+//-----------------------------------------------------------------------------
+class InterestManager
+{
+public:
+    void SetCollisionWorld(const CollisionWorld* pCollisionWorld) { m_pCollisionWorld = pCollisionWorld; }
+    void SetSettings(const InterestSettings& settings) { m_Settings = settings; }
+    const InterestSettings& GetSettings() const { return m_Settings; }
+
+    void SetEnabled(bool enabled) { m_Enabled = enabled; }
+    bool IsEnabled() const { return m_Enabled; }
+
+    // Drop irrelevant remote players from snapshot for its local player.
+    // Disabled: counts every candidate as visible and leaves the snapshot.
+    void Filter(Snapshot& snapshot);
+
+    const InterestStats& GetLastStats() const { return m_LastStats; }
+
+    // Eye height above NetPlayerState.position (must match MockServer hitscan)
+    static constexpr float EYE_HEIGHT = 1.5f;
+
+private:
+    bool HasLineOfSight(const DirectX::XMFLOAT3& eye, const DirectX::XMFLOAT3& feet) const;
+
+    const CollisionWorld* m_pCollisionWorld = nullptr;
+    InterestSettings m_Settings;
+    bool m_Enabled = true;
+    InterestStats m_LastStats = {};
+};
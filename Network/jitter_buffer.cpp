@@ -0,0 +1,118 @@
+//=============================================================================
+// jitter_buffer.cpp
+//
+// Quantile-based interpolation delay with time-dilated changes.
+//=============================================================================
+
+#include "jitter_buffer.h"
+#include <algorithm>
+
+namespace {
+
+// Weight of one sample in the mean lateness
+constexpr double JITTER_GAIN = 1.0 / 16.0;
+
+double Clamp(double value, double lo, double hi)
+{
+    if (value < lo) return lo;
+    if (value > hi) return hi;
+    return value;
+}
+
+} // namespace
+
+void JitterBuffer::Reset()
+{
+    const double lateTarget = m_LateTarget;
+    const double minDelay = m_MinDelay;
+    const double maxDelay = m_MaxDelay;
+
+    *this = JitterBuffer();
+    m_LateTarget = lateTarget;
+    SetDelayLimits(minDelay, maxDelay);
+}
+
+void JitterBuffer::SetDelayLimits(double minDelay, double maxDelay)
+{
+    m_MinDelay = minDelay;
+    m_MaxDelay = (maxDelay > minDelay) ? maxDelay : minDelay;
+    m_TargetDelay = Clamp(m_TargetDelay, m_MinDelay, m_MaxDelay);
+    m_Delay = Clamp(m_Delay, m_MinDelay, m_MaxDelay);
+}
+
+void JitterBuffer::AddSample(uint32_t tickId, double serverTime, double timelineAtArrival)
+{
+    double lateness = timelineAtArrival - serverTime;
+    if (lateness < 0.0) lateness = 0.0;
+    m_Jitter += (lateness - m_Jitter) * JITTER_GAIN;
+
+    // Only a new newest snapshot ends a stretch the render could run dry
+    // in; one overtaken by a newer snapshot needs no delay
+    double needed = 0.0;
+    if (m_SampleCount == 0 || tickId > m_NewestTick)
+    {
+        double gap = m_TickInterval;
+        if (m_SampleCount > 0)
+        {
+            gap = serverTime - m_NewestServerTime;
+            if (tickId == m_NewestTick + 1 && gap > 0.0)
+                m_TickInterval += (gap - m_TickInterval) * JITTER_GAIN;
+        }
+        needed = lateness + gap;
+        m_NewestTick = tickId;
+        m_NewestServerTime = serverTime;
+    }
+    m_SampleCount++;
+
+    const bool late = needed > m_Delay;
+
+    if (m_Count == WINDOW && m_Late[m_Next]) m_LateCount--;
+    m_Needed[m_Next] = needed;
+    m_Late[m_Next] = late;
+    m_Ticks[m_Next] = tickId;
+    if (late) m_LateCount++;
+    m_Next = (m_Next + 1) % WINDOW;
+    if (m_Count < WINDOW) m_Count++;
+
+    if (m_Count < MIN_SAMPLES) return;
+
+    // Smallest delay that covers all but lateTarget of the window
+    double sorted[WINDOW] = {};
+    std::copy(m_Needed, m_Needed + m_Count, sorted);
+    size_t rank = static_cast<size_t>((1.0 - m_LateTarget) * static_cast<double>(m_Count - 1) + 0.5);
+    if (rank >= m_Count) rank = m_Count - 1;
+    std::nth_element(sorted, sorted + rank, sorted + m_Count);
+    m_TargetDelay = Clamp(sorted[rank] + SAFETY_MARGIN, m_MinDelay, m_MaxDelay);
+
+    // Extrapolate long enough to cover the worst need in the window
+    const double worst = *std::max_element(sorted + rank, sorted + m_Count);
+    m_MaxExtrapolation = Clamp(worst - m_TargetDelay + m_TickInterval, MIN_EXTRAPOLATION, MAX_EXTRAPOLATION);
+}
+
+void JitterBuffer::Update(double elapsed_time)
+{
+    const double diff = m_TargetDelay - m_Delay;
+    const double limit = elapsed_time * ((diff > 0.0) ? GROW_RATE : SHRINK_RATE);
+    m_Delay += Clamp(diff, -limit, limit);
+}
+
+double JitterBuffer::GetLossRate() const
+{
+    if (m_Count == 0) return 0.0;
+
+    uint32_t oldest = m_Ticks[0];
+    uint32_t newest = m_Ticks[0];
+    for (size_t i = 1; i < m_Count; i++)
+    {
+        if (m_Ticks[i] < oldest) oldest = m_Ticks[i];
+        if (m_Ticks[i] > newest) newest = m_Ticks[i];
+    }
+    const double expected = static_cast<double>(newest - oldest) + 1.0;
+    const double lost = expected - static_cast<double>(m_Count);
+    return (lost > 0.0) ? lost / expected : 0.0;
+}
+
+double JitterBuffer::GetLateRate() const
+{
+    return m_Count ? static_cast<double>(m_LateCount) / static_cast<double>(m_Count) : 0.0;
+}
@@ -0,0 +1,92 @@
+#pragma once
+//=============================================================================
+// jitter_buffer.h
+//
+// Adaptive interpolation delay for remote players.
+//
+// Interpolation runs dry when the render time passes the newest snapshot
+// received. Just before a snapshot arrives that becomes the new newest, the
+// render time is furthest ahead, so the delay that snapshot needs is
+//   lateness + gap
+// where lateness is how far behind the best-case arrival it came in
+// (ClockSync arrival timeline at arrival - serverTime) and gap is the
+// server time since the previous newest (one tick, or more after a loss).
+// Snapshots overtaken by a newer one need no delay at all. The target delay
+// is the (1 - lateTarget) quantile of that over a sliding window: the
+// smallest delay that keeps the extrapolate/snap rate under lateTarget on
+// the recent link.
+//
+// The delay moves towards the target by time dilation: the render timeline
+// runs at most GROW_RATE slower or SHRINK_RATE faster than real time, so
+// the delay never jumps. It grows faster than it shrinks, since running
+// dry is worse than a few extra milliseconds.
+//
+// The extrapolation limit follows the worst need in the window, so good
+// links snap early instead of guessing and bad links ride out spikes.
+//
+// One instance per connection: all remote players share the timeline.
+//=============================================================================
+
+#include <cstddef>
+#include <cstdint>
+
+class JitterBuffer
+{
+public:
+    void Reset();
+
+    // Allowed fraction of late snapshots (extrapolate/snap), e.g. 0.01
+    void SetLateTarget(double fraction) { m_LateTarget = fraction; }
+    void SetDelayLimits(double minDelay, double maxDelay);
+
+    // One received snapshot: tick, server timestamp, and the interpolation
+    // timeline (ClockSync::GetArrivalTimeline) at its arrival
+    void AddSample(uint32_t tickId, double serverTime, double timelineAtArrival);
+
+    // Once per frame: dilate towards the target
+    void Update(double elapsed_time);
+
+    double GetDelay() const { return m_Delay; }
+    double GetMaxExtrapolation() const { return m_MaxExtrapolation; }
+
+    //-------------------------------------------------------------------------
+    // Debug
+    //-------------------------------------------------------------------------
+    double GetTargetDelay() const { return m_TargetDelay; }
+    double GetJitter() const { return m_Jitter; }          // Mean lateness (s)
+    double GetLossRate() const;                            // Over the window
+    double GetLateRate() const;                            // Samples that needed more than the delay at arrival
+
+    static constexpr size_t WINDOW = 256;                  // Samples (8s @ 32Hz, 2s @ 128Hz)
+    static constexpr size_t MIN_SAMPLES = 32;              // Before this, the initial delay holds
+    static constexpr double INITIAL_DELAY = 0.1;
+    static constexpr double SAFETY_MARGIN = 0.005;         // Added to the quantile
+    static constexpr double GROW_RATE = 0.10;              // Delay s per s (render at 90% speed)
+    static constexpr double SHRINK_RATE = 0.02;            // Delay s per s (render at 102% speed)
+    static constexpr double MIN_EXTRAPOLATION = 0.05;
+    static constexpr double MAX_EXTRAPOLATION = 0.25;
+
+private:
+    // Window of needed delays, plus whether each was late when it arrived
+    double m_Needed[WINDOW] = {};
+    bool m_Late[WINDOW] = {};
+    size_t m_Count = 0;
+    size_t m_Next = 0;
+    uint32_t m_LateCount = 0;
+
+    uint32_t m_Ticks[WINDOW] = {};                         // For the loss rate
+
+    uint32_t m_NewestTick = 0;
+    double m_NewestServerTime = 0.0;
+    double m_TickInterval = 1.0 / 32.0;                    // Measured; starts at the default rate
+    uint32_t m_SampleCount = 0;
+
+    double m_LateTarget = 0.01;
+    double m_MinDelay = 0.03;
+    double m_MaxDelay = 0.3;
+
+    double m_Delay = INITIAL_DELAY;
+    double m_TargetDelay = INITIAL_DELAY;
+    double m_MaxExtrapolation = 0.15;
+    double m_Jitter = 0.0;
+};
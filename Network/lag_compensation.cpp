@@ -0,0 +1,71 @@
+//=============================================================================
+// lag_compensation.cpp
+//
+// Per-tick SoA hit volume history and rewind.
+//=============================================================================
+
+#include "lag_compensation.h"
+
+void LagCompHistory::Reset()
+{
+    m_Newest = 0;
+    m_Count = 0;
+}
+
+void LagCompHistory::BeginFrame(uint32_t tickId, double serverTime)
+{
+    m_Newest = (m_Count == 0) ? 0 : (m_Newest + 1) % CAPACITY;
+    if (m_Count < CAPACITY) m_Count++;
+
+    LagCompFrame& frame = m_Frames[m_Newest];
+    frame.serverTime = serverTime;
+    frame.tickId = tickId;
+    std::memset(frame.alive, 0, sizeof(frame.alive));
+}
+
+void LagCompHistory::Record(uint8_t playerId, const DirectX::XMFLOAT3& position)
+{
+    if (m_Count == 0 || playerId >= MAX_PLAYERS) return;
+
+    LagCompFrame& frame = m_Frames[m_Newest];
+    frame.x[playerId] = position.x;
+    frame.y[playerId] = position.y;
+    frame.z[playerId] = position.z;
+    frame.alive[playerId >> 5] |= 1u << (playerId & 31);
+}
+
+const LagCompFrame& LagCompHistory::GetFrame(uint32_t age) const
+{
+    return m_Frames[(m_Newest + CAPACITY - age) % CAPACITY];
+}
+
+double LagCompHistory::Rewind(double serverTime, double maxRewind, LagCompFrame& out) const
+{
+    if (m_Count == 0) return -1.0;
+
+    const LagCompFrame& newest = GetFrame(0);
+    const LagCompFrame& oldest = GetFrame(m_Count - 1);
+    double time = serverTime;
+    if (time > newest.serverTime) time = newest.serverTime;
+    if (time < newest.serverTime - maxRewind) time = newest.serverTime - maxRewind;
+    if (time < oldest.serverTime) time = oldest.serverTime;
+
+    // Newest frame at or before the rewind time, and the one after it
+    uint32_t age = 0;
+    while (age + 1 < m_Count && GetFrame(age).serverTime > time) age++;
+    const LagCompFrame& a = GetFrame(age);
+    const LagCompFrame& b = GetFrame(age > 0 ? age - 1 : 0);
+
+    const double span = b.serverTime - a.serverTime;
+    const float alpha = (span > 0.0) ? static_cast<float>((time - a.serverTime) / span) : 0.0f;
+
+    out.serverTime = time;
+    out.tickId = a.tickId;
+    for (uint32_t i = 0; i < MAX_PLAYERS / 32; i++) out.alive[i] = a.alive[i] & b.alive[i];
+
+    // Entries of players not alive in both are lerped garbage, masked by alive
+    for (uint32_t i = 0; i < MAX_PLAYERS; i++) out.x[i] = a.x[i] + (b.x[i] - a.x[i]) * alpha;
+    for (uint32_t i = 0; i < MAX_PLAYERS; i++) out.y[i] = a.y[i] + (b.y[i] - a.y[i]) * alpha;
+    for (uint32_t i = 0; i < MAX_PLAYERS; i++) out.z[i] = a.z[i] + (b.z[i] - a.z[i]) * alpha;
+    return time;
+}
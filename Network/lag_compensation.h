@@ -0,0 +1,68 @@
+#pragma once
+//=============================================================================
+// lag_compensation.h
+//
+// Server-side rewind history for lag-compensated hitscan.
+//
+// A shooter aims at remote players as its client rendered them: behind the
+// server by the interpolation delay plus the time its inputs took to get
+// here. The server records every player's hit volume each tick and, when a
+// shot is processed, rewinds the targets to the shooter's view time
+// (InputCmd::viewTimeMs) before the ray test. The shooter itself stays at
+// its current state.
+//
+// Hit volumes are vertical capsules of fixed size, so a player is fully
+// described by its capsule bottom. Each tick is one structure-of-arrays
+// frame (x[], y[], z[] indexed by playerId, plus an alive bitset), so a
+// rewind is one branch-free lerp over three contiguous float arrays.
+//=============================================================================
+
+#include "net_common.h"
+#include "net_tick.h"
+
+//-----------------------------------------------------------------------------
+// LagCompFrame - Every player's capsule bottom at one server time (SoA)
+//-----------------------------------------------------------------------------
+struct LagCompFrame
+{
+    double serverTime;
+    uint32_t tickId;
+    uint32_t alive[MAX_PLAYERS / 32];   // Bit per playerId
+    float x[MAX_PLAYERS];
+    float y[MAX_PLAYERS];
+    float z[MAX_PLAYERS];
+
+    bool IsAlive(uint8_t playerId) const { return (alive[playerId >> 5] >> (playerId & 31)) & 1u; }
+};
+
+class LagCompHistory
+{
+public:
+    void Reset();
+
+    //-------------------------------------------------------------------------
+    // Recording (once per server tick, after physics)
+    //-------------------------------------------------------------------------
+    void BeginFrame(uint32_t tickId, double serverTime);
+    void Record(uint8_t playerId, const DirectX::XMFLOAT3& position);
+
+    //-------------------------------------------------------------------------
+    // Every player at `serverTime`, interpolated between the two recorded
+    // ticks around it. The time is clamped to [newest - maxRewind, newest]
+    // and to the history held; returns the time actually used (negative
+    // when nothing is recorded). A player counts as alive if it was alive
+    // in both frames.
+    //-------------------------------------------------------------------------
+    double Rewind(double serverTime, double maxRewind, LagCompFrame& out) const;
+
+    uint32_t GetFrameCount() const { return m_Count; }
+
+    static constexpr uint32_t CAPACITY = NetTickRate::MAX;  // Ticks (1s @ 128Hz, 4s @ 32Hz)
+
+private:
+    const LagCompFrame& GetFrame(uint32_t age) const;  // 0 = newest
+
+    LagCompFrame m_Frames[CAPACITY] = {};
+    uint32_t m_Newest = 0;
+    uint32_t m_Count = 0;
+};
@@ -1,33 +1,39 @@
 //=============================================================================
 // mock_network.cpp
 //
-// Mock network implementation using std::queue.
-// Thread-safe for future async usage.
+// Mock network implementation using lock-free SPSC rings and a snapshot pool.
+// Safe with the server on one thread and the client on another.
 //=============================================================================
 
 #include "mock_network.h"
+#include "net_clock.h"
 
 void MockNetwork::Initialize()
 {
-    // Clear any existing data
-    std::lock_guard<std::mutex> upLock(m_UpstreamMutex);
-    std::lock_guard<std::mutex> downLock(m_DownstreamMutex);
-    
-    while (!m_UpstreamQueue.empty()) m_UpstreamQueue.pop();
-    while (!m_DownstreamQueue.empty()) m_DownstreamQueue.pop();
-    
+    // Clear any existing data (no producer/consumer is running yet)
+    m_UpstreamQueue.Clear();
+    m_SnapshotPool.Reset();
+    m_EventQueue.Clear();
+
+    m_DeltaEncoder.Reset();
+    m_DeltaDecoder.Reset();
+    m_Reassembler.Reset();
+    m_InputEncoder.Reset();
+    m_InputDecoder.Reset();
+    m_HasConsumed = false;
+    m_TickRate = NetTickRate::DEFAULT;
+
     m_TotalInputsSent = 0;
     m_TotalSnapshotsSent = 0;
+    m_LastSnapshotBytes = 0;
 }
 
 void MockNetwork::Finalize()
 {
     // Clear queues
-    std::lock_guard<std::mutex> upLock(m_UpstreamMutex);
-    std::lock_guard<std::mutex> downLock(m_DownstreamMutex);
-    
-    while (!m_UpstreamQueue.empty()) m_UpstreamQueue.pop();
-    while (!m_DownstreamQueue.empty()) m_DownstreamQueue.pop();
+    m_UpstreamQueue.Clear();
+    m_SnapshotPool.Reset();
+    m_EventQueue.Clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -36,27 +42,33 @@ void MockNetwork::Finalize()
 
 void MockNetwork::SendInputCmd(const InputCmd& cmd)
 {
-    std::lock_guard<std::mutex> lock(m_UpstreamMutex);
-    m_UpstreamQueue.push(cmd);
     m_TotalInputsSent++;
+
+    if (m_InputEncoder.GetRedundancy() <= 1)
+    {
+        m_UpstreamQueue.Push(cmd);
+        return;
+    }
+
+    // Encode on the "client", dedupe on the "server" (mock wire is lossless)
+    uint8_t buffer[INPUT_BATCH_MAX_SIZE];
+    size_t size = m_InputEncoder.Encode(cmd, buffer, sizeof(buffer));
+    if (size == 0) return;
+
+    InputCmd decoded[INPUT_BATCH_MAX_COMMANDS];
+    size_t count = m_InputDecoder.Decode(buffer, size, decoded, INPUT_BATCH_MAX_COMMANDS);
+    for (size_t i = 0; i < count; i++)
+        m_UpstreamQueue.Push(decoded[i]);
 }
 
 bool MockNetwork::ReceiveInputCmd(InputCmd& outCmd)
 {
-    std::lock_guard<std::mutex> lock(m_UpstreamMutex);
-    if (m_UpstreamQueue.empty())
-    {
-        return false;
-    }
-    outCmd = m_UpstreamQueue.front();
-    m_UpstreamQueue.pop();
-    return true;
+    return m_UpstreamQueue.Pop(outCmd);
 }
 
 size_t MockNetwork::GetInputQueueSize() const
 {
-    std::lock_guard<std::mutex> lock(m_UpstreamMutex);
-    return m_UpstreamQueue.size();
+    return m_UpstreamQueue.Size();
 }
 
 //-----------------------------------------------------------------------------
@@ -65,25 +77,96 @@ size_t MockNetwork::GetInputQueueSize() const
 
 void MockNetwork::SendSnapshot(const Snapshot& snapshot)
 {
-    std::lock_guard<std::mutex> lock(m_DownstreamMutex);
-    m_DownstreamQueue.push(snapshot);
     m_TotalSnapshotsSent++;
+
+    // Client holds every slot: drop (counted by the pool)
+    SnapshotPool::Slot* slot = m_SnapshotPool.BeginWrite();
+    if (!slot) return;
+
+    if (!m_SnapshotDeltaEnabled)
+    {
+        CopySnapshot(slot->snapshot, snapshot);
+        slot->arrivalTime = NetClock::Now();
+        m_SnapshotPool.CommitWrite();
+        return;
+    }
+
+    // Pick up the client's newest ack before choosing a baseline
+    if (m_HasConsumed.load(std::memory_order_acquire))
+    {
+        m_DeltaEncoder.Acknowledge(m_ConsumedTick.load(std::memory_order_relaxed));
+    }
+
+    // Encode on the "server", decode on the "client" straight into the slot
+    // (mock wire is lossless)
+    uint8_t buffer[SNAPSHOT_DELTA_MAX_SIZE];
+    size_t size = m_DeltaEncoder.Encode(snapshot, buffer, sizeof(buffer));
+    if (size == 0) return;
+
+    const uint8_t* payload = buffer;
+    size_t payloadSize = size;
+    uint32_t wireBytes = static_cast<uint32_t>(1 + size);  // + PacketType byte
+
+    // Too big for one datagram: split and reassemble as SNAPSHOT_PART
+    if (1 + size > SNAPSHOT_PACKET_MAX_SIZE)
+    {
+        uint8_t part[SNAPSHOT_PACKET_MAX_SIZE];
+        size_t partCount = SnapshotParts::GetPartCount(size);
+        bool complete = false;
+        wireBytes = 0;
+
+        for (size_t i = 0; i < partCount; i++)
+        {
+            size_t partSize = SnapshotParts::WritePart(buffer, size, snapshot.tickId, i, part, sizeof(part));
+            if (partSize == 0) return;
+
+            complete = m_Reassembler.AddPart(part, partSize);
+            wireBytes += static_cast<uint32_t>(1 + partSize);
+        }
+        if (!complete) return;
+
+        payload = m_Reassembler.GetPayload();
+        payloadSize = m_Reassembler.GetPayloadSize();
+    }
+
+    if (!m_DeltaDecoder.Decode(payload, payloadSize, slot->snapshot)) return;
+
+    slot->arrivalTime = NetClock::Now();
+    m_SnapshotPool.CommitWrite();
+    m_LastSnapshotBytes = wireBytes;
 }
 
-bool MockNetwork::ReceiveSnapshot(Snapshot& outSnapshot)
+bool MockNetwork::AcquireSnapshot(SnapshotHandle& outHandle)
 {
-    std::lock_guard<std::mutex> lock(m_DownstreamMutex);
-    if (m_DownstreamQueue.empty())
+    if (!m_SnapshotPool.Acquire(outHandle)) return false;
+
+    // Client consumed it: ack so the server can use it as the next baseline
+    if (m_SnapshotDeltaEnabled)
     {
-        return false;
+        m_ConsumedTick.store(outHandle->tickId, std::memory_order_relaxed);
+        m_HasConsumed.store(true, std::memory_order_release);
     }
-    outSnapshot = m_DownstreamQueue.front();
-    m_DownstreamQueue.pop();
     return true;
 }
 
 size_t MockNetwork::GetSnapshotQueueSize() const
 {
-    std::lock_guard<std::mutex> lock(m_DownstreamMutex);
-    return m_DownstreamQueue.size();
+    return m_SnapshotPool.GetReadyCount();
+}
+
+//-----------------------------------------------------------------------------
+// Server -> Client gameplay events
+//-----------------------------------------------------------------------------
+
+void MockNetwork::SendEvents(uint32_t tickId, const NetEvent* events, size_t count)
+{
+    // Encode on the "server", decode on the "client" (mock wire is reliable)
+    uint8_t buffer[NET_EVENT_BATCH_MAX_SIZE];
+    size_t size = NetEvents::WriteBatch(tickId, events, count, buffer, sizeof(buffer));
+    if (size == 0) return;
+
+    NetEvent decoded[NET_EVENT_BATCH_MAX_EVENTS];
+    size_t decodedCount = NetEvents::ReadBatch(buffer, size, decoded, NET_EVENT_BATCH_MAX_EVENTS);
+    for (size_t i = 0; i < decodedCount; i++)
+        m_EventQueue.Push(decoded[i]);     // Full (game not draining): dropped and counted
 }
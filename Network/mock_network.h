@@ -2,7 +2,7 @@
 //=============================================================================
 // mock_network.h
 // 
-// Mock network layer using std::queue for local testing.
+// Mock network layer using lock-free SPSC rings for local testing.
 // Simulates network communication between client and server.
 //
 // This abstraction allows future replacement with real network (ENet, etc.)
@@ -10,8 +10,11 @@
 //=============================================================================
 
 #include "i_network.h"
-#include <queue>
-#include <mutex>
+#include "snapshot_delta.h"
+#include "snapshot_parts.h"
+#include "input_batch.h"
+#include "spsc_ring.h"
+#include <atomic>
 
 class MockNetwork : public INetwork
 {
@@ -22,6 +25,28 @@ public:
     void Initialize() override;
     void Finalize() override;
 
+    //-------------------------------------------------------------------------
+    // Route snapshots through the delta encoder/decoder, exactly as on the
+    // wire (server encodes vs. acked baseline, client decodes and acks).
+    //-------------------------------------------------------------------------
+    void SetSnapshotDeltaEnabled(bool enabled) { m_SnapshotDeltaEnabled = enabled; }
+
+    // Range code delta snapshots where smaller (NetClientCaps::SNAPSHOT_ENTROPY)
+    void SetSnapshotEntropyEnabled(bool enabled)
+    {
+        m_DeltaEncoder.SetEntropyCoding(enabled);
+        m_DeltaDecoder.SetEntropyCoding(enabled);
+    }
+
+    // Per-snapshot byte budget for the delta path (0 = unlimited); remote
+    // players that do not fit are sent on a later tick by priority
+    void SetSnapshotByteBudget(size_t bytes) { m_DeltaEncoder.SetByteBudget(bytes); }
+
+    //-------------------------------------------------------------------------
+    // Route inputs through the INPUT_BATCH encoder/decoder (1 = raw InputCmd)
+    //-------------------------------------------------------------------------
+    void SetInputRedundancy(int redundancy) { m_InputEncoder.SetRedundancy(redundancy); }
+
     //-------------------------------------------------------------------------
     // Client -> Server (Upstream)
     //-------------------------------------------------------------------------
@@ -33,25 +58,61 @@ public:
     // Server -> Client (Downstream)
     //-------------------------------------------------------------------------
     void SendSnapshot(const Snapshot& snapshot) override;
-    bool ReceiveSnapshot(Snapshot& outSnapshot) override;
+    bool AcquireSnapshot(SnapshotHandle& outHandle) override;
     size_t GetSnapshotQueueSize() const override;
 
+    // Events go through the EVENT_BATCH codec; the mock wire is reliable
+    void SendEvents(uint32_t tickId, const NetEvent* events, size_t count) override;
+    bool ReceiveEvent(NetEvent& outEvent) override { return m_EventQueue.Pop(outEvent); }
+
+    // The in-process server announces its rate when the client joins
+    void SendTickRate(uint32_t hz) override { m_TickRate = hz; }
+    uint32_t GetTickRate() const override { return m_TickRate; }
+
     //-------------------------------------------------------------------------
     // Debug / Statistics
     //-------------------------------------------------------------------------
     uint32_t GetTotalInputsSent() const override { return m_TotalInputsSent; }
     uint32_t GetTotalSnapshotsSent() const override { return m_TotalSnapshotsSent; }
+    uint32_t GetLastSnapshotBytes() const override { return m_LastSnapshotBytes; }
+    uint32_t GetInputDropCount() const override { return m_UpstreamQueue.GetDropCount(); }
+    uint32_t GetSnapshotDropCount() const override { return m_SnapshotPool.GetDropCount(); }
+    uint32_t GetEventDropCount() const override { return m_EventQueue.GetDropCount(); }
+
+    //-------------------------------------------------------------------------
+    // Upstream capacity (full queue drops the oldest element). Downstream
+    // is bounded by SnapshotPool::SLOT_COUNT (full pool drops the newest).
+    //-------------------------------------------------------------------------
+    static constexpr size_t UPSTREAM_CAPACITY = 128;    // > frames per tick at 1000fps
+    static constexpr size_t EVENT_CAPACITY = 1024;      // > two worst-case batches
 
 private:
-    // Upstream: Client -> Server
-    std::queue<InputCmd> m_UpstreamQueue;
-    mutable std::mutex m_UpstreamMutex;
+    // Upstream: Client -> Server (producer: SendInputCmd, consumer: ReceiveInputCmd)
+    SpscRing<InputCmd, UPSTREAM_CAPACITY, RingOverflow::DROP_OLDEST> m_UpstreamQueue;
+
+    // Input batching (producer side only)
+    InputBatchEncoder m_InputEncoder;      // Client side
+    InputBatchDecoder m_InputDecoder;      // Server side
+
+    // Downstream: Server -> Client (producer: SendSnapshot, consumer: AcquireSnapshot)
+    SnapshotPool m_SnapshotPool;
+
+    // Delta compression (producer side only; acks cross over atomically)
+    bool m_SnapshotDeltaEnabled = false;
+    SnapshotDeltaEncoder m_DeltaEncoder;   // Server side
+    SnapshotDeltaDecoder m_DeltaDecoder;   // Client side
+    SnapshotReassembler m_Reassembler;     // Client side (payloads above one datagram)
+    std::atomic<uint32_t> m_ConsumedTick{ 0 };
+    std::atomic<bool> m_HasConsumed{ false };
 
-    // Downstream: Server -> Client
-    std::queue<Snapshot> m_DownstreamQueue;
-    mutable std::mutex m_DownstreamMutex;
+    // Gameplay events (producer: SendEvents, consumer: ReceiveEvent). Events
+    // are reliable: when full, the newest are dropped and counted rather
+    // than silently evicting ones the game has not seen yet.
+    SpscRing<NetEvent, EVENT_CAPACITY, RingOverflow::DROP_NEWEST> m_EventQueue;
+    std::atomic<uint32_t> m_TickRate{ NetTickRate::DEFAULT };
 
     // Statistics
-    uint32_t m_TotalInputsSent = 0;
-    uint32_t m_TotalSnapshotsSent = 0;
+    std::atomic<uint32_t> m_TotalInputsSent{ 0 };
+    std::atomic<uint32_t> m_TotalSnapshotsSent{ 0 };
+    std::atomic<uint32_t> m_LastSnapshotBytes{ 0 };
 };
@@ -1,22 +1,41 @@
 //=============================================================================
 // mock_server.cpp
 //
-// Mock Server implementation with fixed 32Hz tick rate.
+// Mock Server implementation with a fixed, configurable tick rate.
 // Uses accumulator pattern for frame-rate independent simulation.
 //=============================================================================
 
 #include "mock_server.h"
 #include "i_network.h"
 #include <cmath>
+#include <cstring>
+
+namespace {
+
+//-----------------------------------------------------------------------------
+// Spawn point for a playerId: player 0 and 1 keep the single-player corners,
+// the rest cycle through all four corners, stepping toward the centre
+//-----------------------------------------------------------------------------
+DirectX::XMFLOAT3 SpawnPosition(uint8_t playerId)
+{
+    static const float CORNERS[4][2] = { { -7.0f, -7.0f }, { 7.0f, 7.0f }, { 7.0f, -7.0f }, { -7.0f, 7.0f } };
+    const float* corner = CORNERS[playerId % 4];
+    const float scale = 1.0f - 0.15f * static_cast<float>((playerId / 4) % 6);
+    return { corner[0] * scale, 0.0f, corner[1] * scale };
+}
+
+} // namespace
 
 MockServer::MockServer()
-    : m_pNetwork(nullptr)
+    : m_TickRate(0)
+    , m_TickDuration(0.0)
     , m_Accumulator(0.0)
     , m_ServerTime(0.0)
     , m_CurrentTick(0)
-    , m_PlayerState{}
-    , m_LastInputCmd{}
+    , m_Players{}
+    , m_PlayerIds{}
 {
+    SetTickRate(NetTickRate::DEFAULT);
 }
 
 MockServer::~MockServer()
@@ -26,46 +45,134 @@ MockServer::~MockServer()
 
 void MockServer::Initialize(INetwork* pNetwork, CollisionWorld* pCollisionWorld)
 {
-    m_pNetwork = pNetwork;
     m_pCollisionWorld = pCollisionWorld;
+    m_Interest.SetCollisionWorld(pCollisionWorld);
+    m_InterestStats = {};
     m_Accumulator = 0.0;
     m_ServerTime = 0.0;
     m_CurrentTick = 0;
+    m_LagComp.Reset();
+
+    for (ServerPlayer& player : m_Players) player = {};
+    m_PlayerCount = 0;
+    m_ClientCount = 0;
+
+    // Single-player mock mode: the client at one corner, a bot at the other
+    if (pNetwork)
+    {
+        AddClient(pNetwork);
+        AddBot();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// SetTickRate - Step size of the simulation
+//
+// Movement, timers and fire rates are per second, so only the step changes.
+// Peripheral players keep their snapshot rate: the interval is in ticks.
+//-----------------------------------------------------------------------------
+void MockServer::SetTickRate(uint32_t hz)
+{
+    m_TickRate = NetTickRate::Sanitize(hz);
+    m_TickDuration = 1.0 / m_TickRate;
+
+    InterestSettings settings = m_Interest.GetSettings();
+    settings.lowRateInterval = m_TickRate / PERIPHERAL_SEND_RATE;
+    m_Interest.SetSettings(settings);
 
-    // Initialize player state (match Player_Fps spawn in Game_Initialize)
-    m_PlayerState.tickId = 0;
-    m_PlayerState.position = { -7.0f, 0.0f, -7.0f };  // Corner spawn
-    m_PlayerState.velocity = { 0.0f, 0.0f, 0.0f };
-    m_PlayerState.yaw = 0.0f;
-    m_PlayerState.pitch = 0.0f;
-    m_PlayerState.stateFlags = NetStateFlags::IS_GROUNDED;
-    m_PlayerState.health = 200;
-    m_PlayerState.hitByPlayerId = 0xFF;
-    m_PlayerState.fireCounter = 0;
-
-    // Initialize last input
-    m_LastInputCmd = {};
-
-    // Spawn remote bot player at a different corner
-    m_RemotePlayerState = {};
-    m_RemotePlayerState.tickId = 0;
-    m_RemotePlayerState.position = { 7.0f, 0.0f, 7.0f };
-    m_RemotePlayerState.velocity = { 0.0f, 0.0f, 0.0f };
-    m_RemotePlayerState.yaw = 0.0f;
-    m_RemotePlayerState.pitch = 0.0f;
-    m_RemotePlayerState.stateFlags = NetStateFlags::IS_GROUNDED;
-    m_RemotePlayerState.health = MAX_HEALTH;
-    m_RemotePlayerState.hitByPlayerId = 0xFF;
-    m_RemotePlayerState.fireCounter = 0;
-    m_RemoteHealth = MAX_HEALTH;
-    m_RemoteRespawnTimer = 0.0;
-    m_FireTimer = 0.0;
-    m_FireCounter = 0;
+    for (uint32_t i = 0; i < m_PlayerCount; i++)
+    {
+        const ServerPlayer& player = m_Players[m_PlayerIds[i]];
+        if (player.pNetwork) player.pNetwork->SendTickRate(m_TickRate);
+    }
 }
 
 void MockServer::Finalize()
 {
-    m_pNetwork = nullptr;
+    for (ServerPlayer& player : m_Players) player = {};
+    m_PlayerCount = 0;
+    m_ClientCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Player table
+//-----------------------------------------------------------------------------
+int MockServer::AddClient(INetwork* pNetwork)
+{
+    if (!pNetwork) return -1;
+    const int playerId = AddPlayer(pNetwork);
+    if (playerId >= 0) pNetwork->SendTickRate(m_TickRate);
+    return playerId;
+}
+
+int MockServer::AddBot()
+{
+    return AddPlayer(nullptr);
+}
+
+int MockServer::AddPlayer(INetwork* pNetwork)
+{
+    int playerId = -1;
+    for (int id = 0; id < MAX_PLAYERS; id++)
+    {
+        if (!m_Players[id].active)
+        {
+            playerId = id;
+            break;
+        }
+    }
+    if (playerId < 0) return -1;
+
+    const uint8_t id = static_cast<uint8_t>(playerId);
+    ServerPlayer& player = m_Players[id];
+    player = {};
+    player.active = true;
+    player.pNetwork = pNetwork;
+    player.teamId = (id % 2 == 0) ? PlayerTeam::RED : PlayerTeam::BLUE;
+    Respawn(player, id);
+    player.state.tickId = m_CurrentTick;
+
+    // Keep the id list ascending (remote entries are sent in playerId order)
+    uint32_t pos = m_PlayerCount;
+    while (pos > 0 && m_PlayerIds[pos - 1] > id)
+    {
+        m_PlayerIds[pos] = m_PlayerIds[pos - 1];
+        pos--;
+    }
+    m_PlayerIds[pos] = id;
+    m_PlayerCount++;
+    if (pNetwork) m_ClientCount++;
+    return playerId;
+}
+
+void MockServer::RemovePlayer(uint8_t playerId)
+{
+    if (playerId >= MAX_PLAYERS || !m_Players[playerId].active) return;
+
+    if (m_Players[playerId].pNetwork) m_ClientCount--;
+    m_Players[playerId] = {};
+
+    uint32_t out = 0;
+    for (uint32_t i = 0; i < m_PlayerCount; i++)
+    {
+        if (m_PlayerIds[i] != playerId) m_PlayerIds[out++] = m_PlayerIds[i];
+    }
+    m_PlayerCount = out;
+}
+
+const NetPlayerState* MockServer::GetPlayerState(uint8_t playerId) const
+{
+    if (playerId >= MAX_PLAYERS || !m_Players[playerId].active) return nullptr;
+    return &m_Players[playerId].state;
+}
+
+void MockServer::Respawn(ServerPlayer& player, uint8_t playerId)
+{
+    player.state.position = SpawnPosition(playerId);
+    player.state.velocity = { 0.0f, 0.0f, 0.0f };
+    player.state.stateFlags = NetStateFlags::IS_GROUNDED;
+    player.state.health = MAX_HEALTH;
+    player.respawnTimer = 0.0;
 }
 
 //-----------------------------------------------------------------------------
@@ -73,85 +180,118 @@ void MockServer::Finalize()
 // 
 // Accumulator Pattern:
 //   1. Add frame delta time to accumulator
-//   2. While accumulator >= TICK_DURATION, run one Tick()
-//   3. This ensures exactly TICK_RATE ticks per second regardless of FPS
+//   2. While accumulator >= m_TickDuration, run one Tick()
+//   3. This ensures exactly m_TickRate ticks per second regardless of FPS
 //-----------------------------------------------------------------------------
 void MockServer::Update(double deltaTime)
 {
-    if (!m_pNetwork) return;
+    if (m_ClientCount == 0) return;
 
     // Clamp deltaTime to prevent spiral of death on frame spikes
-    const double maxDelta = TICK_DURATION * 4.0;  // Max 4 ticks per frame
+    const double maxDelta = m_TickDuration * 4.0;  // Max 4 ticks per frame
     deltaTime = (deltaTime > maxDelta) ? maxDelta : deltaTime;
 
     m_Accumulator += deltaTime;
 
     // ========================================================================
     // ACCUMULATOR LOOP - Core of fixed tick timing
-    // This loop runs Tick() at exactly 32Hz regardless of render frame rate
+    // This loop runs Tick() at exactly m_TickRate regardless of render frame rate
     // ========================================================================
-    while (m_Accumulator >= TICK_DURATION)
+    while (m_Accumulator >= m_TickDuration)
     {
         Tick();
-        m_Accumulator -= TICK_DURATION;
+        m_Accumulator -= m_TickDuration;
     }
 }
 
 //-----------------------------------------------------------------------------
-// Tick - Fixed rate game logic (32Hz)
+// Tick - Fixed rate game logic (m_TickRate)
 // 
 // This is where all authoritative game logic runs:
-//   1. Consume input commands from client
+//   1. Consume each client's input commands
 //   2. Simulate physics
 //   3. Update game state
-//   4. Broadcast snapshot to client
+//   4. Send each client its snapshot and events
 //-----------------------------------------------------------------------------
 void MockServer::Tick()
 {
     m_CurrentTick++;
-    m_ServerTime += TICK_DURATION;
+    m_ServerTime += m_TickDuration;
+    m_TickEventCount = 0;
 
-    // 1. Consume all pending input commands
-    InputCmd cmd;
-    while (m_pNetwork->ReceiveInputCmd(cmd))
+    // 1. Buffer all pending input commands, per client
+    for (uint32_t i = 0; i < m_PlayerCount; i++)
     {
-        ProcessInputCmd(cmd);
+        ServerPlayer& player = m_Players[m_PlayerIds[i]];
+        if (!player.pNetwork) continue;
+
+        InputCmd cmd;
+        while (player.pNetwork->ReceiveInputCmd(cmd))
+        {
+            player.inputBuffer.Push(cmd);
+        }
     }
 
-    // 2. Simulate physics for this tick
-    SimulatePhysics();
+    // 2. Play back one input per client and simulate it (bots stand still).
+    //    A client whose buffer overflowed gets an extra input to catch up.
+    for (uint32_t i = 0; i < m_PlayerCount; i++)
+    {
+        ServerPlayer& player = m_Players[m_PlayerIds[i]];
+        if (!player.pNetwork) continue;
 
-    // 3. Clear hit marker, then process combat
-    m_PlayerState.hitByPlayerId = 0xFF;
-    m_RemotePlayerState.hitByPlayerId = 0xFF;
+        const uint32_t depth = player.inputBuffer.GetDepth();
+        player.inputDepth = static_cast<uint8_t>(depth < 0xFF ? depth : 0xFF);
 
-    if (m_RemotePlayerState.stateFlags & NetStateFlags::IS_DEAD)
-    {
-        // Respawn timer
-        m_RemoteRespawnTimer -= TICK_DURATION;
-        if (m_RemoteRespawnTimer <= 0.0)
+        const int steps = player.inputBuffer.IsOverfull() ? 2 : 1;
+        for (int step = 0; step < steps; step++)
         {
-            m_RemoteHealth = MAX_HEALTH;
-            m_RemotePlayerState.stateFlags &= ~NetStateFlags::IS_DEAD;
-            m_RemotePlayerState.stateFlags |= NetStateFlags::IS_GROUNDED;
-            m_RemotePlayerState.position = { 7.0f, 0.0f, 7.0f };
-            m_RemotePlayerState.velocity = { 0.0f, 0.0f, 0.0f };
-            m_RemoteRespawnTimer = 0.0;
+            InputCmd cmd;
+            if (player.inputBuffer.Pop(cmd)) ProcessInputCmd(player, cmd);
+            if (!(player.state.stateFlags & NetStateFlags::IS_DEAD)) SimulatePhysics(player);
         }
     }
-    else
+
+    // 3. Record hit volumes for lag compensation, then process combat
+    m_LagComp.BeginFrame(m_CurrentTick, m_ServerTime);
+    for (uint32_t i = 0; i < m_PlayerCount; i++)
     {
-        ProcessFiring();
+        const uint8_t id = m_PlayerIds[i];
+        if (!(m_Players[id].state.stateFlags & NetStateFlags::IS_DEAD))
+            m_LagComp.Record(id, m_Players[id].state.position);
     }
 
-    m_RemotePlayerState.health = m_RemoteHealth;
+    for (uint32_t i = 0; i < m_PlayerCount; i++)
+    {
+        const uint8_t id = m_PlayerIds[i];
+        ServerPlayer& player = m_Players[id];
+
+        if (player.state.stateFlags & NetStateFlags::IS_DEAD)
+        {
+            // Respawn timer
+            player.respawnTimer -= m_TickDuration;
+            if (player.respawnTimer <= 0.0)
+            {
+                Respawn(player, id);
+                PushEvent(NetEventType::RESPAWN, id);
+            }
+        }
+        else if (player.pNetwork)
+        {
+            ProcessFiring(player);
+        }
+    }
 
     // 4. Update tick ID in states
-    m_PlayerState.tickId = m_CurrentTick;
-    m_PlayerState.fireCounter = m_FireCounter;
+    for (uint32_t i = 0; i < m_PlayerCount; i++)
+    {
+        ServerPlayer& player = m_Players[m_PlayerIds[i]];
+        player.state.tickId = m_CurrentTick;
+        player.state.fireCounter = player.fireCounter;
+    }
 
-    // 5. Broadcast snapshot to client
-    BroadcastSnapshot();
+    // 5. Send each client its snapshot, then its events
+    BroadcastSnapshots();
+    BroadcastEvents();
 }
 
 //-----------------------------------------------------------------------------
@@ -160,16 +300,17 @@ void MockServer::Tick()
 // NOTE: Client only sends INPUT INTENT, never position/velocity.
 // Server applies movement based on input.
 //-----------------------------------------------------------------------------
-void MockServer::ProcessInputCmd(const InputCmd& cmd)
+void MockServer::ProcessInputCmd(ServerPlayer& player, const InputCmd& cmd)
 {
-    m_LastInputCmd = cmd;
+    player.lastInputCmd = cmd;
+    player.lastInputTick = cmd.tickId;
 
     // Store camera angles
-    m_PlayerState.yaw = cmd.yaw;
-    m_PlayerState.pitch = cmd.pitch;
+    player.state.yaw = cmd.yaw;
+    player.state.pitch = cmd.pitch;
 
     // Update state flags based on buttons
-    uint32_t flags = m_PlayerState.stateFlags;
+    uint32_t flags = player.state.stateFlags;
 
     if (cmd.buttons & InputButtons::FIRE)
         flags |= NetStateFlags::IS_FIRING;
@@ -184,19 +325,20 @@ void MockServer::ProcessInputCmd(const InputCmd& cmd)
     if (cmd.buttons & InputButtons::RELOAD)
     {
         // Start reload latch — keep IS_RELOADING active for duration
-        if (m_ReloadTimer <= 0.0)
-            m_ReloadTimer = RELOAD_DURATION;
+        if (player.reloadTimer <= 0.0)
+            player.reloadTimer = RELOAD_DURATION;
     }
     
     // Reload latch timer
-    if (m_ReloadTimer > 0.0)
+    if (player.reloadTimer > 0.0)
     {
         flags |= NetStateFlags::IS_RELOADING;
-        m_ReloadTimer -= TICK_DURATION;
-        if (m_ReloadTimer <= 0.0)
+        player.reloadTimer -= m_TickDuration;
+        if (player.reloadTimer <= 0.0)
         {
-            m_ReloadTimer = 0.0;
+            player.reloadTimer = 0.0;
             flags &= ~NetStateFlags::IS_RELOADING;
+            PushEvent(NetEventType::RELOAD_COMPLETE, GetPlayerId(player));
         }
     }
     else
@@ -204,7 +346,7 @@ void MockServer::ProcessInputCmd(const InputCmd& cmd)
         flags &= ~NetStateFlags::IS_RELOADING;
     }
 
-    m_PlayerState.stateFlags = flags;
+    player.state.stateFlags = flags;
 }
 
 //-----------------------------------------------------------------------------
@@ -215,9 +357,11 @@ void MockServer::ProcessInputCmd(const InputCmd& cmd)
 //   - Air: Momentum preservation, limited air control
 //   - Target velocity approach instead of force accumulation
 //-----------------------------------------------------------------------------
-void MockServer::SimulatePhysics()
+void MockServer::SimulatePhysics(ServerPlayer& player)
 {
-    const float dt = static_cast<float>(TICK_DURATION);
+    NetPlayerState& state = player.state;
+    const InputCmd& input = player.lastInputCmd;
+    const float dt = static_cast<float>(m_TickDuration);
     
     // ========================================================================
     // MOVEMENT PARAMETERS (CS:GO / Valorant style)
@@ -229,13 +373,13 @@ void MockServer::SimulatePhysics()
     constexpr float GRAVITY        = 20.0f;   // Heavy, quick jumps
     constexpr float JUMP_VELOCITY  = 8.0f;    // Jump impulse
     
-    bool isGrounded = (m_PlayerState.stateFlags & NetStateFlags::IS_GROUNDED) != 0;
+    bool isGrounded = (state.stateFlags & NetStateFlags::IS_GROUNDED) != 0;
     bool wasGroundedAtStart = isGrounded;
     
     // ========================================================================
     // STEP 1: Calculate Target Velocity from Input
     // ========================================================================
-    float yaw = m_LastInputCmd.yaw;
+    float yaw = input.yaw;
     
     // Forward/Right vectors from yaw (flattened)
     float frontX = sinf(yaw);
@@ -244,8 +388,8 @@ void MockServer::SimulatePhysics()
     float rightZ = -frontX;
     
     // Calculate move direction from input
-    float moveX = m_LastInputCmd.moveAxisX * rightX + m_LastInputCmd.moveAxisY * frontX;
-    float moveZ = m_LastInputCmd.moveAxisX * rightZ + m_LastInputCmd.moveAxisY * frontZ;
+    float moveX = input.moveAxisX * rightX + input.moveAxisY * frontX;
+    float moveZ = input.moveAxisX * rightZ + input.moveAxisY * frontZ;
     
     // Normalize diagonal movement
     float moveMag = sqrtf(moveX * moveX + moveZ * moveZ);
@@ -257,7 +401,7 @@ void MockServer::SimulatePhysics()
     }
     
     // Target speed based on sprint
-    float maxSpeed = (m_LastInputCmd.buttons & InputButtons::SPRINT) ? MAX_RUN_SPEED : MAX_WALK_SPEED;
+    float maxSpeed = (input.buttons & InputButtons::SPRINT) ? MAX_RUN_SPEED : MAX_WALK_SPEED;
     
     // Target velocity = normalized direction * max speed
     float targetVelX = moveX * maxSpeed;
@@ -275,27 +419,27 @@ void MockServer::SimulatePhysics()
         float accelStep = GROUND_ACCEL * dt;
         
         // X axis
-        float diffX = targetVelX - m_PlayerState.velocity.x;
+        float diffX = targetVelX - state.velocity.x;
         if (fabsf(diffX) <= accelStep)
-            m_PlayerState.velocity.x = targetVelX;
+            state.velocity.x = targetVelX;
         else
-            m_PlayerState.velocity.x += (diffX > 0 ? accelStep : -accelStep);
+            state.velocity.x += (diffX > 0 ? accelStep : -accelStep);
         
         // Z axis
-        float diffZ = targetVelZ - m_PlayerState.velocity.z;
+        float diffZ = targetVelZ - state.velocity.z;
         if (fabsf(diffZ) <= accelStep)
-            m_PlayerState.velocity.z = targetVelZ;
+            state.velocity.z = targetVelZ;
         else
-            m_PlayerState.velocity.z += (diffZ > 0 ? accelStep : -accelStep);
+            state.velocity.z += (diffZ > 0 ? accelStep : -accelStep);
         
         // ---------------------------------------------------------------------
         // JUMP - Only on ground
         // ---------------------------------------------------------------------
-        if (m_LastInputCmd.buttons & InputButtons::JUMP)
+        if (input.buttons & InputButtons::JUMP)
         {
-            m_PlayerState.velocity.y = JUMP_VELOCITY;
-            m_PlayerState.stateFlags &= ~NetStateFlags::IS_GROUNDED;
-            m_PlayerState.stateFlags |= NetStateFlags::IS_JUMPING;
+            state.velocity.y = JUMP_VELOCITY;
+            state.stateFlags &= ~NetStateFlags::IS_GROUNDED;
+            state.stateFlags |= NetStateFlags::IS_JUMPING;
             isGrounded = false;
         }
     }
@@ -311,17 +455,17 @@ void MockServer::SimulatePhysics()
         if (moveMag > 0.01f)
         {
             // Air strafe: add small acceleration in input direction
-            m_PlayerState.velocity.x += moveX * airStep;
-            m_PlayerState.velocity.z += moveZ * airStep;
+            state.velocity.x += moveX * airStep;
+            state.velocity.z += moveZ * airStep;
             
             // Cap horizontal speed to prevent infinite acceleration
-            float horizSpeed = sqrtf(m_PlayerState.velocity.x * m_PlayerState.velocity.x + 
-                                     m_PlayerState.velocity.z * m_PlayerState.velocity.z);
+            float horizSpeed = sqrtf(state.velocity.x * state.velocity.x + 
+                                     state.velocity.z * state.velocity.z);
             if (horizSpeed > maxSpeed * 1.2f)  // Allow slight overspeed from bunny hop
             {
                 float scale = (maxSpeed * 1.2f) / horizSpeed;
-                m_PlayerState.velocity.x *= scale;
-                m_PlayerState.velocity.z *= scale;
+                state.velocity.x *= scale;
+                state.velocity.z *= scale;
             }
         }
         // NO friction in air - momentum preserved
@@ -332,15 +476,15 @@ void MockServer::SimulatePhysics()
     // ========================================================================
     if (!wasGroundedAtStart)
     {
-        m_PlayerState.velocity.y -= GRAVITY * dt;
+        state.velocity.y -= GRAVITY * dt;
     }
     
     // ========================================================================
     // STEP 4: Apply velocity to position
     // ========================================================================
-    m_PlayerState.position.x += m_PlayerState.velocity.x * dt;
-    m_PlayerState.position.z += m_PlayerState.velocity.z * dt;
-    m_PlayerState.position.y += m_PlayerState.velocity.y * dt;
+    state.position.x += state.velocity.x * dt;
+    state.position.z += state.velocity.z * dt;
+    state.position.y += state.velocity.y * dt;
     
     // ========================================================================
     // STEP 5: Collision Detection (Capsule vs World AABBs)
@@ -348,29 +492,29 @@ void MockServer::SimulatePhysics()
     if (m_pCollisionWorld)
     {
         auto result = m_pCollisionWorld->ResolveCapsule(
-            m_PlayerState.position, PLAYER_HEIGHT, CAPSULE_RADIUS,
-            m_PlayerState.velocity);
-        m_PlayerState.position = result.position;
-        m_PlayerState.velocity = result.velocity;
+            state.position, PLAYER_HEIGHT, CAPSULE_RADIUS,
+            state.velocity);
+        state.position = result.position;
+        state.velocity = result.velocity;
         if (result.isGrounded)
         {
-            m_PlayerState.stateFlags |= NetStateFlags::IS_GROUNDED;
-            m_PlayerState.stateFlags &= ~NetStateFlags::IS_JUMPING;
+            state.stateFlags |= NetStateFlags::IS_GROUNDED;
+            state.stateFlags &= ~NetStateFlags::IS_JUMPING;
         }
         else
         {
-            m_PlayerState.stateFlags &= ~NetStateFlags::IS_GROUNDED;
+            state.stateFlags &= ~NetStateFlags::IS_GROUNDED;
         }
     }
     else
     {
         // Fallback: simple floor at y=0
-        if (m_PlayerState.position.y <= 0.0f)
+        if (state.position.y <= 0.0f)
         {
-            m_PlayerState.position.y = 0.0f;
-            m_PlayerState.velocity.y = 0.0f;
-            m_PlayerState.stateFlags |= NetStateFlags::IS_GROUNDED;
-            m_PlayerState.stateFlags &= ~NetStateFlags::IS_JUMPING;
+            state.position.y = 0.0f;
+            state.velocity.y = 0.0f;
+            state.stateFlags |= NetStateFlags::IS_GROUNDED;
+            state.stateFlags &= ~NetStateFlags::IS_JUMPING;
         }
     }
 }
@@ -509,116 +653,214 @@ static bool RayAABB(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& di
 }
 
 //-----------------------------------------------------------------------------
-// ProcessFiring - Fire-rate gating + hitscan against remote bot
+// ProcessFiring - Fire-rate gating + hitscan against the other team
 //-----------------------------------------------------------------------------
-void MockServer::ProcessFiring()
+void MockServer::ProcessFiring(ServerPlayer& player)
 {
-    bool isFiring = (m_LastInputCmd.buttons & InputButtons::FIRE) != 0;
+    bool isFiring = (player.lastInputCmd.buttons & InputButtons::FIRE) != 0;
 
     if (!isFiring)
     {
-        m_FireTimer = 0.0;
+        player.fireTimer = 0.0;
         return;
     }
 
     double fireInterval = 60.0 / RED_RPM;
 
     bool shouldFire = false;
-    if (m_FireTimer <= 0.0)
+    if (player.fireTimer <= 0.0)
     {
         shouldFire = true;
-        m_FireTimer = fireInterval;
+        player.fireTimer = fireInterval;
     }
     else
     {
-        m_FireTimer -= TICK_DURATION;
-        if (m_FireTimer <= 0.0)
+        player.fireTimer -= m_TickDuration;
+        if (player.fireTimer <= 0.0)
         {
             shouldFire = true;
-            m_FireTimer += fireInterval;
+            player.fireTimer += fireInterval;
         }
     }
 
     if (!shouldFire) return;
 
-    m_FireCounter++;
+    player.fireCounter++;
 
     // Eye position
     DirectX::XMFLOAT3 eyePos = {
-        m_PlayerState.position.x,
-        m_PlayerState.position.y + 1.5f,
-        m_PlayerState.position.z
+        player.state.position.x,
+        player.state.position.y + 1.5f,
+        player.state.position.z
     };
 
     // Ray direction from yaw/pitch
-    float cosPitch = cosf(m_PlayerState.pitch);
+    float cosPitch = cosf(player.state.pitch);
     DirectX::XMFLOAT3 rayDir = {
-        sinf(m_PlayerState.yaw) * cosPitch,
-        sinf(m_PlayerState.pitch),
-        cosf(m_PlayerState.yaw) * cosPitch
+        sinf(player.state.yaw) * cosPitch,
+        sinf(player.state.pitch),
+        cosf(player.state.yaw) * cosPitch
     };
 
-    // Test against remote bot capsule
+    // Rewind every target to what the shooter saw (its own interpolated
+    // view of them), bounded by m_MaxRewind; without a view time, or with
+    // lag compensation off, this is the current tick
+    const double viewTime = player.lastInputCmd.viewTimeMs / 1000.0;
+    const bool rewind = m_MaxRewind > 0.0 && player.lastInputCmd.viewTimeMs != 0;
+    m_LagComp.Rewind(rewind ? viewTime : m_ServerTime, rewind ? m_MaxRewind : 0.0, m_Rewound);
+
+    // Nearest enemy capsule along the ray, alive now and at the view time
     float hitDist = 0.0f;
-    if (RayCapsule(eyePos, rayDir, m_RemotePlayerState.position,
-                   PLAYER_HEIGHT, CAPSULE_RADIUS, hitDist))
+    int hitId = -1;
+    for (uint32_t i = 0; i < m_PlayerCount; i++)
     {
-        // Check if a wall is closer than the player hit
-        float wallDist = 99999.0f;
-        if (m_pCollisionWorld)
+        const uint8_t id = m_PlayerIds[i];
+        const ServerPlayer& target = m_Players[id];
+        if (target.teamId == player.teamId) continue;
+        if (target.state.stateFlags & NetStateFlags::IS_DEAD) continue;
+        if (!m_Rewound.IsAlive(id)) continue;
+
+        const DirectX::XMFLOAT3 capBottom = { m_Rewound.x[id], m_Rewound.y[id], m_Rewound.z[id] };
+        float t = 0.0f;
+        if (RayCapsule(eyePos, rayDir, capBottom, PLAYER_HEIGHT, CAPSULE_RADIUS, t) &&
+            (hitId < 0 || t < hitDist))
         {
-            for (const auto& col : m_pCollisionWorld->GetColliders())
-            {
-                float t = 0.0f;
-                if (RayAABB(eyePos, rayDir, col.aabb.min, col.aabb.max, t))
-                {
-                    if (t < wallDist) wallDist = t;
-                }
-            }
+            hitDist = t;
+            hitId = id;
         }
+    }
+    if (hitId < 0) return;
 
-        // Only damage if player is closer than the nearest wall
-        if (hitDist < wallDist)
+    // Check if a wall is closer than the player hit
+    float wallDist = 99999.0f;
+    if (m_pCollisionWorld)
+    {
+        for (const auto& col : m_pCollisionWorld->GetColliders())
         {
-            if (m_RemoteHealth > RED_DAMAGE)
+            float t = 0.0f;
+            if (RayAABB(eyePos, rayDir, col.aabb.min, col.aabb.max, t))
             {
-                m_RemoteHealth -= RED_DAMAGE;
-            }
-            else
-            {
-                m_RemoteHealth = 0;
-                m_RemotePlayerState.stateFlags |= NetStateFlags::IS_DEAD;
-                m_RemoteRespawnTimer = RESPAWN_TIME;
-                m_RemotePlayerState.velocity = { 0.0f, 0.0f, 0.0f };
+                if (t < wallDist) wallDist = t;
             }
+        }
+    }
 
-            // Hit marker for local player
-            m_PlayerState.hitByPlayerId = 1;
+    // Only damage if player is closer than the nearest wall
+    if (hitDist >= wallDist) return;
+
+    ServerPlayer& target = m_Players[hitId];
+    const uint8_t shooterId = GetPlayerId(player);
+    const uint8_t targetId = static_cast<uint8_t>(hitId);
+    if (target.state.health > RED_DAMAGE)
+    {
+        target.state.health -= RED_DAMAGE;
+        PushEvent(NetEventType::HIT, shooterId, targetId, RED_DAMAGE);
+    }
+    else
+    {
+        PushEvent(NetEventType::HIT, shooterId, targetId, target.state.health);
+        PushEvent(NetEventType::KILL, shooterId, targetId);
+        target.state.health = 0;
+        target.state.stateFlags |= NetStateFlags::IS_DEAD;
+        target.respawnTimer = RESPAWN_TIME;
+        target.state.velocity = { 0.0f, 0.0f, 0.0f };
+    }
+}
+
+//-----------------------------------------------------------------------------
+// BroadcastSnapshots - Send authoritative state to every client
+//
+// Each client gets its own state as the local player and every other player
+// as a remote entry (ascending playerId), filtered for what it can see.
+//-----------------------------------------------------------------------------
+void MockServer::BroadcastSnapshots()
+{
+    bool firstClient = true;
+
+    for (uint32_t i = 0; i < m_PlayerCount; i++)
+    {
+        const uint8_t clientId = m_PlayerIds[i];
+        const ServerPlayer& client = m_Players[clientId];
+        if (!client.pNetwork) continue;
+
+        // Variable length: clear only the header and the entries that are sent
+        const uint8_t remoteCount = static_cast<uint8_t>(m_PlayerCount - 1);
+        Snapshot snapshot;
+        std::memset(&snapshot, 0, GetSnapshotSize(remoteCount));
+        snapshot.tickId = m_CurrentTick;
+        snapshot.ackInputTick = client.lastInputTick;
+        snapshot.inputBufferDepth = client.inputDepth;
+        snapshot.serverTime = m_ServerTime;
+        snapshot.localPlayer = client.state;
+        snapshot.localPlayerId = clientId;
+        snapshot.localPlayerTeam = client.teamId;
+
+        uint8_t count = 0;
+        for (uint32_t j = 0; j < m_PlayerCount; j++)
+        {
+            const uint8_t id = m_PlayerIds[j];
+            if (id == clientId) continue;
+
+            RemotePlayerEntry& entry = snapshot.remotePlayers[count++];
+            entry.playerId = id;
+            entry.teamId = m_Players[id].teamId;
+            entry.state = m_Players[id].state;
         }
+        snapshot.remotePlayerCount = count;
+
+        // Drop what this client cannot see (or send it at a lower rate)
+        m_Interest.Filter(snapshot);
+        if (firstClient) m_InterestStats = m_Interest.GetLastStats();
+        firstClient = false;
+
+        client.pNetwork->SendSnapshot(snapshot);
     }
 }
 
 //-----------------------------------------------------------------------------
-// BroadcastSnapshot - Send authoritative state to client
+// PushEvent - Queue a gameplay event for this tick's batches
 //-----------------------------------------------------------------------------
-void MockServer::BroadcastSnapshot()
+void MockServer::PushEvent(NetEventType type, uint8_t playerId, uint8_t targetId, uint8_t damage)
 {
-    if (!m_pNetwork) return;
-
-    Snapshot snapshot = {};
-    snapshot.tickId = m_CurrentTick;
-    snapshot.serverTime = m_ServerTime;
-    snapshot.localPlayer = m_PlayerState;
-    snapshot.localPlayerId = 0;
-    snapshot.localPlayerTeam = PlayerTeam::RED;
-
-    // Include remote bot player
-    m_RemotePlayerState.tickId = m_CurrentTick;
-    snapshot.remotePlayers[0].playerId = 1;
-    snapshot.remotePlayers[0].teamId = PlayerTeam::BLUE;
-    snapshot.remotePlayers[0].state = m_RemotePlayerState;
-    snapshot.remotePlayerCount = 1;
-
-    m_pNetwork->SendSnapshot(snapshot);
+    if (m_TickEventCount >= NET_EVENT_BATCH_MAX_EVENTS) return;
+
+    NetEvent& event = m_TickEvents[m_TickEventCount++];
+    event.tickId = m_CurrentTick;
+    event.type = type;
+    event.playerId = playerId;
+    event.targetId = targetId;
+    event.damage = damage;
 }
 
+//-----------------------------------------------------------------------------
+// BroadcastEvents - Send each client this tick's events that concern it
+//
+// Hits go to the shooter (hit marker) and the target, reloads to their
+// owner; kills and respawns go to everyone (kill feed, scoreboard).
+//-----------------------------------------------------------------------------
+void MockServer::BroadcastEvents()
+{
+    if (m_TickEventCount == 0) return;
+
+    for (uint32_t i = 0; i < m_PlayerCount; i++)
+    {
+        const uint8_t clientId = m_PlayerIds[i];
+        const ServerPlayer& client = m_Players[clientId];
+        if (!client.pNetwork) continue;
+
+        uint32_t count = 0;
+        for (uint32_t e = 0; e < m_TickEventCount; e++)
+        {
+            const NetEvent& event = m_TickEvents[e];
+            bool relevant = true;
+            if (event.type == NetEventType::HIT)
+                relevant = event.playerId == clientId || event.targetId == clientId;
+            else if (event.type == NetEventType::RELOAD_COMPLETE)
+                relevant = event.playerId == clientId;
+
+            if (relevant) m_ClientEvents[count++] = event;
+        }
+
+        if (count > 0) client.pNetwork->SendEvents(m_CurrentTick, m_ClientEvents, count);
+    }
+}
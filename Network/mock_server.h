@@ -2,36 +2,72 @@
 //=============================================================================
 // mock_server.h
 //
-// Mock Server with fixed-tick (32Hz) game logic.
+// Mock Server with fixed-tick game logic.
 // Uses accumulator pattern to decouple from render frame rate.
 //
 // Architecture:
-//   - Server runs at fixed 32Hz tick rate
-//   - Consumes InputCmd from client
-//   - Produces authoritative PlayerState
-//   - Broadcasts Snapshot to client
+//   - Server runs at a fixed tick rate (32, 64 or 128Hz, see net_tick.h),
+//     announced to each client as it joins
+//   - Player table indexed by playerId: clients (each on its own INetwork,
+//     which is its input queue and snapshot channel) and standalone bots
+//   - Buffers each client's InputCmds by tick and plays back exactly one
+//     per server tick into that client's player (ServerInputBuffer)
+//   - Produces authoritative PlayerState for every player
+//   - Records every player's hit volume per tick and rewinds targets to the
+//     shooter's view time for hitscan (LagCompHistory)
+//   - Builds and sends one Snapshot per client (its own state as the local
+//     player, everyone else as remote entries, then interest filtering)
+//   - Sends each client the tick's gameplay events that concern it (hits,
+//     kills, respawns, reloads) as one reliable batch
+//
+// Mock mode runs one client (player 0) against one bot (player 1); tests
+// and benchmarks can add many MockNetwork clients to one server.
 //=============================================================================
 
 #include "net_common.h"
+#include "net_event.h"
+#include "net_tick.h"
 #include "collision_world.h"
+#include "interest_manager.h"
+#include "server_input_buffer.h"
+#include "lag_compensation.h"
 
 class INetwork;
 
 class MockServer
 {
 public:
-    //-------------------------------------------------------------------------
-    // Constants
-    //-------------------------------------------------------------------------
-    static constexpr double TICK_RATE = 32.0;                    // 32 ticks per second
-    static constexpr double TICK_DURATION = 1.0 / TICK_RATE;     // ~31.25ms per tick
-
     MockServer();
     ~MockServer();
 
+    // Clears the player table. With pNetwork, that client joins as player 0
+    // and a bot is spawned as player 1 (single-player mock mode); without
+    // it, add players through AddClient / AddBot.
     void Initialize(INetwork* pNetwork, CollisionWorld* pCollisionWorld = nullptr);
     void Finalize();
 
+    //-------------------------------------------------------------------------
+    // Player table (lowest free playerId; -1 when all MAX_PLAYERS are taken)
+    //-------------------------------------------------------------------------
+    int AddClient(INetwork* pNetwork);
+    int AddBot();                           // Stands still, never fires
+    void RemovePlayer(uint8_t playerId);
+    uint32_t GetPlayerCount() const { return m_PlayerCount; }
+
+    // Simulation rate (unsupported rates fall back to NetTickRate::DEFAULT).
+    // Connected clients are told at once; set it before the first Update.
+    void SetTickRate(uint32_t hz);
+    uint32_t GetTickRate() const { return m_TickRate; }
+    double GetTickDuration() const { return m_TickDuration; }
+
+    // Per-client relevancy filtering of snapshot entries (on by default)
+    void SetInterestManagementEnabled(bool enabled) { m_Interest.SetEnabled(enabled); }
+
+    // Furthest a shot rewinds its targets into the past (0 = no lag
+    // compensation; at most LagCompHistory::CAPACITY ticks)
+    void SetMaxRewind(double seconds) { m_MaxRewind = seconds; }
+    double GetMaxRewind() const { return m_MaxRewind; }
+
     //-------------------------------------------------------------------------
     // Called every render frame - uses accumulator for fixed tick
     //-------------------------------------------------------------------------
@@ -43,67 +79,109 @@ public:
     uint32_t GetCurrentTick() const { return m_CurrentTick; }
     double GetAccumulator() const { return m_Accumulator; }
     double GetServerTime() const { return m_ServerTime; }
-    const NetPlayerState& GetPlayerState() const { return m_PlayerState; }
+    const NetPlayerState* GetPlayerState(uint8_t playerId) const;
+
+    // Interest pass of the first client's latest snapshot
+    const InterestStats& GetInterestStats() const { return m_InterestStats; }
 
 private:
     //-------------------------------------------------------------------------
-    // Fixed tick logic (called at exactly 32Hz)
+    // One slot of the player table
+    //-------------------------------------------------------------------------
+    struct ServerPlayer
+    {
+        bool active;
+        INetwork* pNetwork;         // nullptr = bot
+        uint8_t teamId;
+        NetPlayerState state;
+        ServerInputBuffer inputBuffer;
+        uint8_t inputDepth;         // Buffered inputs at this tick's playback
+        InputCmd lastInputCmd;      // Input simulated this tick
+        uint32_t lastInputTick;     // Its tickId, echoed as the snapshot ack
+        double reloadTimer;         // Keeps IS_RELOADING for the full animation
+        double fireTimer;
+        double respawnTimer;
+        uint16_t fireCounter;
+    };
+
+    //-------------------------------------------------------------------------
+    // Fixed tick logic (called at exactly the tick rate)
     //-------------------------------------------------------------------------
     void Tick();
 
     //-------------------------------------------------------------------------
     // Process single input command
     //-------------------------------------------------------------------------
-    void ProcessInputCmd(const InputCmd& cmd);
+    void ProcessInputCmd(ServerPlayer& player, const InputCmd& cmd);
 
     //-------------------------------------------------------------------------
     // Apply physics simulation for one tick
     //-------------------------------------------------------------------------
-    void SimulatePhysics();
+    void SimulatePhysics(ServerPlayer& player);
+
+    //-------------------------------------------------------------------------
+    // Build and send each client's snapshot
+    //-------------------------------------------------------------------------
+    void BroadcastSnapshots();
 
     //-------------------------------------------------------------------------
-    // Send snapshot to client
+    // Gameplay events: queued during the tick, sent after the snapshots
     //-------------------------------------------------------------------------
-    void BroadcastSnapshot();
+    void PushEvent(NetEventType type, uint8_t playerId, uint8_t targetId = 0, uint8_t damage = 0);
+    void BroadcastEvents();
 
     //-------------------------------------------------------------------------
     // Combat: fire-rate gating + hitscan raycast
     //-------------------------------------------------------------------------
-    void ProcessFiring();
+    void ProcessFiring(ServerPlayer& player);
+    void Respawn(ServerPlayer& player, uint8_t playerId);
 
-private:
-    INetwork* m_pNetwork;
+    int AddPlayer(INetwork* pNetwork);
+    uint8_t GetPlayerId(const ServerPlayer& player) const { return static_cast<uint8_t>(&player - m_Players); }
 
+private:
     // Timing
+    uint32_t m_TickRate;            // Ticks per second
+    double m_TickDuration;          // 1 / m_TickRate
     double m_Accumulator;           // Time accumulated since last tick
     double m_ServerTime;            // Total server time
     uint32_t m_CurrentTick;         // Current tick number
 
-    // Game State (Server Authoritative)
-    NetPlayerState m_PlayerState;
-    InputCmd m_LastInputCmd;        // Most recent input from client
+    // Game State (Server Authoritative), indexed by playerId
+    ServerPlayer m_Players[MAX_PLAYERS];
+    uint8_t m_PlayerIds[MAX_PLAYERS];   // Active playerIds, ascending (snapshot order)
+    uint32_t m_PlayerCount = 0;
+    uint32_t m_ClientCount = 0;
 
-    // Reload latch timer — keeps IS_RELOADING active for full animation duration
     static constexpr double RELOAD_DURATION = 10.0;  // seconds
-    double m_ReloadTimer = 0.0;
 
     // Collision world for gravity
     CollisionWorld* m_pCollisionWorld = nullptr;
 
-    // Remote bot player (standalone, not mirrored)
-    NetPlayerState m_RemotePlayerState{};
-    uint8_t  m_RemoteHealth = 200;
-    double   m_RemoteRespawnTimer = 0.0;
+    // Snapshot relevancy (line of sight against m_pCollisionWorld)
+    InterestManager m_Interest;
+    InterestStats m_InterestStats = {};
+
+    // Lag compensation: hit volumes per tick, and the rewound scratch frame
+    LagCompHistory m_LagComp;
+    LagCompFrame m_Rewound = {};
+    double m_MaxRewind = DEFAULT_MAX_REWIND;
 
-    // Local player combat state
-    double   m_FireTimer = 0.0;
-    uint16_t m_FireCounter = 0;
+    // This tick's events, and the subset being sent to one client
+    NetEvent m_TickEvents[NET_EVENT_BATCH_MAX_EVENTS] = {};
+    uint32_t m_TickEventCount = 0;
+    NetEvent m_ClientEvents[NET_EVENT_BATCH_MAX_EVENTS] = {};
 
     // Player collision parameters (must match Player_Fps)
     static constexpr float PLAYER_HEIGHT = 1.6f;
     static constexpr float CAPSULE_RADIUS = 0.3f;
 
-    // Weapon parameters (local player = RED team)
+    static constexpr double DEFAULT_MAX_REWIND = 0.5;   // seconds
+
+    // Peripheral players' snapshot rate at every tick rate (InterestSettings)
+    static constexpr uint32_t PERIPHERAL_SEND_RATE = 8; // Hz
+
+    // Weapon parameters (every player carries the RED team rifle)
     static constexpr double RED_RPM = 600.0;
     static constexpr uint8_t RED_DAMAGE = 34;
     static constexpr uint8_t MAX_HEALTH = 200;
@@ -0,0 +1,144 @@
+//=============================================================================
+// net_allocator.cpp
+//
+// Fixed-block allocator for per-packet network memory.
+//=============================================================================
+
+#include "net_allocator.h"
+#include <cstdlib>
+#include <mutex>
+
+namespace NetAllocator {
+
+namespace {
+
+//-----------------------------------------------------------------------------
+// BlockClass - Contiguous arena of equal blocks with an intrusive free list.
+// The owning class of a pointer is found by address range, so blocks carry
+// no header.
+//-----------------------------------------------------------------------------
+template <size_t BlockSize, size_t BlockCount>
+class BlockClass
+{
+    static_assert(BlockSize >= sizeof(void*) && BlockSize % alignof(std::max_align_t) == 0,
+                  "Blocks must hold a free-list link and keep malloc alignment");
+
+public:
+    static constexpr size_t SIZE = BlockSize;
+
+    BlockClass()
+    {
+        for (size_t i = 0; i < BlockCount; i++)
+        {
+            unsigned char* next = (i + 1 < BlockCount) ? m_Arena + (i + 1) * BlockSize : nullptr;
+            *reinterpret_cast<void**>(m_Arena + i * BlockSize) = next;
+        }
+        m_pFreeList = m_Arena;
+    }
+
+    void* Allocate()
+    {
+        void* block = m_pFreeList;
+        if (block) m_pFreeList = *static_cast<void**>(block);
+        return block;
+    }
+
+    bool Owns(const void* ptr) const
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(ptr);
+        return p >= m_Arena && p < m_Arena + sizeof(m_Arena);
+    }
+
+    void Free(void* ptr)
+    {
+        *static_cast<void**>(ptr) = m_pFreeList;
+        m_pFreeList = ptr;
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char m_Arena[BlockSize * BlockCount];
+    void* m_pFreeList = nullptr;
+};
+
+struct AllocatorState
+{
+    std::mutex mutex;
+    BlockClass<SMALL_BLOCK_SIZE, SMALL_BLOCK_COUNT> small;
+    BlockClass<MEDIUM_BLOCK_SIZE, MEDIUM_BLOCK_COUNT> medium;
+    BlockClass<LARGE_BLOCK_SIZE, LARGE_BLOCK_COUNT> large;
+    Stats stats = {};
+};
+
+// Function-local static: usable from other statics' constructors
+AllocatorState& GetState()
+{
+    static AllocatorState state;
+    return state;
+}
+
+template <typename Class>
+void* TryClass(Class& blockClass, size_t size, Stats& stats)
+{
+    if (size > Class::SIZE) return nullptr;
+
+    void* block = blockClass.Allocate();
+    if (block)
+    {
+        stats.poolAllocs++;
+        stats.blocksInUse++;
+    }
+    return block;
+}
+
+} // namespace
+
+void* Allocate(size_t size)
+{
+    AllocatorState& state = GetState();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        // Smallest class that fits; an exhausted class spills to the next
+        void* block = TryClass(state.small, size, state.stats);
+        if (!block) block = TryClass(state.medium, size, state.stats);
+        if (!block) block = TryClass(state.large, size, state.stats);
+        if (block) return block;
+
+        state.stats.heapAllocs++;
+    }
+    return std::malloc(size);
+}
+
+void Free(void* ptr)
+{
+    if (!ptr) return;
+
+    AllocatorState& state = GetState();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        bool pooled = true;
+        if (state.small.Owns(ptr))       state.small.Free(ptr);
+        else if (state.medium.Owns(ptr)) state.medium.Free(ptr);
+        else if (state.large.Owns(ptr))  state.large.Free(ptr);
+        else pooled = false;
+
+        if (pooled)
+        {
+            state.stats.blocksInUse--;
+            return;
+        }
+    }
+
+    // Not ours: came from the malloc fallback
+    std::free(ptr);
+}
+
+Stats GetStats()
+{
+    AllocatorState& state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.stats;
+}
+
+} // namespace NetAllocator
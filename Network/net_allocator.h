@@ -0,0 +1,48 @@
+#pragma once
+//=============================================================================
+// net_allocator.h
+//
+// Fixed-block allocator for per-packet network memory.
+//
+// ENet allocates an ENetPacket, its payload and a protocol command for every
+// packet sent or received. ENetClientNetwork installs this allocator through
+// enet_initialize_with_callbacks, and outgoing payload buffers come from it
+// too (ENET_PACKET_FLAG_NO_ALLOCATE), so steady-state traffic never reaches
+// the heap. Requests larger than the biggest block (host setup) or made
+// while a class is exhausted fall back to malloc and are counted.
+//
+// Thread-safe (one short lock per call): ENet may run on the IO thread.
+//=============================================================================
+
+#include <cstddef>
+#include <cstdint>
+
+namespace NetAllocator {
+
+//-----------------------------------------------------------------------------
+// Block classes: sized for ENet commands/packets (small), snapshot and
+// input payloads (medium) and MTU-sized datagrams (large)
+//-----------------------------------------------------------------------------
+constexpr size_t SMALL_BLOCK_SIZE  = 128;
+constexpr size_t SMALL_BLOCK_COUNT = 1024;
+constexpr size_t MEDIUM_BLOCK_SIZE  = 512;
+constexpr size_t MEDIUM_BLOCK_COUNT = 256;
+constexpr size_t LARGE_BLOCK_SIZE  = 2048;
+constexpr size_t LARGE_BLOCK_COUNT = 64;
+
+void* Allocate(size_t size);
+void Free(void* ptr);
+
+//-----------------------------------------------------------------------------
+// Statistics
+//-----------------------------------------------------------------------------
+struct Stats
+{
+    uint64_t poolAllocs;     // Served from a block class
+    uint64_t heapAllocs;     // Fell back to malloc
+    uint64_t blocksInUse;    // Pool blocks currently allocated
+};
+
+Stats GetStats();
+
+} // namespace NetAllocator
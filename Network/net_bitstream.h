@@ -0,0 +1,141 @@
+#pragma once
+//=============================================================================
+// net_bitstream.h
+//
+// Bounds-checked bit streams for the network wire format.
+// Shared between game_client and game_server (maintain in sync).
+//
+// Bits are packed LSB-first into bytes, so the encoding does not depend on
+// host endianness. Writing or reading past the end sets an overflow flag
+// instead of touching memory; callers check it once at the end.
+//=============================================================================
+
+#include <cstddef>
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+// BitWriter
+//-----------------------------------------------------------------------------
+class BitWriter
+{
+public:
+    BitWriter(uint8_t* data, size_t capacity)
+        : m_Data(data), m_Capacity(capacity) {}
+
+    // Write the low `bits` bits of value (bits = 0..32)
+    void WriteBits(uint32_t value, int bits)
+    {
+        if (bits <= 0) return;
+        if (bits < 32) value &= (1u << bits) - 1u;
+
+        m_Scratch |= static_cast<uint64_t>(value) << m_ScratchBits;
+        m_ScratchBits += bits;
+
+        while (m_ScratchBits >= 8)
+        {
+            PutByte(static_cast<uint8_t>(m_Scratch));
+            m_Scratch >>= 8;
+            m_ScratchBits -= 8;
+        }
+    }
+
+    void WriteBool(bool value) { WriteBits(value ? 1u : 0u, 1); }
+
+    // LEB128-style: 7 payload bits + continuation bit per group
+    void WriteVarint(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            WriteBits(static_cast<uint32_t>(value & 0x7F) | 0x80u, 8);
+            value >>= 7;
+        }
+        WriteBits(static_cast<uint32_t>(value), 8);
+    }
+
+    // Flush the partial last byte (zero padded). Returns total bytes.
+    size_t Finish()
+    {
+        if (m_ScratchBits > 0)
+        {
+            PutByte(static_cast<uint8_t>(m_Scratch));
+            m_Scratch = 0;
+            m_ScratchBits = 0;
+        }
+        return m_Overflow ? 0 : m_Size;
+    }
+
+    size_t GetBitsWritten() const { return m_Size * 8 + m_ScratchBits; }
+    bool HasOverflow() const { return m_Overflow; }
+
+private:
+    void PutByte(uint8_t byte)
+    {
+        if (m_Size >= m_Capacity) { m_Overflow = true; return; }
+        m_Data[m_Size++] = byte;
+    }
+
+    uint8_t* m_Data;
+    size_t m_Capacity;
+    size_t m_Size = 0;
+    uint64_t m_Scratch = 0;
+    int m_ScratchBits = 0;
+    bool m_Overflow = false;
+};
+
+//-----------------------------------------------------------------------------
+// BitReader
+//-----------------------------------------------------------------------------
+class BitReader
+{
+public:
+    BitReader(const uint8_t* data, size_t size)
+        : m_Data(data), m_Size(size) {}
+
+    // Read `bits` bits (0..32). Returns 0 and sets overflow past the end.
+    uint32_t ReadBits(int bits)
+    {
+        if (bits <= 0) return 0;
+
+        while (m_ScratchBits < bits)
+        {
+            if (m_Offset >= m_Size) { m_Overflow = true; return 0; }
+            m_Scratch |= static_cast<uint64_t>(m_Data[m_Offset++]) << m_ScratchBits;
+            m_ScratchBits += 8;
+        }
+
+        uint32_t value = static_cast<uint32_t>(m_Scratch & ((1ull << bits) - 1ull));
+        m_Scratch >>= bits;
+        m_ScratchBits -= bits;
+        return value;
+    }
+
+    bool ReadBool() { return ReadBits(1) != 0; }
+
+    uint64_t ReadVarint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            uint32_t group = ReadBits(8);
+            if (m_Overflow) return 0;
+            value |= static_cast<uint64_t>(group & 0x7F) << shift;
+            if (!(group & 0x80)) return value;
+        }
+        m_Overflow = true;  // Too many continuation groups
+        return 0;
+    }
+
+    size_t GetBitsRead() const { return m_Offset * 8 - m_ScratchBits; }
+
+    // True if everything but the zero padding of the last byte was consumed
+    bool IsAtEnd() const { return m_Offset == m_Size && m_ScratchBits < 8; }
+    bool HasOverflow() const { return m_Overflow; }
+
+private:
+    const uint8_t* m_Data;
+    size_t m_Size;
+    size_t m_Offset = 0;
+    uint64_t m_Scratch = 0;
+    int m_ScratchBits = 0;
+    bool m_Overflow = false;
+};
@@ -0,0 +1,129 @@
+//=============================================================================
+// net_bundle.cpp
+//
+// Varint-framed message bundles.
+//=============================================================================
+
+#include "net_bundle.h"
+#include <cstring>
+
+namespace {
+
+// Message sizes are below 2^32, so a length takes at most 5 bytes
+constexpr size_t VARINT_MAX_BYTES = 5;
+
+size_t VarintSize(size_t value)
+{
+    size_t bytes = 1;
+    while (value >= 0x80)
+    {
+        value >>= 7;
+        bytes++;
+    }
+    return bytes;
+}
+
+} // namespace
+
+//=============================================================================
+// PacketBundler
+//=============================================================================
+
+PacketBundler::PacketBundler()
+    : m_Mtu(NET_BUNDLE_DEFAULT_MTU)
+{
+    Clear();
+}
+
+void PacketBundler::SetMtu(size_t mtu)
+{
+    m_Mtu = (mtu > NET_BUNDLE_MAX_SIZE) ? NET_BUNDLE_MAX_SIZE : mtu;
+    Clear();
+}
+
+void PacketBundler::Clear()
+{
+    m_Buffer[0] = static_cast<uint8_t>(PacketType::BUNDLE);
+    m_Size = 1;
+    m_MessageCount = 0;
+    m_FirstOffset = 0;
+    m_FirstSize = 0;
+}
+
+bool PacketBundler::Append(const uint8_t* message, size_t size)
+{
+    if (size == 0 || static_cast<PacketType>(message[0]) == PacketType::BUNDLE) return false;
+    if (m_Size + VarintSize(size) + size > m_Mtu) return false;
+
+    size_t value = size;
+    while (value >= 0x80)
+    {
+        m_Buffer[m_Size++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    m_Buffer[m_Size++] = static_cast<uint8_t>(value);
+
+    if (m_MessageCount == 0)
+    {
+        m_FirstOffset = m_Size;
+        m_FirstSize = size;
+    }
+
+    std::memcpy(m_Buffer + m_Size, message, size);
+    m_Size += size;
+    m_MessageCount++;
+    return true;
+}
+
+const uint8_t* PacketBundler::GetData() const
+{
+    return (m_MessageCount == 1) ? m_Buffer + m_FirstOffset : m_Buffer;
+}
+
+size_t PacketBundler::GetSize() const
+{
+    if (m_MessageCount == 0) return 0;
+    return (m_MessageCount == 1) ? m_FirstSize : m_Size;
+}
+
+//=============================================================================
+// BundleReader
+//=============================================================================
+
+BundleReader::BundleReader(const uint8_t* data, size_t size)
+    : m_Data(data)
+    , m_Size(size)
+    , m_Pos(0)
+    , m_Error(false)
+{
+}
+
+bool BundleReader::Next(const uint8_t*& outMessage, size_t& outSize)
+{
+    if (m_Error || m_Pos >= m_Size) return false;
+
+    uint64_t length = 0;
+    for (size_t i = 0;; i++)
+    {
+        if (i == VARINT_MAX_BYTES || m_Pos >= m_Size)
+        {
+            m_Error = true;
+            return false;
+        }
+        const uint8_t byte = m_Data[m_Pos++];
+        length |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0) break;
+    }
+
+    if (length == 0 || length > m_Size - m_Pos ||
+        static_cast<PacketType>(m_Data[m_Pos]) == PacketType::BUNDLE)
+    {
+        m_Error = true;
+        return false;
+    }
+
+    outMessage = m_Data + m_Pos;
+    outSize = static_cast<size_t>(length);
+    m_Pos += outSize;
+    return true;
+}
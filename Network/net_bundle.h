@@ -0,0 +1,95 @@
+#pragma once
+//=============================================================================
+// net_bundle.h
+//
+// Packs several small messages into one datagram.
+// Shared between game_client and game_server (maintain in sync).
+//
+// Every message (INPUT_BATCH, SNAPSHOT_ACK, ...) starts with its PacketType
+// byte. Sent one by one, each costs an enet_peer_send, a pooled payload and
+// an ENet command header in the datagram. A BUNDLE carries several:
+//   Sender:   appends the messages of one pump to a PacketBundler, which
+//             refuses a message that would push it past the MTU; the caller
+//             then flushes and starts a new bundle. A bundle holding a
+//             single message goes out as that message, unframed. Only
+//             messages of the same channel and reliability share a bundle.
+//   Receiver: unpacks a BUNDLE with BundleReader and dispatches each message
+//             exactly as if it had arrived alone. A malformed length drops
+//             the rest of the bundle; bundles never nest.
+//
+// Wire layout (after the PacketType byte), repeated until the end:
+//   varint  message size (PacketType byte included, LEB128)
+//   bytes   message
+//=============================================================================
+
+#include "net_packet.h"
+#include <cstddef>
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+// Size limits
+//-----------------------------------------------------------------------------
+
+// Largest bundle we build, PacketType byte included. Same budget as
+// SNAPSHOT_PACKET_MAX_SIZE: fits ENet's default 1392-byte MTU unfragmented.
+static constexpr size_t NET_BUNDLE_MAX_SIZE = 1200;
+static constexpr size_t NET_BUNDLE_DEFAULT_MTU = NET_BUNDLE_MAX_SIZE;
+
+//-----------------------------------------------------------------------------
+// PacketBundler - Sender side
+//-----------------------------------------------------------------------------
+class PacketBundler
+{
+public:
+    PacketBundler();
+
+    // Bundle size limit, clamped to NET_BUNDLE_MAX_SIZE. 0 disables
+    // bundling: every message is sent on its own.
+    void SetMtu(size_t mtu);
+    size_t GetMtu() const { return m_Mtu; }
+    bool IsEnabled() const { return m_Mtu > 0; }
+
+    // Append one message (PacketType byte first). Returns false if it would
+    // not fit: flush and retry. A message that does not even fit an empty
+    // bundle must be sent on its own.
+    bool Append(const uint8_t* message, size_t size);
+
+    // Datagram to send: the message itself while only one is held,
+    // otherwise the BUNDLE. Valid until the next Append or Clear.
+    const uint8_t* GetData() const;
+    size_t GetSize() const;
+
+    bool IsEmpty() const { return m_MessageCount == 0; }
+    uint32_t GetMessageCount() const { return m_MessageCount; }
+    void Clear();
+
+private:
+    size_t m_Mtu;
+    size_t m_Size;                  // Bytes used in m_Buffer, BUNDLE byte included
+    uint32_t m_MessageCount;
+    size_t m_FirstOffset;           // First message, sent unframed when alone
+    size_t m_FirstSize;
+    uint8_t m_Buffer[NET_BUNDLE_MAX_SIZE];
+};
+
+//-----------------------------------------------------------------------------
+// BundleReader - Receiver side
+//-----------------------------------------------------------------------------
+class BundleReader
+{
+public:
+    // BUNDLE payload, without the PacketType byte
+    BundleReader(const uint8_t* data, size_t size);
+
+    // Next message (PacketType byte first). Returns false at the end, or
+    // at the first malformed entry (HasError).
+    bool Next(const uint8_t*& outMessage, size_t& outSize);
+
+    bool HasError() const { return m_Error; }
+
+private:
+    const uint8_t* m_Data;
+    size_t m_Size;
+    size_t m_Pos;
+    bool m_Error;
+};
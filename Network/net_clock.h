@@ -0,0 +1,19 @@
+#pragma once
+//=============================================================================
+// net_clock.h
+//
+// Monotonic clock for network timestamps (seconds, arbitrary epoch).
+// Safe to call from any thread; only differences between values matter.
+//=============================================================================
+
+#include <chrono>
+
+namespace NetClock {
+
+inline double Now()
+{
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace NetClock
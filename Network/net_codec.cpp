@@ -0,0 +1,488 @@
+//=============================================================================
+// net_codec.cpp
+//
+// Bit-packed, quantized wire codec for NetPlayerState, Snapshot and InputCmd.
+//=============================================================================
+
+#include "net_codec.h"
+#include <cmath>
+
+namespace NetCodec {
+
+//=============================================================================
+// Scalar quantizers
+//=============================================================================
+
+uint32_t Quantize(float value, const QuantRange& range)
+{
+    if (!(value > range.min)) return 0;                    // also catches NaN
+    if (value >= range.max) return range.MaxValue();
+
+    float normalized = (value - range.min) / (range.max - range.min);
+    uint32_t q = static_cast<uint32_t>(normalized * static_cast<float>(range.MaxValue()) + 0.5f);
+    return (q > range.MaxValue()) ? range.MaxValue() : q;
+}
+
+float Dequantize(uint32_t q, const QuantRange& range)
+{
+    if (q >= range.MaxValue()) return range.max;
+    return range.min + static_cast<float>(q) * range.Step();
+}
+
+uint32_t QuantizeAngle(float radians, int bits)
+{
+    const uint32_t steps = 1u << bits;
+
+    if (!std::isfinite(radians)) return 0;
+
+    // Wrap into [0, 2pi) measured from -pi
+    float turns = (radians + DirectX::XM_PI) / DirectX::XM_2PI;
+    turns -= std::floor(turns);
+
+    uint32_t q = static_cast<uint32_t>(turns * static_cast<float>(steps) + 0.5f);
+    return q & (steps - 1u);  // 2pi wraps to 0
+}
+
+float DequantizeAngle(uint32_t q, int bits)
+{
+    const float steps = static_cast<float>(1u << bits);
+    return static_cast<float>(q) * (DirectX::XM_2PI / steps) - DirectX::XM_PI;
+}
+
+uint32_t QuantizeAxis(float value)
+{
+    const float half = static_cast<float>((1u << (MOVE_AXIS_BITS - 1)) - 1u);  // 127
+
+    if (!(value > -1.0f)) return 0;                        // also catches NaN
+    if (value >= 1.0f) return static_cast<uint32_t>(half * 2.0f);
+
+    return static_cast<uint32_t>(std::lround(value * half) + static_cast<long>(half));
+}
+
+float DequantizeAxis(uint32_t q)
+{
+    const float half = static_cast<float>((1u << (MOVE_AXIS_BITS - 1)) - 1u);
+
+    float value = (static_cast<float>(q) - half) / half;
+    return (value > 1.0f) ? 1.0f : value;
+}
+
+//=============================================================================
+// NetPlayerState
+//=============================================================================
+
+QuantizedState QuantizeState(const NetPlayerState& s)
+{
+    QuantizedState q;
+    q.pos[0] = Quantize(s.position.x, POS_X);
+    q.pos[1] = Quantize(s.position.y, POS_Y);
+    q.pos[2] = Quantize(s.position.z, POS_Z);
+    q.vel[0] = Quantize(s.velocity.x, VEL);
+    q.vel[1] = Quantize(s.velocity.y, VEL);
+    q.vel[2] = Quantize(s.velocity.z, VEL);
+    q.yaw = QuantizeAngle(s.yaw, YAW_BITS);
+    q.pitch = Quantize(s.pitch, PITCH);
+    q.stateFlags = s.stateFlags & ((1u << STATE_FLAG_BITS) - 1u);
+    q.health = s.health;
+    q.fireCounter = s.fireCounter;
+    return q;
+}
+
+void DequantizeState(const QuantizedState& q, NetPlayerState& out)
+{
+    out.position.x = Dequantize(q.pos[0], POS_X);
+    out.position.y = Dequantize(q.pos[1], POS_Y);
+    out.position.z = Dequantize(q.pos[2], POS_Z);
+    out.velocity.x = Dequantize(q.vel[0], VEL);
+    out.velocity.y = Dequantize(q.vel[1], VEL);
+    out.velocity.z = Dequantize(q.vel[2], VEL);
+    out.yaw = DequantizeAngle(q.yaw, YAW_BITS);
+    out.pitch = Dequantize(q.pitch, PITCH);
+    out.stateFlags = q.stateFlags;
+    out.health = q.health;
+    out.fireCounter = q.fireCounter;
+}
+
+uint32_t ZigZag(int32_t value)
+{
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+int32_t UnZigZag(uint32_t value)
+{
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+uint64_t ToMicroseconds(double seconds)
+{
+    if (!(seconds > 0.0)) return 0;
+    return static_cast<uint64_t>(std::llround(seconds * 1000000.0));
+}
+
+uint8_t SaturateInputDepth(uint8_t depth)
+{
+    constexpr uint8_t MAX_DEPTH = (1u << INPUT_DEPTH_BITS) - 1u;
+    return depth < MAX_DEPTH ? depth : MAX_DEPTH;
+}
+
+namespace {
+
+void WriteTick(BitWriter& w, uint32_t tickId, uint32_t snapshotTick)
+{
+    bool differs = (tickId != snapshotTick);
+    w.WriteBool(differs);
+    if (differs) w.WriteVarint(tickId);
+}
+
+uint32_t ReadTick(BitReader& r, uint32_t snapshotTick)
+{
+    if (!r.ReadBool()) return snapshotTick;
+    return static_cast<uint32_t>(r.ReadVarint());
+}
+
+} // namespace
+
+void WriteState(BitWriter& w, const NetPlayerState& state, uint32_t snapshotTick)
+{
+    QuantizedState q = QuantizeState(state);
+
+    WriteTick(w, state.tickId, snapshotTick);
+    w.WriteBits(q.pos[0], POS_X.bits);
+    w.WriteBits(q.pos[1], POS_Y.bits);
+    w.WriteBits(q.pos[2], POS_Z.bits);
+    w.WriteBits(q.vel[0], VEL.bits);
+    w.WriteBits(q.vel[1], VEL.bits);
+    w.WriteBits(q.vel[2], VEL.bits);
+    w.WriteBits(q.yaw, YAW_BITS);
+    w.WriteBits(q.pitch, PITCH.bits);
+    w.WriteBits(q.stateFlags, STATE_FLAG_BITS);
+    w.WriteBits(q.health, 8);
+    w.WriteBits(q.fireCounter, 16);
+}
+
+void ReadState(BitReader& r, NetPlayerState& out, uint32_t snapshotTick)
+{
+    out.tickId = ReadTick(r, snapshotTick);
+    out.position.x = Dequantize(r.ReadBits(POS_X.bits), POS_X);
+    out.position.y = Dequantize(r.ReadBits(POS_Y.bits), POS_Y);
+    out.position.z = Dequantize(r.ReadBits(POS_Z.bits), POS_Z);
+    out.velocity.x = Dequantize(r.ReadBits(VEL.bits), VEL);
+    out.velocity.y = Dequantize(r.ReadBits(VEL.bits), VEL);
+    out.velocity.z = Dequantize(r.ReadBits(VEL.bits), VEL);
+    out.yaw = DequantizeAngle(r.ReadBits(YAW_BITS), YAW_BITS);
+    out.pitch = Dequantize(r.ReadBits(PITCH.bits), PITCH);
+    out.stateFlags = r.ReadBits(STATE_FLAG_BITS);
+    out.health = static_cast<uint8_t>(r.ReadBits(8));
+    out.fireCounter = static_cast<uint16_t>(r.ReadBits(16));
+}
+
+void WriteStateDelta(BitWriter& w, const NetPlayerState& state, const NetPlayerState& base,
+                     uint32_t snapshotTick)
+{
+    QuantizedState q = QuantizeState(state);
+    QuantizedState b = QuantizeState(base);
+
+    uint32_t mask = 0;
+    if (state.tickId != snapshotTick)   mask |= NetStateField::TICK_ID;
+    if (q.pos[0] != b.pos[0])           mask |= NetStateField::POS_X;
+    if (q.pos[1] != b.pos[1])           mask |= NetStateField::POS_Y;
+    if (q.pos[2] != b.pos[2])           mask |= NetStateField::POS_Z;
+    if (q.vel[0] != b.vel[0])           mask |= NetStateField::VEL_X;
+    if (q.vel[1] != b.vel[1])           mask |= NetStateField::VEL_Y;
+    if (q.vel[2] != b.vel[2])           mask |= NetStateField::VEL_Z;
+    if (q.yaw != b.yaw)                 mask |= NetStateField::YAW;
+    if (q.pitch != b.pitch)             mask |= NetStateField::PITCH;
+    if (q.stateFlags != b.stateFlags)   mask |= NetStateField::STATE_FLAGS;
+    if (q.health != b.health)           mask |= NetStateField::HEALTH;
+    if (q.fireCounter != b.fireCounter) mask |= NetStateField::FIRE_COUNTER;
+
+    w.WriteBits(mask, STATE_FIELD_MASK_BITS);
+    if (mask & NetStateField::TICK_ID)      w.WriteVarint(state.tickId);
+    if (mask & NetStateField::POS_X)        w.WriteBits(q.pos[0], POS_X.bits);
+    if (mask & NetStateField::POS_Y)        w.WriteBits(q.pos[1], POS_Y.bits);
+    if (mask & NetStateField::POS_Z)        w.WriteBits(q.pos[2], POS_Z.bits);
+    if (mask & NetStateField::VEL_X)        w.WriteBits(q.vel[0], VEL.bits);
+    if (mask & NetStateField::VEL_Y)        w.WriteBits(q.vel[1], VEL.bits);
+    if (mask & NetStateField::VEL_Z)        w.WriteBits(q.vel[2], VEL.bits);
+    if (mask & NetStateField::YAW)          w.WriteBits(q.yaw, YAW_BITS);
+    if (mask & NetStateField::PITCH)        w.WriteBits(q.pitch, PITCH.bits);
+    if (mask & NetStateField::STATE_FLAGS)  w.WriteBits(q.stateFlags, STATE_FLAG_BITS);
+    if (mask & NetStateField::HEALTH)       w.WriteBits(q.health, 8);
+    if (mask & NetStateField::FIRE_COUNTER) w.WriteBits(q.fireCounter, 16);
+}
+
+void ReadStateDelta(BitReader& r, NetPlayerState& out, const NetPlayerState& base,
+                    uint32_t snapshotTick)
+{
+    uint32_t mask = r.ReadBits(STATE_FIELD_MASK_BITS);
+
+    out = base;
+    out.tickId = snapshotTick;
+
+    if (mask & NetStateField::TICK_ID)      out.tickId = static_cast<uint32_t>(r.ReadVarint());
+    if (mask & NetStateField::POS_X)        out.position.x = Dequantize(r.ReadBits(POS_X.bits), POS_X);
+    if (mask & NetStateField::POS_Y)        out.position.y = Dequantize(r.ReadBits(POS_Y.bits), POS_Y);
+    if (mask & NetStateField::POS_Z)        out.position.z = Dequantize(r.ReadBits(POS_Z.bits), POS_Z);
+    if (mask & NetStateField::VEL_X)        out.velocity.x = Dequantize(r.ReadBits(VEL.bits), VEL);
+    if (mask & NetStateField::VEL_Y)        out.velocity.y = Dequantize(r.ReadBits(VEL.bits), VEL);
+    if (mask & NetStateField::VEL_Z)        out.velocity.z = Dequantize(r.ReadBits(VEL.bits), VEL);
+    if (mask & NetStateField::YAW)          out.yaw = DequantizeAngle(r.ReadBits(YAW_BITS), YAW_BITS);
+    if (mask & NetStateField::PITCH)        out.pitch = Dequantize(r.ReadBits(PITCH.bits), PITCH);
+    if (mask & NetStateField::STATE_FLAGS)  out.stateFlags = r.ReadBits(STATE_FLAG_BITS);
+    if (mask & NetStateField::HEALTH)       out.health = static_cast<uint8_t>(r.ReadBits(8));
+    if (mask & NetStateField::FIRE_COUNTER) out.fireCounter = static_cast<uint16_t>(r.ReadBits(16));
+}
+
+NetPlayerState RoundTrip(const NetPlayerState& state)
+{
+    QuantizedState q = QuantizeState(state);
+
+    NetPlayerState out = state;
+    DequantizeState(q, out);
+    return out;
+}
+
+//=============================================================================
+// Snapshot
+//=============================================================================
+
+namespace {
+
+//-----------------------------------------------------------------------------
+// BaselineCursor - Forward-only walk over the baseline's remote entries
+//
+// Both lists are in ascending playerId order, so matching every entry costs
+// O(current + baseline) in total. An out-of-order id simply finds no
+// baseline and is written in full; writer and reader make the same call.
+//-----------------------------------------------------------------------------
+class BaselineCursor
+{
+public:
+    explicit BaselineCursor(const Snapshot* baseline)
+        : m_pBaseline(baseline)
+        , m_Count(baseline ? baseline->remotePlayerCount : 0)
+    {
+        if (m_Count > MAX_PLAYERS - 1) m_Count = MAX_PLAYERS - 1;
+    }
+
+    const NetPlayerState* Find(uint8_t playerId)
+    {
+        while (m_Index < m_Count && m_pBaseline->remotePlayers[m_Index].playerId < playerId)
+            m_Index++;
+
+        if (m_Index < m_Count && m_pBaseline->remotePlayers[m_Index].playerId == playerId)
+            return &m_pBaseline->remotePlayers[m_Index++].state;
+        return nullptr;
+    }
+
+private:
+    const Snapshot* m_pBaseline;
+    uint8_t m_Count;
+    uint8_t m_Index = 0;
+};
+
+void WriteRemoteEntry(BitWriter& w, const RemotePlayerEntry& entry, const NetPlayerState* base,
+                      uint32_t snapshotTick)
+{
+    w.WriteBits(entry.playerId, 8);
+    w.WriteBits(entry.teamId, TEAM_BITS);
+
+    if (base) WriteStateDelta(w, entry.state, *base, snapshotTick);
+    else      WriteState(w, entry.state, snapshotTick);
+}
+
+} // namespace
+
+void WriteSnapshot(BitWriter& w, const Snapshot& snapshot, const Snapshot* baseline)
+{
+    uint8_t remoteCount = snapshot.remotePlayerCount;
+    if (remoteCount > MAX_PLAYERS - 1) remoteCount = MAX_PLAYERS - 1;
+
+    w.WriteVarint(ToMicroseconds(snapshot.serverTime));
+    w.WriteBits(snapshot.localPlayerId, 8);
+    w.WriteBits(snapshot.localPlayerTeam, TEAM_BITS);
+    w.WriteBits(remoteCount, 8);
+
+    // The ack usually advances by one input per snapshot
+    if (baseline) w.WriteVarint(ZigZag(static_cast<int32_t>(snapshot.ackInputTick - baseline->ackInputTick)));
+    else          w.WriteVarint(snapshot.ackInputTick);
+    w.WriteBits(SaturateInputDepth(snapshot.inputBufferDepth), INPUT_DEPTH_BITS);
+
+    if (baseline) WriteStateDelta(w, snapshot.localPlayer, baseline->localPlayer, snapshot.tickId);
+    else          WriteState(w, snapshot.localPlayer, snapshot.tickId);
+
+    BaselineCursor cursor(baseline);
+    for (uint8_t i = 0; i < remoteCount; i++)
+    {
+        const RemotePlayerEntry& entry = snapshot.remotePlayers[i];
+        WriteRemoteEntry(w, entry, cursor.Find(entry.playerId), snapshot.tickId);
+    }
+}
+
+bool ReadSnapshot(BitReader& r, Snapshot& out, const Snapshot* baseline)
+{
+    const uint32_t tickId = out.tickId;
+
+    out.serverTime = static_cast<double>(r.ReadVarint()) / 1000000.0;
+    out.localPlayerId = static_cast<uint8_t>(r.ReadBits(8));
+    out.localPlayerTeam = static_cast<uint8_t>(r.ReadBits(TEAM_BITS));
+    out.remotePlayerCount = static_cast<uint8_t>(r.ReadBits(8));
+    if (r.HasOverflow() || out.remotePlayerCount > MAX_PLAYERS - 1) return false;
+
+    const uint32_t ack = static_cast<uint32_t>(r.ReadVarint());
+    out.ackInputTick = baseline ? baseline->ackInputTick + static_cast<uint32_t>(UnZigZag(ack)) : ack;
+    out.inputBufferDepth = static_cast<uint8_t>(r.ReadBits(INPUT_DEPTH_BITS));
+
+    if (baseline) ReadStateDelta(r, out.localPlayer, baseline->localPlayer, tickId);
+    else          ReadState(r, out.localPlayer, tickId);
+
+    BaselineCursor cursor(baseline);
+    for (uint8_t i = 0; i < out.remotePlayerCount; i++)
+    {
+        RemotePlayerEntry& entry = out.remotePlayers[i];
+        entry.playerId = static_cast<uint8_t>(r.ReadBits(8));
+        entry.teamId = static_cast<uint8_t>(r.ReadBits(TEAM_BITS));
+        entry.padding[0] = entry.padding[1] = 0;
+
+        const NetPlayerState* base = cursor.Find(entry.playerId);
+        if (base) ReadStateDelta(r, entry.state, *base, tickId);
+        else      ReadState(r, entry.state, tickId);
+    }
+
+    return !r.HasOverflow();
+}
+
+size_t GetRemoteEntryBits(const RemotePlayerEntry& entry, const NetPlayerState* base,
+                          uint32_t snapshotTick)
+{
+    uint8_t scratch[(REMOTE_ENTRY_MAX_BITS + 7) / 8];
+    BitWriter w(scratch, sizeof(scratch));
+    WriteRemoteEntry(w, entry, base, snapshotTick);
+    return w.GetBitsWritten();
+}
+
+void QuantizeSnapshot(Snapshot& snapshot)
+{
+    snapshot.serverTime = static_cast<double>(ToMicroseconds(snapshot.serverTime)) / 1000000.0;
+    snapshot.localPlayerTeam &= (1u << TEAM_BITS) - 1u;
+    snapshot.inputBufferDepth = SaturateInputDepth(snapshot.inputBufferDepth);
+    snapshot.localPlayer = RoundTrip(snapshot.localPlayer);
+
+    if (snapshot.remotePlayerCount > MAX_PLAYERS - 1) snapshot.remotePlayerCount = MAX_PLAYERS - 1;
+    for (uint8_t i = 0; i < snapshot.remotePlayerCount; i++)
+    {
+        RemotePlayerEntry& entry = snapshot.remotePlayers[i];
+        entry.teamId &= (1u << TEAM_BITS) - 1u;
+        entry.padding[0] = entry.padding[1] = 0;
+        entry.state = RoundTrip(entry.state);
+    }
+}
+
+//=============================================================================
+// InputCmd
+//=============================================================================
+
+namespace {
+
+struct QuantizedInput
+{
+    uint32_t move[2];
+    uint32_t yaw;
+    uint32_t pitch;
+    uint32_t buttons;
+};
+
+QuantizedInput QuantizeInput(const InputCmd& cmd)
+{
+    QuantizedInput q;
+    q.move[0] = QuantizeAxis(cmd.moveAxisX);
+    q.move[1] = QuantizeAxis(cmd.moveAxisY);
+    q.yaw = QuantizeAngle(cmd.yaw, YAW_BITS);
+    q.pitch = Quantize(cmd.pitch, PITCH);
+    q.buttons = cmd.buttons & ((1u << INPUT_BUTTON_BITS) - 1u);
+    return q;
+}
+
+} // namespace
+
+void WriteInputCmd(BitWriter& w, const InputCmd& cmd)
+{
+    QuantizedInput q = QuantizeInput(cmd);
+
+    w.WriteBits(q.move[0], MOVE_AXIS_BITS);
+    w.WriteBits(q.move[1], MOVE_AXIS_BITS);
+    w.WriteBits(q.yaw, YAW_BITS);
+    w.WriteBits(q.pitch, PITCH.bits);
+    w.WriteBits(q.buttons, INPUT_BUTTON_BITS);
+    w.WriteVarint(cmd.viewTimeMs);
+}
+
+void ReadInputCmd(BitReader& r, InputCmd& out)
+{
+    out.moveAxisX = DequantizeAxis(r.ReadBits(MOVE_AXIS_BITS));
+    out.moveAxisY = DequantizeAxis(r.ReadBits(MOVE_AXIS_BITS));
+    out.yaw = DequantizeAngle(r.ReadBits(YAW_BITS), YAW_BITS);
+    out.pitch = Dequantize(r.ReadBits(PITCH.bits), PITCH);
+    out.buttons = r.ReadBits(INPUT_BUTTON_BITS);
+    out.viewTimeMs = static_cast<uint32_t>(r.ReadVarint());
+}
+
+void WriteInputCmdDelta(BitWriter& w, const InputCmd& cmd, const InputCmd& base)
+{
+    QuantizedInput q = QuantizeInput(cmd);
+    QuantizedInput b = QuantizeInput(base);
+
+    uint32_t mask = 0;
+    if (q.move[0] != b.move[0] || q.move[1] != b.move[1]) mask |= NetInputField::MOVE;
+    if (q.yaw != b.yaw)             mask |= NetInputField::YAW;
+    if (q.pitch != b.pitch)         mask |= NetInputField::PITCH;
+    if (q.buttons != b.buttons)     mask |= NetInputField::BUTTONS;
+    if (cmd.viewTimeMs != base.viewTimeMs) mask |= NetInputField::VIEW_TIME;
+
+    w.WriteBits(mask, INPUT_FIELD_MASK_BITS);
+    if (mask & NetInputField::MOVE)
+    {
+        w.WriteBits(q.move[0], MOVE_AXIS_BITS);
+        w.WriteBits(q.move[1], MOVE_AXIS_BITS);
+    }
+    if (mask & NetInputField::YAW)      w.WriteBits(q.yaw, YAW_BITS);
+    if (mask & NetInputField::PITCH)    w.WriteBits(q.pitch, PITCH.bits);
+    if (mask & NetInputField::BUTTONS)  w.WriteBits(q.buttons, INPUT_BUTTON_BITS);
+    if (mask & NetInputField::VIEW_TIME)
+        w.WriteVarint(ZigZag(static_cast<int32_t>(cmd.viewTimeMs - base.viewTimeMs)));
+}
+
+void ReadInputCmdDelta(BitReader& r, InputCmd& out, const InputCmd& base)
+{
+    uint32_t mask = r.ReadBits(INPUT_FIELD_MASK_BITS);
+
+    const uint32_t tickId = out.tickId;
+    out = base;
+    out.tickId = tickId;
+
+    if (mask & NetInputField::MOVE)
+    {
+        out.moveAxisX = DequantizeAxis(r.ReadBits(MOVE_AXIS_BITS));
+        out.moveAxisY = DequantizeAxis(r.ReadBits(MOVE_AXIS_BITS));
+    }
+    if (mask & NetInputField::YAW)      out.yaw = DequantizeAngle(r.ReadBits(YAW_BITS), YAW_BITS);
+    if (mask & NetInputField::PITCH)    out.pitch = Dequantize(r.ReadBits(PITCH.bits), PITCH);
+    if (mask & NetInputField::BUTTONS)  out.buttons = r.ReadBits(INPUT_BUTTON_BITS);
+    if (mask & NetInputField::VIEW_TIME)
+        out.viewTimeMs = base.viewTimeMs + static_cast<uint32_t>(UnZigZag(static_cast<uint32_t>(r.ReadVarint())));
+}
+
+InputCmd RoundTrip(const InputCmd& cmd)
+{
+    QuantizedInput q = QuantizeInput(cmd);
+
+    InputCmd out = cmd;
+    out.moveAxisX = DequantizeAxis(q.move[0]);
+    out.moveAxisY = DequantizeAxis(q.move[1]);
+    out.yaw = DequantizeAngle(q.yaw, YAW_BITS);
+    out.pitch = Dequantize(q.pitch, PITCH);
+    out.buttons = q.buttons;
+    return out;
+}
+
+} // namespace NetCodec
@@ -0,0 +1,233 @@
+#pragma once
+//=============================================================================
+// net_codec.h
+//
+// Bit-packed, quantized wire codec for NetPlayerState, Snapshot and InputCmd.
+// Shared between game_client and game_server (maintain in sync).
+//
+// Separates the wire format from the in-memory layout: net_common.h structs
+// can change freely as long as this codec is updated on both sides.
+//
+// Quantization (round-to-nearest, values outside the range are clamped;
+// errors below are exact-arithmetic bounds, float rounding adds ~1 ulp):
+//
+//   Field          Range                      Bits  Max round-trip error
+//   -------------  -------------------------  ----  --------------------------
+//   position.x/z   MAP_WORLD_MIN/MAX (±128m)   16   256m / 65535 / 2 = 1.96mm
+//   position.y     MAP_WORLD_MIN/MAX (-1..31)  13    32m /  8191 / 2 = 1.96mm
+//   velocity.xyz   ±32 m/s                     13    64  /  8191 / 2 = 3.91mm/s
+//   yaw            [-pi, pi) wrapping          16   2pi  / 65536 / 2 = 4.8e-5 rad
+//   pitch          [-pi/2, pi/2]               16    pi  / 65535 / 2 = 2.4e-5 rad
+//   stateFlags     NetStateFlags (7 used)       7   exact
+//   health         uint8                        8   exact
+//   fireCounter    uint16                      16   exact
+//   tickId         varint, omitted if == snapshot tick           exact
+//   serverTime     varint microseconds                           0.5us
+//   ackInputTick   varint, zigzag delta vs. baseline if any      exact
+//   inputDepth     inputBufferDepth 0..15       4   exact, saturates at 15
+//
+// InputCmd (client -> server, see input_batch.h):
+//
+//   moveAxisX/Y    [-1, 1], 0 exact           8   1/127 / 2 = 3.9e-3
+//   yaw            [-pi, pi) wrapping          16   4.8e-5 rad
+//   pitch          [-pi/2, pi/2]               16   2.4e-5 rad
+//   buttons        InputButtons (6 used)        6   exact
+//   viewTimeMs     varint, zigzag delta vs. base in deltas       exact
+//
+// Full NetPlayerState: 148 bits (~19 bytes) vs. 44 bytes raw. One-shot
+// events (hits, kills) go on the reliable event channel, see net_event.h.
+// Position error is far below Player_Fps RESIM threshold (0.1m).
+//=============================================================================
+
+#include "net_common.h"
+#include "net_bitstream.h"
+#include "map_colliders.h"
+#include <cstddef>
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+// Per-field change mask for NetPlayerState deltas
+//-----------------------------------------------------------------------------
+namespace NetStateField {
+constexpr uint32_t TICK_ID      = 1 << 0;  // Only when != snapshot tickId
+constexpr uint32_t POS_X        = 1 << 1;
+constexpr uint32_t POS_Y        = 1 << 2;
+constexpr uint32_t POS_Z        = 1 << 3;
+constexpr uint32_t VEL_X        = 1 << 4;
+constexpr uint32_t VEL_Y        = 1 << 5;
+constexpr uint32_t VEL_Z        = 1 << 6;
+constexpr uint32_t YAW          = 1 << 7;
+constexpr uint32_t PITCH        = 1 << 8;
+constexpr uint32_t STATE_FLAGS  = 1 << 9;
+constexpr uint32_t HEALTH       = 1 << 10;
+constexpr uint32_t FIRE_COUNTER = 1 << 11;
+} // namespace NetStateField
+
+//-----------------------------------------------------------------------------
+// Per-field change mask for InputCmd deltas
+//-----------------------------------------------------------------------------
+namespace NetInputField {
+constexpr uint32_t MOVE    = 1 << 0;  // moveAxisX and moveAxisY
+constexpr uint32_t YAW     = 1 << 1;
+constexpr uint32_t PITCH   = 1 << 2;
+constexpr uint32_t BUTTONS = 1 << 3;
+constexpr uint32_t VIEW_TIME = 1 << 4;
+} // namespace NetInputField
+
+namespace NetCodec {
+
+//-----------------------------------------------------------------------------
+// Quantization ranges
+//-----------------------------------------------------------------------------
+struct QuantRange
+{
+    float min;
+    float max;
+    int   bits;
+
+    constexpr uint32_t MaxValue() const { return (bits >= 32) ? 0xFFFFFFFFu : ((1u << bits) - 1u); }
+    constexpr float Step() const { return (max - min) / static_cast<float>(MaxValue()); }
+    constexpr float MaxError() const { return Step() * 0.5f; }
+};
+
+constexpr QuantRange POS_X = { MAP_WORLD_MIN_X, MAP_WORLD_MAX_X, 16 };
+constexpr QuantRange POS_Y = { MAP_WORLD_MIN_Y, MAP_WORLD_MAX_Y, 13 };
+constexpr QuantRange POS_Z = { MAP_WORLD_MIN_Z, MAP_WORLD_MAX_Z, 16 };
+constexpr QuantRange VEL   = { -32.0f, 32.0f, 13 };
+constexpr QuantRange PITCH = { -DirectX::XM_PI * 0.5f, DirectX::XM_PI * 0.5f, 16 };
+constexpr int YAW_BITS          = 16;   // wraps, see QuantizeAngle
+constexpr int STATE_FLAG_BITS   = 7;    // NetStateFlags::IS_JUMPING .. IS_DEAD
+constexpr int TEAM_BITS         = 1;    // PlayerTeam::RED / BLUE
+constexpr int MOVE_AXIS_BITS    = 8;    // signed, see QuantizeAxis
+constexpr int INPUT_BUTTON_BITS = 6;    // InputButtons::JUMP .. SPRINT
+constexpr int INPUT_DEPTH_BITS  = 4;    // Snapshot::inputBufferDepth, saturates
+
+static_assert(NetStateFlags::IS_DEAD < (1u << STATE_FLAG_BITS),
+              "NetStateFlags grew - widen STATE_FLAG_BITS");
+static_assert(PlayerTeam::BLUE < (1u << TEAM_BITS),
+              "PlayerTeam grew - widen TEAM_BITS");
+static_assert(InputButtons::SPRINT < (1u << INPUT_BUTTON_BITS),
+              "InputButtons grew - widen INPUT_BUTTON_BITS");
+
+//-----------------------------------------------------------------------------
+// Scalar quantizers
+//-----------------------------------------------------------------------------
+uint32_t Quantize(float value, const QuantRange& range);
+float Dequantize(uint32_t q, const QuantRange& range);
+
+// Angle in radians, wrapped into [-pi, pi) before quantizing
+uint32_t QuantizeAngle(float radians, int bits);
+float DequantizeAngle(uint32_t q, int bits);
+
+// Axis in [-1, 1] mapped to 0..254 so that 0 and +-1 are exact
+uint32_t QuantizeAxis(float value);
+float DequantizeAxis(uint32_t q);
+
+//-----------------------------------------------------------------------------
+// Wire-domain values (also used by snapshot_entropy.cpp)
+//
+// Deltas compare these, never floats, so both sides agree on "unchanged".
+//-----------------------------------------------------------------------------
+struct QuantizedState
+{
+    uint32_t pos[3];
+    uint32_t vel[3];
+    uint32_t yaw;
+    uint32_t pitch;
+    uint32_t stateFlags;
+    uint8_t  health;
+    uint16_t fireCounter;
+};
+
+QuantizedState QuantizeState(const NetPlayerState& state);
+
+// Every field but tickId from its quantized value
+void DequantizeState(const QuantizedState& q, NetPlayerState& out);
+
+// Signed delta as an unsigned value (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...)
+uint32_t ZigZag(int32_t value);
+int32_t UnZigZag(uint32_t value);
+
+// Snapshot::serverTime on the wire
+uint64_t ToMicroseconds(double seconds);
+uint8_t SaturateInputDepth(uint8_t depth);
+
+//-----------------------------------------------------------------------------
+// Worst-case encoded sizes
+//-----------------------------------------------------------------------------
+constexpr size_t STATE_FIELD_MASK_BITS = 12;   // NetStateField bits
+constexpr size_t VARINT32_MAX_BITS = 40;
+constexpr size_t VARINT64_MAX_BITS = 80;
+constexpr size_t STATE_MAX_BITS =
+    STATE_FIELD_MASK_BITS + 1 + VARINT32_MAX_BITS +
+    16 + 13 + 16 + 3 * 13 + YAW_BITS + 16 + STATE_FLAG_BITS + 8 + 16;
+
+//-----------------------------------------------------------------------------
+// NetPlayerState
+//
+// Full:  every field (tickId only when it differs from snapshotTick).
+// Delta: NetStateField mask + only fields whose *quantized* value differs
+//        from base. base must itself be a decoded (dequantized) state so
+//        both sides compare identical values.
+//-----------------------------------------------------------------------------
+void WriteState(BitWriter& w, const NetPlayerState& state, uint32_t snapshotTick);
+void ReadState(BitReader& r, NetPlayerState& out, uint32_t snapshotTick);
+
+void WriteStateDelta(BitWriter& w, const NetPlayerState& state, const NetPlayerState& base,
+                     uint32_t snapshotTick);
+void ReadStateDelta(BitReader& r, NetPlayerState& out, const NetPlayerState& base,
+                    uint32_t snapshotTick);
+
+// Pass a state through wire precision (what the receiver will see)
+NetPlayerState RoundTrip(const NetPlayerState& state);
+
+//-----------------------------------------------------------------------------
+// Snapshot body (after any header owned by the caller)
+//
+// The caller transmits tickId in its header and must set out.tickId before
+// ReadSnapshot; per-player tickIds are encoded relative to it.
+//
+// With a baseline, the local player and every remote player present in the
+// baseline are delta-encoded; new players are written in full. Remote
+// entries are matched against the baseline in one forward pass, so cost is
+// linear in the players present as long as both list them in ascending
+// playerId order (an out-of-order entry is just sent in full).
+// Returns false on malformed input (check r.HasOverflow() as well).
+//-----------------------------------------------------------------------------
+void WriteSnapshot(BitWriter& w, const Snapshot& snapshot, const Snapshot* baseline);
+bool ReadSnapshot(BitReader& r, Snapshot& out, const Snapshot* baseline);
+
+// Bring a snapshot to wire precision in place, i.e. exactly what the
+// receiver will decode (for server-side baselines)
+void QuantizeSnapshot(Snapshot& snapshot);
+
+// Exact size of one remote entry as WriteSnapshot writes it, given the
+// baseline state it will be matched with (nullptr = written in full).
+// Used by the server to fit entries into a byte budget.
+size_t GetRemoteEntryBits(const RemotePlayerEntry& entry, const NetPlayerState* base,
+                          uint32_t snapshotTick);
+
+constexpr size_t SNAPSHOT_HEADER_MAX_BITS = VARINT64_MAX_BITS + 8 + TEAM_BITS + 8 + VARINT32_MAX_BITS + INPUT_DEPTH_BITS;
+constexpr size_t REMOTE_ENTRY_MAX_BITS = 8 + TEAM_BITS + STATE_MAX_BITS;
+constexpr size_t SNAPSHOT_MAX_BITS =
+    SNAPSHOT_HEADER_MAX_BITS + STATE_MAX_BITS + (MAX_PLAYERS - 1) * REMOTE_ENTRY_MAX_BITS;
+
+//-----------------------------------------------------------------------------
+// InputCmd (tickId is owned by the caller, see input_batch.h)
+//
+// Delta: NetInputField mask + only fields whose quantized value differs.
+//-----------------------------------------------------------------------------
+constexpr size_t INPUT_FIELD_MASK_BITS = 5;    // NetInputField bits
+constexpr size_t INPUT_CMD_MAX_BITS =
+    INPUT_FIELD_MASK_BITS + 2 * MOVE_AXIS_BITS + YAW_BITS + 16 + INPUT_BUTTON_BITS + VARINT32_MAX_BITS;
+
+void WriteInputCmd(BitWriter& w, const InputCmd& cmd);
+void ReadInputCmd(BitReader& r, InputCmd& out);
+
+void WriteInputCmdDelta(BitWriter& w, const InputCmd& cmd, const InputCmd& base);
+void ReadInputCmdDelta(BitReader& r, InputCmd& out, const InputCmd& base);
+
+// Pass a command through wire precision (what the server will simulate)
+InputCmd RoundTrip(const InputCmd& cmd);
+
+} // namespace NetCodec
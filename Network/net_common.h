@@ -11,7 +11,9 @@
 //=============================================================================
 
 #include <DirectXMath.h>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 
 //-----------------------------------------------------------------------------
@@ -25,6 +27,9 @@ constexpr uint32_t ADS = 1 << 2; // Aim Down Sights
 constexpr uint32_t RELOAD = 1 << 3;
 constexpr uint32_t INSPECT = 1 << 4;
 constexpr uint32_t SPRINT = 1 << 5;
+
+// Act once per press: a repeated input (server buffer underflow) drops them
+constexpr uint32_t ONE_SHOT = RELOAD | INSPECT;
 } // namespace InputButtons
 
 //-----------------------------------------------------------------------------
@@ -34,12 +39,13 @@ constexpr uint32_t SPRINT = 1 << 5;
 // Server will simulate movement based on these inputs.
 //-----------------------------------------------------------------------------
 struct InputCmd {
-  uint32_t tickId;  // Target server tick for this command
+  uint32_t tickId;  // Client input tick (increasing); the server acks it in Snapshot::ackInputTick
   float moveAxisX;  // Horizontal movement: -1.0 (A) to 1.0 (D)
   float moveAxisY;  // Forward movement: -1.0 (S) to 1.0 (W)
   float yaw;        // Camera horizontal angle (radians)
   float pitch;      // Camera vertical angle (radians)
   uint32_t buttons; // Bitfield of InputButtons
+  uint32_t viewTimeMs; // Server time (ms) remote players were rendered at, for lag compensation (0 = unknown)
 };
 
 //-----------------------------------------------------------------------------
@@ -67,14 +73,18 @@ struct NetPlayerState {
   float pitch;                // Camera pitch
   uint32_t stateFlags;        // Bitfield of StateFlags
   uint8_t  health;            // 0-200, server authoritative
-  uint8_t  hitByPlayerId;     // 0xFF = no hit, else attacker ID
+  uint8_t  padding;           // Hits are reliable NetEvents (net_event.h), not state
   uint16_t fireCounter;       // Server-tracked fire count
 };
 
 //-----------------------------------------------------------------------------
 // Multi-player constants
+//
+// Upper bound for one session (playerIds are 0..MAX_PLAYERS-1). Snapshots
+// reserve room for MAX_PLAYERS - 1 remote entries, but copying, encoding
+// and decoding only touch the remotePlayerCount entries actually present.
 //-----------------------------------------------------------------------------
-static constexpr uint8_t MAX_PLAYERS = 4;
+static constexpr uint8_t MAX_PLAYERS = 128;
 
 //-----------------------------------------------------------------------------
 // Team IDs
@@ -99,19 +109,49 @@ struct RemotePlayerEntry {
 //
 // Contains all authoritative state the client needs.
 //   localPlayer    — your own state (for client-side prediction correction)
+//   ackInputTick   — which of your inputs localPlayer is the result of, so
+//                    reconciliation rewinds to exactly that input
+//   inputBufferDepth — how many of your inputs the server had queued, for
+//                    the client's tick lead adjustment. 0 (with an ack)
+//                    means none had arrived: the server repeated the acked
+//                    input this tick, so localPlayer is that many steps past it
 //   remotePlayers  — other connected players' states (for RemotePlayer rendering)
+//
+// Variable length: only remotePlayers[0..remotePlayerCount) are valid. Copy
+// with CopySnapshot and size with GetSnapshotSize, never sizeof(Snapshot).
+// Entries should be in ascending playerId order (see NetCodec::WriteSnapshot).
 //-----------------------------------------------------------------------------
 struct Snapshot {
   uint32_t tickId;                                  // Server tick this snapshot represents
+  uint32_t ackInputTick;                            // Your newest input simulated (0 = none)
   double serverTime;                                // Server time
   NetPlayerState localPlayer;                       // Your authoritative state
   uint8_t localPlayerId;                            // Your player ID
   uint8_t remotePlayerCount;                        // Number of valid entries in remotePlayers[]
   uint8_t localPlayerTeam;                          // Your team (PlayerTeam::RED or BLUE)
-  uint8_t padding_snap[1];                          // Alignment
+  uint8_t inputBufferDepth;                         // Your inputs queued on the server at this tick
   RemotePlayerEntry remotePlayers[MAX_PLAYERS - 1]; // Other players' states
 };
 
+// Bytes of a Snapshot up to its last valid remote entry. The fixed part is
+// laid out exactly as the original 4-player struct (ackInputTick fills its
+// padding after tickId), so a raw SNAPSHOT packet is just these bytes.
+static constexpr size_t SNAPSHOT_HEADER_SIZE = offsetof(Snapshot, remotePlayers);
+
+constexpr size_t GetSnapshotSize(uint8_t remotePlayerCount)
+{
+  return SNAPSHOT_HEADER_SIZE +
+         (remotePlayerCount < MAX_PLAYERS - 1 ? remotePlayerCount : MAX_PLAYERS - 1) *
+             sizeof(RemotePlayerEntry);
+}
+
+// Copy the valid part of a snapshot (cost follows remotePlayerCount)
+inline void CopySnapshot(Snapshot& dst, const Snapshot& src)
+{
+  if (&dst == &src) return;
+  std::memcpy(&dst, &src, GetSnapshotSize(src.remotePlayerCount));
+}
+
 //-----------------------------------------------------------------------------
 // NetworkDebugInfo - Cached network state for debug display
 //
@@ -131,15 +171,20 @@ struct NetworkDebugInfo {
   // Tick delta tracking (gap between consecutive server ticks)
   uint32_t prevServerTick = 0;
   uint32_t tickDelta = 0;            // Should be 1 normally; >1 = missed ticks
+
+  // Time the last snapshot waited between packet arrival and consumption
+  double   snapshotWaitMs = 0.0;
 };
 
 //-----------------------------------------------------------------------------
-// Size guards for network serialization (memcpy)
+// Size guards for network serialization (field lists: net_schema.h)
 // If these fire, struct layout changed and both client/server must be updated.
 //-----------------------------------------------------------------------------
-static_assert(sizeof(InputCmd) == 24,
+static_assert(sizeof(InputCmd) == 28,
               "InputCmd size changed - update network serialization");
 static_assert(sizeof(NetPlayerState) == 44,
               "NetPlayerState size changed - update network serialization");
 static_assert(sizeof(RemotePlayerEntry) == 48,
               "RemotePlayerEntry size changed - update network serialization");
+static_assert(SNAPSHOT_HEADER_SIZE == 64,
+              "Snapshot header size changed - update network serialization");
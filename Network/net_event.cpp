@@ -0,0 +1,82 @@
+//=============================================================================
+// net_event.cpp
+//
+// Type-tagged, bit-packed gameplay event batches.
+//=============================================================================
+
+#include "net_event.h"
+#include "net_bitstream.h"
+
+namespace NetEvents {
+
+size_t WriteBatch(uint32_t tickId, const NetEvent* events, size_t count,
+                  uint8_t* out, size_t capacity)
+{
+    if (count == 0 || count > NET_EVENT_BATCH_MAX_EVENTS) return 0;
+
+    BitWriter w(out, capacity);
+    w.WriteVarint(tickId);
+    w.WriteVarint(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const NetEvent& e = events[i];
+        if (e.type >= NetEventType::COUNT) return 0;
+
+        w.WriteBits(static_cast<uint32_t>(e.type), NET_EVENT_TYPE_BITS);
+        w.WriteBits(e.playerId, NET_EVENT_PLAYER_BITS);
+
+        switch (e.type)
+        {
+        case NetEventType::HIT:
+            w.WriteBits(e.targetId, NET_EVENT_PLAYER_BITS);
+            w.WriteBits(e.damage, 8);
+            break;
+        case NetEventType::KILL:
+            w.WriteBits(e.targetId, NET_EVENT_PLAYER_BITS);
+            break;
+        default:
+            break;
+        }
+    }
+
+    return w.Finish();
+}
+
+size_t ReadBatch(const uint8_t* data, size_t size, NetEvent* outEvents, size_t maxEvents)
+{
+    BitReader r(data, size);
+    const uint32_t tickId = static_cast<uint32_t>(r.ReadVarint());
+    const uint64_t count = r.ReadVarint();
+    if (r.HasOverflow() || count == 0 || count > maxEvents) return 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        NetEvent& e = outEvents[i];
+        e = {};
+        e.tickId = tickId;
+
+        const uint32_t type = r.ReadBits(NET_EVENT_TYPE_BITS);
+        if (type >= static_cast<uint32_t>(NetEventType::COUNT)) return 0;
+        e.type = static_cast<NetEventType>(type);
+        e.playerId = static_cast<uint8_t>(r.ReadBits(NET_EVENT_PLAYER_BITS));
+
+        switch (e.type)
+        {
+        case NetEventType::HIT:
+            e.targetId = static_cast<uint8_t>(r.ReadBits(NET_EVENT_PLAYER_BITS));
+            e.damage = static_cast<uint8_t>(r.ReadBits(8));
+            break;
+        case NetEventType::KILL:
+            e.targetId = static_cast<uint8_t>(r.ReadBits(NET_EVENT_PLAYER_BITS));
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (r.HasOverflow() || !r.IsAtEnd()) return 0;
+    return static_cast<size_t>(count);
+}
+
+} // namespace NetEvents
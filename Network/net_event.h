@@ -0,0 +1,86 @@
+#pragma once
+//=============================================================================
+// net_event.h
+//
+// Reliable one-shot gameplay events: hits, kills, respawns, reloads.
+// Shared between game_client and game_server (maintain in sync).
+//
+// Snapshots carry state, which the next snapshot repeats; an event sent as
+// per-tick state is lost with the snapshot that carried it. Events
+// therefore go on their own reliable, ordered ENet channel
+// (NetChannel::EVENTS), separate from the unreliable snapshot stream:
+//   Server: collects the events of one tick and sends each client a single
+//           EVENT_BATCH with the ones relevant to it (only to clients that
+//           advertised NetClientCaps::GAME_EVENTS). Ticks without events
+//           send nothing.
+//   Client: decodes batches in arrival order, which the channel guarantees
+//           is tick order with none missing.
+//
+// Wire layout (bit-packed, after the PacketType byte):
+//   varint  tickId
+//   varint  count
+//   repeated count times:
+//     3 bits  NetEventType
+//     ...     fields of that type (playerIds are 7 bits):
+//       HIT              playerId (shooter), targetId, 8 bits damage
+//       KILL             playerId (killer), targetId (victim)
+//       RESPAWN          playerId
+//       RELOAD_COMPLETE  playerId
+//=============================================================================
+
+#include "net_common.h"
+#include <cstddef>
+#include <cstdint>
+
+enum class NetEventType : uint8_t
+{
+    HIT             = 0,    // playerId hit targetId for `damage`
+    KILL            = 1,    // playerId killed targetId
+    RESPAWN         = 2,    // playerId is alive again
+    RELOAD_COMPLETE = 3,    // playerId's magazine is full
+    COUNT
+};
+
+//-----------------------------------------------------------------------------
+// NetEvent - One decoded event (fields a type does not use are 0)
+//-----------------------------------------------------------------------------
+struct NetEvent
+{
+    uint32_t tickId;        // Server tick it happened on (the batch's tick)
+    NetEventType type;
+    uint8_t playerId;       // Shooter / killer, or the player it happened to
+    uint8_t targetId;       // HIT / KILL: player hit or killed
+    uint8_t damage;         // HIT: health taken
+};
+
+//-----------------------------------------------------------------------------
+// Size limits
+//-----------------------------------------------------------------------------
+static constexpr int NET_EVENT_TYPE_BITS = 3;
+static constexpr int NET_EVENT_PLAYER_BITS = 7;
+
+// Every player firing, killing, respawning and reloading in the same tick;
+// the batch header is two varints (40 bits each at most)
+static constexpr size_t NET_EVENT_BATCH_MAX_EVENTS = 4 * MAX_PLAYERS;
+static constexpr size_t NET_EVENT_MAX_BITS = NET_EVENT_TYPE_BITS + 2 * NET_EVENT_PLAYER_BITS + 8;
+static constexpr size_t NET_EVENT_BATCH_MAX_SIZE =
+    (2 * 40 + NET_EVENT_BATCH_MAX_EVENTS * NET_EVENT_MAX_BITS + 7) / 8;
+
+static_assert(static_cast<uint32_t>(NetEventType::COUNT) <= (1u << NET_EVENT_TYPE_BITS),
+              "NetEventType grew - widen NET_EVENT_TYPE_BITS");
+static_assert(MAX_PLAYERS <= (1u << NET_EVENT_PLAYER_BITS),
+              "MAX_PLAYERS grew - widen NET_EVENT_PLAYER_BITS");
+
+namespace NetEvents {
+
+// Encode one tick's events into out[0..capacity) without the PacketType
+// byte. Returns bytes written, 0 on error.
+size_t WriteBatch(uint32_t tickId, const NetEvent* events, size_t count,
+                  uint8_t* out, size_t capacity);
+
+// Decode an EVENT_BATCH payload into outEvents (tickId filled in from the
+// batch). Returns how many, 0 for malformed packets; empty batches are
+// never sent.
+size_t ReadBatch(const uint8_t* data, size_t size, NetEvent* outEvents, size_t maxEvents);
+
+} // namespace NetEvents
@@ -10,6 +10,44 @@
 
 enum class PacketType : uint8_t
 {
-    INPUT_CMD = 1,   // Client -> Server (contains InputCmd)
-    SNAPSHOT  = 2,   // Server -> Client (contains Snapshot)
+    INPUT_CMD      = 1,   // Client -> Server (contains InputCmd)
+    SNAPSHOT       = 2,   // Server -> Client (contains Snapshot)
+    SNAPSHOT_DELTA = 3,   // Server -> Client (delta vs. acked baseline, see snapshot_delta.h)
+    SNAPSHOT_ACK   = 4,   // Client -> Server (uint32 tickId of newest decoded snapshot)
+    INPUT_BATCH    = 5,   // Client -> Server (newest + redundant InputCmds, see input_batch.h)
+    SNAPSHOT_PART  = 6,   // Server -> Client (one piece of an oversized SNAPSHOT_DELTA, see snapshot_parts.h)
+    EVENT_BATCH    = 7,   // Server -> Client (one tick's gameplay events, reliable, see net_event.h)
+    BUNDLE         = 8,   // Both ways (several length-prefixed messages, see net_bundle.h)
+    SCHEMA         = 9,   // Both ways (u32 NET_SCHEMA_HASH, reliable on NetChannel::EVENTS, see net_schema.h)
+    TICK_RATE      = 10,  // Both ways (u16 Hz: client's request, server's answer; reliable on NetChannel::EVENTS, see net_tick.h)
+    CAPS           = 11,  // Server -> Client (u32 NetClientCaps the server honours for this session, reliable on NetChannel::EVENTS)
 };
+
+//-----------------------------------------------------------------------------
+// ENet channels. Everything is unreliable on SNAPSHOT except EVENT_BATCH,
+// SCHEMA, TICK_RATE and CAPS, which are reliable and ordered on their own
+// channel so a retransmit never holds back snapshots.
+//-----------------------------------------------------------------------------
+namespace NetChannel {
+constexpr uint8_t SNAPSHOT = 0;
+constexpr uint8_t EVENTS   = 1;
+constexpr uint8_t COUNT    = 2;
+} // namespace NetChannel
+
+//-----------------------------------------------------------------------------
+// Client capabilities, sent as the ENet connect data.
+// The server only uses optional encodings the client advertised. A server
+// that knows CAPS answers with the subset it honours; the client only uses
+// optional upstream encodings (BUNDLE) the server confirmed that way.
+//-----------------------------------------------------------------------------
+namespace NetClientCaps {
+constexpr uint32_t NONE           = 0;
+constexpr uint32_t SNAPSHOT_DELTA = 1 << 0;  // Understands SNAPSHOT_DELTA, sends SNAPSHOT_ACK
+constexpr uint32_t INPUT_BATCH    = 1 << 1;  // Sends INPUT_BATCH instead of INPUT_CMD
+constexpr uint32_t SNAPSHOT_PARTS = 1 << 2;  // Reassembles SNAPSHOT_PART (large sessions)
+constexpr uint32_t GAME_EVENTS    = 1 << 3;  // Understands EVENT_BATCH on NetChannel::EVENTS
+constexpr uint32_t BUNDLE         = 1 << 4;  // Unpacks BUNDLE; sends it once the server's CAPS confirms it
+constexpr uint32_t SNAPSHOT_ENTROPY = 1 << 5; // SNAPSHOT_DELTA carries ENTROPY_CODED (snapshot_delta.h)
+constexpr uint32_t SCHEMA_HASH    = 1 << 6;  // Sends SCHEMA on connect, expects the server's in reply
+constexpr uint32_t TICK_RATE      = 1 << 7;  // Sends TICK_RATE on connect, simulates at the server's answer
+} // namespace NetClientCaps
@@ -0,0 +1,580 @@
+#pragma once
+//=============================================================================
+// net_reflect.h
+//
+// Compile-time reflected serializer for fixed-layout network structs.
+// Shared between game_client and game_server (maintain in sync).
+//
+// A struct lists its fields once, in wire order, in a NetSchema<T>
+// specialization (field lists: net_schema.h):
+//
+//   template <> struct NetSchema<InputCmd>
+//   {
+//       static constexpr const char* NAME = "InputCmd";
+//       static constexpr auto FIELDS = std::make_tuple(
+//           NET_FIELD(InputCmd, tickId),
+//           NET_FIELD_Q(InputCmd, moveAxisX, NetQuant::Fixed<-1, 1, 127>),
+//           ...);
+//   };
+//
+// and the templates below generate, all inlined:
+//   Write / Read     little-endian, packed, no padding between fields
+//   WIRE_SIZE        bytes of the fixed part (MAX_WIRE_SIZE with arrays)
+//   HASH             FNV-1a over struct and field names, field types and
+//                    annotations: two builds share a layout iff they agree
+//
+// Field kinds:
+//   NET_FIELD(T, m)               integer or float scalar, array of them, or
+//                                 a nested struct with its own NetSchema
+//   NET_FIELD_Q(T, m, Quant)      float member stored through a quantizer
+//                                 (NetQuant::Fixed, NetQuant::Angle)
+//   NET_FIELD_COUNTED(T, m, n)    array of which only the first T::n
+//                                 elements go on the wire; must be the last
+//                                 field, with n listed before it
+//
+// A struct whose fields are all full width and add up to sizeof(T) has no
+// member missing from its list and no implicit padding. Its wire layout is
+// then its memory layout (IS_MEMCPY_LAYOUT), and little-endian targets copy
+// it in one piece, as fast as the memcpy it replaces.
+//=============================================================================
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(_WIN32) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define NET_REFLECT_LITTLE_ENDIAN 1
+#else
+#define NET_REFLECT_LITTLE_ENDIAN 0
+#endif
+
+// Specialized per struct with NAME and FIELDS (see above)
+template <typename T>
+struct NetSchema;
+
+#define NET_FIELD(Type, member) NetReflect::MakeField(&Type::member, #member)
+#define NET_FIELD_Q(Type, member, ...) NetReflect::MakeQuantizedField<__VA_ARGS__>(&Type::member, #member)
+#define NET_FIELD_COUNTED(Type, member, count) \
+    NetReflect::MakeCountedField(&Type::member, &Type::count, #member)
+
+namespace NetReflect {
+
+//-----------------------------------------------------------------------------
+// Schema hash (FNV-1a, 32-bit)
+//-----------------------------------------------------------------------------
+constexpr uint32_t HASH_SEED = 2166136261u;
+
+constexpr uint32_t HashByte(uint32_t hash, uint8_t byte)
+{
+    return (hash ^ byte) * 16777619u;
+}
+
+constexpr uint32_t HashU32(uint32_t hash, uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+        hash = HashByte(hash, static_cast<uint8_t>(value >> (8 * i)));
+    return hash;
+}
+
+// Includes the terminator, so "ab" + "c" and "a" + "bc" differ
+constexpr uint32_t HashString(uint32_t hash, const char* text)
+{
+    while (*text != '\0')
+        hash = HashByte(hash, static_cast<uint8_t>(*text++));
+    return HashByte(hash, 0);
+}
+
+//-----------------------------------------------------------------------------
+// Little-endian scalars
+//-----------------------------------------------------------------------------
+template <size_t SIZE> struct UintOfSize;
+template <> struct UintOfSize<1> { using Type = uint8_t; };
+template <> struct UintOfSize<2> { using Type = uint16_t; };
+template <> struct UintOfSize<4> { using Type = uint32_t; };
+template <> struct UintOfSize<8> { using Type = uint64_t; };
+
+template <typename T>
+inline void StoreLE(uint8_t* out, T value)
+{
+    static_assert(std::is_arithmetic<T>::value, "Scalars only");
+#if NET_REFLECT_LITTLE_ENDIAN
+    std::memcpy(out, &value, sizeof(T));
+#else
+    typename UintOfSize<sizeof(T)>::Type bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    for (size_t i = 0; i < sizeof(T); i++)
+        out[i] = static_cast<uint8_t>(bits >> (8 * i));
+#endif
+}
+
+template <typename T>
+inline T LoadLE(const uint8_t* in)
+{
+    static_assert(std::is_arithmetic<T>::value, "Scalars only");
+    T value;
+#if NET_REFLECT_LITTLE_ENDIAN
+    std::memcpy(&value, in, sizeof(T));
+#else
+    typename UintOfSize<sizeof(T)>::Type bits = 0;
+    for (size_t i = 0; i < sizeof(T); i++)
+        bits |= static_cast<decltype(bits)>(in[i]) << (8 * i);
+    std::memcpy(&value, &bits, sizeof(T));
+#endif
+    return value;
+}
+
+template <typename T> struct Struct;
+
+//-----------------------------------------------------------------------------
+// TypeCodec - Full-width encoding of one member type
+//-----------------------------------------------------------------------------
+template <typename T, typename = void>
+struct TypeCodec
+{
+    static_assert(sizeof(T) == 0, "Member type needs a NetSchema specialization");
+};
+
+// Scalars: integers and floats at their own width ('u', 'i' or 'f' + bytes)
+template <typename T>
+struct TypeCodec<T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>>
+{
+    static constexpr size_t WIRE_SIZE = sizeof(T);
+    static constexpr bool MEMCPY = true;
+
+    static constexpr uint32_t Hash(uint32_t hash)
+    {
+        const uint32_t kind = std::is_floating_point<T>::value ? 'f' : std::is_signed<T>::value ? 'i' : 'u';
+        return HashU32(hash, (kind << 8) | static_cast<uint32_t>(sizeof(T)));
+    }
+
+    static void Write(uint8_t* out, const T& value) { StoreLE(out, value); }
+    static void Read(const uint8_t* in, T& value) { value = LoadLE<T>(in); }
+};
+
+// Fixed arrays: every element
+template <typename T, size_t N>
+struct TypeCodec<T[N], void>
+{
+    using Element = TypeCodec<T>;
+    static constexpr size_t WIRE_SIZE = N * Element::WIRE_SIZE;
+    static constexpr bool MEMCPY = Element::MEMCPY;
+
+    static constexpr uint32_t Hash(uint32_t hash)
+    {
+        return Element::Hash(HashU32(HashByte(hash, '['), static_cast<uint32_t>(N)));
+    }
+
+    static void Write(uint8_t* out, const T (&value)[N])
+    {
+        if (MEMCPY && NET_REFLECT_LITTLE_ENDIAN)
+        {
+            std::memcpy(out, value, sizeof(value));
+            return;
+        }
+        for (size_t i = 0; i < N; i++)
+            Element::Write(out + i * Element::WIRE_SIZE, value[i]);
+    }
+
+    static void Read(const uint8_t* in, T (&value)[N])
+    {
+        if (MEMCPY && NET_REFLECT_LITTLE_ENDIAN)
+        {
+            std::memcpy(value, in, sizeof(value));
+            return;
+        }
+        for (size_t i = 0; i < N; i++)
+            Element::Read(in + i * Element::WIRE_SIZE, value[i]);
+    }
+};
+
+// Nested structs: their own field list, which must be fixed size
+template <typename T>
+struct TypeCodec<T, std::void_t<decltype(NetSchema<T>::FIELDS)>>
+{
+    static_assert(Struct<T>::IS_FIXED_SIZE, "Nested structs cannot hold counted arrays");
+    static constexpr size_t WIRE_SIZE = Struct<T>::WIRE_SIZE;
+    static constexpr bool MEMCPY = Struct<T>::IS_MEMCPY_LAYOUT;
+
+    static constexpr uint32_t Hash(uint32_t hash) { return HashU32(hash, Struct<T>::HASH); }
+    static void Write(uint8_t* out, const T& value) { Struct<T>::WriteFixed(value, out); }
+    static void Read(const uint8_t* in, T& value) { Struct<T>::ReadFixed(in, value); }
+};
+
+//-----------------------------------------------------------------------------
+// Field descriptors
+//
+// Fixed fields write and read exactly WIRE_SIZE bytes; the struct checks
+// the buffer once up front. Only a counted field varies (and validates).
+//-----------------------------------------------------------------------------
+template <typename Class, typename Member>
+struct Field
+{
+    using Codec = TypeCodec<Member>;
+    static constexpr size_t WIRE_SIZE = Codec::WIRE_SIZE;
+    static constexpr size_t MAX_WIRE_SIZE = WIRE_SIZE;
+    static constexpr bool MEMCPY = Codec::MEMCPY;
+    static constexpr bool COUNTED = false;
+
+    Member Class::* member;
+    const char* name;
+
+    constexpr uint32_t Hash(uint32_t hash) const { return Codec::Hash(HashString(hash, name)); }
+    bool IsValid(const Class&) const { return true; }
+    size_t GetWireSize(const Class&) const { return WIRE_SIZE; }
+
+    uint8_t* Write(const Class& object, uint8_t* out) const
+    {
+        Codec::Write(out, object.*member);
+        return out + WIRE_SIZE;
+    }
+
+    bool Read(const uint8_t*& in, const uint8_t*, Class& object) const
+    {
+        Codec::Read(in, object.*member);
+        in += WIRE_SIZE;
+        return true;
+    }
+};
+
+template <typename Class, typename Quant>
+struct QuantizedField
+{
+    using Wire = typename Quant::Wire;
+    static constexpr size_t WIRE_SIZE = sizeof(Wire);
+    static constexpr size_t MAX_WIRE_SIZE = WIRE_SIZE;
+    static constexpr bool MEMCPY = false;
+    static constexpr bool COUNTED = false;
+
+    float Class::* member;
+    const char* name;
+
+    constexpr uint32_t Hash(uint32_t hash) const { return Quant::Hash(HashString(hash, name)); }
+    bool IsValid(const Class&) const { return true; }
+    size_t GetWireSize(const Class&) const { return WIRE_SIZE; }
+
+    uint8_t* Write(const Class& object, uint8_t* out) const
+    {
+        StoreLE(out, Quant::Encode(object.*member));
+        return out + WIRE_SIZE;
+    }
+
+    bool Read(const uint8_t*& in, const uint8_t*, Class& object) const
+    {
+        object.*member = Quant::Decode(LoadLE<Wire>(in));
+        in += WIRE_SIZE;
+        return true;
+    }
+};
+
+template <typename Class, typename Element, size_t N, typename Count>
+struct CountedField
+{
+    using Codec = TypeCodec<Element>;
+    static constexpr size_t WIRE_SIZE = 0;
+    static constexpr size_t MAX_WIRE_SIZE = N * Codec::WIRE_SIZE;
+    static constexpr bool MEMCPY = false;
+    static constexpr bool COUNTED = true;
+
+    Element (Class::* member)[N];
+    Count Class::* count;
+    const char* name;
+
+    constexpr uint32_t Hash(uint32_t hash) const
+    {
+        return Codec::Hash(HashU32(HashByte(HashString(hash, name), '#'), static_cast<uint32_t>(N)));
+    }
+
+    bool IsValid(const Class& object) const { return static_cast<size_t>(object.*count) <= N; }
+    size_t GetWireSize(const Class& object) const { return static_cast<size_t>(object.*count) * Codec::WIRE_SIZE; }
+
+    uint8_t* Write(const Class& object, uint8_t* out) const
+    {
+        const size_t n = static_cast<size_t>(object.*count);
+        if (Codec::MEMCPY && NET_REFLECT_LITTLE_ENDIAN)
+        {
+            std::memcpy(out, object.*member, n * sizeof(Element));
+            return out + n * sizeof(Element);
+        }
+        for (size_t i = 0; i < n; i++)
+            Codec::Write(out + i * Codec::WIRE_SIZE, (object.*member)[i]);
+        return out + n * Codec::WIRE_SIZE;
+    }
+
+    // The count was read with the fields before this one
+    bool Read(const uint8_t*& in, const uint8_t* end, Class& object) const
+    {
+        const size_t n = static_cast<size_t>(object.*count);
+        if (n > N || static_cast<size_t>(end - in) < n * Codec::WIRE_SIZE) return false;
+        if (Codec::MEMCPY && NET_REFLECT_LITTLE_ENDIAN)
+        {
+            std::memcpy(object.*member, in, n * sizeof(Element));
+        }
+        else
+        {
+            for (size_t i = 0; i < n; i++)
+                Codec::Read(in + i * Codec::WIRE_SIZE, (object.*member)[i]);
+        }
+        in += n * Codec::WIRE_SIZE;
+        return true;
+    }
+};
+
+template <typename Class, typename Member>
+constexpr Field<Class, Member> MakeField(Member Class::* member, const char* name)
+{
+    return { member, name };
+}
+
+template <typename Quant, typename Class>
+constexpr QuantizedField<Class, Quant> MakeQuantizedField(float Class::* member, const char* name)
+{
+    return { member, name };
+}
+
+template <typename Class, typename Element, size_t N, typename Count>
+constexpr CountedField<Class, Element, N, Count> MakeCountedField(
+    Element (Class::* member)[N], Count Class::* count, const char* name)
+{
+    static_assert(std::is_integral<Count>::value, "Array count must be an integer member");
+    return { member, count, name };
+}
+
+//-----------------------------------------------------------------------------
+// Struct - Serializer generated from NetSchema<T>::FIELDS
+//-----------------------------------------------------------------------------
+template <typename Tuple> struct FieldListInfo;
+
+template <typename... F>
+struct FieldListInfo<std::tuple<F...>>
+{
+    static constexpr size_t WIRE_SIZE = (F::WIRE_SIZE + ... + 0);
+    static constexpr size_t MAX_WIRE_SIZE = (F::MAX_WIRE_SIZE + ... + 0);
+    static constexpr bool ALL_MEMCPY = (F::MEMCPY && ...);
+    static constexpr size_t COUNTED_FIELDS = (static_cast<size_t>(F::COUNTED) + ... + 0);
+
+    static constexpr bool IsCountedLast()
+    {
+        constexpr bool counted[] = { F::COUNTED..., false };
+        for (size_t i = 0; i + 1 < sizeof...(F); i++)
+            if (counted[i]) return false;
+        return true;
+    }
+};
+
+template <typename T, size_t... I>
+constexpr uint32_t HashSchema(std::index_sequence<I...>)
+{
+    uint32_t hash = HashString(HASH_SEED, NetSchema<T>::NAME);
+    ((hash = std::get<I>(NetSchema<T>::FIELDS).Hash(hash)), ...);
+    return hash;
+}
+
+template <typename T>
+struct Struct
+{
+private:
+    using Fields = std::decay_t<decltype(NetSchema<T>::FIELDS)>;
+    using Info = FieldListInfo<Fields>;
+    static constexpr size_t FIELD_COUNT = std::tuple_size<Fields>::value;
+    using Indices = std::make_index_sequence<FIELD_COUNT>;
+
+    static_assert(FIELD_COUNT > 0, "Empty field list");
+    static_assert(Info::COUNTED_FIELDS <= 1 && Info::IsCountedLast(),
+                  "A counted array must be the last field");
+
+    template <size_t... I>
+    static bool IsValid(const T& value, std::index_sequence<I...>)
+    {
+        return (std::get<I>(NetSchema<T>::FIELDS).IsValid(value) && ...);
+    }
+
+    template <size_t... I>
+    static size_t GetWireSize(const T& value, std::index_sequence<I...>)
+    {
+        return (std::get<I>(NetSchema<T>::FIELDS).GetWireSize(value) + ... + 0);
+    }
+
+    template <size_t... I>
+    static uint8_t* WriteFields(const T& value, uint8_t* out, std::index_sequence<I...>)
+    {
+        ((out = std::get<I>(NetSchema<T>::FIELDS).Write(value, out)), ...);
+        return out;
+    }
+
+    template <size_t... I>
+    static bool ReadFields(const uint8_t*& in, const uint8_t* end, T& value, std::index_sequence<I...>)
+    {
+        return (std::get<I>(NetSchema<T>::FIELDS).Read(in, end, value) && ...);
+    }
+
+public:
+    static constexpr size_t WIRE_SIZE = Info::WIRE_SIZE;           // Fixed part
+    static constexpr size_t MAX_WIRE_SIZE = Info::MAX_WIRE_SIZE;   // Counted array full
+    static constexpr bool IS_FIXED_SIZE = Info::COUNTED_FIELDS == 0;
+    static constexpr bool IS_MEMCPY_LAYOUT = IS_FIXED_SIZE && Info::ALL_MEMCPY && WIRE_SIZE == sizeof(T);
+    static constexpr uint32_t HASH = HashSchema<T>(Indices());
+
+    // Wire bytes of this value; 0 if a count exceeds its array
+    static size_t GetWireSize(const T& value)
+    {
+        if (!IsValid(value, Indices())) return 0;
+        return GetWireSize(value, Indices());
+    }
+
+    // Returns bytes written, 0 if the buffer is too small or a count
+    // exceeds its array
+    static size_t Write(const T& value, uint8_t* out, size_t capacity)
+    {
+        const size_t size = GetWireSize(value);
+        if (size == 0 || size > capacity) return 0;
+        if (IS_FIXED_SIZE)
+            WriteFixed(value, out);
+        else
+            WriteFields(value, out, Indices());
+        return size;
+    }
+
+    // Returns bytes consumed (trailing bytes are left alone), 0 if the data
+    // is too short or a count exceeds its array
+    static size_t Read(const uint8_t* data, size_t size, T& out)
+    {
+        if (size < WIRE_SIZE) return 0;
+        if (IS_FIXED_SIZE)
+        {
+            ReadFixed(data, out);
+            return WIRE_SIZE;
+        }
+
+        const uint8_t* in = data;
+        if (!ReadFields(in, data + size, out, Indices())) return 0;
+        return static_cast<size_t>(in - data);
+    }
+
+    // Fixed-size structs only, buffer of WIRE_SIZE bytes already checked
+    static void WriteFixed(const T& value, uint8_t* out)
+    {
+        if (IS_MEMCPY_LAYOUT && NET_REFLECT_LITTLE_ENDIAN)
+            std::memcpy(out, &value, sizeof(T));
+        else
+            WriteFields(value, out, Indices());
+    }
+
+    static void ReadFixed(const uint8_t* in, T& out)
+    {
+        if (IS_MEMCPY_LAYOUT && NET_REFLECT_LITTLE_ENDIAN)
+        {
+            std::memcpy(&out, in, sizeof(T));
+        }
+        else
+        {
+            const uint8_t* cursor = in;
+            ReadFields(cursor, in + WIRE_SIZE, out, Indices());
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Shorthands
+//-----------------------------------------------------------------------------
+template <typename T> constexpr size_t WIRE_SIZE = Struct<T>::WIRE_SIZE;
+template <typename T> constexpr size_t MAX_WIRE_SIZE = Struct<T>::MAX_WIRE_SIZE;
+template <typename T> constexpr bool IS_MEMCPY_LAYOUT = Struct<T>::IS_MEMCPY_LAYOUT;
+template <typename T> constexpr uint32_t HASH = Struct<T>::HASH;
+
+template <typename T>
+inline size_t Write(const T& value, uint8_t* out, size_t capacity)
+{
+    return Struct<T>::Write(value, out, capacity);
+}
+
+template <typename T>
+inline size_t Read(const uint8_t* data, size_t size, T& out)
+{
+    return Struct<T>::Read(data, size, out);
+}
+
+constexpr uint32_t CombineHash(uint32_t hash, uint32_t other)
+{
+    return HashU32(hash, other);
+}
+
+} // namespace NetReflect
+
+//-----------------------------------------------------------------------------
+// Quantizers for NET_FIELD_Q (float members)
+//
+// Each names its Wire integer type, Encode/Decode and a Hash of its
+// parameters. Encode never fails: out-of-range values clamp (or wrap for
+// angles) and NaN encodes as the lowest value.
+//-----------------------------------------------------------------------------
+namespace NetQuant {
+
+// [MIN, MAX] in steps of 1/SCALE, in the smallest unsigned type that fits
+template <int32_t MIN, int32_t MAX, uint32_t SCALE>
+struct Fixed
+{
+    static_assert(MIN < MAX && SCALE > 0, "Empty range");
+    static constexpr uint64_t STEPS = static_cast<uint64_t>(static_cast<int64_t>(MAX) - MIN) * SCALE;
+    static_assert(STEPS <= 0xFFFFFFFFu, "Range does not fit 32 bits");
+
+    using Wire = std::conditional_t<STEPS <= 0xFFu, uint8_t,
+                 std::conditional_t<STEPS <= 0xFFFFu, uint16_t, uint32_t>>;
+
+    static Wire Encode(float value)
+    {
+        const double steps = (static_cast<double>(value) - MIN) * SCALE;
+        if (!(steps > 0.0)) return 0;
+        if (steps >= static_cast<double>(STEPS)) return static_cast<Wire>(STEPS);
+        return static_cast<Wire>(steps + 0.5);
+    }
+
+    static float Decode(Wire wire)
+    {
+        const uint64_t steps = (wire < STEPS) ? wire : STEPS;
+        return static_cast<float>(static_cast<double>(steps) / SCALE + MIN);
+    }
+
+    static constexpr uint32_t Hash(uint32_t hash)
+    {
+        hash = NetReflect::HashU32(NetReflect::HashByte(hash, 'Q'), static_cast<uint32_t>(MIN));
+        return NetReflect::HashU32(NetReflect::HashU32(hash, static_cast<uint32_t>(MAX)), SCALE);
+    }
+};
+
+// Radians as a fraction of a turn over the full range of Wire (unsigned);
+// decodes to [-pi, pi)
+template <typename Wire_>
+struct Angle
+{
+    using Wire = Wire_;
+    static_assert(std::is_unsigned<Wire>::value && sizeof(Wire) <= 4, "Unsigned, up to 32 bits");
+    static constexpr double TWO_PI = 6.283185307179586;
+    static constexpr double STEPS = 256.0 * static_cast<double>(1ull << (8 * sizeof(Wire) - 8));
+
+    static Wire Encode(float radians)
+    {
+        double turns = static_cast<double>(radians) / TWO_PI;
+        if (!std::isfinite(turns)) return 0;
+        turns -= std::floor(turns);
+        // Rounds to STEPS for values just below a full turn: wraps to 0
+        return static_cast<Wire>(static_cast<uint64_t>(turns * STEPS + 0.5));
+    }
+
+    static float Decode(Wire wire)
+    {
+        using Signed = std::make_signed_t<Wire>;
+        const Signed steps = static_cast<Signed>(wire);
+        return static_cast<float>(steps * (TWO_PI / STEPS));
+    }
+
+    static constexpr uint32_t Hash(uint32_t hash)
+    {
+        return NetReflect::HashU32(NetReflect::HashByte(hash, 'A'), static_cast<uint32_t>(sizeof(Wire)));
+    }
+};
+
+} // namespace NetQuant
@@ -0,0 +1,106 @@
+#pragma once
+//=============================================================================
+// net_schema.h
+//
+// Field lists of the raw wire structs for the reflected serializer
+// (net_reflect.h): INPUT_CMD carries an InputCmd, SNAPSHOT a Snapshot
+// trimmed after its last valid remote entry.
+// Shared between game_client and game_server (maintain in sync).
+//
+// Everything is listed at full width in memory order, so the generated
+// layout is byte for byte the memcpy layout these packets always had, now
+// also on big-endian targets. NET_SCHEMA_HASH covers every list and is
+// exchanged at connect (PacketType::SCHEMA): a peer built from different
+// lists is refused instead of misreading every packet.
+//
+// Adding a struct member: list it here too. The IS_MEMCPY_LAYOUT checks
+// below fail until the list covers the struct again.
+//=============================================================================
+
+#include "net_common.h"
+#include "net_reflect.h"
+
+template <>
+struct NetSchema<DirectX::XMFLOAT3>
+{
+    static constexpr const char* NAME = "XMFLOAT3";
+    static constexpr auto FIELDS = std::make_tuple(
+        NET_FIELD(DirectX::XMFLOAT3, x),
+        NET_FIELD(DirectX::XMFLOAT3, y),
+        NET_FIELD(DirectX::XMFLOAT3, z));
+};
+
+template <>
+struct NetSchema<InputCmd>
+{
+    static constexpr const char* NAME = "InputCmd";
+    static constexpr auto FIELDS = std::make_tuple(
+        NET_FIELD(InputCmd, tickId),
+        NET_FIELD(InputCmd, moveAxisX),
+        NET_FIELD(InputCmd, moveAxisY),
+        NET_FIELD(InputCmd, yaw),
+        NET_FIELD(InputCmd, pitch),
+        NET_FIELD(InputCmd, buttons),
+        NET_FIELD(InputCmd, viewTimeMs));
+};
+
+template <>
+struct NetSchema<NetPlayerState>
+{
+    static constexpr const char* NAME = "NetPlayerState";
+    static constexpr auto FIELDS = std::make_tuple(
+        NET_FIELD(NetPlayerState, tickId),
+        NET_FIELD(NetPlayerState, position),
+        NET_FIELD(NetPlayerState, velocity),
+        NET_FIELD(NetPlayerState, yaw),
+        NET_FIELD(NetPlayerState, pitch),
+        NET_FIELD(NetPlayerState, stateFlags),
+        NET_FIELD(NetPlayerState, health),
+        NET_FIELD(NetPlayerState, padding),
+        NET_FIELD(NetPlayerState, fireCounter));
+};
+
+template <>
+struct NetSchema<RemotePlayerEntry>
+{
+    static constexpr const char* NAME = "RemotePlayerEntry";
+    static constexpr auto FIELDS = std::make_tuple(
+        NET_FIELD(RemotePlayerEntry, playerId),
+        NET_FIELD(RemotePlayerEntry, teamId),
+        NET_FIELD(RemotePlayerEntry, padding),
+        NET_FIELD(RemotePlayerEntry, state));
+};
+
+template <>
+struct NetSchema<Snapshot>
+{
+    static constexpr const char* NAME = "Snapshot";
+    static constexpr auto FIELDS = std::make_tuple(
+        NET_FIELD(Snapshot, tickId),
+        NET_FIELD(Snapshot, ackInputTick),
+        NET_FIELD(Snapshot, serverTime),
+        NET_FIELD(Snapshot, localPlayer),
+        NET_FIELD(Snapshot, localPlayerId),
+        NET_FIELD(Snapshot, remotePlayerCount),
+        NET_FIELD(Snapshot, localPlayerTeam),
+        NET_FIELD(Snapshot, inputBufferDepth),
+        NET_FIELD_COUNTED(Snapshot, remotePlayers, remotePlayerCount));
+};
+
+//-----------------------------------------------------------------------------
+// Layout guards: each list covers its struct, and the wire sizes are the
+// ones the memcpy serialization used
+//-----------------------------------------------------------------------------
+static_assert(NetReflect::IS_MEMCPY_LAYOUT<InputCmd>,
+              "InputCmd member missing from NetSchema");
+static_assert(NetReflect::IS_MEMCPY_LAYOUT<NetPlayerState>,
+              "NetPlayerState member missing from NetSchema");
+static_assert(NetReflect::IS_MEMCPY_LAYOUT<RemotePlayerEntry>,
+              "RemotePlayerEntry member missing from NetSchema");
+static_assert(NetReflect::WIRE_SIZE<Snapshot> == SNAPSHOT_HEADER_SIZE &&
+              NetReflect::MAX_WIRE_SIZE<Snapshot> == GetSnapshotSize(MAX_PLAYERS - 1),
+              "Snapshot member missing from NetSchema");
+
+// Exchanged at connect (PacketType::SCHEMA)
+constexpr uint32_t NET_SCHEMA_HASH =
+    NetReflect::CombineHash(NetReflect::HASH<InputCmd>, NetReflect::HASH<Snapshot>);
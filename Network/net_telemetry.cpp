@@ -0,0 +1,371 @@
+//=============================================================================
+// net_telemetry.cpp
+//
+// Log-linear histograms, mode counters and their CSV / JSON export.
+//=============================================================================
+
+#include "net_telemetry.h"
+#include "i_network.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+uint32_t FloorLog2(uint32_t value)
+{
+    uint32_t log = 0;
+    if (value >= 1u << 16) { value >>= 16; log += 16; }
+    if (value >= 1u << 8) { value >>= 8; log += 8; }
+    if (value >= 1u << 4) { value >>= 4; log += 4; }
+    if (value >= 1u << 2) { value >>= 2; log += 2; }
+    if (value >= 1u << 1) { log += 1; }
+    return log;
+}
+
+uint32_t ToSample(double value)
+{
+    if (!(value > 0.0)) return 0;
+    if (value >= 4294967295.0) return 0xFFFFFFFFu;
+    return static_cast<uint32_t>(value + 0.5);
+}
+
+const char* const METRIC_NAMES[NetTelemetry::METRIC_COUNT] = {
+    "bytes_up_per_s",
+    "bytes_down_per_s",
+    "packets_up_per_s",
+    "packets_down_per_s",
+    "snapshot_jitter_us",
+    "rtt_ms",
+};
+
+} // namespace
+
+//=============================================================================
+// LogLinearHistogram
+//=============================================================================
+
+void LogLinearHistogram::Reset()
+{
+    std::memset(m_Buckets, 0, sizeof(m_Buckets));
+    m_Count = 0;
+    m_Sum = 0;
+    m_Min = 0xFFFFFFFFu;
+    m_Max = 0;
+}
+
+void LogLinearHistogram::Record(uint32_t value)
+{
+    m_Buckets[GetBucketIndex(value)]++;
+    m_Count++;
+    m_Sum += value;
+    if (value < m_Min) m_Min = value;
+    if (value > m_Max) m_Max = value;
+}
+
+uint32_t LogLinearHistogram::GetBucketIndex(uint32_t value)
+{
+    if (value < 2 * SUB_BUCKETS) return value;
+
+    const uint32_t shift = FloorLog2(value) - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS);
+}
+
+uint32_t LogLinearHistogram::GetBucketLower(uint32_t index)
+{
+    if (index < 2 * SUB_BUCKETS) return index;
+
+    const uint32_t shift = index / SUB_BUCKETS - 1;
+    return (SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+}
+
+uint32_t LogLinearHistogram::GetBucketUpper(uint32_t index)
+{
+    if (index < 2 * SUB_BUCKETS) return index;
+
+    const uint32_t shift = index / SUB_BUCKETS - 1;
+    return GetBucketLower(index) + ((1u << shift) - 1);
+}
+
+uint32_t LogLinearHistogram::GetPercentile(double q) const
+{
+    if (m_Count == 0) return 0;
+
+    uint64_t target = static_cast<uint64_t>(std::ceil(q * static_cast<double>(m_Count)));
+    if (target < 1) target = 1;
+    if (target > m_Count) target = m_Count;
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += m_Buckets[i];
+        if (seen < target) continue;
+
+        const uint32_t lower = GetBucketLower(i);
+        uint32_t value = lower + (GetBucketUpper(i) - lower) / 2;
+        if (value < m_Min) value = m_Min;
+        if (value > m_Max) value = m_Max;
+        return value;
+    }
+    return m_Max;
+}
+
+//=============================================================================
+// NetModeCounter
+//=============================================================================
+
+void NetModeCounter::Reset()
+{
+    m_ModeCount = 0;
+    m_Other = 0;
+}
+
+void NetModeCounter::Count(const char* mode)
+{
+    if (!mode) return;
+
+    for (uint32_t i = 0; i < m_ModeCount; i++)
+    {
+        // Same literal almost always: skip the strcmp
+        if (m_Names[i] == mode || std::strcmp(m_Names[i], mode) == 0)
+        {
+            m_Counts[i]++;
+            return;
+        }
+    }
+
+    if (m_ModeCount == MAX_MODES)
+    {
+        m_Other++;
+        return;
+    }
+    m_Names[m_ModeCount] = mode;
+    m_Counts[m_ModeCount] = 1;
+    m_ModeCount++;
+}
+
+//=============================================================================
+// NetTelemetry
+//=============================================================================
+
+NetTelemetry::NetTelemetry()
+    : m_pFile(nullptr)
+    , m_Format(NetTelemetryFormat::CSV)
+    , m_Interval(10.0)
+{
+    Reset();
+}
+
+NetTelemetry::~NetTelemetry()
+{
+    Close();
+}
+
+void NetTelemetry::Reset()
+{
+    for (LogLinearHistogram& histogram : m_Histograms) histogram.Reset();
+    m_CorrectionModes.Reset();
+    m_SyncModes.Reset();
+
+    m_HasSnapshot = false;
+    m_LastArrival = 0.0;
+    m_LastServerTime = 0.0;
+
+    m_HasWindow = false;
+    m_WindowStart = 0.0;
+    std::memset(m_WindowCounters, 0, sizeof(m_WindowCounters));
+
+    m_StartTime = -1.0;
+    m_LastUpdate = 0.0;
+    m_NextDump = 0.0;
+    m_DumpCount = 0;
+}
+
+bool NetTelemetry::Open(const char* path, NetTelemetryFormat format, double interval)
+{
+    Close();
+    m_pFile = std::fopen(path, "w");
+    if (!m_pFile) return false;
+
+    m_Format = format;
+    m_Interval = (interval > 0.0) ? interval : 10.0;
+    if (m_Format == NetTelemetryFormat::CSV)
+        std::fputs("time_s,metric,count,min,mean,p50,p90,p99,max\n", m_pFile);
+
+    if (m_StartTime >= 0.0) m_NextDump = m_LastUpdate + m_Interval;
+    return true;
+}
+
+void NetTelemetry::Close()
+{
+    if (!m_pFile) return;
+
+    Dump(m_LastUpdate);
+    std::fclose(m_pFile);
+    m_pFile = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// OnSnapshot - Jitter against the previous newer-than-before snapshot
+//-----------------------------------------------------------------------------
+void NetTelemetry::OnSnapshot(double arrivalTime, double serverTime, uint32_t rttMs)
+{
+    // ENet reports 0 until the first round trip has been measured
+    if (rttMs > 0) m_Histograms[RTT_MS].Record(rttMs);
+
+    if (m_HasSnapshot)
+    {
+        // Stale or duplicate snapshots say nothing about spacing
+        if (serverTime <= m_LastServerTime) return;
+
+        const double deviation = (arrivalTime - m_LastArrival) - (serverTime - m_LastServerTime);
+        m_Histograms[SNAPSHOT_JITTER_US].Record(ToSample(std::fabs(deviation) * 1e6));
+    }
+
+    m_HasSnapshot = true;
+    m_LastArrival = arrivalTime;
+    m_LastServerTime = serverTime;
+}
+
+//-----------------------------------------------------------------------------
+// Update - Throughput once per THROUGHPUT_WINDOW, export every interval
+//-----------------------------------------------------------------------------
+void NetTelemetry::Update(double now, const INetwork* network)
+{
+    if (m_StartTime < 0.0)
+    {
+        m_StartTime = now;
+        m_NextDump = now + m_Interval;
+    }
+    m_LastUpdate = now;
+
+    if (network)
+    {
+        const uint64_t counters[4] = {
+            network->GetTotalBytesSent(),
+            network->GetTotalBytesReceived(),
+            network->GetTotalPacketsSent(),
+            network->GetTotalPacketsReceived(),
+        };
+
+        // Counters restart with the connection: start a new window
+        bool restarted = false;
+        for (int i = 0; i < 4; i++) restarted |= counters[i] < m_WindowCounters[i];
+
+        if (!m_HasWindow || restarted)
+        {
+            m_HasWindow = true;
+            m_WindowStart = now;
+            std::memcpy(m_WindowCounters, counters, sizeof(counters));
+        }
+        else if (now - m_WindowStart >= THROUGHPUT_WINDOW)
+        {
+            const double seconds = now - m_WindowStart;
+            for (int i = 0; i < 4; i++)
+            {
+                const double rate = static_cast<double>(counters[i] - m_WindowCounters[i]) / seconds;
+                m_Histograms[BYTES_UP_PER_SEC + i].Record(ToSample(rate));
+            }
+            m_WindowStart = now;
+            std::memcpy(m_WindowCounters, counters, sizeof(counters));
+        }
+    }
+
+    if (m_pFile && now >= m_NextDump)
+    {
+        Dump(now);
+        m_NextDump = now + m_Interval;
+    }
+}
+
+const char* NetTelemetry::GetMetricName(Metric metric)
+{
+    return (metric < METRIC_COUNT) ? METRIC_NAMES[metric] : "unknown";
+}
+
+bool NetTelemetry::Dump(double now)
+{
+    if (!m_pFile) return false;
+
+    const double time = (m_StartTime >= 0.0) ? now - m_StartTime : 0.0;
+    if (m_Format == NetTelemetryFormat::CSV)
+        WriteCsv(time);
+    else
+        WriteJson(time);
+
+    std::fflush(m_pFile);
+    m_DumpCount++;
+    return std::ferror(m_pFile) == 0;
+}
+
+//-----------------------------------------------------------------------------
+// WriteCsv - One row per metric, then one per mode (count column only)
+//-----------------------------------------------------------------------------
+void NetTelemetry::WriteCsv(double time)
+{
+    for (uint32_t i = 0; i < METRIC_COUNT; i++)
+    {
+        const LogLinearHistogram& h = m_Histograms[i];
+        std::fprintf(m_pFile, "%.3f,%s,%llu,%u,%.1f,%u,%u,%u,%u\n",
+                     time, METRIC_NAMES[i], static_cast<unsigned long long>(h.GetCount()),
+                     h.GetMin(), h.GetMean(), h.GetPercentile(0.50), h.GetPercentile(0.90),
+                     h.GetPercentile(0.99), h.GetMax());
+    }
+
+    const struct { const char* prefix; const NetModeCounter* modes; } counters[] = {
+        { "correction", &m_CorrectionModes },
+        { "sync", &m_SyncModes },
+    };
+    for (const auto& counter : counters)
+    {
+        for (uint32_t i = 0; i < counter.modes->GetModeCount(); i++)
+            std::fprintf(m_pFile, "%.3f,%s:%s,%llu,,,,,,\n", time, counter.prefix, counter.modes->GetName(i),
+                         static_cast<unsigned long long>(counter.modes->GetCount(i)));
+        if (counter.modes->GetOtherCount() > 0)
+            std::fprintf(m_pFile, "%.3f,%s:other,%llu,,,,,,\n", time, counter.prefix,
+                         static_cast<unsigned long long>(counter.modes->GetOtherCount()));
+    }
+}
+
+//-----------------------------------------------------------------------------
+// WriteJson - One object per line; buckets as [lower, count] pairs
+//-----------------------------------------------------------------------------
+void NetTelemetry::WriteJson(double time)
+{
+    std::fprintf(m_pFile, "{\"time_s\":%.3f,\"metrics\":{", time);
+    for (uint32_t i = 0; i < METRIC_COUNT; i++)
+    {
+        const LogLinearHistogram& h = m_Histograms[i];
+        std::fprintf(m_pFile, "%s\"%s\":{\"count\":%llu,\"min\":%u,\"mean\":%.1f,\"p50\":%u,\"p90\":%u,"
+                     "\"p99\":%u,\"max\":%u,\"buckets\":[",
+                     i ? "," : "", METRIC_NAMES[i], static_cast<unsigned long long>(h.GetCount()),
+                     h.GetMin(), h.GetMean(), h.GetPercentile(0.50), h.GetPercentile(0.90),
+                     h.GetPercentile(0.99), h.GetMax());
+
+        bool first = true;
+        for (uint32_t b = 0; b < LogLinearHistogram::BUCKET_COUNT; b++)
+        {
+            if (h.GetBucket(b) == 0) continue;
+            std::fprintf(m_pFile, "%s[%u,%u]", first ? "" : ",", LogLinearHistogram::GetBucketLower(b), h.GetBucket(b));
+            first = false;
+        }
+        std::fputs("]}", m_pFile);
+    }
+    std::fputs("}", m_pFile);
+
+    const struct { const char* key; const NetModeCounter* modes; } counters[] = {
+        { "correction_modes", &m_CorrectionModes },
+        { "sync_modes", &m_SyncModes },
+    };
+    for (const auto& counter : counters)
+    {
+        std::fprintf(m_pFile, ",\"%s\":{", counter.key);
+        for (uint32_t i = 0; i < counter.modes->GetModeCount(); i++)
+            std::fprintf(m_pFile, "%s\"%s\":%llu", i ? "," : "", counter.modes->GetName(i),
+                         static_cast<unsigned long long>(counter.modes->GetCount(i)));
+        if (counter.modes->GetOtherCount() > 0)
+            std::fprintf(m_pFile, "%s\"other\":%llu", counter.modes->GetModeCount() ? "," : "",
+                         static_cast<unsigned long long>(counter.modes->GetOtherCount()));
+        std::fputs("}", m_pFile);
+    }
+    std::fputs("}\n", m_pFile);
+}
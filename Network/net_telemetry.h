@@ -0,0 +1,179 @@
+#pragma once
+//=============================================================================
+// net_telemetry.h
+//
+// Client network telemetry for tuning tick rate and interpolation delay
+// from real sessions.
+//
+// Records, for the whole session:
+//   - bytes and packets per second in each direction (sampled once a second
+//     from the INetwork counters)
+//   - snapshot jitter: how far each inter-arrival interval strays from the
+//     server time between the two snapshots, |darrival - dserverTime|
+//   - RTT, one sample per snapshot
+//   - how often each local correction mode (Player_Fps::GetCorrectionMode)
+//     and remote sync mode (RemotePlayer::GetSyncMode) occurs
+//
+// Distributions go into fixed-size log-linear histograms: no allocation and
+// O(1) recording, at most 1/8 relative error on percentiles. Every
+// `interval` seconds (and on Close) the whole state is appended to the
+// export file as CSV rows or one JSON object per line.
+//=============================================================================
+
+#include <cstdint>
+#include <cstdio>
+
+class INetwork;
+
+//-----------------------------------------------------------------------------
+// LogLinearHistogram - Non-negative integer samples over the uint32 range
+//
+// Values below 16 get a bucket each; above, every power of two is split
+// into SUB_BUCKETS equal buckets.
+//-----------------------------------------------------------------------------
+class LogLinearHistogram
+{
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 3;
+    static constexpr uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr uint32_t BUCKET_COUNT = (32 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    LogLinearHistogram() { Reset(); }
+    void Reset();
+    void Record(uint32_t value);
+
+    uint64_t GetCount() const { return m_Count; }
+    uint32_t GetMin() const { return m_Count ? m_Min : 0; }
+    uint32_t GetMax() const { return m_Max; }
+    double GetMean() const { return m_Count ? static_cast<double>(m_Sum) / m_Count : 0.0; }
+
+    // Value at quantile q (0..1): middle of its bucket, clamped to [min, max]
+    uint32_t GetPercentile(double q) const;
+
+    uint32_t GetBucket(uint32_t index) const { return m_Buckets[index]; }
+    static uint32_t GetBucketIndex(uint32_t value);
+    static uint32_t GetBucketLower(uint32_t index);
+    static uint32_t GetBucketUpper(uint32_t index);     // Inclusive
+
+private:
+    uint32_t m_Buckets[BUCKET_COUNT];
+    uint64_t m_Count;
+    uint64_t m_Sum;
+    uint32_t m_Min;
+    uint32_t m_Max;
+};
+
+//-----------------------------------------------------------------------------
+// NetModeCounter - Occurrences per mode name (the game's mode strings)
+//-----------------------------------------------------------------------------
+class NetModeCounter
+{
+public:
+    static constexpr uint32_t MAX_MODES = 8;
+
+    void Reset();
+
+    // Names are compared by content and must outlive the counter (string
+    // literals). Names past MAX_MODES are counted as "other".
+    void Count(const char* mode);
+
+    uint32_t GetModeCount() const { return m_ModeCount; }
+    const char* GetName(uint32_t index) const { return m_Names[index]; }
+    uint64_t GetCount(uint32_t index) const { return m_Counts[index]; }
+    uint64_t GetOtherCount() const { return m_Other; }
+
+private:
+    const char* m_Names[MAX_MODES] = {};
+    uint64_t m_Counts[MAX_MODES] = {};
+    uint32_t m_ModeCount = 0;
+    uint64_t m_Other = 0;
+};
+
+enum class NetTelemetryFormat : uint8_t
+{
+    CSV,        // time_s,metric,count,min,mean,p50,p90,p99,max rows per dump
+    JSON,       // One object per dump and line, with histogram buckets
+};
+
+//-----------------------------------------------------------------------------
+// NetTelemetry
+//-----------------------------------------------------------------------------
+class NetTelemetry
+{
+public:
+    enum Metric : uint32_t
+    {
+        BYTES_UP_PER_SEC,
+        BYTES_DOWN_PER_SEC,
+        PACKETS_UP_PER_SEC,
+        PACKETS_DOWN_PER_SEC,
+        SNAPSHOT_JITTER_US,
+        RTT_MS,
+        METRIC_COUNT
+    };
+
+    static constexpr double THROUGHPUT_WINDOW = 1.0;     // Seconds per rate sample
+
+    NetTelemetry();
+    ~NetTelemetry();
+
+    void Reset();
+
+    // Export to `path` every `interval` seconds, truncating the file.
+    // Without Open the telemetry is only kept in memory.
+    bool Open(const char* path, NetTelemetryFormat format, double interval);
+    void Close();       // Writes a last dump
+    bool IsOpen() const { return m_pFile != nullptr; }
+
+    //-------------------------------------------------------------------------
+    // Recording (game thread)
+    //-------------------------------------------------------------------------
+    // Once per snapshot consumed, with its arrival time (NetClock seconds)
+    void OnSnapshot(double arrivalTime, double serverTime, uint32_t rttMs);
+    void CountCorrectionMode(const char* mode) { m_CorrectionModes.Count(mode); }
+    void CountSyncMode(const char* mode) { m_SyncModes.Count(mode); }
+
+    // Once per frame: throughput samples and periodic export. network may
+    // be null.
+    void Update(double now, const INetwork* network);
+
+    //-------------------------------------------------------------------------
+    // Results
+    //-------------------------------------------------------------------------
+    const LogLinearHistogram& GetHistogram(Metric metric) const { return m_Histograms[metric]; }
+    const NetModeCounter& GetCorrectionModes() const { return m_CorrectionModes; }
+    const NetModeCounter& GetSyncModes() const { return m_SyncModes; }
+    uint32_t GetDumpCount() const { return m_DumpCount; }
+
+    static const char* GetMetricName(Metric metric);
+
+    // Append the current state to the export file now
+    bool Dump(double now);
+
+private:
+    void WriteCsv(double time);
+    void WriteJson(double time);
+
+    LogLinearHistogram m_Histograms[METRIC_COUNT];
+    NetModeCounter m_CorrectionModes;
+    NetModeCounter m_SyncModes;
+
+    // Snapshot jitter
+    bool m_HasSnapshot;
+    double m_LastArrival;
+    double m_LastServerTime;
+
+    // Throughput window
+    bool m_HasWindow;
+    double m_WindowStart;
+    uint64_t m_WindowCounters[4];       // Bytes up/down, packets up/down at m_WindowStart
+
+    // Export
+    std::FILE* m_pFile;
+    NetTelemetryFormat m_Format;
+    double m_Interval;
+    double m_StartTime;                 // First Update (-1 = none yet)
+    double m_LastUpdate;
+    double m_NextDump;
+    uint32_t m_DumpCount;
+};
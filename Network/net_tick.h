@@ -0,0 +1,37 @@
+#pragma once
+//=============================================================================
+// net_tick.h
+//
+// Simulation tick rates. Shared between game_client and game_server
+// (maintain in sync).
+//
+// The server simulation, client prediction and every per-tick history run
+// at one rate per session. The client asks for a rate at connect
+// (PacketType::TICK_RATE) and adopts the one the server answers with;
+// servers that do not answer run DEFAULT. Histories indexed by tick are
+// sized for MAX, so they cover the same time span at every rate.
+//
+// Movement, timers and fire rates are per second and stepped by the tick
+// duration, so only the step size changes with the rate.
+//=============================================================================
+
+#include <cstdint>
+
+namespace NetTickRate {
+
+constexpr uint32_t DEFAULT = 32;    // Hz
+constexpr uint32_t MAX = 128;
+
+// 32, 64 or 128 Hz
+constexpr bool IsSupported(uint32_t hz)
+{
+    return hz == 32 || hz == 64 || hz == 128;
+}
+
+// Unsupported values (config typos, a confused peer) fall back to DEFAULT
+constexpr uint32_t Sanitize(uint32_t hz)
+{
+    return IsSupported(hz) ? hz : DEFAULT;
+}
+
+} // namespace NetTickRate
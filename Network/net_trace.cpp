@@ -0,0 +1,329 @@
+//=============================================================================
+// net_trace.cpp
+//
+// Trace file writer and reader (format in net_trace.h).
+//=============================================================================
+
+#include "net_trace.h"
+#include "net_bitstream.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+size_t PutVarint(uint8_t* out, uint64_t value)
+{
+    size_t size = 0;
+    do
+    {
+        uint8_t byte = static_cast<uint8_t>(value & 0x7F);
+        value >>= 7;
+        out[size++] = value ? static_cast<uint8_t>(byte | 0x80) : byte;
+    } while (value);
+    return size;
+}
+
+bool GetVarint(const uint8_t* data, size_t size, size_t& offset, uint64_t& outValue)
+{
+    outValue = 0;
+    for (int shift = 0; shift < 64 && offset < size; shift += 7)
+    {
+        uint8_t byte = data[offset++];
+        outValue |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+//=============================================================================
+// TraceWriter
+//=============================================================================
+
+bool TraceWriter::Open(const char* path)
+{
+    Close();
+    m_pFile = std::fopen(path, "wb");
+    if (!m_pFile) return false;
+
+    uint8_t header[NetTrace::FILE_HEADER_SIZE] = {};
+    std::memcpy(header, NetTrace::MAGIC, sizeof(NetTrace::MAGIC));
+    header[4] = static_cast<uint8_t>(NetTrace::VERSION & 0xFF);
+    header[5] = static_cast<uint8_t>(NetTrace::VERSION >> 8);
+    std::memcpy(m_Buffer, header, sizeof(header));
+    m_BufferSize = sizeof(header);
+
+    m_Started = false;
+    m_LastMicros = 0;
+    m_RecordCount = 0;
+    m_BytesWritten = 0;
+    m_PrevInput = {};
+    m_HasPrevSnapshot = false;
+    return true;
+}
+
+void TraceWriter::Close()
+{
+    if (!m_pFile) return;
+    Flush();
+    std::fclose(m_pFile);
+    m_pFile = nullptr;
+}
+
+void TraceWriter::Flush()
+{
+    if (m_BufferSize == 0) return;
+    std::fwrite(m_Buffer, 1, m_BufferSize, m_pFile);
+    m_BytesWritten += m_BufferSize;
+    m_BufferSize = 0;
+}
+
+uint64_t TraceWriter::ElapsedMicros(double time)
+{
+    if (!m_Started)
+    {
+        m_StartTime = time;
+        m_Started = true;
+    }
+    double elapsed = time - m_StartTime;
+    uint64_t micros = (elapsed > 0.0) ? static_cast<uint64_t>(std::llround(elapsed * 1000000.0)) : 0;
+    if (micros < m_LastMicros) micros = m_LastMicros;    // Keep records in time order
+
+    uint64_t dt = micros - m_LastMicros;
+    m_LastMicros = micros;
+    return dt;
+}
+
+void TraceWriter::Append(TraceRecordType type, uint64_t dt, const uint8_t* payload, size_t size)
+{
+    if (m_BufferSize + NetTrace::RECORD_HEADER_MAX_SIZE + size > BUFFER_SIZE)
+        Flush();
+
+    m_Buffer[m_BufferSize++] = static_cast<uint8_t>(type);
+    m_BufferSize += PutVarint(m_Buffer + m_BufferSize, dt);
+    m_BufferSize += PutVarint(m_Buffer + m_BufferSize, size);
+    std::memcpy(m_Buffer + m_BufferSize, payload, size);
+    m_BufferSize += size;
+    m_RecordCount++;
+}
+
+void TraceWriter::WriteInput(double time, const InputCmd& cmd)
+{
+    if (!m_pFile) return;
+
+    BitWriter w(m_Payload, sizeof(m_Payload));
+    w.WriteVarint(cmd.tickId);
+    NetCodec::WriteInputCmdDelta(w, cmd, m_PrevInput);
+    size_t size = w.Finish();
+    if (size == 0) return;
+
+    m_PrevInput = NetCodec::RoundTrip(cmd);
+    Append(TraceRecordType::INPUT, ElapsedMicros(time), m_Payload, size);
+}
+
+void TraceWriter::WriteSnapshot(double time, double arrivalTime, const Snapshot& snapshot)
+{
+    if (!m_pFile) return;
+
+    uint64_t wait = 0;
+    if (arrivalTime >= 0.0)
+    {
+        double waited = time - arrivalTime;
+        wait = 1 + ((waited > 0.0) ? static_cast<uint64_t>(std::llround(waited * 1000000.0)) : 0);
+    }
+
+    const Snapshot* baseline = m_HasPrevSnapshot ? &m_PrevSnapshot : nullptr;
+    BitWriter w(m_Payload, sizeof(m_Payload));
+    w.WriteVarint(wait);
+    w.WriteVarint(snapshot.tickId);
+    NetCodec::WriteSnapshot(w, snapshot, baseline);
+    size_t size = w.Finish();
+    if (size == 0) return;
+
+    // Baseline is what the reader will decode
+    CopySnapshot(m_PrevSnapshot, snapshot);
+    NetCodec::QuantizeSnapshot(m_PrevSnapshot);
+    m_HasPrevSnapshot = true;
+
+    Append(TraceRecordType::SNAPSHOT, ElapsedMicros(time), m_Payload, size);
+}
+
+void TraceWriter::WriteTickRate(double time, uint32_t hz)
+{
+    if (!m_pFile) return;
+
+    BitWriter w(m_Payload, sizeof(m_Payload));
+    w.WriteVarint(hz);
+    size_t size = w.Finish();
+    if (size == 0) return;
+
+    Append(TraceRecordType::TICK_RATE, ElapsedMicros(time), m_Payload, size);
+}
+
+void TraceWriter::WriteEvent(double time, const NetEvent& event)
+{
+    if (!m_pFile) return;
+
+    size_t size = NetEvents::WriteBatch(event.tickId, &event, 1, m_Payload, sizeof(m_Payload));
+    if (size == 0) return;
+
+    Append(TraceRecordType::EVENT, ElapsedMicros(time), m_Payload, size);
+}
+
+//=============================================================================
+// TraceReader
+//=============================================================================
+
+bool TraceReader::Open(const char* path)
+{
+    m_Data.clear();
+    std::FILE* pFile = std::fopen(path, "rb");
+    if (!pFile) return false;
+
+    uint8_t chunk[64 * 1024];
+    size_t read;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), pFile)) > 0)
+        m_Data.insert(m_Data.end(), chunk, chunk + read);
+    std::fclose(pFile);
+
+    if (m_Data.size() < NetTrace::FILE_HEADER_SIZE ||
+        std::memcmp(m_Data.data(), NetTrace::MAGIC, sizeof(NetTrace::MAGIC)) != 0 ||
+        static_cast<uint16_t>(m_Data[4] | (m_Data[5] << 8)) != NetTrace::VERSION)
+    {
+        m_Data.clear();
+        return false;
+    }
+
+    Rewind();
+    return true;
+}
+
+void TraceReader::Rewind()
+{
+    m_Offset = NetTrace::FILE_HEADER_SIZE;
+    m_Error = false;
+    m_HavePeek = false;
+    m_Micros = 0;
+    m_PrevInput = {};
+    m_HasPrevSnapshot = false;
+}
+
+bool TraceReader::ReadHeader()
+{
+    if (m_HavePeek) return true;
+    if (m_Error || m_Offset >= m_Data.size()) return false;
+
+    const uint8_t* data = m_Data.data();
+    size_t offset = m_Offset;
+    uint8_t type = data[offset++];
+    uint64_t dt, size;
+    // A truncated last record (the recording process died) ends the trace
+    if (!GetVarint(data, m_Data.size(), offset, dt) ||
+        !GetVarint(data, m_Data.size(), offset, size) ||
+        size > m_Data.size() - offset)
+    {
+        return false;
+    }
+    if (type != static_cast<uint8_t>(TraceRecordType::INPUT) &&
+        type != static_cast<uint8_t>(TraceRecordType::SNAPSHOT) &&
+        type != static_cast<uint8_t>(TraceRecordType::TICK_RATE) &&
+        type != static_cast<uint8_t>(TraceRecordType::EVENT))
+    {
+        m_Error = true;
+        return false;
+    }
+
+    m_PeekType = static_cast<TraceRecordType>(type);
+    m_PeekMicros = m_Micros + dt;
+    m_PayloadOffset = offset;
+    m_PayloadSize = static_cast<size_t>(size);
+    m_HavePeek = true;
+    return true;
+}
+
+bool TraceReader::Peek(TraceRecordType& outType, double& outTime)
+{
+    if (!ReadHeader()) return false;
+    outType = m_PeekType;
+    outTime = static_cast<double>(m_PeekMicros) / 1000000.0;
+    return true;
+}
+
+bool TraceReader::ReadInput(InputCmd& outCmd)
+{
+    if (!ReadHeader() || m_PeekType != TraceRecordType::INPUT) return false;
+
+    BitReader r(m_Data.data() + m_PayloadOffset, m_PayloadSize);
+    outCmd.tickId = static_cast<uint32_t>(r.ReadVarint());
+    NetCodec::ReadInputCmdDelta(r, outCmd, m_PrevInput);
+    if (r.HasOverflow())
+    {
+        m_Error = true;
+        return false;
+    }
+
+    m_PrevInput = outCmd;
+    m_Micros = m_PeekMicros;
+    m_Offset = m_PayloadOffset + m_PayloadSize;
+    m_HavePeek = false;
+    return true;
+}
+
+bool TraceReader::ReadSnapshot(Snapshot& outSnapshot, double& outArrivalTime)
+{
+    if (!ReadHeader() || m_PeekType != TraceRecordType::SNAPSHOT) return false;
+
+    BitReader r(m_Data.data() + m_PayloadOffset, m_PayloadSize);
+    uint64_t wait = r.ReadVarint();
+    outSnapshot.tickId = static_cast<uint32_t>(r.ReadVarint());
+    if (!NetCodec::ReadSnapshot(r, outSnapshot, m_HasPrevSnapshot ? &m_PrevSnapshot : nullptr))
+    {
+        m_Error = true;
+        return false;
+    }
+
+    const double time = static_cast<double>(m_PeekMicros) / 1000000.0;
+    outArrivalTime = wait ? time - static_cast<double>(wait - 1) / 1000000.0 : -1.0;
+
+    CopySnapshot(m_PrevSnapshot, outSnapshot);
+    m_HasPrevSnapshot = true;
+    m_Micros = m_PeekMicros;
+    m_Offset = m_PayloadOffset + m_PayloadSize;
+    m_HavePeek = false;
+    return true;
+}
+
+bool TraceReader::ReadTickRate(uint32_t& outHz)
+{
+    if (!ReadHeader() || m_PeekType != TraceRecordType::TICK_RATE) return false;
+
+    BitReader r(m_Data.data() + m_PayloadOffset, m_PayloadSize);
+    outHz = static_cast<uint32_t>(r.ReadVarint());
+    if (r.HasOverflow())
+    {
+        m_Error = true;
+        return false;
+    }
+
+    m_Micros = m_PeekMicros;
+    m_Offset = m_PayloadOffset + m_PayloadSize;
+    m_HavePeek = false;
+    return true;
+}
+
+bool TraceReader::ReadEvent(NetEvent& outEvent)
+{
+    if (!ReadHeader() || m_PeekType != TraceRecordType::EVENT) return false;
+
+    if (NetEvents::ReadBatch(m_Data.data() + m_PayloadOffset, m_PayloadSize, &outEvent, 1) != 1)
+    {
+        m_Error = true;
+        return false;
+    }
+
+    m_Micros = m_PeekMicros;
+    m_Offset = m_PayloadOffset + m_PayloadSize;
+    m_HavePeek = false;
+    return true;
+}
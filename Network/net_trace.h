@@ -0,0 +1,152 @@
+#pragma once
+//=============================================================================
+// net_trace.h
+//
+// Binary trace of one client session: every InputCmd the game sent and
+// every Snapshot and gameplay event it received, with microsecond
+// timestamps.
+//
+// File layout:
+//   header:  "TOTR", u16 version (little-endian), u16 reserved
+//   records: u8 type, varint dt, varint payload bytes, payload
+//
+// dt is microseconds since the previous record (the first record is at 0).
+// Payloads are BitWriter streams using the wire codec:
+//   INPUT:     varint tickId, InputCmd delta against the previous input
+//   SNAPSHOT:  varint wait (us between arrival and consumption, +1; 0 = no
+//              arrival time), varint tickId, snapshot body delta against
+//              the previous snapshot (NetCodec::WriteSnapshot)
+//   TICK_RATE: varint Hz the following snapshots were simulated at
+//   EVENT:     one NetEvent as a one-event EVENT_BATCH payload (NetEvents)
+//
+// Everything is stored at wire precision, so a trace of an ENet session
+// replays bit-exact; mock sessions without delta encoding are rounded to
+// what the wire would have carried. A record cut off by a crash ends the
+// trace cleanly.
+//=============================================================================
+
+#include "net_common.h"
+#include "net_codec.h"
+#include "net_event.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+enum class TraceRecordType : uint8_t
+{
+    INPUT = 1,
+    SNAPSHOT = 2,
+    TICK_RATE = 3,
+    EVENT = 4,
+};
+
+namespace NetTrace {
+
+constexpr char MAGIC[4] = { 'T', 'O', 'T', 'R' };
+constexpr uint16_t VERSION = 7;    // 2: snapshots carry ackInputTick, 3: inputBufferDepth, 4: InputCmd::viewTimeMs, 5: no hitByPlayerId, 6: TICK_RATE records, 7: EVENT records
+constexpr size_t FILE_HEADER_SIZE = 8;
+constexpr size_t RECORD_HEADER_MAX_SIZE = 1 + 10 + 5;     // type, dt, size
+constexpr size_t RECORD_MAX_PAYLOAD =
+    (NetCodec::VARINT64_MAX_BITS + NetCodec::VARINT32_MAX_BITS + NetCodec::SNAPSHOT_MAX_BITS + 7) / 8;
+
+} // namespace NetTrace
+
+//-----------------------------------------------------------------------------
+// TraceWriter - Encodes records into a buffer, flushed to the file in blocks
+//-----------------------------------------------------------------------------
+class TraceWriter
+{
+public:
+    TraceWriter() = default;
+    ~TraceWriter() { Close(); }
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    bool Open(const char* path);
+    void Close();
+    bool IsOpen() const { return m_pFile != nullptr; }
+
+    // time / arrivalTime are NetClock seconds; arrivalTime < 0 = unknown
+    void WriteInput(double time, const InputCmd& cmd);
+    void WriteSnapshot(double time, double arrivalTime, const Snapshot& snapshot);
+    void WriteTickRate(double time, uint32_t hz);
+    void WriteEvent(double time, const NetEvent& event);
+
+    uint32_t GetRecordCount() const { return m_RecordCount; }
+    uint64_t GetBytesWritten() const { return m_BytesWritten + m_BufferSize; }
+
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+private:
+    uint64_t ElapsedMicros(double time);
+    void Append(TraceRecordType type, uint64_t dt, const uint8_t* payload, size_t size);
+    void Flush();
+
+    std::FILE* m_pFile = nullptr;
+    uint8_t m_Buffer[BUFFER_SIZE];
+    size_t m_BufferSize = 0;
+    uint8_t m_Payload[NetTrace::RECORD_MAX_PAYLOAD];
+
+    double m_StartTime = 0.0;
+    uint64_t m_LastMicros = 0;
+    bool m_Started = false;
+    uint32_t m_RecordCount = 0;
+    uint64_t m_BytesWritten = 0;
+
+    // Delta baselines, at wire precision
+    InputCmd m_PrevInput = {};
+    Snapshot m_PrevSnapshot;
+    bool m_HasPrevSnapshot = false;
+};
+
+//-----------------------------------------------------------------------------
+// TraceReader - Whole trace in memory, read one record at a time
+//
+//   while (reader.Peek(type, time))
+//       type == INPUT ? reader.ReadInput(cmd) : reader.ReadSnapshot(snap, arrival);
+//
+// TICK_RATE records (type 3) are read with ReadTickRate, EVENT records
+// (type 4) with ReadEvent.
+//-----------------------------------------------------------------------------
+class TraceReader
+{
+public:
+    bool Open(const char* path);
+
+    // Back to the first record
+    void Rewind();
+
+    // Type and time (seconds since the first record) of the next record;
+    // false at the end of the trace or on a malformed record
+    bool Peek(TraceRecordType& outType, double& outTime);
+
+    // Consume the record Peek reported. arrivalTime is in trace seconds,
+    // or < 0 if it was not recorded.
+    bool ReadInput(InputCmd& outCmd);
+    bool ReadSnapshot(Snapshot& outSnapshot, double& outArrivalTime);
+    bool ReadTickRate(uint32_t& outHz);
+    bool ReadEvent(NetEvent& outEvent);
+
+    bool HasError() const { return m_Error; }
+    size_t GetSize() const { return m_Data.size(); }
+
+private:
+    bool ReadHeader();
+
+    std::vector<uint8_t> m_Data;
+    size_t m_Offset = 0;
+    bool m_Error = false;
+
+    // Header of the record at m_Offset (valid while m_HavePeek)
+    bool m_HavePeek = false;
+    TraceRecordType m_PeekType = TraceRecordType::INPUT;
+    uint64_t m_PeekMicros = 0;
+    size_t m_PayloadOffset = 0;
+    size_t m_PayloadSize = 0;
+
+    uint64_t m_Micros = 0;
+    InputCmd m_PrevInput = {};
+    Snapshot m_PrevSnapshot;
+    bool m_HasPrevSnapshot = false;
+};
@@ -0,0 +1,250 @@
+//=============================================================================
+// netsim_network.cpp
+//
+// Latency / jitter / loss / duplication / reordering / bandwidth simulation
+// around any INetwork backend.
+//=============================================================================
+
+#include "netsim_network.h"
+#include "net_clock.h"
+#include "net_schema.h"
+
+namespace {
+
+// IPv4 + UDP headers, counted against the bandwidth cap
+constexpr size_t UDP_IP_HEADER_BYTES = 28;
+
+// Separates the downstream RNG stream from the upstream one
+constexpr uint64_t DOWNSTREAM_SEED_SALT = 0x9E3779B97F4A7C15ull;
+
+} // namespace
+
+//=============================================================================
+// NetSimLink
+//=============================================================================
+
+void NetSimLink::Reset(uint64_t seed)
+{
+    m_Stats = {};
+    m_RandomState = seed;
+    m_LinkFreeAt = 0.0;
+    m_LastRelease = 0.0;
+}
+
+//-----------------------------------------------------------------------------
+// NextFloat - splitmix64, top 24 bits as a float in [0, 1)
+//
+// Self-contained so a seed gives the same sequence on every compiler
+// (std:: distributions are implementation-defined).
+//-----------------------------------------------------------------------------
+float NetSimLink::NextFloat()
+{
+    uint64_t z = (m_RandomState += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z = z ^ (z >> 31);
+    return static_cast<float>(z >> 40) * (1.0f / 16777216.0f);
+}
+
+int NetSimLink::Schedule(double now, size_t bytes, double outRelease[2])
+{
+    // Always draw the same values so each packet's fate depends only on the
+    // seed and its position in the sequence
+    const float rLoss = NextFloat();
+    const float rJitter = NextFloat();
+    const float rReorder = NextFloat();
+    const float rDuplicate = NextFloat();
+    const float rDuplicateJitter = NextFloat();
+
+    m_Stats.offered++;
+
+    const bool duplicate = rDuplicate < m_Settings.duplicate;
+    const int copies = duplicate ? 2 : 1;
+
+    // Bandwidth cap: packets leave one after another at the link rate
+    double departure = now;
+    if (m_Settings.bandwidthKbps > 0.0f)
+    {
+        double start = (m_LinkFreeAt > now) ? m_LinkFreeAt : now;
+        if (start - now > MAX_BACKLOG)
+        {
+            m_Stats.overflowed++;
+            return 0;
+        }
+        double wireBits = static_cast<double>((bytes + UDP_IP_HEADER_BYTES) * copies) * 8.0;
+        m_LinkFreeAt = start + wireBits / (m_Settings.bandwidthKbps * 1000.0);
+        departure = m_LinkFreeAt;
+    }
+
+    if (rLoss < m_Settings.loss)
+    {
+        m_Stats.lost++;
+        return 0;
+    }
+
+    double delayMs = m_Settings.latencyMs + (rJitter * 2.0f - 1.0f) * m_Settings.jitterMs;
+    if (delayMs < 0.0) delayMs = 0.0;
+    double release = departure + delayMs / 1000.0;
+
+    if (rReorder < m_Settings.reorder)
+    {
+        // Held back; does not move the in-order watermark
+        release += m_Settings.reorderMs / 1000.0;
+        m_Stats.reordered++;
+    }
+    else
+    {
+        // Jitter alone never reorders
+        if (release < m_LastRelease) release = m_LastRelease;
+        m_LastRelease = release;
+    }
+
+    outRelease[0] = release;
+    if (duplicate)
+    {
+        outRelease[1] = release + rDuplicateJitter * m_Settings.jitterMs / 1000.0;
+        m_Stats.duplicated++;
+    }
+    return copies;
+}
+
+//=============================================================================
+// NetSimNetwork
+//=============================================================================
+
+void NetSimNetwork::Initialize()
+{
+    if (!m_pNow) m_pNow = NetClock::Now;
+
+    m_UpLink.Reset(m_Seed);
+    m_DownLink.Reset(m_Seed ^ DOWNSTREAM_SEED_SALT);
+    m_UpLine.Clear();
+    m_DownLine.Clear();
+    m_EventLine.Clear();
+    m_LastEventRelease = 0.0;
+
+    m_FreeHeldCount = 0;
+    for (size_t i = 0; i < DOWNSTREAM_CAPACITY; i++)
+        m_FreeHeld[m_FreeHeldCount++] = static_cast<uint8_t>(DOWNSTREAM_CAPACITY - 1 - i);
+    m_Pool.Reset();
+}
+
+void NetSimNetwork::Finalize()
+{
+    m_UpLine.Clear();
+    m_DownLine.Clear();
+    m_EventLine.Clear();
+}
+
+//-----------------------------------------------------------------------------
+// Pump - Move due inputs to the backend, take new snapshots from it and
+// publish due snapshots to the pool
+//-----------------------------------------------------------------------------
+void NetSimNetwork::Pump(double now)
+{
+    InputCmd cmd;
+    double releaseTime;
+    while (m_UpLine.Pop(now, cmd, releaseTime))
+    {
+        m_pInner->SendInputCmd(cmd);
+        m_UpLink.CountDelivered();
+    }
+
+    SnapshotHandle incoming;
+    while (m_pInner->AcquireSnapshot(incoming))
+    {
+        const Snapshot& snapshot = *incoming;
+        // Newest encoded size; close enough for the cap when several arrive
+        uint32_t wireBytes = m_pInner->GetLastSnapshotBytes();
+        size_t bytes = wireBytes ? wireBytes : GetSnapshotSize(snapshot.remotePlayerCount);
+
+        double release[2];
+        int copies = m_DownLink.Schedule(now, bytes, release);
+        for (int c = 0; c < copies; c++)
+        {
+            if (m_FreeHeldCount == 0)
+            {
+                m_DownLink.CountOverflow();
+                continue;
+            }
+            uint8_t index = m_FreeHeld[--m_FreeHeldCount];
+            CopySnapshot(m_Held[index], snapshot);
+            m_DownLine.Push(release[c], index);   // Cannot fail: one entry per held slot
+        }
+    }
+    incoming.Release();
+
+    uint8_t index;
+    while (m_DownLine.Pop(now, index, releaseTime))
+    {
+        // Game holding every pool slot: the pool counts the drop
+        if (SnapshotPool::Slot* slot = m_Pool.BeginWrite())
+        {
+            CopySnapshot(slot->snapshot, m_Held[index]);
+            slot->arrivalTime = releaseTime;
+            m_Pool.CommitWrite();
+            m_DownLink.CountDelivered();
+        }
+        m_FreeHeld[m_FreeHeldCount++] = index;
+    }
+}
+
+void NetSimNetwork::SendInputCmd(const InputCmd& cmd)
+{
+    double now = m_pNow();
+
+    // The backend encodes after the link, so charge the raw INPUT_CMD wire
+    // size: exact without redundancy, a floor for an INPUT_BATCH
+    constexpr size_t INPUT_WIRE_BYTES = 1 + NetReflect::WIRE_SIZE<InputCmd>;
+
+    double release[2];
+    int copies = m_UpLink.Schedule(now, INPUT_WIRE_BYTES, release);
+    for (int c = 0; c < copies; c++)
+    {
+        if (!m_UpLine.Push(release[c], cmd)) m_UpLink.CountOverflow();
+    }
+
+    Pump(now);
+}
+
+bool NetSimNetwork::AcquireSnapshot(SnapshotHandle& outHandle)
+{
+    Pump(m_pNow());
+    return m_Pool.Acquire(outHandle);
+}
+
+//-----------------------------------------------------------------------------
+// ReceiveEvent - Events are reliable: base latency only, in order
+//-----------------------------------------------------------------------------
+bool NetSimNetwork::ReceiveEvent(NetEvent& outEvent)
+{
+    const double now = m_pNow();
+    double release = now + m_DownLink.GetSettings().latencyMs / 1000.0;
+    if (release < m_LastEventRelease) release = m_LastEventRelease;
+
+    NetEvent incoming;
+    while (m_EventLine.Size() < EVENT_CAPACITY && m_pInner->ReceiveEvent(incoming))
+    {
+        m_EventLine.Push(release, incoming);
+        m_LastEventRelease = release;
+    }
+
+    double releaseTime;
+    return m_EventLine.Pop(now, outEvent, releaseTime);
+}
+
+size_t NetSimNetwork::GetSnapshotQueueSize() const
+{
+    return m_pInner->GetSnapshotQueueSize() + m_DownLine.Size() + m_Pool.GetReadyCount();
+}
+
+uint32_t NetSimNetwork::GetRTT() const
+{
+    const float simulatedMs = m_UpLink.GetSettings().latencyMs + m_DownLink.GetSettings().latencyMs;
+    return m_pInner->GetRTT() + static_cast<uint32_t>(simulatedMs + 0.5f);
+}
+
+uint32_t NetSimNetwork::GetSnapshotDropCount() const
+{
+    return m_pInner->GetSnapshotDropCount() + m_Pool.GetDropCount();
+}
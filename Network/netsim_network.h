@@ -0,0 +1,243 @@
+#pragma once
+//=============================================================================
+// netsim_network.h
+//
+// Network condition simulator: an INetwork decorator that wraps any backend
+// (MockNetwork, ENetClientNetwork) and applies one-way latency, jitter,
+// loss, duplication, reordering and a bandwidth cap in each direction.
+//
+// Everything happens on the client side of the wrapped network:
+//   Upstream    SendInputCmd holds each command in a delay line and forwards
+//               it to the backend once it is due.
+//   Downstream  snapshots taken from the backend are copied into a delay
+//               line (the backend's handle is released at once) and handed
+//               out through the decorator's own SnapshotPool when due, with
+//               the simulated arrival time.
+//   Events      gameplay events ride a reliable channel: they are delayed by
+//               the downstream base latency but never lost, duplicated or
+//               reordered.
+// The delay lines are pumped from SendInputCmd, AcquireSnapshot and
+// ReceiveEvent, i.e. every client frame. Server-side calls pass straight
+// through.
+//
+// Every packet draws the same number of values from a seeded per-direction
+// RNG, so a given seed and packet sequence always yields the same fate for
+// each packet, even when only some of the parameters change.
+//
+// Conditions apply to messages above the backend's own encoding, so:
+//   - a lost InputCmd never reaches the INPUT_BATCH encoder (worst case:
+//     every redundant copy lost), and
+//   - snapshots are decoded and acked by the backend before the delay line,
+//     so loss does not invalidate delta baselines.
+// The bandwidth cap charges snapshots their encoded size and inputs the raw
+// INPUT_CMD packet size (a floor when the backend batches them).
+// Latency, jitter and ordering as seen by the game are exact.
+//
+// The backend's Initialize/Finalize stay with its owner.
+//=============================================================================
+
+#include "i_network.h"
+#include <cstddef>
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+// Per-direction link parameters
+//-----------------------------------------------------------------------------
+struct NetSimLinkSettings
+{
+    float latencyMs = 0.0f;       // One-way base delay
+    float jitterMs = 0.0f;        // Uniform +-jitter around latency (order kept)
+    float loss = 0.0f;            // Drop probability [0, 1]
+    float duplicate = 0.0f;       // Probability of a second copy
+    float reorder = 0.0f;         // Probability a packet is held back by reorderMs
+    float reorderMs = 40.0f;      //   so later packets overtake it
+    float bandwidthKbps = 0.0f;   // Serialization cap, 0 = unlimited
+};
+
+//-----------------------------------------------------------------------------
+// Per-direction counters
+//-----------------------------------------------------------------------------
+struct NetSimStats
+{
+    uint32_t offered;       // Packets handed to the link
+    uint32_t delivered;     // Copies released to the receiver
+    uint32_t lost;          // Dropped by the loss model
+    uint32_t duplicated;    // Extra copies scheduled
+    uint32_t reordered;     // Held back past later packets
+    uint32_t overflowed;    // Dropped: bandwidth backlog or delay line full
+};
+
+//-----------------------------------------------------------------------------
+// NetSimLink - Fate and release time of each packet in one direction
+//-----------------------------------------------------------------------------
+class NetSimLink
+{
+public:
+    void Reset(uint64_t seed);
+    void SetSettings(const NetSimLinkSettings& settings) { m_Settings = settings; }
+    const NetSimLinkSettings& GetSettings() const { return m_Settings; }
+
+    // Schedule a packet of `bytes` offered at `now`. Writes up to two
+    // release times (original, duplicate) and returns how many were written.
+    int Schedule(double now, size_t bytes, double outRelease[2]);
+
+    void CountDelivered() { m_Stats.delivered++; }
+    void CountOverflow() { m_Stats.overflowed++; }
+    const NetSimStats& GetStats() const { return m_Stats; }
+
+    // A link backed up by more than this drops new packets (router queue)
+    static constexpr double MAX_BACKLOG = 1.0;
+
+private:
+    float NextFloat();   // [0, 1)
+
+    NetSimLinkSettings m_Settings;
+    NetSimStats m_Stats = {};
+    uint64_t m_RandomState = 0;
+    double m_LinkFreeAt = 0.0;    // Bandwidth: when the last packet is fully sent
+    double m_LastRelease = 0.0;   // Newest in-order release time
+};
+
+//-----------------------------------------------------------------------------
+// NetSimDelayLine - Fixed-capacity queue ordered by release time
+//
+// Equal release times keep insertion order.
+//-----------------------------------------------------------------------------
+template <typename T, size_t N>
+class NetSimDelayLine
+{
+public:
+    void Clear() { m_Count = 0; }
+    size_t Size() const { return m_Count; }
+
+    bool Push(double releaseTime, const T& item)
+    {
+        if (m_Count == N) return false;
+
+        size_t i = m_Count;
+        while (i > 0 && m_Entries[i - 1].releaseTime > releaseTime)
+        {
+            m_Entries[i] = m_Entries[i - 1];
+            i--;
+        }
+        m_Entries[i] = { releaseTime, item };
+        m_Count++;
+        return true;
+    }
+
+    // Earliest entry if it is due at `now`
+    bool Pop(double now, T& outItem, double& outReleaseTime)
+    {
+        if (m_Count == 0 || m_Entries[0].releaseTime > now) return false;
+
+        outItem = m_Entries[0].item;
+        outReleaseTime = m_Entries[0].releaseTime;
+        for (size_t i = 1; i < m_Count; i++)
+            m_Entries[i - 1] = m_Entries[i];
+        m_Count--;
+        return true;
+    }
+
+private:
+    struct Entry
+    {
+        double releaseTime;
+        T item;
+    };
+
+    Entry m_Entries[N];
+    size_t m_Count = 0;
+};
+
+//-----------------------------------------------------------------------------
+// NetSimNetwork - INetwork decorator (client side)
+//-----------------------------------------------------------------------------
+class NetSimNetwork : public INetwork
+{
+public:
+    NetSimNetwork() = default;
+    ~NetSimNetwork() override = default;
+
+    //-------------------------------------------------------------------------
+    // Setup (before Initialize)
+    //-------------------------------------------------------------------------
+    void SetInner(INetwork* pInner) { m_pInner = pInner; }
+    void SetSeed(uint64_t seed) { m_Seed = seed; }
+    void SetUpstreamSettings(const NetSimLinkSettings& settings) { m_UpLink.SetSettings(settings); }
+    void SetDownstreamSettings(const NetSimLinkSettings& settings) { m_DownLink.SetSettings(settings); }
+
+    // Clock for release times (default NetClock::Now); benches drive a
+    // virtual clock through this
+    void SetTimeSource(double (*pNow)()) { m_pNow = pNow; }
+
+    // Reset links, RNGs and delay lines (not the wrapped network)
+    void Initialize() override;
+    void Finalize() override;
+
+    //-------------------------------------------------------------------------
+    // Client -> Server (Upstream)
+    //-------------------------------------------------------------------------
+    void SendInputCmd(const InputCmd& cmd) override;
+    bool ReceiveInputCmd(InputCmd& outCmd) override { return m_pInner->ReceiveInputCmd(outCmd); }
+    size_t GetInputQueueSize() const override { return m_pInner->GetInputQueueSize() + m_UpLine.Size(); }
+
+    //-------------------------------------------------------------------------
+    // Server -> Client (Downstream)
+    //-------------------------------------------------------------------------
+    void SendSnapshot(const Snapshot& snapshot) override { m_pInner->SendSnapshot(snapshot); }
+    bool AcquireSnapshot(SnapshotHandle& outHandle) override;
+    size_t GetSnapshotQueueSize() const override;
+
+    void SendEvents(uint32_t tickId, const NetEvent* events, size_t count) override { m_pInner->SendEvents(tickId, events, count); }
+    bool ReceiveEvent(NetEvent& outEvent) override;
+    void SendTickRate(uint32_t hz) override { m_pInner->SendTickRate(hz); }
+
+    //-------------------------------------------------------------------------
+    // Debug / Statistics (backend values, RTT includes simulated latency)
+    //-------------------------------------------------------------------------
+    uint32_t GetTotalInputsSent() const override { return m_pInner->GetTotalInputsSent(); }
+    uint32_t GetTotalSnapshotsSent() const override { return m_pInner->GetTotalSnapshotsSent(); }
+    uint32_t GetRTT() const override;
+    uint32_t GetPacketLoss() const override { return m_pInner->GetPacketLoss(); }
+    bool IsConnected() const override { return m_pInner->IsConnected(); }
+    uint32_t GetTickRate() const override { return m_pInner->GetTickRate(); }
+    uint32_t GetSessionEpoch() const override { return m_pInner->GetSessionEpoch(); }
+    uint32_t GetLastSnapshotBytes() const override { return m_pInner->GetLastSnapshotBytes(); }
+    uint64_t GetTotalBytesSent() const override { return m_pInner->GetTotalBytesSent(); }
+    uint64_t GetTotalBytesReceived() const override { return m_pInner->GetTotalBytesReceived(); }
+    uint64_t GetTotalPacketsSent() const override { return m_pInner->GetTotalPacketsSent(); }
+    uint64_t GetTotalPacketsReceived() const override { return m_pInner->GetTotalPacketsReceived(); }
+    uint32_t GetInputDropCount() const override { return m_pInner->GetInputDropCount(); }
+    uint32_t GetSnapshotDropCount() const override;
+    uint32_t GetEventDropCount() const override { return m_pInner->GetEventDropCount(); }
+
+    const NetSimStats& GetUpstreamStats() const { return m_UpLink.GetStats(); }
+    const NetSimStats& GetDownstreamStats() const { return m_DownLink.GetStats(); }
+
+    static constexpr size_t UPSTREAM_CAPACITY = 512;    // 0.5s of input @ 1000fps
+    static constexpr size_t DOWNSTREAM_CAPACITY = NetTickRate::MAX;   // 1s of snapshots @ 128Hz
+    static constexpr size_t EVENT_CAPACITY = 1024;
+
+private:
+    void Pump(double now);
+
+    INetwork* m_pInner = nullptr;
+    uint64_t m_Seed = 1;
+    double (*m_pNow)() = nullptr;
+
+    // Upstream: commands waiting to reach the backend
+    NetSimLink m_UpLink;
+    NetSimDelayLine<InputCmd, UPSTREAM_CAPACITY> m_UpLine;
+
+    // Downstream: copies waiting in m_Held, then delivered through m_Pool
+    NetSimLink m_DownLink;
+    NetSimDelayLine<uint8_t, DOWNSTREAM_CAPACITY> m_DownLine;
+    Snapshot m_Held[DOWNSTREAM_CAPACITY];
+    uint8_t m_FreeHeld[DOWNSTREAM_CAPACITY] = {};
+    size_t m_FreeHeldCount = 0;
+    SnapshotPool m_Pool;
+
+    // Events waiting out the downstream latency
+    NetSimDelayLine<NetEvent, EVENT_CAPACITY> m_EventLine;
+    double m_LastEventRelease = 0.0;    // Keeps order if the latency drops
+};
@@ -0,0 +1,325 @@
+#pragma once
+//=============================================================================
+// range_coder.h
+//
+// Adaptive binary range coder for the network wire format.
+// Shared between game_client and game_server (maintain in sync).
+//
+// LZMA-style: a 32-bit range split by 11-bit probabilities that adapt by
+// 1/32 towards every coded bit, with carry propagation on the encoder
+// side. Multi-bit values are coded through bit trees (every prefix has its
+// own probability) or AdaptiveIntModel (length, then the top mantissa bits
+// under their own contexts, the rest at probability 1/2).
+//
+// Models are plain arrays of uint16_t, so a whole set can be copied to
+// snapshot it and restored later; encoder and decoder stay in lockstep as
+// long as they start every stream from identical models.
+//
+// Stream: the always-zero first byte of the LZMA layout is left out and up
+// to FLUSH_MAX_BYTES trailing zero bytes are trimmed; the decoder reads
+// them back as zeros. Writing past the end sets an overflow flag instead
+// of touching memory, like BitWriter.
+//=============================================================================
+
+#include <cstddef>
+#include <cstdint>
+
+namespace RangeCoder {
+constexpr int PROB_BITS = 11;
+constexpr uint16_t PROB_ONE = 1u << PROB_BITS;
+constexpr int ADAPT_SHIFT = 5;                  // Moves 1/32 of the way per bit
+constexpr uint32_t TOP = 1u << 24;              // Renormalize below this range
+constexpr size_t FLUSH_MAX_BYTES = 4;
+
+// Bits needed to hold 0..value
+constexpr int BitWidth(uint32_t value)
+{
+    int bits = 0;
+    while (value != 0) { bits++; value >>= 1; }
+    return bits;
+}
+} // namespace RangeCoder
+
+//-----------------------------------------------------------------------------
+// BitModel - Adaptive probability that the next bit is 0
+//-----------------------------------------------------------------------------
+struct BitModel
+{
+    uint16_t prob = RangeCoder::PROB_ONE / 2;
+};
+
+//-----------------------------------------------------------------------------
+// RangeEncoder
+//-----------------------------------------------------------------------------
+class RangeEncoder
+{
+public:
+    RangeEncoder(uint8_t* data, size_t capacity)
+        : m_Data(data), m_Capacity(capacity) {}
+
+    void EncodeBit(BitModel& model, uint32_t bit)
+    {
+        const uint32_t bound = (m_Range >> RangeCoder::PROB_BITS) * model.prob;
+        if (bit == 0)
+        {
+            m_Range = bound;
+            model.prob += (RangeCoder::PROB_ONE - model.prob) >> RangeCoder::ADAPT_SHIFT;
+        }
+        else
+        {
+            m_Low += bound;
+            m_Range -= bound;
+            model.prob -= model.prob >> RangeCoder::ADAPT_SHIFT;
+        }
+        Normalize();
+    }
+
+    // Low `bits` bits of value at probability 1/2, MSB first (bits = 0..32)
+    void EncodeDirect(uint32_t value, int bits)
+    {
+        for (int i = bits - 1; i >= 0; i--)
+        {
+            m_Range >>= 1;
+            if ((value >> i) & 1u) m_Low += m_Range;
+            Normalize();
+        }
+    }
+
+    // Flush the shortest tail that still decodes correctly. Returns total
+    // bytes, 0 on overflow.
+    size_t Finish()
+    {
+        // Round low up to the value in [low, low + range) with the most
+        // trailing zero bytes; those are then trimmed
+        for (int shift = 32; shift > 0; shift -= 8)
+        {
+            const uint64_t mask = (1ull << shift) - 1u;
+            const uint64_t rounded = (m_Low + mask) & ~mask;
+            if (rounded < m_Low + m_Range)
+            {
+                m_Low = rounded;
+                break;
+            }
+        }
+        for (size_t i = 0; i <= RangeCoder::FLUSH_MAX_BYTES; i++)
+            ShiftLow();
+
+        for (size_t i = 0; i < RangeCoder::FLUSH_MAX_BYTES && m_Size > 0 && m_Data[m_Size - 1] == 0; i++)
+            m_Size--;
+        return m_Overflow ? 0 : m_Size;
+    }
+
+    bool HasOverflow() const { return m_Overflow; }
+
+private:
+    void Normalize()
+    {
+        while (m_Range < RangeCoder::TOP)
+        {
+            m_Range <<= 8;
+            ShiftLow();
+        }
+    }
+
+    // Emit the top byte of low, unless it may still receive a carry
+    void ShiftLow()
+    {
+        if (static_cast<uint32_t>(m_Low) < 0xFF000000u || (m_Low >> 32) != 0)
+        {
+            const uint8_t carry = static_cast<uint8_t>(m_Low >> 32);
+            uint8_t byte = m_Cache;
+            do
+            {
+                PutByte(static_cast<uint8_t>(byte + carry));
+                byte = 0xFF;
+            } while (--m_CacheSize != 0);
+            m_Cache = static_cast<uint8_t>(m_Low >> 24);
+        }
+        m_CacheSize++;
+        m_Low = (m_Low & 0x00FFFFFFu) << 8;
+    }
+
+    void PutByte(uint8_t byte)
+    {
+        if (m_SkipFirst) { m_SkipFirst = false; return; }   // Always 0
+        if (m_Size >= m_Capacity) { m_Overflow = true; return; }
+        m_Data[m_Size++] = byte;
+    }
+
+    uint8_t* m_Data;
+    size_t m_Capacity;
+    size_t m_Size = 0;
+    uint64_t m_Low = 0;
+    uint32_t m_Range = 0xFFFFFFFFu;
+    uint8_t m_Cache = 0;
+    uint64_t m_CacheSize = 1;
+    bool m_SkipFirst = true;
+    bool m_Overflow = false;
+};
+
+//-----------------------------------------------------------------------------
+// RangeDecoder
+//-----------------------------------------------------------------------------
+class RangeDecoder
+{
+public:
+    RangeDecoder(const uint8_t* data, size_t size)
+        : m_Data(data), m_Size(size)
+    {
+        for (size_t i = 0; i < 4; i++)
+            m_Code = (m_Code << 8) | NextByte();
+    }
+
+    uint32_t DecodeBit(BitModel& model)
+    {
+        const uint32_t bound = (m_Range >> RangeCoder::PROB_BITS) * model.prob;
+        uint32_t bit;
+        if (m_Code < bound)
+        {
+            m_Range = bound;
+            model.prob += (RangeCoder::PROB_ONE - model.prob) >> RangeCoder::ADAPT_SHIFT;
+            bit = 0;
+        }
+        else
+        {
+            m_Code -= bound;
+            m_Range -= bound;
+            model.prob -= model.prob >> RangeCoder::ADAPT_SHIFT;
+            bit = 1;
+        }
+        Normalize();
+        return bit;
+    }
+
+    uint32_t DecodeDirect(int bits)
+    {
+        uint32_t value = 0;
+        for (int i = 0; i < bits; i++)
+        {
+            m_Range >>= 1;
+            uint32_t bit = 0;
+            if (m_Code >= m_Range)
+            {
+                m_Code -= m_Range;
+                bit = 1;
+            }
+            value = (value << 1) | bit;
+            Normalize();
+        }
+        return value;
+    }
+
+    // True if every byte was consumed, counting the trimmed zero tail
+    bool IsAtEnd() const { return m_Offset >= m_Size && !HasOverflow(); }
+    bool HasOverflow() const { return m_PastEnd > RangeCoder::FLUSH_MAX_BYTES; }
+
+private:
+    void Normalize()
+    {
+        while (m_Range < RangeCoder::TOP)
+        {
+            m_Range <<= 8;
+            m_Code = (m_Code << 8) | NextByte();
+        }
+    }
+
+    uint32_t NextByte()
+    {
+        if (m_Offset < m_Size) return m_Data[m_Offset++];
+        m_PastEnd++;
+        return 0;
+    }
+
+    const uint8_t* m_Data;
+    size_t m_Size;
+    size_t m_Offset = 0;
+    size_t m_PastEnd = 0;
+    uint32_t m_Code = 0;
+    uint32_t m_Range = 0xFFFFFFFFu;
+};
+
+//-----------------------------------------------------------------------------
+// BitTreeModel - BITS-bit symbols, one context per prefix
+//-----------------------------------------------------------------------------
+template <int BITS>
+class BitTreeModel
+{
+public:
+    void Encode(RangeEncoder& rc, uint32_t symbol)
+    {
+        uint32_t node = 1;
+        for (int i = BITS - 1; i >= 0; i--)
+        {
+            const uint32_t bit = (symbol >> i) & 1u;
+            rc.EncodeBit(m_Nodes[node], bit);
+            node = (node << 1) | bit;
+        }
+    }
+
+    uint32_t Decode(RangeDecoder& rc)
+    {
+        uint32_t node = 1;
+        for (int i = 0; i < BITS; i++)
+            node = (node << 1) | rc.DecodeBit(m_Nodes[node]);
+        return node - (1u << BITS);
+    }
+
+private:
+    BitModel m_Nodes[1u << BITS];       // [0] unused
+};
+
+//-----------------------------------------------------------------------------
+// AdaptiveIntModel - Unsigned values below 2^MAX_BITS with a skewed,
+// roughly geometric distribution (magnitudes, zigzagged residuals)
+//
+// Codes the bit length under a bit tree, then up to HIGH_BITS mantissa bits
+// below the leading one under contexts per length; lower bits go direct.
+//-----------------------------------------------------------------------------
+template <int MAX_BITS>
+class AdaptiveIntModel
+{
+public:
+    static_assert(MAX_BITS >= 1 && MAX_BITS <= 32, "MAX_BITS out of range");
+    static constexpr int LENGTH_BITS = RangeCoder::BitWidth(MAX_BITS);
+    static constexpr int HIGH_BITS = 2;
+
+    void Encode(RangeEncoder& rc, uint32_t value)
+    {
+        const int length = RangeCoder::BitWidth(value);
+        m_Length.Encode(rc, static_cast<uint32_t>(length));
+        if (length <= 1) return;
+
+        const int mantissa = length - 1;
+        const int high = (mantissa < HIGH_BITS) ? mantissa : HIGH_BITS;
+        uint32_t node = 1;
+        for (int i = mantissa - 1; i >= mantissa - high; i--)
+        {
+            const uint32_t bit = (value >> i) & 1u;
+            rc.EncodeBit(m_High[length][node], bit);
+            node = (node << 1) | bit;
+        }
+        rc.EncodeDirect(value, mantissa - high);
+    }
+
+    // Malformed input may decode a length past MAX_BITS; callers range
+    // check the result
+    uint32_t Decode(RangeDecoder& rc)
+    {
+        int length = static_cast<int>(m_Length.Decode(rc));
+        if (length > MAX_BITS) length = MAX_BITS;
+        if (length <= 1) return static_cast<uint32_t>(length);
+
+        const int mantissa = length - 1;
+        const int high = (mantissa < HIGH_BITS) ? mantissa : HIGH_BITS;
+        uint32_t node = 1;
+        for (int i = 0; i < high; i++)
+            node = (node << 1) | rc.DecodeBit(m_High[length][node]);
+
+        // node is the leading one followed by the high bits
+        return (node << (mantissa - high)) | rc.DecodeDirect(mantissa - high);
+    }
+
+private:
+    BitTreeModel<LENGTH_BITS> m_Length;
+    BitModel m_High[MAX_BITS + 1][1u << HIGH_BITS];   // [length][prefix node], [.][0] unused
+};
@@ -15,16 +15,47 @@
 
 using namespace DirectX;
 
-// Global remote player array (pre-allocated, indexed by playerId)
-RemotePlayer g_RemotePlayers[MAX_PLAYERS];
-bool g_RemotePlayerActive[MAX_PLAYERS] = {};
+// Global remote players (indexed by playerId, created on first sight)
+std::vector<std::unique_ptr<RemotePlayer>> g_RemotePlayers;
+
+//-----------------------------------------------------------------------------
+// RemotePlayers_Acquire - Player for playerId, created on first use
+//-----------------------------------------------------------------------------
+RemotePlayer& RemotePlayers_Acquire(uint8_t playerId)
+{
+    if (playerId >= g_RemotePlayers.size())
+        g_RemotePlayers.resize(playerId + 1);
+
+    std::unique_ptr<RemotePlayer>& slot = g_RemotePlayers[playerId];
+    if (!slot)
+    {
+        slot = std::make_unique<RemotePlayer>();
+        slot->Initialize({ 0.0f, 0.0f, 0.0f });
+        slot->SetActive(false);
+    }
+    return *slot;
+}
+
+//-----------------------------------------------------------------------------
+// RemotePlayers_ResetSession - Forget every player's old-session snapshots
+//-----------------------------------------------------------------------------
+void RemotePlayers_ResetSession()
+{
+    for (const auto& rp : g_RemotePlayers)
+    {
+        if (!rp) continue;
+        rp->ClearSnapshots();
+        rp->SetActive(false);
+    }
+}
 
 //-----------------------------------------------------------------------------
 // Constructor
 //-----------------------------------------------------------------------------
 RemotePlayer::RemotePlayer()
-    : m_InterpolationDelay(0.1)    // 100ms interpolation delay
+    : m_InterpolationDelay(0.075)  // 75ms: 2 ticks @ 32Hz + margin (server timeline, see ClockSync)
     , m_MaxExtrapolationTime(0.15) // 150ms max extrapolation
+                                   // (both replaced per frame when the jitter buffer is adaptive)
     , m_RenderPosition{ 0.0f, 0.0f, 0.0f }
     , m_Velocity{ 0.0f, 0.0f, 0.0f }
     , m_Yaw(0.0f)
@@ -172,13 +203,20 @@ void RemotePlayer::SetTeam(uint8_t teamId)
 //-----------------------------------------------------------------------------
 // PushSnapshot - Add new server snapshot to buffer
 //-----------------------------------------------------------------------------
-void RemotePlayer::PushSnapshot(const NetPlayerState& state, double currentTime)
+void RemotePlayer::PushSnapshot(const NetPlayerState& state, double serverTime)
 {
     RemoteSnapshot snapshot;
     snapshot.state = state;
-    snapshot.receiveTime = currentTime;
+    snapshot.serverTime = serverTime;
     
-    m_SnapshotBuffer.push_back(snapshot);
+    // Keep the buffer in server time order: reordered snapshots slot in,
+    // duplicates are dropped
+    auto it = m_SnapshotBuffer.end();
+    while (it != m_SnapshotBuffer.begin() && (it - 1)->serverTime > serverTime)
+        --it;
+    if (it != m_SnapshotBuffer.begin() && (it - 1)->serverTime == serverTime)
+        return;
+    m_SnapshotBuffer.insert(it, snapshot);
     
     // Keep buffer size manageable
     while (m_SnapshotBuffer.size() > MAX_BUFFER_SIZE)
@@ -217,8 +255,8 @@ void RemotePlayer::Update(double elapsed_time, double currentTime)
     
     for (size_t i = 0; i + 1 < m_SnapshotBuffer.size(); ++i)
     {
-        double t0 = m_SnapshotBuffer[i].receiveTime;
-        double t1 = m_SnapshotBuffer[i + 1].receiveTime;
+        double t0 = m_SnapshotBuffer[i].serverTime;
+        double t1 = m_SnapshotBuffer[i + 1].serverTime;
         
         // Ensure t0 < t1 (snapshots are in correct order)
         if (t0 >= t1) continue;  // Skip invalid/duplicate snapshots
@@ -244,7 +282,7 @@ void RemotePlayer::Update(double elapsed_time, double currentTime)
         const RemoteSnapshot& oldest = m_SnapshotBuffer.front();
         const RemoteSnapshot& newest = m_SnapshotBuffer.back();
         
-        if (renderTime < oldest.receiveTime)
+        if (renderTime < oldest.serverTime)
         {
             // ===== WAITING =====
             // renderTime is before all snapshots (buffer hasn't caught up)
@@ -256,11 +294,11 @@ void RemotePlayer::Update(double elapsed_time, double currentTime)
             m_StateFlags = oldest.state.stateFlags;
             m_DebugLerpFactor = 0.0f;
         }
-        else if (renderTime >= newest.receiveTime)
+        else if (renderTime >= newest.serverTime)
         {
             // ===== EXTRAPOLATION =====
             // renderTime is past all snapshots
-            double timeSinceNewest = renderTime - newest.receiveTime;
+            double timeSinceNewest = renderTime - newest.serverTime;
             
             if (timeSinceNewest < m_MaxExtrapolationTime)
             {
@@ -341,7 +379,7 @@ void RemotePlayer::Update(double elapsed_time, double currentTime)
     
     // Clean up old snapshots (keep at least 3 for interpolation margin)
     while (m_SnapshotBuffer.size() > 3 && 
-           m_SnapshotBuffer.front().receiveTime < renderTime - 0.5)
+           m_SnapshotBuffer.front().serverTime < renderTime - 0.5)
     {
         m_SnapshotBuffer.erase(m_SnapshotBuffer.begin());
     }
@@ -352,10 +390,10 @@ void RemotePlayer::Update(double elapsed_time, double currentTime)
 //-----------------------------------------------------------------------------
 void RemotePlayer::InterpolateBetween(const RemoteSnapshot& a, const RemoteSnapshot& b, double renderTime)
 {
-    double duration = b.receiveTime - a.receiveTime;
+    double duration = b.serverTime - a.serverTime;
     if (duration <= 0.0) duration = 0.001;
     
-    float t = static_cast<float>((renderTime - a.receiveTime) / duration);
+    float t = static_cast<float>((renderTime - a.serverTime) / duration);
     t = std::max(0.0f, std::min(1.0f, t));  // Clamp 0-1
     m_DebugLerpFactor = t;  // Save for debug
     
@@ -478,7 +516,7 @@ std::string RemotePlayer::GetMoveDirectionString() const
 double RemotePlayer::GetOldestSnapshotTime() const
 {
     if (m_SnapshotBuffer.empty()) return 0.0;
-    return m_SnapshotBuffer.front().receiveTime;
+    return m_SnapshotBuffer.front().serverTime;
 }
 
 //-----------------------------------------------------------------------------
@@ -487,5 +525,5 @@ double RemotePlayer::GetOldestSnapshotTime() const
 double RemotePlayer::GetNewestSnapshotTime() const
 {
     if (m_SnapshotBuffer.empty()) return 0.0;
-    return m_SnapshotBuffer.back().receiveTime;
+    return m_SnapshotBuffer.back().serverTime;
 }
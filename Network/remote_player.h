@@ -5,14 +5,18 @@
 // Represents another player in the game world, controlled by server data.
 // 
 // Sync Strategy: INTERPOLATION + EXTRAPOLATION (with snapshot buffer)
-//   - Maintains buffer of recent server snapshots
-//   - Render time is delayed by ~100ms for interpolation
+//   - Maintains buffer of recent server snapshots, stamped with server time
+//   - Render time follows the client's estimate of the server timeline
+//     (ClockSync) delayed for interpolation, so arrival jitter does not
+//     reach the rendered motion. The delay is set by the JitterBuffer
+//     (75ms when adaptive interpolation is off)
 //   - Interpolates between snapshots for smooth movement
 //   - Extrapolates if no recent data (packet loss)
 //   - Snaps if too far behind
 //=============================================================================
 
 #include <DirectXMath.h>
+#include <memory>
 #include <vector>
 #include "net_common.h"
 #include "model_ani.h"
@@ -25,7 +29,7 @@
 struct RemoteSnapshot
 {
     NetPlayerState state;
-    double receiveTime;     // Local time when received
+    double serverTime;      // Snapshot::serverTime
 };
 
 class RemotePlayer
@@ -43,10 +47,12 @@ public:
     //-------------------------------------------------------------------------
     // Add snapshot to buffer (called when server data received)
     //-------------------------------------------------------------------------
-    void PushSnapshot(const NetPlayerState& state, double currentTime);
+    void PushSnapshot(const NetPlayerState& state, double serverTime);
+    void ClearSnapshots() { m_SnapshotBuffer.clear(); }
     
     //-------------------------------------------------------------------------
-    // Update interpolation/extrapolation (called every frame)
+    // Update interpolation/extrapolation (called every frame).
+    // currentTime is on the server timeline (ClockSync::GetArrivalTimeline).
     //-------------------------------------------------------------------------
     void Update(double elapsed_time, double currentTime);
     
@@ -74,6 +80,7 @@ public:
     const char* GetSyncMode() const { return m_SyncMode; }
     size_t GetBufferSize() const { return m_SnapshotBuffer.size(); }
     double GetInterpolationDelay() const { return m_InterpolationDelay; }
+    double GetMaxExtrapolationTime() const { return m_MaxExtrapolationTime; }
     float GetLerpFactor() const { return m_DebugLerpFactor; }
     double GetLastRenderTime() const { return m_DebugRenderTime; }
     double GetOldestSnapshotTime() const;
@@ -84,6 +91,8 @@ public:
     std::string GetMoveDirectionString() const;
     
     void SetActive(bool active) { m_IsActive = active; }
+    void SetInterpolationDelay(double delay) { m_InterpolationDelay = delay; }
+    void SetMaxExtrapolationTime(double time) { m_MaxExtrapolationTime = time; }
     void SetTeam(uint8_t teamId);
     uint8_t GetTeam() const { return m_TeamId; }
 
@@ -104,8 +113,8 @@ private:
     static const size_t MAX_BUFFER_SIZE = 32;
     
     // Interpolation parameters
-    double m_InterpolationDelay;    // How far behind real-time we render (100ms)
-    double m_MaxExtrapolationTime;  // Max time to extrapolate (150ms)
+    double m_InterpolationDelay;    // How far behind the server timeline we render (75ms / JitterBuffer)
+    double m_MaxExtrapolationTime;  // Max time to extrapolate (150ms / JitterBuffer)
     
     // Render state (what we display)
     DirectX::XMFLOAT3 m_RenderPosition;
@@ -137,6 +146,17 @@ private:
     MODEL* m_WeaponModel;
 };
 
-// Global remote player array (pre-allocated, indexed by playerId)
-extern RemotePlayer g_RemotePlayers[];
-extern bool g_RemotePlayerActive[];
+//-----------------------------------------------------------------------------
+// Global remote players, indexed by playerId
+//
+// A slot stays null until its playerId first appears in a snapshot;
+// RemotePlayers_Acquire then creates it and loads its models, so memory and
+// load time follow the players actually in the session.
+//-----------------------------------------------------------------------------
+extern std::vector<std::unique_ptr<RemotePlayer>> g_RemotePlayers;
+
+RemotePlayer& RemotePlayers_Acquire(uint8_t playerId);
+
+// New server session: deactivate every player and drop its buffered
+// snapshots (the new server's times restart). Models stay loaded.
+void RemotePlayers_ResetSession();
@@ -0,0 +1,100 @@
+//=============================================================================
+// server_input_buffer.cpp
+//
+// Tick-ordered input playback with repeat / fast-forward.
+//=============================================================================
+
+#include "server_input_buffer.h"
+
+void ServerInputBuffer::Reset()
+{
+    *this = ServerInputBuffer();
+}
+
+bool ServerInputBuffer::Push(const InputCmd& cmd)
+{
+    if (cmd.tickId == 0 || (m_NextTick != 0 && cmd.tickId < m_NextTick))
+    {
+        m_Dropped++;
+        return false;
+    }
+
+    if (m_NextTick == 0)
+    {
+        m_NextTick = cmd.tickId;
+        m_NewestTick = cmd.tickId;
+    }
+    else if (cmd.tickId - m_NextTick >= CAPACITY)
+    {
+        // Client is a full buffer ahead (stall on our side or theirs):
+        // drop what is waiting and resume from the newest input
+        m_Dropped += GetSpan();
+        for (bool& valid : m_Valid) valid = false;
+        m_NextTick = cmd.tickId;
+        m_NewestTick = cmd.tickId;
+    }
+
+    const uint32_t slot = cmd.tickId % CAPACITY;
+    if (m_Valid[slot] && m_Slots[slot].tickId == cmd.tickId)
+    {
+        m_Dropped++;
+        return false;
+    }
+
+    m_Slots[slot] = cmd;
+    m_Valid[slot] = true;
+    if (cmd.tickId > m_NewestTick) m_NewestTick = cmd.tickId;
+    return true;
+}
+
+bool ServerInputBuffer::Pop(InputCmd& out)
+{
+    if (m_NextTick == 0) return false;
+
+    if (GetDepth() == 0)
+    {
+        // Next input not here yet (or overtaken by later ones and still
+        // expected): repeat the last and keep waiting for it
+        m_Underflows++;
+        out = m_Last;
+        out.buttons &= ~InputButtons::ONE_SHOT;
+        return m_HasLast;
+    }
+
+    // Waited as long as the buffer allows: ticks still missing below a
+    // buffered one are lost, skip them (the newest received is always
+    // buffered). A redundant INPUT_BATCH usually fills them in before this.
+    uint32_t slot = m_NextTick % CAPACITY;
+    while (!m_Valid[slot] || m_Slots[slot].tickId != m_NextTick)
+    {
+        m_Lost++;
+        m_NextTick++;
+        slot = m_NextTick % CAPACITY;
+    }
+
+    m_Last = m_Slots[slot];
+    m_HasLast = true;
+    m_Valid[slot] = false;
+    m_NextTick++;
+    out = m_Last;
+    return true;
+}
+
+uint32_t ServerInputBuffer::GetDepth() const
+{
+    const uint32_t span = GetSpan();
+    if (span <= MAX_DEPTH && !IsNextBuffered()) return 0;
+    return span;
+}
+
+uint32_t ServerInputBuffer::GetSpan() const
+{
+    if (m_NextTick == 0 || m_NewestTick < m_NextTick) return 0;
+    return m_NewestTick - m_NextTick + 1;
+}
+
+bool ServerInputBuffer::IsNextBuffered() const
+{
+    const uint32_t slot = m_NextTick % CAPACITY;
+    return m_Valid[slot] && m_Slots[slot].tickId == m_NextTick;
+}
@@ -0,0 +1,74 @@
+#pragma once
+//=============================================================================
+// server_input_buffer.h
+//
+// Server-side input jitter buffer for one client, keyed by client tick.
+//
+// Inputs arrive in bursts (frame hitches, network jitter, redundant
+// batches), but the client predicted each of them as one fixed tick. The
+// server therefore plays back exactly one input per server tick, in tick
+// order, so its movement replays the client's prediction step for step:
+//   - Underflow (next input not here yet): repeat the last input with its
+//     one-shot buttons cleared, and wait for the missing tick
+//   - Missing tick (a later one already arrived): inputs are unsequenced
+//     and may be reordered, so keep repeating while it may still come, as
+//     long as the inputs behind it fit in MAX_DEPTH. Beyond that it counts
+//     as lost: skip it and play the next one that did arrive
+//   - Overflow (more than MAX_DEPTH waiting): fast-forward by simulating
+//     one extra input per server tick until back under the limit
+//
+// The depth before each playback is reported to the client in the
+// snapshot, which nudges its tick clock to keep about one input queued.
+// A depth of 0 also tells the client the acked input was repeated, so it
+// replays the repeat too instead of treating it as a misprediction.
+//=============================================================================
+
+#include "net_common.h"
+#include "net_tick.h"
+
+class ServerInputBuffer
+{
+public:
+    void Reset();
+
+    // Buffer one received input. Ticks already played (or skipped) and
+    // duplicates are dropped; false when dropped.
+    bool Push(const InputCmd& cmd);
+
+    // Input to simulate next: the next buffered tick in order, or a repeat
+    // of the last one. False until the first input has arrived.
+    bool Pop(InputCmd& out);
+
+    // Inputs waiting, from the next tick to play up to the newest received;
+    // 0 while the next tick is missing and still awaited (Pop repeats)
+    uint32_t GetDepth() const;
+
+    // More than MAX_DEPTH waiting: the server should play an extra input
+    bool IsOverfull() const { return GetDepth() > MAX_DEPTH; }
+
+    //-------------------------------------------------------------------------
+    // Counters (since Reset)
+    //-------------------------------------------------------------------------
+    uint32_t GetUnderflowCount() const { return m_Underflows; }     // Repeats while waiting
+    uint32_t GetLostCount() const { return m_Lost; }                // Ticks skipped after waiting
+    uint32_t GetDroppedCount() const { return m_Dropped; }          // Late, duplicate or out of range
+
+    static constexpr uint32_t CAPACITY = NetTickRate::MAX;  // Ticks (1s @ 128Hz)
+    static constexpr uint32_t MAX_DEPTH = 4;                // Beyond this, fast-forward
+
+private:
+    uint32_t GetSpan() const;                   // Next tick to newest, gaps included
+    bool IsNextBuffered() const;
+
+    InputCmd m_Slots[CAPACITY] = {};            // Indexed by tickId % CAPACITY
+    bool m_Valid[CAPACITY] = {};
+
+    uint32_t m_NextTick = 0;                    // Next tick to play (0 = nothing received yet)
+    uint32_t m_NewestTick = 0;
+    InputCmd m_Last = {};                       // Most recently played
+    bool m_HasLast = false;
+
+    uint32_t m_Underflows = 0;
+    uint32_t m_Lost = 0;
+    uint32_t m_Dropped = 0;
+};
@@ -0,0 +1,300 @@
+//=============================================================================
+// snapshot_delta.cpp
+//
+// Delta encoding of Snapshot against an acknowledged baseline.
+// Field quantization and packing live in net_codec.cpp.
+//=============================================================================
+
+#include "snapshot_delta.h"
+#include "net_bitstream.h"
+#include <cstring>
+
+namespace {
+
+// Delta header: HAS_BASELINE + ENTROPY_CODED + tickId + baseline age
+constexpr size_t DELTA_HEADER_MAX_BITS = 2 + 2 * NetCodec::VARINT32_MAX_BITS;
+
+void WriteDeltaHeader(BitWriter& w, uint32_t tickId, const Snapshot* baseline,
+                      bool entropyCoding, bool entropyCoded)
+{
+    w.WriteBool(baseline != nullptr);
+    if (entropyCoding) w.WriteBool(entropyCoded);
+    w.WriteVarint(tickId);
+    if (baseline) w.WriteVarint(tickId - baseline->tickId);
+}
+
+//-----------------------------------------------------------------------------
+// CarryForward - Merge baseline remote entries missing from stored into it
+//
+// Linear merge done in place from the back. Both lists must be in strictly
+// ascending playerId order (otherwise stored is left alone); encoder and
+// decoder run this on identical data, so their baselines stay in sync.
+//-----------------------------------------------------------------------------
+void CarryForward(Snapshot& stored, const Snapshot& baseline)
+{
+    const int count = stored.remotePlayerCount;
+    const int baseCount = baseline.remotePlayerCount;
+    const RemotePlayerEntry* base = baseline.remotePlayers;
+    RemotePlayerEntry* entries = stored.remotePlayers;
+
+    for (int i = 1; i < count; i++)
+    {
+        if (entries[i].playerId <= entries[i - 1].playerId) return;
+    }
+
+    int missing = 0;
+    int i = 0;
+    for (int j = 0; j < baseCount; j++)
+    {
+        if (j > 0 && base[j].playerId <= base[j - 1].playerId) return;
+        while (i < count && entries[i].playerId < base[j].playerId) i++;
+        if (i == count || entries[i].playerId != base[j].playerId) missing++;
+    }
+    if (missing == 0 || count + missing > MAX_PLAYERS - 1) return;
+
+    int k = count + missing - 1;
+    i = count - 1;
+    for (int j = baseCount - 1; j >= 0; j--)
+    {
+        while (i >= 0 && entries[i].playerId > base[j].playerId) entries[k--] = entries[i--];
+        if (i >= 0 && entries[i].playerId == base[j].playerId) entries[k--] = entries[i--];
+        else                                                    entries[k--] = base[j];
+    }
+
+    stored.remotePlayerCount = static_cast<uint8_t>(count + missing);
+}
+
+// The ring slot of a baseline SNAPSHOT_HISTORY_SIZE ticks old is the one
+// the new snapshot is stored in
+bool CanCarryForward(uint32_t baselineAge)
+{
+    return baselineAge % SNAPSHOT_HISTORY_SIZE != 0;
+}
+
+} // namespace
+
+//=============================================================================
+// SnapshotRing
+//=============================================================================
+
+void SnapshotRing::Clear()
+{
+    for (size_t i = 0; i < SNAPSHOT_HISTORY_SIZE; i++)
+        m_Valid[i] = false;
+}
+
+Snapshot& SnapshotRing::Store(const Snapshot& snapshot)
+{
+    size_t slot = snapshot.tickId % SNAPSHOT_HISTORY_SIZE;
+    CopySnapshot(m_Slots[slot], snapshot);
+    m_Valid[slot] = true;
+    return m_Slots[slot];
+}
+
+const Snapshot* SnapshotRing::Find(uint32_t tickId) const
+{
+    size_t slot = tickId % SNAPSHOT_HISTORY_SIZE;
+    if (m_Valid[slot] && m_Slots[slot].tickId == tickId)
+        return &m_Slots[slot];
+    return nullptr;
+}
+
+//=============================================================================
+// SnapshotDeltaEncoder
+//=============================================================================
+
+void SnapshotDeltaEncoder::Reset()
+{
+    m_History.Clear();
+    m_AckedTick = 0;
+    m_HasAck = false;
+    m_FullCount = 0;
+    m_DeltaCount = 0;
+    m_EntropyCodedCount = 0;
+    m_Prioritizer.Reset();
+    m_Models.Clear();
+}
+
+void SnapshotDeltaEncoder::Acknowledge(uint32_t tickId)
+{
+    // Acks travel unreliably and may be reordered; only move forward
+    if (m_HasAck && tickId <= m_AckedTick) return;
+
+    // Never accept an ack for something we did not send
+    if (!m_History.Find(tickId)) return;
+
+    m_AckedTick = tickId;
+    m_HasAck = true;
+}
+
+size_t SnapshotDeltaEncoder::Encode(const Snapshot& snapshot, uint8_t* out, size_t capacity)
+{
+    // Newest acked snapshot is the baseline, if it is still in the ring
+    const Snapshot* baseline = m_HasAck ? m_History.Find(m_AckedTick) : nullptr;
+    if (baseline && baseline->tickId >= snapshot.tickId)
+        baseline = nullptr;
+
+    const Snapshot& sent = (m_ByteBudget > 0) ? ApplyBudget(snapshot, baseline) : snapshot;
+
+    BitWriter w(out, capacity);
+    WriteDeltaHeader(w, sent.tickId, baseline, m_EntropyCoding, false);
+    NetCodec::WriteSnapshot(w, sent, baseline);
+
+    size_t size = w.Finish();
+    if (size == 0) return 0;
+
+    // Range code it as well and keep whichever is smaller
+    const SnapshotEntropyModels* baseModels = nullptr;
+    bool entropyCoded = false;
+    if (m_EntropyCoding)
+    {
+        baseModels = baseline ? m_Models.Find(baseline->tickId) : nullptr;
+        size_t coded = EncodeEntropy(sent, baseline, baseModels, m_EntropyBuffer, size - 1);
+        if (coded > 0)
+        {
+            std::memcpy(out, m_EntropyBuffer, coded);
+            size = coded;
+            entropyCoded = true;
+            m_EntropyCodedCount++;
+        }
+    }
+
+    // Remember exactly what the client will reconstruct (before the store,
+    // which may reuse the baseline's slot)
+    bool carry = baseline && CanCarryForward(sent.tickId - baseline->tickId);
+    Snapshot& stored = m_History.Store(sent);
+    NetCodec::QuantizeSnapshot(stored);
+    if (carry) CarryForward(stored, *baseline);
+
+    if (entropyCoded)         m_Models.Store(sent.tickId, m_WorkModels);
+    else if (baseModels)      m_Models.Store(sent.tickId, *baseModels);
+    else if (m_EntropyCoding) m_Models.Store(sent.tickId, SnapshotEntropyModels());
+
+    if (baseline) m_DeltaCount++;
+    else          m_FullCount++;
+
+    return size;
+}
+
+//-----------------------------------------------------------------------------
+// EncodeEntropy - Range-coded payload, 0 if it does not fit capacity
+//
+// Starts from the baseline's models (fresh ones for a full snapshot or a
+// baseline without models); m_WorkModels holds the result.
+//-----------------------------------------------------------------------------
+size_t SnapshotDeltaEncoder::EncodeEntropy(const Snapshot& snapshot, const Snapshot* baseline,
+                                           const SnapshotEntropyModels* baseModels,
+                                           uint8_t* out, size_t capacity)
+{
+    m_WorkModels = baseModels ? *baseModels : SnapshotEntropyModels();
+
+    BitWriter w(out, capacity);
+    WriteDeltaHeader(w, snapshot.tickId, baseline, true, true);
+    size_t headerSize = w.Finish();
+    if (headerSize == 0) return 0;
+
+    RangeEncoder rc(out + headerSize, capacity - headerSize);
+    SnapshotEntropy::WriteSnapshot(rc, m_WorkModels, snapshot, baseline);
+    size_t bodySize = rc.Finish();
+    if (rc.HasOverflow()) return 0;
+
+    return headerSize + bodySize;
+}
+
+//-----------------------------------------------------------------------------
+// ApplyBudget - Copy the header and the remote entries that fit the budget
+//-----------------------------------------------------------------------------
+const Snapshot& SnapshotDeltaEncoder::ApplyBudget(const Snapshot& snapshot, const Snapshot* baseline)
+{
+    std::memcpy(&m_Budgeted, &snapshot, SNAPSHOT_HEADER_SIZE);
+    m_Budgeted.remotePlayerCount = 0;
+
+    // Exact cost of everything but the remote entries
+    uint8_t scratch[(DELTA_HEADER_MAX_BITS + NetCodec::SNAPSHOT_HEADER_MAX_BITS +
+                     NetCodec::STATE_MAX_BITS + 7) / 8];
+    BitWriter probe(scratch, sizeof(scratch));
+    WriteDeltaHeader(probe, snapshot.tickId, baseline, m_EntropyCoding, false);
+    NetCodec::WriteSnapshot(probe, m_Budgeted, baseline);
+
+    size_t budgetBits = m_ByteBudget * 8;
+    size_t fixedBits = probe.GetBitsWritten();
+    budgetBits = (budgetBits > fixedBits) ? budgetBits - fixedBits : 0;
+
+    m_Prioritizer.Select(snapshot, baseline, budgetBits, m_Budgeted);
+    return m_Budgeted;
+}
+
+//=============================================================================
+// SnapshotDeltaDecoder
+//=============================================================================
+
+void SnapshotDeltaDecoder::Reset()
+{
+    m_Baselines.Clear();
+    m_NewestTick = 0;
+    m_HasDecoded = false;
+    m_MissingBaselineCount = 0;
+    m_Models.Clear();
+}
+
+bool SnapshotDeltaDecoder::Decode(const uint8_t* data, size_t size, Snapshot& outSnapshot)
+{
+    BitReader r(data, size);
+
+    bool hasBaseline = r.ReadBool();
+    bool entropyCoded = m_EntropyCoding && r.ReadBool();
+    uint32_t tickId = static_cast<uint32_t>(r.ReadVarint());
+    if (r.HasOverflow()) return false;
+
+    const Snapshot* baseline = nullptr;
+    uint32_t age = 0;
+    if (hasBaseline)
+    {
+        age = static_cast<uint32_t>(r.ReadVarint());
+        if (r.HasOverflow() || age == 0) return false;
+
+        baseline = m_Baselines.Find(tickId - age);
+        if (!baseline)
+        {
+            // Server used a baseline we no longer have; wait for a newer ack
+            m_MissingBaselineCount++;
+            return false;
+        }
+    }
+
+    // Decode in place (outSnapshot may be a pooled slot). Remote entries are
+    // written as they are read, so only the fixed header needs clearing.
+    std::memset(&outSnapshot, 0, SNAPSHOT_HEADER_SIZE);
+    outSnapshot.tickId = tickId;
+
+    const SnapshotEntropyModels* baseModels =
+        (m_EntropyCoding && baseline) ? m_Models.Find(baseline->tickId) : nullptr;
+    if (entropyCoded)
+    {
+        // Body starts at the byte after the header
+        m_WorkModels = baseModels ? *baseModels : SnapshotEntropyModels();
+        size_t offset = (r.GetBitsRead() + 7) / 8;
+        RangeDecoder rc(data + offset, size - offset);
+        if (!SnapshotEntropy::ReadSnapshot(rc, m_WorkModels, outSnapshot, baseline) || !rc.IsAtEnd()) return false;
+    }
+    else
+    {
+        if (!NetCodec::ReadSnapshot(r, outSnapshot, baseline) || !r.IsAtEnd()) return false;
+    }
+
+    // Mirror the encoder: keep omitted players in the stored baseline
+    Snapshot& stored = m_Baselines.Store(outSnapshot);
+    if (baseline && CanCarryForward(age)) CarryForward(stored, *baseline);
+
+    if (entropyCoded)         m_Models.Store(tickId, m_WorkModels);
+    else if (baseModels)      m_Models.Store(tickId, *baseModels);
+    else if (m_EntropyCoding) m_Models.Store(tickId, SnapshotEntropyModels());
+
+    if (!m_HasDecoded || tickId > m_NewestTick)
+    {
+        m_NewestTick = tickId;
+        m_HasDecoded = true;
+    }
+
+    return true;
+}
@@ -0,0 +1,184 @@
+#pragma once
+//=============================================================================
+// snapshot_delta.h
+//
+// Delta compression for Snapshot against the last acknowledged baseline.
+// Shared between game_client and game_server (maintain in sync).
+//
+// Protocol:
+//   Server: keeps a ring of recently sent snapshots (SnapshotHistory).
+//           Each new snapshot is encoded per-field against the newest
+//           snapshot the client has acknowledged. If there is no usable
+//           baseline (no ack yet, or it fell out of the ring) the snapshot
+//           is sent in full.
+//   Client: keeps a ring of decoded snapshots (SnapshotBaselineStore) keyed
+//           by tickId, decodes deltas against them and acks every tick it
+//           successfully decoded (PacketType::SNAPSHOT_ACK).
+//
+// Wire layout (bit-packed, see net_codec.h for field quantization):
+//   1 bit   HAS_BASELINE
+//   1 bit   ENTROPY_CODED            only with entropy coding enabled
+//   varint  tickId
+//   varint  tickId - baselineTick    only if HAS_BASELINE
+//   ...     NetCodec snapshot body   (delta vs. baseline, or full)
+//
+// Entropy coding (NetClientCaps::SNAPSHOT_ENTROPY, both sides enable it for
+// the whole session): the encoder also range codes the body
+// (snapshot_entropy.h) and sends that instead if it is smaller, marked by
+// ENTROPY_CODED and starting at the next byte boundary. Both sides keep the
+// context models each snapshot ended with next to it in the ring; a delta
+// continues from its baseline's models, a full snapshot starts fresh ones.
+// A snapshot sent bit-packed keeps its baseline's models unchanged.
+//
+// Both sides keep baselines at wire precision (NetCodec::QuantizeSnapshot),
+// so "unchanged" is decided on identical quantized values.
+//
+// Remote players left out of a delta snapshot (interest management, byte
+// budget) are carried forward from its baseline into the stored copy on
+// both sides, so they are still delta-encoded when they are next sent.
+// The decoded output itself only contains what was on the wire.
+//
+// With a byte budget set, the encoder picks remote entries by accumulated
+// priority (snapshot_priority.h) until the payload would exceed it. The
+// header and local player are always sent. Entries are costed bit-packed,
+// so an entropy coded payload stays below the budget.
+//
+// A payload larger than one datagram is carried in SNAPSHOT_PART packets
+// (snapshot_parts.h) and decoded once reassembled.
+//=============================================================================
+
+#include "net_common.h"
+#include "net_codec.h"
+#include "snapshot_entropy.h"
+#include "snapshot_priority.h"
+#include <cstddef>
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+// Size limits
+//-----------------------------------------------------------------------------
+static constexpr size_t SNAPSHOT_HISTORY_SIZE = 32;  // 1s @ 32Hz, 250ms @ 128Hz (older acks get a full snapshot)
+
+// Worst case: every field of every player changed
+static constexpr size_t SNAPSHOT_DELTA_MAX_SIZE =
+    (2 + 2 * NetCodec::VARINT32_MAX_BITS + NetCodec::SNAPSHOT_MAX_BITS + 7) / 8;
+
+//-----------------------------------------------------------------------------
+// SnapshotRing - Fixed-size ring of snapshots indexed by tickId
+//
+// Slot = tickId % SNAPSHOT_HISTORY_SIZE; a lookup only succeeds if the slot
+// still holds that exact tick (older ticks are overwritten silently).
+//-----------------------------------------------------------------------------
+class SnapshotRing
+{
+public:
+    void Clear();
+    Snapshot& Store(const Snapshot& snapshot);   // Copies the valid part only
+    const Snapshot* Find(uint32_t tickId) const;
+
+private:
+    Snapshot m_Slots[SNAPSHOT_HISTORY_SIZE] = {};
+    bool m_Valid[SNAPSHOT_HISTORY_SIZE] = {};
+};
+
+// Server keeps what it sent, client keeps what it decoded
+using SnapshotHistory = SnapshotRing;
+using SnapshotBaselineStore = SnapshotRing;
+using SnapshotHistoryModels = SnapshotModelRing<SNAPSHOT_HISTORY_SIZE>;
+
+//-----------------------------------------------------------------------------
+// SnapshotDeltaEncoder - Server side (one per client connection)
+//-----------------------------------------------------------------------------
+class SnapshotDeltaEncoder
+{
+public:
+    void Reset();
+
+    // Client acknowledged receipt of tickId (out-of-order acks are ignored)
+    void Acknowledge(uint32_t tickId);
+
+    // Encode snapshot into out[0..capacity). Returns bytes written, 0 on error.
+    // The snapshot is recorded in the history for use as a future baseline.
+    size_t Encode(const Snapshot& snapshot, uint8_t* out, size_t capacity);
+
+    bool HasAck() const { return m_HasAck; }
+    uint32_t GetAckedTick() const { return m_AckedTick; }
+
+    // Upper bound for Encode's output (0 = unlimited). Remote entries that
+    // do not fit are deferred with their priority kept.
+    void SetByteBudget(size_t bytes) { m_ByteBudget = bytes; }
+    size_t GetByteBudget() const { return m_ByteBudget; }
+    void SetPrioritySettings(const SnapshotPrioritySettings& settings) { m_Prioritizer.SetSettings(settings); }
+
+    // Range code payloads where that is smaller. Only for clients that
+    // advertised NetClientCaps::SNAPSHOT_ENTROPY; set before the first
+    // Encode (or right after Reset).
+    void SetEntropyCoding(bool enabled) { m_EntropyCoding = enabled; }
+    bool IsEntropyCoding() const { return m_EntropyCoding; }
+
+    // Statistics
+    uint32_t GetFullCount() const { return m_FullCount; }
+    uint32_t GetDeltaCount() const { return m_DeltaCount; }
+    uint32_t GetEntropyCodedCount() const { return m_EntropyCodedCount; }
+    const SnapshotPriorityStats& GetPriorityStats() const { return m_Prioritizer.GetLastStats(); }
+
+private:
+    const Snapshot& ApplyBudget(const Snapshot& snapshot, const Snapshot* baseline);
+    size_t EncodeEntropy(const Snapshot& snapshot, const Snapshot* baseline,
+                         const SnapshotEntropyModels* baseModels, uint8_t* out, size_t capacity);
+
+    SnapshotHistory m_History;
+    uint32_t m_AckedTick = 0;
+    bool m_HasAck = false;
+
+    size_t m_ByteBudget = 0;
+    SnapshotPrioritizer m_Prioritizer;
+    Snapshot m_Budgeted = {};              // Entries that fit this tick
+
+    bool m_EntropyCoding = false;
+    SnapshotHistoryModels m_Models;
+    SnapshotEntropyModels m_WorkModels;
+    uint8_t m_EntropyBuffer[SNAPSHOT_DELTA_MAX_SIZE];
+
+    uint32_t m_FullCount = 0;
+    uint32_t m_DeltaCount = 0;
+    uint32_t m_EntropyCodedCount = 0;
+};
+
+//-----------------------------------------------------------------------------
+// SnapshotDeltaDecoder - Client side
+//-----------------------------------------------------------------------------
+class SnapshotDeltaDecoder
+{
+public:
+    void Reset();
+
+    // Decode a SNAPSHOT_DELTA payload (without the PacketType byte).
+    // Returns false if the packet is malformed or its baseline is unknown
+    // (outSnapshot is then undefined). On success the result is stored as a
+    // baseline for later deltas.
+    bool Decode(const uint8_t* data, size_t size, Snapshot& outSnapshot);
+
+    // Expect the ENTROPY_CODED bit, i.e. NetClientCaps::SNAPSHOT_ENTROPY was
+    // advertised. Set before the first Decode (or right after Reset).
+    void SetEntropyCoding(bool enabled) { m_EntropyCoding = enabled; }
+    bool IsEntropyCoding() const { return m_EntropyCoding; }
+
+    // Newest successfully decoded tick (what the client should ack)
+    bool HasDecoded() const { return m_HasDecoded; }
+    uint32_t GetNewestTick() const { return m_NewestTick; }
+
+    // Statistics
+    uint32_t GetMissingBaselineCount() const { return m_MissingBaselineCount; }
+
+private:
+    SnapshotBaselineStore m_Baselines;
+    uint32_t m_NewestTick = 0;
+    bool m_HasDecoded = false;
+
+    bool m_EntropyCoding = false;
+    SnapshotHistoryModels m_Models;
+    SnapshotEntropyModels m_WorkModels;
+
+    uint32_t m_MissingBaselineCount = 0;
+};
@@ -0,0 +1,443 @@
+//=============================================================================
+// snapshot_entropy.cpp
+//
+// Range-coded snapshot body with adaptive per-field context models.
+//=============================================================================
+
+#include "snapshot_entropy.h"
+
+using NetCodec::QuantizedState;
+
+namespace {
+
+// Player state fields in coding order (contexts of the changed flags)
+enum Field
+{
+    FIELD_TICK,
+    FIELD_VEL_X, FIELD_VEL_Y, FIELD_VEL_Z,
+    FIELD_POS_X, FIELD_POS_Y, FIELD_POS_Z,
+    FIELD_YAW,
+    FIELD_PITCH,
+    FIELD_STATE_FLAGS,
+    FIELD_HEALTH,
+    FIELD_FIRE_COUNTER,
+    FIELD_COUNT
+};
+static_assert(FIELD_COUNT == SnapshotEntropyModels::FIELD_COUNT, "Field list out of sync");
+
+const NetCodec::QuantRange POS_RANGES[3] = { NetCodec::POS_X, NetCodec::POS_Y, NetCodec::POS_Z };
+
+// Full-state values are coded relative to the middle of their range
+constexpr int32_t VEL_CENTER = static_cast<int32_t>((NetCodec::VEL.MaxValue() + 1) / 2);       // 0 m/s
+constexpr int32_t PITCH_CENTER = static_cast<int32_t>((NetCodec::PITCH.MaxValue() + 1) / 2);   // Level
+
+// Baselines are at most SNAPSHOT_HISTORY_SIZE ticks old; anything longer is
+// a paused server and not worth extrapolating
+constexpr int64_t PREDICT_MAX_US = 2000000;
+
+//-----------------------------------------------------------------------------
+// Position prediction
+//
+// Half the velocity step equals the position step on every axis (to 0.03%),
+// so moving at the mean of the old and new velocity for dt seconds covers
+// (baseVel + vel - VEL.MaxValue()) * dt position steps. Integer-only, so
+// both sides predict bit-identical values.
+//-----------------------------------------------------------------------------
+uint32_t PredictPosition(uint32_t base, uint32_t baseVel, uint32_t vel, int64_t dtUs, uint32_t maxValue)
+{
+    const int64_t steps = (static_cast<int64_t>(baseVel) + vel - NetCodec::VEL.MaxValue()) * dtUs;
+    const int64_t rounded = (steps >= 0 ? steps + 500000 : steps - 500000) / 1000000;
+    const int64_t predicted = static_cast<int64_t>(base) + rounded;
+
+    if (predicted < 0) return 0;
+    if (predicted > maxValue) return maxValue;
+    return static_cast<uint32_t>(predicted);
+}
+
+int64_t GetPredictionTime(uint64_t us, uint64_t baseUs)
+{
+    if (us <= baseUs) return 0;
+    const uint64_t dt = us - baseUs;
+    return (dt > static_cast<uint64_t>(PREDICT_MAX_US)) ? PREDICT_MAX_US : static_cast<int64_t>(dt);
+}
+
+//-----------------------------------------------------------------------------
+// Signed residuals (never zero: the changed flag already says "same")
+//-----------------------------------------------------------------------------
+template <int MAX_BITS>
+void EncodeResidual(RangeEncoder& rc, AdaptiveIntModel<MAX_BITS>& model, int32_t residual)
+{
+    model.Encode(rc, NetCodec::ZigZag(residual) - 1u);
+}
+
+template <int MAX_BITS>
+int32_t DecodeResidual(RangeDecoder& rc, AdaptiveIntModel<MAX_BITS>& model)
+{
+    return NetCodec::UnZigZag(model.Decode(rc) + 1u);
+}
+
+// Quantized value + residual, false if it leaves 0..maxValue
+bool ApplyResidual(uint32_t base, int32_t residual, uint32_t maxValue, uint32_t& out)
+{
+    const int64_t value = static_cast<int64_t>(base) + residual;
+    if (value < 0 || value > maxValue) return false;
+    out = static_cast<uint32_t>(value);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Up to 64 raw bits: 7-bit length, then the value
+//-----------------------------------------------------------------------------
+void EncodeDirect64(RangeEncoder& rc, uint64_t value)
+{
+    const uint32_t high = static_cast<uint32_t>(value >> 32);
+    const int length = high ? 32 + RangeCoder::BitWidth(high) : RangeCoder::BitWidth(static_cast<uint32_t>(value));
+
+    rc.EncodeDirect(static_cast<uint32_t>(length), 7);
+    if (length > 32) rc.EncodeDirect(high, length - 32);
+    rc.EncodeDirect(static_cast<uint32_t>(value), length > 32 ? 32 : length);
+}
+
+bool DecodeDirect64(RangeDecoder& rc, uint64_t& out)
+{
+    const int length = static_cast<int>(rc.DecodeDirect(7));
+    if (length > 64) return false;
+
+    const uint64_t high = (length > 32) ? rc.DecodeDirect(length - 32) : 0;
+    out = (high << 32) | rc.DecodeDirect(length > 32 ? 32 : length);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Player state
+//-----------------------------------------------------------------------------
+class ChangedFlags
+{
+public:
+    explicit ChangedFlags(SnapshotEntropyModels& models) : m_Models(models) {}
+
+    bool Encode(RangeEncoder& rc, int field, bool changed)
+    {
+        rc.EncodeBit(m_Models.changed[field][m_Previous], changed ? 1u : 0u);
+        m_Previous = changed ? 1u : 0u;
+        return changed;
+    }
+
+    bool Decode(RangeDecoder& rc, int field)
+    {
+        m_Previous = rc.DecodeBit(m_Models.changed[field][m_Previous]);
+        return m_Previous != 0;
+    }
+
+private:
+    SnapshotEntropyModels& m_Models;
+    uint32_t m_Previous = 0;
+};
+
+void WriteStateDelta(RangeEncoder& rc, SnapshotEntropyModels& m, const NetPlayerState& state,
+                     const NetPlayerState& base, uint32_t snapshotTick, int64_t dtUs)
+{
+    const QuantizedState q = NetCodec::QuantizeState(state);
+    const QuantizedState b = NetCodec::QuantizeState(base);
+    ChangedFlags flags(m);
+
+    if (flags.Encode(rc, FIELD_TICK, state.tickId != snapshotTick))
+        EncodeResidual(rc, m.tick, static_cast<int32_t>(state.tickId - snapshotTick));
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (flags.Encode(rc, FIELD_VEL_X + i, q.vel[i] != b.vel[i]))
+            EncodeResidual(rc, m.velDelta[i], static_cast<int32_t>(q.vel[i] - b.vel[i]));
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        const uint32_t predicted = PredictPosition(b.pos[i], b.vel[i], q.vel[i], dtUs, POS_RANGES[i].MaxValue());
+        if (flags.Encode(rc, FIELD_POS_X + i, q.pos[i] != predicted))
+            EncodeResidual(rc, m.posDelta[i], static_cast<int32_t>(q.pos[i] - predicted));
+    }
+
+    if (flags.Encode(rc, FIELD_YAW, q.yaw != b.yaw))
+        EncodeResidual(rc, m.yawDelta, static_cast<int16_t>(static_cast<uint16_t>(q.yaw - b.yaw)));
+    if (flags.Encode(rc, FIELD_PITCH, q.pitch != b.pitch))
+        EncodeResidual(rc, m.pitchDelta, static_cast<int32_t>(q.pitch - b.pitch));
+    if (flags.Encode(rc, FIELD_STATE_FLAGS, q.stateFlags != b.stateFlags))
+        m.stateFlags.Encode(rc, q.stateFlags);
+    if (flags.Encode(rc, FIELD_HEALTH, q.health != b.health))
+        EncodeResidual(rc, m.healthDelta, static_cast<int32_t>(q.health) - b.health);
+    if (flags.Encode(rc, FIELD_FIRE_COUNTER, q.fireCounter != b.fireCounter))
+        m.fireDelta.Encode(rc, static_cast<uint16_t>(q.fireCounter - b.fireCounter) - 1u);
+}
+
+bool ReadStateDelta(RangeDecoder& rc, SnapshotEntropyModels& m, NetPlayerState& out,
+                    const NetPlayerState& base, uint32_t snapshotTick, int64_t dtUs)
+{
+    const QuantizedState b = NetCodec::QuantizeState(base);
+    QuantizedState q = b;
+    ChangedFlags flags(m);
+    bool ok = true;
+
+    out = base;
+    out.tickId = snapshotTick;
+    if (flags.Decode(rc, FIELD_TICK))
+        out.tickId = snapshotTick + static_cast<uint32_t>(DecodeResidual(rc, m.tick));
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (flags.Decode(rc, FIELD_VEL_X + i))
+            ok &= ApplyResidual(b.vel[i], DecodeResidual(rc, m.velDelta[i]), NetCodec::VEL.MaxValue(), q.vel[i]);
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        const uint32_t maxValue = POS_RANGES[i].MaxValue();
+        q.pos[i] = PredictPosition(b.pos[i], b.vel[i], q.vel[i], dtUs, maxValue);
+        if (flags.Decode(rc, FIELD_POS_X + i))
+            ok &= ApplyResidual(q.pos[i], DecodeResidual(rc, m.posDelta[i]), maxValue, q.pos[i]);
+    }
+
+    if (flags.Decode(rc, FIELD_YAW))
+        q.yaw = (b.yaw + static_cast<uint32_t>(DecodeResidual(rc, m.yawDelta))) & ((1u << NetCodec::YAW_BITS) - 1u);
+    if (flags.Decode(rc, FIELD_PITCH))
+        ok &= ApplyResidual(b.pitch, DecodeResidual(rc, m.pitchDelta), NetCodec::PITCH.MaxValue(), q.pitch);
+    if (flags.Decode(rc, FIELD_STATE_FLAGS))
+        q.stateFlags = m.stateFlags.Decode(rc);
+    if (flags.Decode(rc, FIELD_HEALTH))
+    {
+        uint32_t health = 0;
+        ok &= ApplyResidual(b.health, DecodeResidual(rc, m.healthDelta), 0xFF, health);
+        q.health = static_cast<uint8_t>(health);
+    }
+    if (flags.Decode(rc, FIELD_FIRE_COUNTER))
+        q.fireCounter = static_cast<uint16_t>(b.fireCounter + m.fireDelta.Decode(rc) + 1u);
+
+    NetCodec::DequantizeState(q, out);
+    return ok;
+}
+
+void WriteStateFull(RangeEncoder& rc, SnapshotEntropyModels& m, const NetPlayerState& state,
+                    uint32_t snapshotTick)
+{
+    const QuantizedState q = NetCodec::QuantizeState(state);
+
+    const bool tickDiffers = (state.tickId != snapshotTick);
+    rc.EncodeBit(m.tickDiffers, tickDiffers ? 1u : 0u);
+    if (tickDiffers) EncodeResidual(rc, m.tick, static_cast<int32_t>(state.tickId - snapshotTick));
+
+    for (int i = 0; i < 3; i++)
+        m.velFull.Encode(rc, NetCodec::ZigZag(static_cast<int32_t>(q.vel[i]) - VEL_CENTER));
+    for (int i = 0; i < 3; i++)
+        rc.EncodeDirect(q.pos[i], POS_RANGES[i].bits);
+
+    rc.EncodeDirect(q.yaw, NetCodec::YAW_BITS);
+    m.pitchFull.Encode(rc, NetCodec::ZigZag(static_cast<int32_t>(q.pitch) - PITCH_CENTER));
+    m.stateFlags.Encode(rc, q.stateFlags);
+    m.healthFull.Encode(rc, q.health);
+    m.fireFull.Encode(rc, q.fireCounter);
+}
+
+bool ReadStateFull(RangeDecoder& rc, SnapshotEntropyModels& m, NetPlayerState& out, uint32_t snapshotTick)
+{
+    QuantizedState q;
+    bool ok = true;
+
+    out.tickId = snapshotTick;
+    if (rc.DecodeBit(m.tickDiffers))
+        out.tickId = snapshotTick + static_cast<uint32_t>(DecodeResidual(rc, m.tick));
+
+    for (int i = 0; i < 3; i++)
+        ok &= ApplyResidual(VEL_CENTER, NetCodec::UnZigZag(m.velFull.Decode(rc)), NetCodec::VEL.MaxValue(), q.vel[i]);
+    for (int i = 0; i < 3; i++)
+        q.pos[i] = rc.DecodeDirect(POS_RANGES[i].bits);
+
+    q.yaw = rc.DecodeDirect(NetCodec::YAW_BITS);
+    ok &= ApplyResidual(PITCH_CENTER, NetCodec::UnZigZag(m.pitchFull.Decode(rc)), NetCodec::PITCH.MaxValue(), q.pitch);
+    q.stateFlags = m.stateFlags.Decode(rc);
+    q.health = static_cast<uint8_t>(m.healthFull.Decode(rc));
+    q.fireCounter = static_cast<uint16_t>(m.fireFull.Decode(rc));
+
+    NetCodec::DequantizeState(q, out);
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// BaselineEntries - Forward-only walk over the baseline's remote entries
+//
+// Same matching as NetCodec's BaselineCursor, but yields the whole entry
+// so the team can be predicted as well.
+//-----------------------------------------------------------------------------
+class BaselineEntries
+{
+public:
+    explicit BaselineEntries(const Snapshot* baseline)
+        : m_pBaseline(baseline)
+        , m_Count(baseline ? baseline->remotePlayerCount : 0)
+    {
+        if (m_Count > MAX_PLAYERS - 1) m_Count = MAX_PLAYERS - 1;
+    }
+
+    const RemotePlayerEntry* Find(uint8_t playerId)
+    {
+        while (m_Index < m_Count && m_pBaseline->remotePlayers[m_Index].playerId < playerId)
+            m_Index++;
+
+        if (m_Index < m_Count && m_pBaseline->remotePlayers[m_Index].playerId == playerId)
+            return &m_pBaseline->remotePlayers[m_Index++];
+        return nullptr;
+    }
+
+private:
+    const Snapshot* m_pBaseline;
+    uint8_t m_Count;
+    uint8_t m_Index = 0;
+};
+
+// Team context: 0 without baseline, else 1 + the baseline's team
+uint32_t TeamContext(const uint8_t* baseTeam)
+{
+    return baseTeam ? 1u + (*baseTeam & 1u) : 0u;
+}
+
+} // namespace
+
+namespace SnapshotEntropy {
+
+//=============================================================================
+// Snapshot
+//=============================================================================
+
+void WriteSnapshot(RangeEncoder& rc, SnapshotEntropyModels& m,
+                   const Snapshot& snapshot, const Snapshot* baseline)
+{
+    uint8_t remoteCount = snapshot.remotePlayerCount;
+    if (remoteCount > MAX_PLAYERS - 1) remoteCount = MAX_PLAYERS - 1;
+
+    const uint64_t us = NetCodec::ToMicroseconds(snapshot.serverTime);
+    const uint64_t baseUs = baseline ? NetCodec::ToMicroseconds(baseline->serverTime) : 0;
+    const int64_t dtUs = GetPredictionTime(us, baseUs);
+
+    //-------------------------------------------------------------------------
+    // Header
+    //-------------------------------------------------------------------------
+    if (baseline)
+    {
+        const int64_t timeDelta = static_cast<int64_t>(us - baseUs);
+        const bool escape = timeDelta < INT32_MIN || timeDelta > INT32_MAX;
+        rc.EncodeBit(m.timeEscape, escape ? 1u : 0u);
+        if (escape) EncodeDirect64(rc, us);
+        else        m.timeDelta.Encode(rc, NetCodec::ZigZag(static_cast<int32_t>(timeDelta)));
+
+        const bool idChanged = (snapshot.localPlayerId != baseline->localPlayerId);
+        rc.EncodeBit(m.localIdChanged, idChanged ? 1u : 0u);
+        if (idChanged) rc.EncodeDirect(snapshot.localPlayerId, 8);
+
+        rc.EncodeBit(m.team[TeamContext(&baseline->localPlayerTeam)], snapshot.localPlayerTeam & 1u);
+        m.remoteCountDelta.Encode(rc, NetCodec::ZigZag(static_cast<int32_t>(remoteCount) - baseline->remotePlayerCount));
+        m.ackDelta.Encode(rc, NetCodec::ZigZag(static_cast<int32_t>(snapshot.ackInputTick - baseline->ackInputTick)));
+    }
+    else
+    {
+        EncodeDirect64(rc, us);
+        rc.EncodeDirect(snapshot.localPlayerId, 8);
+        rc.EncodeBit(m.team[TeamContext(nullptr)], snapshot.localPlayerTeam & 1u);
+        rc.EncodeDirect(remoteCount, 8);
+        rc.EncodeDirect(snapshot.ackInputTick, 32);
+    }
+    m.inputDepth.Encode(rc, NetCodec::SaturateInputDepth(snapshot.inputBufferDepth));
+
+    //-------------------------------------------------------------------------
+    // Players
+    //-------------------------------------------------------------------------
+    if (baseline) WriteStateDelta(rc, m, snapshot.localPlayer, baseline->localPlayer, snapshot.tickId, dtUs);
+    else          WriteStateFull(rc, m, snapshot.localPlayer, snapshot.tickId);
+
+    BaselineEntries entries(baseline);
+    int32_t previousId = -1;
+    for (uint8_t i = 0; i < remoteCount; i++)
+    {
+        const RemotePlayerEntry& entry = snapshot.remotePlayers[i];
+        const RemotePlayerEntry* base = entries.Find(entry.playerId);
+
+        m.playerIdGap.Encode(rc, NetCodec::ZigZag(entry.playerId - previousId - 1));
+        previousId = entry.playerId;
+        rc.EncodeBit(m.team[TeamContext(base ? &base->teamId : nullptr)], entry.teamId & 1u);
+
+        if (base) WriteStateDelta(rc, m, entry.state, base->state, snapshot.tickId, dtUs);
+        else      WriteStateFull(rc, m, entry.state, snapshot.tickId);
+    }
+}
+
+bool ReadSnapshot(RangeDecoder& rc, SnapshotEntropyModels& m, Snapshot& out, const Snapshot* baseline)
+{
+    const uint32_t tickId = out.tickId;
+
+    //-------------------------------------------------------------------------
+    // Header
+    //-------------------------------------------------------------------------
+    uint64_t us = 0;
+    const uint64_t baseUs = baseline ? NetCodec::ToMicroseconds(baseline->serverTime) : 0;
+    uint32_t remoteCount = 0;
+
+    if (baseline)
+    {
+        if (rc.DecodeBit(m.timeEscape))
+        {
+            if (!DecodeDirect64(rc, us)) return false;
+        }
+        else
+        {
+            us = baseUs + static_cast<uint64_t>(static_cast<int64_t>(NetCodec::UnZigZag(m.timeDelta.Decode(rc))));
+        }
+
+        out.localPlayerId = rc.DecodeBit(m.localIdChanged) ? static_cast<uint8_t>(rc.DecodeDirect(8))
+                                                             : baseline->localPlayerId;
+        out.localPlayerTeam = static_cast<uint8_t>(rc.DecodeBit(m.team[TeamContext(&baseline->localPlayerTeam)]));
+
+        const int32_t count = baseline->remotePlayerCount + NetCodec::UnZigZag(m.remoteCountDelta.Decode(rc));
+        if (count < 0) return false;
+        remoteCount = static_cast<uint32_t>(count);
+
+        out.ackInputTick = baseline->ackInputTick + static_cast<uint32_t>(NetCodec::UnZigZag(m.ackDelta.Decode(rc)));
+    }
+    else
+    {
+        if (!DecodeDirect64(rc, us)) return false;
+        out.localPlayerId = static_cast<uint8_t>(rc.DecodeDirect(8));
+        out.localPlayerTeam = static_cast<uint8_t>(rc.DecodeBit(m.team[TeamContext(nullptr)]));
+        remoteCount = rc.DecodeDirect(8);
+        out.ackInputTick = rc.DecodeDirect(32);
+    }
+    out.inputBufferDepth = static_cast<uint8_t>(m.inputDepth.Decode(rc));
+
+    if (remoteCount > MAX_PLAYERS - 1 || rc.HasOverflow()) return false;
+    out.remotePlayerCount = static_cast<uint8_t>(remoteCount);
+    out.serverTime = static_cast<double>(us) / 1000000.0;
+    const int64_t dtUs = GetPredictionTime(us, baseUs);
+
+    //-------------------------------------------------------------------------
+    // Players
+    //-------------------------------------------------------------------------
+    bool ok = baseline ? ReadStateDelta(rc, m, out.localPlayer, baseline->localPlayer, tickId, dtUs)
+                       : ReadStateFull(rc, m, out.localPlayer, tickId);
+
+    BaselineEntries entries(baseline);
+    int32_t previousId = -1;
+    for (uint8_t i = 0; i < out.remotePlayerCount && ok; i++)
+    {
+        RemotePlayerEntry& entry = out.remotePlayers[i];
+        const int32_t playerId = previousId + 1 + NetCodec::UnZigZag(m.playerIdGap.Decode(rc));
+        if (playerId < 0 || playerId > 0xFF) return false;
+        previousId = playerId;
+
+        entry.playerId = static_cast<uint8_t>(playerId);
+        entry.padding[0] = entry.padding[1] = 0;
+        const RemotePlayerEntry* base = entries.Find(entry.playerId);
+        entry.teamId = static_cast<uint8_t>(rc.DecodeBit(m.team[TeamContext(base ? &base->teamId : nullptr)]));
+
+        ok = base ? ReadStateDelta(rc, m, entry.state, base->state, tickId, dtUs)
+                  : ReadStateFull(rc, m, entry.state, tickId);
+        ok &= !rc.HasOverflow();
+    }
+
+    return ok && !rc.HasOverflow();
+}
+
+} // namespace SnapshotEntropy
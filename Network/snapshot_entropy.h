@@ -0,0 +1,126 @@
+#pragma once
+//=============================================================================
+// snapshot_entropy.h
+//
+// Range-coded snapshot body with adaptive per-field context models.
+// Shared between game_client and game_server (maintain in sync).
+//
+// Same quantization as net_codec.h, but instead of fixed-width fields every
+// value is coded through a model that learns its distribution:
+//
+//   Field          Delta (vs. baseline)                    Full
+//   -------------  --------------------------------------  ------------------
+//   changed flags  one bit per field, context = whether     -
+//                  the previous field changed
+//   velocity       residual vs. baseline                   vs. zero
+//   position       residual vs. baseline advanced by the   raw bits
+//                  mean of old and new velocity over the
+//                  serverTime gap
+//   yaw            wrapped residual                        raw bits
+//   pitch          residual                                vs. level
+//   stateFlags     bit tree over the 7-bit value (shared)
+//   health, fire   residual                                value
+//   playerId       gap to the previous entry's id
+//   header         serverTime / ack / count vs. baseline   raw bits
+//
+// Lockstep: the models a snapshot was coded with are kept next to it in
+// both the server history and the client baseline store. A delta starts
+// from the models stored with its baseline and a full snapshot from fresh
+// ones, so a lost packet never desynchronizes the two sides, and a full
+// snapshot resynchronizes them outright. SnapshotDeltaEncoder/Decoder do
+// the bookkeeping (snapshot_delta.h).
+//=============================================================================
+
+#include "net_codec.h"
+#include "range_coder.h"
+#include <cstddef>
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+// SnapshotEntropyModels - Every context of one snapshot stream (~4.2 KB)
+//-----------------------------------------------------------------------------
+struct SnapshotEntropyModels
+{
+    static constexpr int FIELD_COUNT = 12;      // NetStateField bits
+
+    // Player state, delta
+    BitModel changed[FIELD_COUNT][2];
+    AdaptiveIntModel<32> tick;                  // vs. snapshot tickId, both modes
+    AdaptiveIntModel<14> velDelta[3];
+    AdaptiveIntModel<17> posDelta[3];
+    AdaptiveIntModel<16> yawDelta;
+    AdaptiveIntModel<17> pitchDelta;
+    AdaptiveIntModel<9>  healthDelta;
+    AdaptiveIntModel<16> fireDelta;
+
+    // Player state, full
+    BitModel tickDiffers;
+    AdaptiveIntModel<14> velFull;
+    AdaptiveIntModel<17> pitchFull;
+    AdaptiveIntModel<8>  healthFull;
+    AdaptiveIntModel<16> fireFull;
+
+    BitTreeModel<NetCodec::STATE_FLAG_BITS> stateFlags;
+
+    // Snapshot header
+    BitModel timeEscape;                        // serverTime gap beyond int32
+    AdaptiveIntModel<32> timeDelta;
+    BitModel localIdChanged;
+    BitModel team[3];                           // Context: no baseline, RED, BLUE
+    AdaptiveIntModel<8> remoteCountDelta;
+    AdaptiveIntModel<32> ackDelta;
+    BitTreeModel<NetCodec::INPUT_DEPTH_BITS> inputDepth;
+
+    // Remote entries
+    AdaptiveIntModel<9> playerIdGap;
+};
+
+//-----------------------------------------------------------------------------
+// SnapshotModelRing - Models each stored snapshot was coded with
+//
+// Same slot scheme as SnapshotRing; Find only succeeds for the exact tick.
+//-----------------------------------------------------------------------------
+template <size_t SIZE>
+class SnapshotModelRing
+{
+public:
+    void Clear()
+    {
+        for (size_t i = 0; i < SIZE; i++)
+            m_Valid[i] = false;
+    }
+
+    void Store(uint32_t tickId, const SnapshotEntropyModels& models)
+    {
+        const size_t slot = tickId % SIZE;
+        m_Slots[slot] = models;
+        m_Ticks[slot] = tickId;
+        m_Valid[slot] = true;
+    }
+
+    const SnapshotEntropyModels* Find(uint32_t tickId) const
+    {
+        const size_t slot = tickId % SIZE;
+        return (m_Valid[slot] && m_Ticks[slot] == tickId) ? &m_Slots[slot] : nullptr;
+    }
+
+private:
+    SnapshotEntropyModels m_Slots[SIZE];
+    uint32_t m_Ticks[SIZE] = {};
+    bool m_Valid[SIZE] = {};
+};
+
+namespace SnapshotEntropy {
+
+//-----------------------------------------------------------------------------
+// Snapshot body, same contract as NetCodec::WriteSnapshot/ReadSnapshot
+// (out.tickId set by the caller, ascending playerIds for cheap entries).
+// models is updated in place: pass a copy of the baseline's models, or
+// fresh ones without a baseline.
+//-----------------------------------------------------------------------------
+void WriteSnapshot(RangeEncoder& rc, SnapshotEntropyModels& models,
+                   const Snapshot& snapshot, const Snapshot* baseline);
+bool ReadSnapshot(RangeDecoder& rc, SnapshotEntropyModels& models,
+                  Snapshot& out, const Snapshot* baseline);
+
+} // namespace SnapshotEntropy
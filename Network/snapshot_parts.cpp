@@ -0,0 +1,119 @@
+//=============================================================================
+// snapshot_parts.cpp
+//
+// Splitting and reassembly of oversized SNAPSHOT_DELTA payloads.
+//=============================================================================
+
+#include "snapshot_parts.h"
+#include "net_reflect.h"
+#include <cstring>
+
+//=============================================================================
+// SnapshotParts
+//=============================================================================
+
+size_t SnapshotParts::GetPartCount(size_t payloadSize)
+{
+    if (payloadSize == 0) return 0;
+    return (payloadSize + SNAPSHOT_PART_DATA_SIZE - 1) / SNAPSHOT_PART_DATA_SIZE;
+}
+
+size_t SnapshotParts::WritePart(const uint8_t* payload, size_t payloadSize, uint32_t tickId,
+                                size_t index, uint8_t* out, size_t capacity)
+{
+    size_t count = GetPartCount(payloadSize);
+    if (count == 0 || count > SNAPSHOT_PART_MAX_COUNT || index >= count) return 0;
+
+    size_t offset = index * SNAPSHOT_PART_DATA_SIZE;
+    size_t length = payloadSize - offset;
+    if (length > SNAPSHOT_PART_DATA_SIZE) length = SNAPSHOT_PART_DATA_SIZE;
+    if (capacity < SNAPSHOT_PART_HEADER_SIZE + length) return 0;
+
+    NetReflect::StoreLE(out, tickId);
+    out[4] = static_cast<uint8_t>(index);
+    out[5] = static_cast<uint8_t>(count);
+    std::memcpy(out + SNAPSHOT_PART_HEADER_SIZE, payload + offset, length);
+
+    return SNAPSHOT_PART_HEADER_SIZE + length;
+}
+
+//=============================================================================
+// SnapshotReassembler
+//=============================================================================
+
+void SnapshotReassembler::Reset()
+{
+    m_PayloadSize = 0;
+    m_TickId = 0;
+    m_InProgress = false;
+    m_PartCount = 0;
+    m_ReceivedMask = 0;
+    m_CompletedTick = 0;
+    m_HasCompleted = false;
+    m_IncompleteCount = 0;
+    m_MalformedCount = 0;
+}
+
+bool SnapshotReassembler::AddPart(const uint8_t* data, size_t size)
+{
+    if (size <= SNAPSHOT_PART_HEADER_SIZE)
+    {
+        m_MalformedCount++;
+        return false;
+    }
+
+    uint32_t tickId = NetReflect::LoadLE<uint32_t>(data);
+    uint8_t index = data[4];
+    uint8_t count = data[5];
+    size_t length = size - SNAPSHOT_PART_HEADER_SIZE;
+
+    // Every part but the last is full
+    bool isLast = (index + 1 == count);
+    if (count == 0 || count > SNAPSHOT_PART_MAX_COUNT || index >= count ||
+        length > SNAPSHOT_PART_DATA_SIZE || (!isLast && length != SNAPSHOT_PART_DATA_SIZE))
+    {
+        m_MalformedCount++;
+        return false;
+    }
+
+    // Late part of a tick we already finished (or one even older)
+    if (m_HasCompleted && tickId <= m_CompletedTick) return false;
+
+    if (m_InProgress && tickId != m_TickId)
+    {
+        if (tickId < m_TickId) return false;
+
+        // Newer tick started: the old one will never complete
+        m_IncompleteCount++;
+        m_InProgress = false;
+    }
+
+    if (!m_InProgress)
+    {
+        m_TickId = tickId;
+        m_PartCount = count;
+        m_ReceivedMask = 0;
+        m_InProgress = true;
+    }
+    else if (count != m_PartCount)
+    {
+        m_MalformedCount++;
+        return false;
+    }
+
+    uint64_t bit = uint64_t(1) << index;
+    if (m_ReceivedMask & bit) return false;   // Duplicate
+
+    size_t offset = index * SNAPSHOT_PART_DATA_SIZE;
+    std::memcpy(m_Buffer + offset, data + SNAPSHOT_PART_HEADER_SIZE, length);
+    m_ReceivedMask |= bit;
+    if (isLast) m_PayloadSize = offset + length;
+
+    uint64_t complete = (count == 64) ? ~uint64_t(0) : ((uint64_t(1) << count) - 1);
+    if (m_ReceivedMask != complete) return false;
+
+    m_InProgress = false;
+    m_CompletedTick = tickId;
+    m_HasCompleted = true;
+    return true;
+}
@@ -0,0 +1,96 @@
+#pragma once
+//=============================================================================
+// snapshot_parts.h
+//
+// Splits SNAPSHOT_DELTA payloads that do not fit one datagram.
+// Shared between game_client and game_server (maintain in sync).
+//
+// Protocol:
+//   Server: if 1 + payload exceeds SNAPSHOT_PACKET_MAX_SIZE and the client
+//           advertised NetClientCaps::SNAPSHOT_PARTS, the encoded payload is
+//           cut into SNAPSHOT_PART packets of at most that size, all sent
+//           unreliably like the delta itself. Smaller payloads still go out
+//           as a single SNAPSHOT_DELTA.
+//   Client: SnapshotReassembler collects the parts of one tick and hands
+//           the rebuilt payload to SnapshotDeltaDecoder. A tick with a
+//           missing part is dropped (and not acked) exactly like a lost
+//           SNAPSHOT_DELTA; parts of a newer tick abandon the older one.
+//
+// Wire layout (after the PacketType byte):
+//   uint32  tickId               (little-endian, as in SNAPSHOT_ACK)
+//   uint8   partIndex            (0..partCount-1)
+//   uint8   partCount
+//   bytes   payload[partIndex * SNAPSHOT_PART_DATA_SIZE ...]
+//=============================================================================
+
+#include "snapshot_delta.h"
+#include <cstddef>
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+// Size limits
+//-----------------------------------------------------------------------------
+
+// Largest snapshot datagram we build, PacketType byte included. Leaves room
+// for ENet's protocol headers under its default 1392-byte MTU, so ENet never
+// has to fragment (and a single lost fragment cannot stall the channel).
+static constexpr size_t SNAPSHOT_PACKET_MAX_SIZE = 1200;
+
+static constexpr size_t SNAPSHOT_PART_HEADER_SIZE = sizeof(uint32_t) + 2;
+static constexpr size_t SNAPSHOT_PART_DATA_SIZE =
+    SNAPSHOT_PACKET_MAX_SIZE - 1 - SNAPSHOT_PART_HEADER_SIZE;
+static constexpr size_t SNAPSHOT_PART_MAX_COUNT =
+    (SNAPSHOT_DELTA_MAX_SIZE + SNAPSHOT_PART_DATA_SIZE - 1) / SNAPSHOT_PART_DATA_SIZE;
+
+static_assert(SNAPSHOT_PART_MAX_COUNT <= 64, "Part mask is a uint64_t");
+
+namespace SnapshotParts {
+
+// Parts needed for a payload of this size (1 = fits a single SNAPSHOT_DELTA)
+size_t GetPartCount(size_t payloadSize);
+
+// Write part `index` of payload into out[0..capacity) without the PacketType
+// byte. Returns bytes written, 0 on error.
+size_t WritePart(const uint8_t* payload, size_t payloadSize, uint32_t tickId,
+                 size_t index, uint8_t* out, size_t capacity);
+
+} // namespace SnapshotParts
+
+//-----------------------------------------------------------------------------
+// SnapshotReassembler - Client side
+//-----------------------------------------------------------------------------
+class SnapshotReassembler
+{
+public:
+    void Reset();
+
+    // Add one SNAPSHOT_PART payload (without the PacketType byte). Returns
+    // true when it completes its tick; the rebuilt payload is then valid
+    // until the next call.
+    bool AddPart(const uint8_t* data, size_t size);
+
+    const uint8_t* GetPayload() const { return m_Buffer; }
+    size_t GetPayloadSize() const { return m_PayloadSize; }
+    size_t GetPartCount() const { return m_PartCount; }
+
+    // Statistics
+    uint32_t GetIncompleteCount() const { return m_IncompleteCount; }   // Ticks abandoned
+    uint32_t GetMalformedCount() const { return m_MalformedCount; }
+
+private:
+    uint8_t m_Buffer[SNAPSHOT_PART_MAX_COUNT * SNAPSHOT_PART_DATA_SIZE];
+    size_t m_PayloadSize = 0;
+
+    // Tick being collected
+    uint32_t m_TickId = 0;
+    bool m_InProgress = false;
+    uint8_t m_PartCount = 0;
+    uint64_t m_ReceivedMask = 0;
+
+    // Newest completed tick; its late duplicates and older ticks are ignored
+    uint32_t m_CompletedTick = 0;
+    bool m_HasCompleted = false;
+
+    uint32_t m_IncompleteCount = 0;
+    uint32_t m_MalformedCount = 0;
+};
@@ -0,0 +1,101 @@
+//=============================================================================
+// snapshot_pool.cpp
+//
+// Preallocated snapshot slots handed out as move-only handles.
+//=============================================================================
+
+#include "snapshot_pool.h"
+
+//=============================================================================
+// SnapshotHandle
+//=============================================================================
+
+SnapshotHandle::SnapshotHandle(SnapshotHandle&& other) noexcept
+    : m_pPool(other.m_pPool)
+    , m_Slot(other.m_Slot)
+{
+    other.m_pPool = nullptr;
+}
+
+SnapshotHandle& SnapshotHandle::operator=(SnapshotHandle&& other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        m_pPool = other.m_pPool;
+        m_Slot = other.m_Slot;
+        other.m_pPool = nullptr;
+    }
+    return *this;
+}
+
+const Snapshot& SnapshotHandle::Get() const
+{
+    return m_pPool->GetSlot(m_Slot).snapshot;
+}
+
+double SnapshotHandle::GetArrivalTime() const
+{
+    return m_pPool ? m_pPool->GetSlot(m_Slot).arrivalTime : -1.0;
+}
+
+void SnapshotHandle::Release()
+{
+    if (!m_pPool) return;
+    m_pPool->ReleaseSlot(m_Slot);
+    m_pPool = nullptr;
+}
+
+//=============================================================================
+// SnapshotPool
+//=============================================================================
+
+void SnapshotPool::Reset()
+{
+    m_Free.Clear();
+    m_Ready.Clear();
+    for (size_t i = 0; i < SLOT_COUNT; i++)
+        m_Free.Push(static_cast<uint16_t>(i));
+
+    m_Writing = -1;
+    m_DropCount.store(0, std::memory_order_relaxed);
+}
+
+SnapshotPool::Slot* SnapshotPool::BeginWrite()
+{
+    if (m_Writing < 0)
+    {
+        uint16_t slot;
+        if (!m_Free.Pop(slot))
+        {
+            m_DropCount.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        m_Writing = slot;
+    }
+    return &m_Slots[m_Writing];
+}
+
+void SnapshotPool::CommitWrite()
+{
+    if (m_Writing < 0) return;
+    m_Ready.Push(static_cast<uint16_t>(m_Writing));
+    m_Writing = -1;
+}
+
+bool SnapshotPool::Acquire(SnapshotHandle& outHandle)
+{
+    outHandle.Release();
+
+    uint16_t slot;
+    if (!m_Ready.Pop(slot)) return false;
+
+    outHandle.m_pPool = this;
+    outHandle.m_Slot = slot;
+    return true;
+}
+
+void SnapshotPool::ReleaseSlot(uint16_t slot)
+{
+    m_Free.Push(slot);
+}
@@ -0,0 +1,120 @@
+#pragma once
+//=============================================================================
+// snapshot_pool.h
+//
+// Preallocated snapshot slots shared by the network pump (producer) and the
+// game (consumer). A packet is decoded once, straight into a free slot; the
+// game reads it in place through a SnapshotHandle and the slot goes back to
+// the free list when the handle is released. No copies, no allocation.
+//
+//   producer:  BeginWrite() -> decode into slot -> CommitWrite()
+//   consumer:  Acquire(handle) -> read *handle -> handle released
+//
+// Free and ready slot indices travel through two SpscRings, so producer and
+// consumer may run on different threads. Handles must be released on the
+// consumer thread.
+//=============================================================================
+
+#include "net_common.h"
+#include "spsc_ring.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+class SnapshotPool;
+
+//-----------------------------------------------------------------------------
+// SnapshotHandle - Move-only read access to one pooled snapshot
+//-----------------------------------------------------------------------------
+class SnapshotHandle
+{
+public:
+    SnapshotHandle() = default;
+    ~SnapshotHandle() { Release(); }
+
+    SnapshotHandle(SnapshotHandle&& other) noexcept;
+    SnapshotHandle& operator=(SnapshotHandle&& other) noexcept;
+    SnapshotHandle(const SnapshotHandle&) = delete;
+    SnapshotHandle& operator=(const SnapshotHandle&) = delete;
+
+    bool IsValid() const { return m_pPool != nullptr; }
+    const Snapshot& Get() const;
+    const Snapshot& operator*() const { return Get(); }
+    const Snapshot* operator->() const { return &Get(); }
+
+    // NetClock time the packet arrived (net_clock.h)
+    double GetArrivalTime() const;
+
+    // Return the slot to the pool early (also done on destruction)
+    void Release();
+
+private:
+    friend class SnapshotPool;
+
+    SnapshotPool* m_pPool = nullptr;
+    uint16_t m_Slot = 0;
+};
+
+//-----------------------------------------------------------------------------
+// SnapshotPool
+//-----------------------------------------------------------------------------
+class SnapshotPool
+{
+public:
+    static constexpr size_t SLOT_COUNT = 64;   // 2s @ 32Hz, 0.5s @ 128Hz
+
+    // Snapshot slot plus arrival time, filled in place by the producer
+    struct Slot
+    {
+        Snapshot snapshot;
+        double arrivalTime;
+    };
+
+    SnapshotPool() { Reset(); }
+
+    // Mark every slot free. Only while no thread is using the pool and no
+    // handle is outstanding.
+    void Reset();
+
+    //-------------------------------------------------------------------------
+    // Producer side
+    //-------------------------------------------------------------------------
+
+    // Slot to decode into, or nullptr (counted as a drop) if the game is
+    // holding every slot. Repeated calls without CommitWrite return the
+    // same slot, so a failed decode simply reuses it.
+    Slot* BeginWrite();
+
+    // Publish the slot from BeginWrite to the consumer
+    void CommitWrite();
+
+    //-------------------------------------------------------------------------
+    // Consumer side
+    //-------------------------------------------------------------------------
+
+    // Oldest committed snapshot; the previous contents of outHandle are
+    // released first
+    bool Acquire(SnapshotHandle& outHandle);
+
+    //-------------------------------------------------------------------------
+    // Either side
+    //-------------------------------------------------------------------------
+    size_t GetReadyCount() const { return m_Ready.Size(); }
+    uint32_t GetDropCount() const { return m_DropCount.load(std::memory_order_relaxed); }
+
+private:
+    friend class SnapshotHandle;
+
+    void ReleaseSlot(uint16_t slot);
+    const Slot& GetSlot(uint16_t slot) const { return m_Slots[slot]; }
+
+    Slot m_Slots[SLOT_COUNT];
+
+    // Each index is in exactly one place: m_Free, m_Ready, m_Writing or a
+    // live handle, so neither ring can overflow
+    SpscRing<uint16_t, SLOT_COUNT> m_Free;    // consumer -> producer
+    SpscRing<uint16_t, SLOT_COUNT> m_Ready;   // producer -> consumer
+
+    int m_Writing = -1;                        // Producer only
+    std::atomic<uint32_t> m_DropCount{ 0 };
+};
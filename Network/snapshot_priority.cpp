@@ -0,0 +1,127 @@
+//=============================================================================
+// snapshot_priority.cpp
+//
+// Priority accumulation and byte-budgeted entry selection for snapshots.
+//=============================================================================
+
+#include "snapshot_priority.h"
+#include "net_codec.h"
+#include <algorithm>
+#include <cmath>
+
+void SnapshotPrioritizer::Reset()
+{
+    for (size_t i = 0; i < MAX_PLAYERS; i++)
+    {
+        m_Priority[i] = 0.0f;
+        m_SentFlags[i] = 0;
+        m_BaseByPlayer[i] = nullptr;
+    }
+    m_LastStats = {};
+}
+
+//-----------------------------------------------------------------------------
+// Accumulate - Add this tick's priority for one entry
+//-----------------------------------------------------------------------------
+void SnapshotPrioritizer::Accumulate(const RemotePlayerEntry& entry, const DirectX::XMFLOAT3& viewer)
+{
+    const NetPlayerState& state = entry.state;
+
+    float dx = state.position.x - viewer.x;
+    float dy = state.position.y - viewer.y;
+    float dz = state.position.z - viewer.z;
+    float dist = sqrtf(dx * dx + dy * dy + dz * dz);
+    float nearness = (dist > m_Settings.nearDistance) ? m_Settings.nearDistance / dist : 1.0f;
+
+    const DirectX::XMFLOAT3& v = state.velocity;
+    float speed = sqrtf(v.x * v.x + v.y * v.y + v.z * v.z);
+
+    float gain = m_Settings.basePriority +
+                 m_Settings.distanceWeight * nearness +
+                 m_Settings.speedWeight * speed;
+
+    if ((state.stateFlags ^ m_SentFlags[entry.playerId]) & PRIORITY_FLAGS)
+        gain += m_Settings.flagChangeBoost;
+
+    m_Priority[entry.playerId] += gain;
+}
+
+//-----------------------------------------------------------------------------
+// Select - Fill out.remotePlayers in priority order until the budget is used
+//-----------------------------------------------------------------------------
+void SnapshotPrioritizer::Select(const Snapshot& snapshot, const Snapshot* baseline, size_t budgetBits,
+                                 Snapshot& out)
+{
+    SnapshotPriorityStats stats = {};
+    uint8_t count = snapshot.remotePlayerCount;
+    if (count > MAX_PLAYERS - 1) count = MAX_PLAYERS - 1;
+    stats.candidates = count;
+    stats.budgetBits = static_cast<uint32_t>(budgetBits);
+
+    // Index the baseline by playerId for the cost estimate (entries are
+    // visited out of order here, unlike the encoder's forward match)
+    uint8_t baseCount = baseline ? baseline->remotePlayerCount : 0;
+    if (baseCount > MAX_PLAYERS - 1) baseCount = MAX_PLAYERS - 1;
+    for (uint8_t j = 0; j < baseCount; j++)
+    {
+        const RemotePlayerEntry& base = baseline->remotePlayers[j];
+        if (base.playerId < MAX_PLAYERS) m_BaseByPlayer[base.playerId] = &base.state;
+    }
+
+    // Ids outside the table cannot be tracked and are never sent
+    uint8_t candidates = 0;
+    const DirectX::XMFLOAT3& viewer = snapshot.localPlayer.position;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        m_Selected[i] = false;
+        const RemotePlayerEntry& entry = snapshot.remotePlayers[i];
+        if (entry.playerId >= MAX_PLAYERS) continue;
+
+        Accumulate(entry, viewer);
+        m_Order[candidates++] = i;
+    }
+
+    // Highest priority first; ties go to the lower index (std::stable_sort
+    // would allocate a buffer every tick)
+    std::sort(m_Order, m_Order + candidates, [&](uint8_t a, uint8_t b) {
+        float pa = m_Priority[snapshot.remotePlayers[a].playerId];
+        float pb = m_Priority[snapshot.remotePlayers[b].playerId];
+        return (pa != pb) ? pa > pb : a < b;
+    });
+
+    size_t usedBits = 0;
+    for (uint8_t n = 0; n < candidates; n++)
+    {
+        uint8_t i = m_Order[n];
+        const RemotePlayerEntry& entry = snapshot.remotePlayers[i];
+
+        // Skip what does not fit but keep going: a smaller delta further
+        // down may still fill the remaining space
+        size_t bits = NetCodec::GetRemoteEntryBits(entry, m_BaseByPlayer[entry.playerId], snapshot.tickId);
+        if (usedBits + bits > budgetBits) continue;
+
+        usedBits += bits;
+        m_Selected[i] = true;
+        m_Priority[entry.playerId] = 0.0f;
+        m_SentFlags[entry.playerId] = entry.state.stateFlags;
+    }
+
+    // Compact in the snapshot's order
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (m_Selected[i]) out.remotePlayers[kept++] = snapshot.remotePlayers[i];
+    }
+    out.remotePlayerCount = kept;
+
+    for (uint8_t j = 0; j < baseCount; j++)
+    {
+        uint8_t id = baseline->remotePlayers[j].playerId;
+        if (id < MAX_PLAYERS) m_BaseByPlayer[id] = nullptr;
+    }
+
+    stats.sent = kept;
+    stats.deferred = count - kept;
+    stats.usedBits = static_cast<uint32_t>(usedBits);
+    m_LastStats = stats;
+}
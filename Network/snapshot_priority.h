@@ -0,0 +1,90 @@
+#pragma once
+//=============================================================================
+// snapshot_priority.h
+//
+// Priority accumulator that keeps each client's snapshot within a byte
+// budget. Shared between game_client (MockNetwork) and game_server
+// (maintain in sync).
+//
+// Every tick, each remote player present in the snapshot adds to its
+// accumulated priority:
+//   basePriority                                     always (nobody starves)
+//   distanceWeight * min(1, nearDistance / distance) close to the viewer
+//   speedWeight * |velocity|                         moving fast
+//   flagChangeBoost                                  PRIORITY_FLAGS toggled
+//                                                    since last sent
+// Entries are then taken in descending priority while their exact encoded
+// size (NetCodec::GetRemoteEntryBits against the encoder's baseline) still
+// fits; anything that does not fit is skipped and tried again next tick
+// with its priority intact. Sent entries restart from zero.
+//
+// The output keeps the snapshot's ascending playerId order, so the encoder's
+// baseline matching stays linear.
+//=============================================================================
+
+#include "net_common.h"
+#include <cstddef>
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+// Tuning
+//-----------------------------------------------------------------------------
+struct SnapshotPrioritySettings
+{
+    float basePriority = 1.0f;
+    float distanceWeight = 4.0f;         // Full weight inside nearDistance
+    float nearDistance = 5.0f;
+    float speedWeight = 0.5f;            // Per m/s (sprint ~6 m/s -> +3)
+    float flagChangeBoost = 16.0f;       // Firing/death must not wait behind movement
+};
+
+//-----------------------------------------------------------------------------
+// Debug counters for one pass (one client, one tick)
+//-----------------------------------------------------------------------------
+struct SnapshotPriorityStats
+{
+    uint32_t candidates;    // Remote players in the snapshot
+    uint32_t sent;          // Fitted into the budget
+    uint32_t deferred;      // Skipped this tick (priority carried over)
+    uint32_t budgetBits;    // Bits available for remote entries
+    uint32_t usedBits;      // Bits taken by the sent entries
+};
+
+//-----------------------------------------------------------------------------
+// SnapshotPrioritizer - Server side (one per client connection)
+//-----------------------------------------------------------------------------
+class SnapshotPrioritizer
+{
+public:
+    void Reset();
+    void SetSettings(const SnapshotPrioritySettings& settings) { m_Settings = settings; }
+    const SnapshotPrioritySettings& GetSettings() const { return m_Settings; }
+
+    // Accumulate priority for every remote entry of snapshot and copy the
+    // ones that fit into budgetBits to out.remotePlayers (header untouched,
+    // remotePlayerCount set). baseline is what the encoder will delta
+    // against (nullptr = full encoding).
+    void Select(const Snapshot& snapshot, const Snapshot* baseline, size_t budgetBits, Snapshot& out);
+
+    const SnapshotPriorityStats& GetLastStats() const { return m_LastStats; }
+
+    // State changes that are worth jumping the queue for
+    static constexpr uint32_t PRIORITY_FLAGS =
+        NetStateFlags::IS_FIRING | NetStateFlags::IS_DEAD |
+        NetStateFlags::IS_JUMPING | NetStateFlags::IS_RELOADING;
+
+private:
+    void Accumulate(const RemotePlayerEntry& entry, const DirectX::XMFLOAT3& viewer);
+
+    SnapshotPrioritySettings m_Settings;
+    SnapshotPriorityStats m_LastStats = {};
+
+    // Per playerId
+    float m_Priority[MAX_PLAYERS] = {};
+    uint32_t m_SentFlags[MAX_PLAYERS] = {};
+    const NetPlayerState* m_BaseByPlayer[MAX_PLAYERS] = {};
+
+    // Per entry of the current pass
+    uint8_t m_Order[MAX_PLAYERS - 1] = {};
+    bool m_Selected[MAX_PLAYERS - 1] = {};
+};
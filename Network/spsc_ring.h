@@ -0,0 +1,198 @@
+#pragma once
+//=============================================================================
+// spsc_ring.h
+//
+// Fixed-capacity, lock-free single-producer/single-consumer ring buffer.
+// Replaces mutex + std::queue for the network queues: no locks and no heap
+// allocation after construction.
+//
+// Exactly one thread may call Push and exactly one thread may call Pop
+// (they may be the same thread). Size/GetDropCount may be called anywhere.
+//
+// Overflow policy (when Push finds the ring full):
+//   DROP_NEWEST  The pushed element is discarded.
+//   DROP_OLDEST  The oldest queued element is discarded to make room.
+//                The producer then races the consumer for that element:
+//                both claim it with a CAS on the tail, the loser retries.
+//
+// Every slot carries a sequence number (Vyukov-style): a slot is written
+// only after whoever claimed its previous element has released it, and an
+// element is read only after its claim, so producer and consumer never
+// touch the same slot at once.
+//
+// Head/tail live on separate cache lines so producer and consumer do not
+// invalidate each other's line on every operation.
+//=============================================================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+enum class RingOverflow : uint8_t
+{
+    DROP_NEWEST,
+    DROP_OLDEST,
+};
+
+static constexpr size_t RING_CACHE_LINE_SIZE = 64;
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4324)  // Padding from alignas is intentional
+#endif
+
+template <typename T, size_t Capacity, RingOverflow Overflow = RingOverflow::DROP_NEWEST>
+class SpscRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+public:
+    static constexpr size_t CAPACITY = Capacity;
+    static constexpr RingOverflow OVERFLOW_POLICY = Overflow;
+
+    SpscRing() { Clear(); }
+
+    //-------------------------------------------------------------------------
+    // Producer side
+    //
+    // Returns false if an element was dropped (the new one for DROP_NEWEST,
+    // the oldest queued one for DROP_OLDEST).
+    //-------------------------------------------------------------------------
+    bool Push(const T& value)
+    {
+        const uint64_t head = m_Head.load(std::memory_order_relaxed);
+        bool dropped = false;
+
+        if (head - m_CachedTail >= Capacity)
+        {
+            m_CachedTail = m_Tail.load(std::memory_order_acquire);
+
+            if (head - m_CachedTail >= Capacity)
+            {
+                if constexpr (Overflow == RingOverflow::DROP_NEWEST)
+                {
+                    m_DropCount.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else
+                {
+                    // Claim the oldest element; if the consumer took it
+                    // first the ring has room now either way
+                    uint64_t expected = m_CachedTail;
+                    if (m_Tail.compare_exchange_strong(expected, expected + 1,
+                                                       std::memory_order_acq_rel))
+                    {
+                        // Never read: release the slot for the next lap
+                        m_Slots[expected & (Capacity - 1)].seq.store(
+                            expected + Capacity, std::memory_order_release);
+                        m_CachedTail = expected + 1;
+                        m_DropCount.fetch_add(1, std::memory_order_relaxed);
+                        dropped = true;
+                    }
+                    else
+                    {
+                        m_CachedTail = expected;
+                    }
+                }
+            }
+        }
+
+        // The ring has room, so the previous lap's element in this slot has
+        // been claimed; wait out a consumer still copying it
+        Slot& slot = m_Slots[head & (Capacity - 1)];
+        while (slot.seq.load(std::memory_order_acquire) != head) {}
+
+        slot.value = value;
+        slot.seq.store(head + 1, std::memory_order_release);
+        m_Head.store(head + 1, std::memory_order_release);
+        return !dropped;
+    }
+
+    //-------------------------------------------------------------------------
+    // Consumer side
+    //-------------------------------------------------------------------------
+    bool Pop(T& outValue)
+    {
+        for (;;)
+        {
+            uint64_t tail = m_Tail.load(std::memory_order_acquire);
+            Slot& slot = m_Slots[tail & (Capacity - 1)];
+
+            // seq == tail + 1: element written; == tail: not yet (empty);
+            // anything else: the producer dropped it, reload the tail
+            const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+            if (seq == tail) return false;
+            if (seq != tail + 1) continue;
+
+            if constexpr (Overflow == RingOverflow::DROP_NEWEST)
+            {
+                m_Tail.store(tail + 1, std::memory_order_release);
+            }
+            else
+            {
+                if (!m_Tail.compare_exchange_strong(tail, tail + 1,
+                                                    std::memory_order_acq_rel))
+                {
+                    continue;
+                }
+            }
+
+            outValue = slot.value;
+            slot.seq.store(tail + Capacity, std::memory_order_release);
+            return true;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    // Either side
+    //-------------------------------------------------------------------------
+    size_t Size() const
+    {
+        const uint64_t tail = m_Tail.load(std::memory_order_acquire);
+        const uint64_t head = m_Head.load(std::memory_order_acquire);
+        return (head > tail) ? static_cast<size_t>(head - tail) : 0;
+    }
+
+    bool IsEmpty() const { return Size() == 0; }
+
+    uint32_t GetDropCount() const
+    {
+        return m_DropCount.load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------
+    // Reset to empty. Only while neither producer nor consumer is running.
+    //-------------------------------------------------------------------------
+    void Clear()
+    {
+        m_Head.store(0, std::memory_order_relaxed);
+        m_Tail.store(0, std::memory_order_relaxed);
+        m_CachedTail = 0;
+        m_DropCount.store(0, std::memory_order_relaxed);
+        for (size_t i = 0; i < Capacity; i++)
+            m_Slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> seq;      // Position + 1 once written, + Capacity once released
+        T value;
+    };
+
+    // Producer line: written by Push
+    alignas(RING_CACHE_LINE_SIZE) std::atomic<uint64_t> m_Head{ 0 };
+    uint64_t m_CachedTail = 0;          // Producer's last view of m_Tail
+
+    // Consumer line: written by Pop (and by Push when dropping oldest)
+    alignas(RING_CACHE_LINE_SIZE) std::atomic<uint64_t> m_Tail{ 0 };
+
+    alignas(RING_CACHE_LINE_SIZE) std::atomic<uint32_t> m_DropCount{ 0 };
+
+    alignas(RING_CACHE_LINE_SIZE) Slot m_Slots[Capacity];
+};
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
@@ -0,0 +1,158 @@
+//=============================================================================
+// trace_network.cpp
+//
+// Trace capture decorator and replay backend.
+//=============================================================================
+
+#include "trace_network.h"
+#include "net_clock.h"
+
+//=============================================================================
+// TraceRecordNetwork
+//=============================================================================
+
+void TraceRecordNetwork::Initialize()
+{
+    if (!m_pNow) m_pNow = NetClock::Now;
+    m_RecordedTickRate = 0;
+}
+
+void TraceRecordNetwork::SendInputCmd(const InputCmd& cmd)
+{
+    m_Writer.WriteInput(m_pNow(), cmd);
+    m_pInner->SendInputCmd(cmd);
+}
+
+bool TraceRecordNetwork::AcquireSnapshot(SnapshotHandle& outHandle)
+{
+    if (!m_pInner->AcquireSnapshot(outHandle)) return false;
+
+    // The rate this snapshot was simulated at (ENet learns it after connect)
+    const double now = m_pNow();
+    const uint32_t tickRate = m_pInner->GetTickRate();
+    if (tickRate != m_RecordedTickRate)
+    {
+        m_Writer.WriteTickRate(now, tickRate);
+        m_RecordedTickRate = tickRate;
+    }
+
+    // Recorded in place from the backend's pool
+    m_Writer.WriteSnapshot(now, outHandle.GetArrivalTime(), *outHandle);
+    return true;
+}
+
+bool TraceRecordNetwork::ReceiveEvent(NetEvent& outEvent)
+{
+    if (!m_pInner->ReceiveEvent(outEvent)) return false;
+    m_Writer.WriteEvent(m_pNow(), outEvent);
+    return true;
+}
+
+//=============================================================================
+// TraceReplayNetwork
+//=============================================================================
+
+void TraceReplayNetwork::Initialize()
+{
+    if (!m_pNow) m_pNow = NetClock::Now;
+
+    m_Reader.Rewind();
+    m_Pool.Reset();
+    m_Inputs.Clear();
+    m_Events.Clear();
+    m_StartTime = m_pNow();
+    m_Finished = false;
+    m_TickRate = NetTickRate::DEFAULT;
+    m_LiveInputs = 0;
+    m_InputsReplayed = 0;
+    m_EventsReplayed = 0;
+    m_SnapshotsReplayed = 0;
+}
+
+void TraceReplayNetwork::Finalize()
+{
+    m_Inputs.Clear();
+    m_Events.Clear();
+}
+
+//-----------------------------------------------------------------------------
+// Pump - Play every record that is due. Unthrottled (speed 0), stop before
+// the second snapshot so the game reads them one at a time.
+//-----------------------------------------------------------------------------
+void TraceReplayNetwork::Pump(double now, bool wantSnapshot)
+{
+    const bool throttled = m_Speed > 0.0;
+    // Record times are whole microseconds
+    const double traceNow = throttled ? (now - m_StartTime) * m_Speed + 0.5e-6 : 0.0;
+
+    TraceRecordType type;
+    double time;
+    while (m_Reader.Peek(type, time))
+    {
+        if (throttled && time > traceNow) return;
+
+        if (type == TraceRecordType::INPUT)
+        {
+            InputCmd cmd;
+            if (!m_Reader.ReadInput(cmd)) break;
+            m_Inputs.Push(cmd);     // The ring counts drops
+            m_InputsReplayed++;
+            continue;
+        }
+
+        if (type == TraceRecordType::TICK_RATE)
+        {
+            if (!m_Reader.ReadTickRate(m_TickRate)) break;
+            continue;
+        }
+
+        if (type == TraceRecordType::EVENT)
+        {
+            NetEvent event;
+            if (!m_Reader.ReadEvent(event)) break;
+            m_Events.Push(event);   // The ring counts drops
+            m_EventsReplayed++;
+            continue;
+        }
+
+        if (!throttled && !wantSnapshot) return;
+
+        // Game holding every slot: leave the record for the next call
+        if (m_Pool.GetReadyCount() + 1 >= SnapshotPool::SLOT_COUNT) return;
+        SnapshotPool::Slot* slot = m_Pool.BeginWrite();
+        if (!slot) return;
+
+        double arrival;
+        if (!m_Reader.ReadSnapshot(slot->snapshot, arrival)) break;
+        slot->arrivalTime = (throttled && arrival >= 0.0) ? m_StartTime + arrival / m_Speed : now;
+        m_Pool.CommitWrite();
+        m_SnapshotsReplayed++;
+        wantSnapshot = false;
+    }
+
+    m_Finished = true;
+}
+
+void TraceReplayNetwork::SendInputCmd(const InputCmd&)
+{
+    m_LiveInputs++;
+    Pump(m_pNow(), false);
+}
+
+bool TraceReplayNetwork::ReceiveInputCmd(InputCmd& outCmd)
+{
+    Pump(m_pNow(), false);
+    return m_Inputs.Pop(outCmd);
+}
+
+bool TraceReplayNetwork::AcquireSnapshot(SnapshotHandle& outHandle)
+{
+    Pump(m_pNow(), m_Pool.GetReadyCount() == 0);
+    return m_Pool.Acquire(outHandle);
+}
+
+bool TraceReplayNetwork::ReceiveEvent(NetEvent& outEvent)
+{
+    Pump(m_pNow(), false);
+    return m_Events.Pop(outEvent);
+}
@@ -0,0 +1,180 @@
+#pragma once
+//=============================================================================
+// trace_network.h
+//
+// Session capture and replay through INetwork (file format in net_trace.h).
+//
+// TraceRecordNetwork  decorator around any backend: every InputCmd the game
+//                     sends and every Snapshot and event it receives is
+//                     appended to a trace, stamped with the call time and
+//                     the snapshot's arrival time. Wrap it outermost (around NetSim too) to
+//                     capture exactly what the game saw.
+//
+// TraceReplayNetwork  backend that plays a trace back to the game with its
+//                     original timing (scaled by the speed), or as fast as
+//                     the game reads it (speed 0). Snapshots are decoded
+//                     straight into its SnapshotPool; arrival times keep
+//                     their recorded offsets. Recorded inputs come out of
+//                     ReceiveInputCmd for a server-side re-simulation; the
+//                     game's live inputs are counted and dropped.
+//
+// Gameplay events are recorded when the game receives them and come out of
+// the replay's ReceiveEvent at the same point, between the same snapshots.
+// The session's tick rate is recorded before the first snapshot and
+// whenever it changes, and replayed through GetTickRate. Reconnects are
+// not recorded: a replay is one session (GetSessionEpoch stays 0).
+//
+// Both are driven from the game thread (SendInputCmd / AcquireSnapshot).
+// The backend's Initialize/Finalize stay with its owner.
+//=============================================================================
+
+#include "i_network.h"
+#include "net_trace.h"
+#include "spsc_ring.h"
+#include <cstddef>
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+// TraceRecordNetwork
+//-----------------------------------------------------------------------------
+class TraceRecordNetwork : public INetwork
+{
+public:
+    TraceRecordNetwork() = default;
+    ~TraceRecordNetwork() override = default;
+
+    //-------------------------------------------------------------------------
+    // Setup (before Initialize)
+    //-------------------------------------------------------------------------
+    void SetInner(INetwork* pInner) { m_pInner = pInner; }
+    void SetTimeSource(double (*pNow)()) { m_pNow = pNow; }
+
+    // Creates the trace file; false if it cannot be opened
+    bool Open(const char* path) { return m_Writer.Open(path); }
+
+    void Initialize() override;
+    void Finalize() override { m_Writer.Close(); }
+
+    //-------------------------------------------------------------------------
+    // Client -> Server (Upstream)
+    //-------------------------------------------------------------------------
+    void SendInputCmd(const InputCmd& cmd) override;
+    bool ReceiveInputCmd(InputCmd& outCmd) override { return m_pInner->ReceiveInputCmd(outCmd); }
+    size_t GetInputQueueSize() const override { return m_pInner->GetInputQueueSize(); }
+
+    //-------------------------------------------------------------------------
+    // Server -> Client (Downstream)
+    //-------------------------------------------------------------------------
+    void SendSnapshot(const Snapshot& snapshot) override { m_pInner->SendSnapshot(snapshot); }
+    bool AcquireSnapshot(SnapshotHandle& outHandle) override;
+    size_t GetSnapshotQueueSize() const override { return m_pInner->GetSnapshotQueueSize(); }
+    void SendEvents(uint32_t tickId, const NetEvent* events, size_t count) override { m_pInner->SendEvents(tickId, events, count); }
+    bool ReceiveEvent(NetEvent& outEvent) override;
+    void SendTickRate(uint32_t hz) override { m_pInner->SendTickRate(hz); }
+
+    //-------------------------------------------------------------------------
+    // Debug / Statistics (backend values)
+    //-------------------------------------------------------------------------
+    uint32_t GetTotalInputsSent() const override { return m_pInner->GetTotalInputsSent(); }
+    uint32_t GetTotalSnapshotsSent() const override { return m_pInner->GetTotalSnapshotsSent(); }
+    uint32_t GetRTT() const override { return m_pInner->GetRTT(); }
+    uint32_t GetPacketLoss() const override { return m_pInner->GetPacketLoss(); }
+    bool IsConnected() const override { return m_pInner->IsConnected(); }
+    uint32_t GetTickRate() const override { return m_pInner->GetTickRate(); }
+    uint32_t GetSessionEpoch() const override { return m_pInner->GetSessionEpoch(); }
+    uint32_t GetLastSnapshotBytes() const override { return m_pInner->GetLastSnapshotBytes(); }
+    uint64_t GetTotalBytesSent() const override { return m_pInner->GetTotalBytesSent(); }
+    uint64_t GetTotalBytesReceived() const override { return m_pInner->GetTotalBytesReceived(); }
+    uint64_t GetTotalPacketsSent() const override { return m_pInner->GetTotalPacketsSent(); }
+    uint64_t GetTotalPacketsReceived() const override { return m_pInner->GetTotalPacketsReceived(); }
+    uint32_t GetInputDropCount() const override { return m_pInner->GetInputDropCount(); }
+    uint32_t GetSnapshotDropCount() const override { return m_pInner->GetSnapshotDropCount(); }
+    uint32_t GetEventDropCount() const override { return m_pInner->GetEventDropCount(); }
+
+    const TraceWriter& GetWriter() const { return m_Writer; }
+
+private:
+    INetwork* m_pInner = nullptr;
+    double (*m_pNow)() = nullptr;
+    TraceWriter m_Writer;
+    uint32_t m_RecordedTickRate = 0;    // Last TICK_RATE record (0 = none yet)
+};
+
+//-----------------------------------------------------------------------------
+// TraceReplayNetwork
+//-----------------------------------------------------------------------------
+class TraceReplayNetwork : public INetwork
+{
+public:
+    TraceReplayNetwork() = default;
+    ~TraceReplayNetwork() override = default;
+
+    //-------------------------------------------------------------------------
+    // Setup (before Initialize)
+    //-------------------------------------------------------------------------
+
+    // Loads the whole trace; false if it is missing or not a trace
+    bool Open(const char* path) { return m_Reader.Open(path); }
+
+    // 1 = original timing, 2 = twice as fast, 0 = as fast as it is read
+    void SetSpeed(double speed) { m_Speed = speed; }
+    void SetTimeSource(double (*pNow)()) { m_pNow = pNow; }
+
+    // Rewind; the trace's first record plays at the time of this call
+    void Initialize() override;
+    void Finalize() override;
+
+    //-------------------------------------------------------------------------
+    // Client -> Server (Upstream)
+    //-------------------------------------------------------------------------
+    void SendInputCmd(const InputCmd& cmd) override;
+    bool ReceiveInputCmd(InputCmd& outCmd) override;
+    size_t GetInputQueueSize() const override { return m_Inputs.Size(); }
+
+    //-------------------------------------------------------------------------
+    // Server -> Client (Downstream)
+    //-------------------------------------------------------------------------
+    void SendSnapshot(const Snapshot&) override {}
+    bool AcquireSnapshot(SnapshotHandle& outHandle) override;
+    size_t GetSnapshotQueueSize() const override { return m_Pool.GetReadyCount(); }
+    bool ReceiveEvent(NetEvent& outEvent) override;
+
+    //-------------------------------------------------------------------------
+    // Debug / Statistics
+    //-------------------------------------------------------------------------
+    uint32_t GetTotalInputsSent() const override { return m_LiveInputs; }
+    uint32_t GetTotalSnapshotsSent() const override { return m_SnapshotsReplayed; }
+    bool IsConnected() const override { return !m_Finished; }
+    uint32_t GetTickRate() const override { return m_TickRate; }   // As recorded
+    uint32_t GetInputDropCount() const override { return m_Inputs.GetDropCount(); }
+    uint32_t GetSnapshotDropCount() const override { return m_Pool.GetDropCount(); }
+    uint32_t GetEventDropCount() const override { return m_Events.GetDropCount(); }
+
+    // Every record played (or the trace was malformed, see HasError)
+    bool IsFinished() const { return m_Finished; }
+    bool HasError() const { return m_Reader.HasError(); }
+    uint32_t GetInputsReplayed() const { return m_InputsReplayed; }
+    uint32_t GetEventsReplayed() const { return m_EventsReplayed; }
+
+    static constexpr size_t INPUT_CAPACITY = 512;   // Recorded inputs not yet read
+    static constexpr size_t EVENT_CAPACITY = 1024;  // Recorded events not yet read
+
+private:
+    void Pump(double now, bool wantSnapshot);
+
+    double (*m_pNow)() = nullptr;
+    double m_Speed = 1.0;
+    double m_StartTime = 0.0;
+
+    TraceReader m_Reader;
+    SnapshotPool m_Pool;
+    SpscRing<InputCmd, INPUT_CAPACITY> m_Inputs;
+    SpscRing<NetEvent, EVENT_CAPACITY> m_Events;
+
+    bool m_Finished = false;
+    uint32_t m_TickRate = NetTickRate::DEFAULT;
+    uint32_t m_LiveInputs = 0;
+    uint32_t m_InputsReplayed = 0;
+    uint32_t m_EventsReplayed = 0;
+    uint32_t m_SnapshotsReplayed = 0;
+};
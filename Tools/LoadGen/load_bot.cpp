@@ -0,0 +1,178 @@
+//=============================================================================
+// load_bot.cpp
+//
+// LoadBot: one ENet connection, its input script and its measurements.
+//=============================================================================
+
+#include "load_gen.h"
+#include "net_clock.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+LoadBot::LoadBot(uint32_t id, const LoadGenOptions& options)
+    : m_Id(id)
+    , m_Pattern(options.pattern)
+    , m_RandomState(options.seed * 0x100000001B3ull + id)
+{
+    m_Network.SetServerAddress(options.host, options.port);
+    m_Network.SetSnapshotDeltaEnabled(options.snapshotDelta);
+    m_Network.SetSnapshotEntropyEnabled(options.snapshotEntropy);
+    m_Network.SetInputRedundancy(options.redundancy);
+    m_Network.SetIoThreadEnabled(options.ioThread);
+    m_Network.SetBundleMtu(options.bundleMtu);
+    m_Network.SetTickRate(options.tickRate);
+    m_Network.SetReconnectEnabled(false);     // A dropped bot is a failure, not a retry
+
+    // Spread the bots around so their samples are not in lockstep
+    m_Yaw = static_cast<float>(id) * 0.7f;
+}
+
+bool LoadBot::Connect()
+{
+    // Initialize only starts the handshake; pump until it settles
+    m_Network.Initialize();
+    while (m_Network.GetConnectionState() == ConnectionState::CONNECTING)
+    {
+        m_Network.PollEvents();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    m_Stats.connected = m_Network.IsConnected();
+    m_Stats.connectTime = NetClock::Now();
+    return m_Stats.connected;
+}
+
+//-----------------------------------------------------------------------------
+// Poll - Snapshot rate, arrival intervals and tickDelta gaps
+//-----------------------------------------------------------------------------
+void LoadBot::Poll()
+{
+    if (!m_Stats.connected) return;
+    m_Network.PollEvents();
+
+    SnapshotHandle handle;
+    while (m_Network.AcquireSnapshot(handle))
+    {
+        const uint32_t tickId = handle->tickId;
+        const double arrival = handle.GetArrivalTime();
+
+        if (m_Stats.snapshots > 0)
+        {
+            const int32_t delta = static_cast<int32_t>(tickId - m_LastServerTick);
+            m_Stats.tickDeltas.push_back(delta);
+            if (delta <= 0)
+            {
+                m_Stats.staleSnapshots++;
+                continue;
+            }
+            if (delta > 1) m_Stats.missedTicks += static_cast<uint32_t>(delta - 1);
+            m_Stats.intervalMs.push_back((arrival - m_LastArrival) * 1000.0);
+        }
+
+        m_Stats.snapshots++;
+        m_LastServerTick = tickId;
+        m_LastArrival = arrival;
+    }
+
+    NetEvent event;
+    while (m_Network.ReceiveEvent(event)) m_Stats.events++;
+
+    if (!m_Network.IsConnected()) m_Stats.lostConnection = true;
+    if (m_Network.HasSchemaMismatch()) m_Stats.schemaMismatch = true;
+}
+
+//-----------------------------------------------------------------------------
+// Tick - One InputCmd per tick, RTT sampled at the same rate
+//-----------------------------------------------------------------------------
+void LoadBot::Tick(double now)
+{
+    if (!m_Stats.connected || !m_Network.IsConnected()) return;
+
+    InputCmd cmd = MakeInput(now - m_Stats.connectTime);
+    m_Network.SendInputCmd(cmd);
+
+    // ENet reports 0 until the first reliable round trip has been measured
+    const uint32_t rtt = m_Network.GetRTT();
+    if (rtt > 0) m_Stats.rttMs.push_back(static_cast<double>(rtt));
+}
+
+//-----------------------------------------------------------------------------
+// Disconnect - Graceful disconnect; PollDisconnect until it returns false
+//-----------------------------------------------------------------------------
+void LoadBot::Disconnect()
+{
+    m_Network.Disconnect();
+}
+
+bool LoadBot::PollDisconnect()
+{
+    m_Network.PollEvents();
+    return m_Network.GetConnectionState() != ConnectionState::DISCONNECTED;
+}
+
+void LoadBot::Finish(double now)
+{
+    m_Stats.endTime = now;
+    m_Stats.inputsSent = m_Network.GetTotalInputsSent();
+    m_Stats.snapshotDrops = m_Network.GetSnapshotDropCount();
+    m_Stats.bytesReceived = m_Network.GetTotalBytesReceived();
+    m_Stats.bytesSent = m_Network.GetTotalBytesSent();
+}
+
+//-----------------------------------------------------------------------------
+// MakeInput - This tick's command for the bot's pattern
+//-----------------------------------------------------------------------------
+InputCmd LoadBot::MakeInput(double elapsed)
+{
+    InputCmd cmd = {};
+    cmd.tickId = ++m_ClientTick;
+
+    if (m_Pattern == BotPattern::SCRIPTED)
+    {
+        // 12s cycle: forward, strafe right, back, strafe left, each while
+        // turning; fire for 0.5s every 3s, jump every 5s
+        const double t = elapsed + m_Id * 0.37;
+        const int leg = static_cast<int>(std::fmod(t, 12.0) / 3.0);
+        cmd.moveAxisY = (leg == 0) ? 1.0f : (leg == 2) ? -1.0f : 0.0f;
+        cmd.moveAxisX = (leg == 1) ? 1.0f : (leg == 3) ? -1.0f : 0.0f;
+        cmd.yaw = m_Yaw + static_cast<float>(t * 0.8);
+        cmd.pitch = static_cast<float>(std::sin(t * 0.5) * 0.3);
+        if (std::fmod(t, 3.0) < 0.5) cmd.buttons |= InputButtons::FIRE;
+        if (std::fmod(t, 5.0) < 0.1) cmd.buttons |= InputButtons::JUMP;
+        return cmd;
+    }
+
+    if (elapsed >= m_NextReroll)
+    {
+        m_MoveX = std::round(NextFloat() * 2.0f - 1.0f);
+        m_MoveY = std::round(NextFloat() * 2.0f - 1.0f);
+        m_YawRate = (NextFloat() * 2.0f - 1.0f) * 0.1f;
+        m_Buttons = InputButtons::NONE;
+        if (NextFloat() < 0.3f) m_Buttons |= InputButtons::FIRE;
+        if (NextFloat() < 0.2f) m_Buttons |= InputButtons::ADS;
+        if (NextFloat() < 0.2f) m_Buttons |= InputButtons::SPRINT;
+        m_NextReroll = elapsed + 0.5 + NextFloat() * 1.5;
+    }
+
+    m_Yaw += m_YawRate;
+    cmd.moveAxisX = m_MoveX;
+    cmd.moveAxisY = m_MoveY;
+    cmd.yaw = m_Yaw;
+    cmd.pitch = 0.0f;
+    cmd.buttons = m_Buttons;
+    if (NextFloat() < 0.02f) cmd.buttons |= InputButtons::JUMP;
+    return cmd;
+}
+
+//-----------------------------------------------------------------------------
+// NextFloat - splitmix64 in [0, 1), same sequence on every compiler
+//-----------------------------------------------------------------------------
+float LoadBot::NextFloat()
+{
+    uint64_t z = (m_RandomState += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z = z ^ (z >> 31);
+    return static_cast<float>(z >> 40) * (1.0f / 16777216.0f);
+}
@@ -0,0 +1,135 @@
+#pragma once
+//=============================================================================
+// load_gen.h
+//
+// LoadGen - headless load generator for the game server. Opens one
+// ENetClientNetwork per bot from a single process, drives each with a
+// scripted or seeded random InputCmd stream at the tick rate, and reports
+// per-client and aggregate percentiles for RTT, snapshot rate and interval,
+// tickDelta gaps and bytes/sec. Links only the Network/ layer (no Direct3D).
+//
+// Usage:
+//   LoadGen [options]
+//     --host <addr>          server address (default 127.0.0.1)
+//     --port <n>             server port (default 7777)
+//     --clients <n>          bot count (default 16)
+//     --duration <s>         soak time after every bot connected (default 60)
+//     --tick-rate <hz>       rate requested from the server: 32 | 64 | 128
+//                            (default 32); bots send inputs at its answer
+//     --pattern <name>       scripted | random (default scripted)
+//     --seed <n>             random pattern seed (default 1)
+//     --redundancy <n>       inputs per packet, 1..8 (default 3)
+//     --no-delta             full snapshots only
+//     --io-thread            one ENet IO thread per bot
+//     --bundle-mtu <n>       bundle inputs + acks up to n bytes, 0 = off (default 1200)
+//     --max-rtt-ms <ms>      fail if the p99 RTT exceeds this (0 = off)
+//     --max-missed <frac>    fail if more server ticks are missed (default 0.05)
+//
+// Exit code 0 when every bot connected, stayed connected and met the
+// thresholds, so a soak run against a loopback server can gate CI.
+//=============================================================================
+
+#include "enet_client_network.h"
+#include <cstdint>
+#include <vector>
+
+enum class BotPattern
+{
+    SCRIPTED,   // Deterministic walk / strafe / turn / fire cycle per bot
+    RANDOM,     // Seeded random intents, re-rolled every 0.5..2s
+};
+
+struct LoadGenOptions
+{
+    const char* host = "127.0.0.1";
+    uint16_t port = 7777;
+    uint32_t clients = 16;
+    double duration = 60.0;
+    uint32_t tickRate = NetTickRate::DEFAULT;
+    BotPattern pattern = BotPattern::SCRIPTED;
+    uint64_t seed = 1;
+    int redundancy = 3;
+    bool snapshotDelta = true;
+    bool snapshotEntropy = true;
+    bool ioThread = false;
+    uint32_t bundleMtu = static_cast<uint32_t>(NET_BUNDLE_DEFAULT_MTU);
+    double maxRttMs = 0.0;
+    double maxMissed = 0.05;
+};
+
+//-----------------------------------------------------------------------------
+// Per-bot measurements (raw samples; percentiles are taken by the report)
+//-----------------------------------------------------------------------------
+struct LoadBotStats
+{
+    bool connected = false;         // Initialize reached the server
+    bool lostConnection = false;    // Disconnected during the run
+    bool schemaMismatch = false;    // ...because the server's NET_SCHEMA_HASH differs
+    double connectTime = 0.0;       // NetClock seconds
+    double endTime = 0.0;
+
+    uint32_t snapshots = 0;
+    uint32_t missedTicks = 0;       // Sum of (tickDelta - 1) over gaps
+    uint32_t staleSnapshots = 0;    // tickDelta <= 0 (duplicate / out of order)
+    uint32_t snapshotDrops = 0;     // Pool full on the client
+    uint32_t events = 0;            // Gameplay events (reliable channel)
+    uint32_t inputsSent = 0;
+    uint64_t bytesReceived = 0;
+    uint64_t bytesSent = 0;
+
+    std::vector<double> rttMs;          // One sample per tick
+    std::vector<double> intervalMs;     // Between snapshot arrivals
+    std::vector<double> tickDeltas;     // Between consecutive snapshots
+};
+
+//-----------------------------------------------------------------------------
+// LoadBot - One connection and its input script
+//-----------------------------------------------------------------------------
+class LoadBot
+{
+public:
+    LoadBot(uint32_t id, const LoadGenOptions& options);
+
+    // Blocks until connected or CONNECT_TIMEOUT; false on failure
+    bool Connect();
+
+    // Pump ENet (unless the IO thread does) and drain received snapshots
+    void Poll();
+
+    // Send this tick's InputCmd and sample RTT
+    void Tick(double now);
+
+    // Final counters
+    void Finish(double now);
+
+    // Start a graceful disconnect, then pump it until PollDisconnect is false
+    void Disconnect();
+    bool PollDisconnect();
+
+    const LoadBotStats& GetStats() const { return m_Stats; }
+    uint32_t GetId() const { return m_Id; }
+    bool IsConnected() const { return m_Network.IsConnected(); }
+    uint32_t GetTickRate() const { return m_Network.GetTickRate(); }     // Server's answer
+
+private:
+    InputCmd MakeInput(double elapsed);
+    float NextFloat();
+
+    uint32_t m_Id;
+    BotPattern m_Pattern;
+    ENetClientNetwork m_Network;
+    LoadBotStats m_Stats;
+
+    uint32_t m_ClientTick = 0;
+    uint32_t m_LastServerTick = 0;
+    double m_LastArrival = -1.0;
+
+    // Random pattern state
+    uint64_t m_RandomState;
+    double m_NextReroll = 0.0;
+    float m_MoveX = 0.0f;
+    float m_MoveY = 0.0f;
+    float m_YawRate = 0.0f;
+    float m_Yaw = 0.0f;
+    uint32_t m_Buttons = 0;
+};
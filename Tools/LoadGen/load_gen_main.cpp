@@ -0,0 +1,284 @@
+//=============================================================================
+// load_gen_main.cpp
+//
+// LoadGen entry point: parses options, connects the bots, drives them at
+// the tick rate for the soak duration and prints the percentile report.
+//=============================================================================
+
+// WinSock2.h must come before Windows.h to avoid winsock.h conflict
+#include <WinSock2.h>
+#include <mmsystem.h>
+#include "load_gen.h"
+#include "net_clock.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+namespace {
+
+constexpr double PROGRESS_INTERVAL = 5.0;
+
+//-----------------------------------------------------------------------------
+// Options
+//-----------------------------------------------------------------------------
+void PrintUsage()
+{
+    std::printf(
+        "Usage: LoadGen [--host addr] [--port n] [--clients n] [--duration s]\n"
+        "               [--tick-rate hz] [--pattern scripted|random] [--seed n]\n"
+        "               [--redundancy n] [--no-delta] [--no-entropy] [--io-thread]\n"
+        "               [--bundle-mtu n] [--max-rtt-ms ms] [--max-missed fraction]\n");
+}
+
+bool ParseOptions(int argc, char** argv, LoadGenOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--no-delta") == 0) { options.snapshotDelta = false; continue; }
+        if (std::strcmp(arg, "--no-entropy") == 0) { options.snapshotEntropy = false; continue; }
+        if (std::strcmp(arg, "--io-thread") == 0) { options.ioThread = true; continue; }
+        if (!value) return false;
+        i++;
+
+        if (std::strcmp(arg, "--host") == 0) options.host = value;
+        else if (std::strcmp(arg, "--port") == 0) options.port = static_cast<uint16_t>(std::atoi(value));
+        else if (std::strcmp(arg, "--clients") == 0) options.clients = static_cast<uint32_t>(std::atoi(value));
+        else if (std::strcmp(arg, "--duration") == 0) options.duration = std::atof(value);
+        else if (std::strcmp(arg, "--tick-rate") == 0) options.tickRate = static_cast<uint32_t>(std::atoi(value));
+        else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoull(value, nullptr, 10);
+        else if (std::strcmp(arg, "--redundancy") == 0) options.redundancy = std::atoi(value);
+        else if (std::strcmp(arg, "--bundle-mtu") == 0) options.bundleMtu = static_cast<uint32_t>(std::atoi(value));
+        else if (std::strcmp(arg, "--max-rtt-ms") == 0) options.maxRttMs = std::atof(value);
+        else if (std::strcmp(arg, "--max-missed") == 0) options.maxMissed = std::atof(value);
+        else if (std::strcmp(arg, "--pattern") == 0)
+        {
+            if (std::strcmp(value, "scripted") == 0) options.pattern = BotPattern::SCRIPTED;
+            else if (std::strcmp(value, "random") == 0) options.pattern = BotPattern::RANDOM;
+            else return false;
+        }
+        else return false;
+    }
+
+    return options.clients > 0 && NetTickRate::IsSupported(options.tickRate) && options.duration > 0.0 &&
+           options.redundancy >= 1 && options.redundancy <= static_cast<int>(INPUT_BATCH_MAX_COMMANDS);
+}
+
+//-----------------------------------------------------------------------------
+// Percentiles (nearest rank; sorts the samples)
+//-----------------------------------------------------------------------------
+struct Percentiles
+{
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+    size_t count = 0;
+};
+
+Percentiles ComputePercentiles(std::vector<double>& samples)
+{
+    Percentiles result;
+    result.count = samples.size();
+    if (samples.empty()) return result;
+
+    std::sort(samples.begin(), samples.end());
+    auto rank = [&](double p) {
+        size_t index = static_cast<size_t>(std::ceil(p * samples.size()));
+        return samples[index > 0 ? index - 1 : 0];
+    };
+    result.p50 = rank(0.50);
+    result.p90 = rank(0.90);
+    result.p99 = rank(0.99);
+    result.max = samples.back();
+    return result;
+}
+
+void PrintPercentiles(const char* name, std::vector<double>& samples)
+{
+    Percentiles p = ComputePercentiles(samples);
+    std::printf("  %-24s %9.2f %9.2f %9.2f %9.2f   (%zu samples)\n",
+                name, p.p50, p.p90, p.p99, p.max, p.count);
+}
+
+//-----------------------------------------------------------------------------
+// Report - Per-client table, pooled percentiles and the pass/fail verdict
+//-----------------------------------------------------------------------------
+bool Report(const LoadGenOptions& options, const std::vector<std::unique_ptr<LoadBot>>& bots)
+{
+    std::vector<double> rtt, interval, tickDelta, snapshotRate, down, up;
+    uint32_t connected = 0, lost = 0;
+    uint64_t snapshots = 0, missed = 0, stale = 0, drops = 0, events = 0;
+
+    std::printf("\n  bot  snaps/s  rtt p50  rtt p99  intv p99  missed  stale  down KB/s  up KB/s\n");
+    for (const auto& bot : bots)
+    {
+        LoadBotStats stats = bot->GetStats();
+        if (!stats.connected)
+        {
+            std::printf("  %3u  (not connected)\n", bot->GetId());
+            continue;
+        }
+
+        const double seconds = std::max(stats.endTime - stats.connectTime, 1e-3);
+        const double rate = stats.snapshots / seconds;
+        const double downKBs = stats.bytesReceived / 1024.0 / seconds;
+        const double upKBs = stats.bytesSent / 1024.0 / seconds;
+
+        rtt.insert(rtt.end(), stats.rttMs.begin(), stats.rttMs.end());
+        interval.insert(interval.end(), stats.intervalMs.begin(), stats.intervalMs.end());
+        tickDelta.insert(tickDelta.end(), stats.tickDeltas.begin(), stats.tickDeltas.end());
+        snapshotRate.push_back(rate);
+        down.push_back(downKBs);
+        up.push_back(upKBs);
+
+        Percentiles botRtt = ComputePercentiles(stats.rttMs);
+        Percentiles botInterval = ComputePercentiles(stats.intervalMs);
+        std::printf("  %3u  %7.1f  %7.0f  %7.0f  %8.1f  %6u  %5u  %9.2f  %7.2f%s\n",
+                    bot->GetId(), rate, botRtt.p50, botRtt.p99, botInterval.p99,
+                    stats.missedTicks, stats.staleSnapshots, downKBs, upKBs,
+                    stats.schemaMismatch ? "  LOST (schema mismatch)" : stats.lostConnection ? "  LOST" : "");
+
+        connected++;
+        if (stats.lostConnection) lost++;
+        snapshots += stats.snapshots;
+        missed += stats.missedTicks;
+        stale += stats.staleSnapshots;
+        drops += stats.snapshotDrops;
+        events += stats.events;
+    }
+
+    std::printf("\n  %-24s %9s %9s %9s %9s\n", "", "p50", "p90", "p99", "max");
+    PrintPercentiles("RTT (ms)", rtt);
+    PrintPercentiles("Snapshot interval (ms)", interval);
+    PrintPercentiles("Tick delta", tickDelta);
+    PrintPercentiles("Snapshots/s per client", snapshotRate);
+    PrintPercentiles("Down KB/s per client", down);
+    PrintPercentiles("Up KB/s per client", up);
+
+    const double missedFraction = (snapshots + missed) ? static_cast<double>(missed) / (snapshots + missed) : 1.0;
+    const double rttP99 = ComputePercentiles(rtt).p99;
+    std::printf("\n  Connected %u/%u  lost %u  snapshots %llu  missed ticks %llu (%.2f%%)  stale %llu  pool drops %llu  events %llu\n",
+                connected, options.clients, lost, static_cast<unsigned long long>(snapshots),
+                static_cast<unsigned long long>(missed), missedFraction * 100.0,
+                static_cast<unsigned long long>(stale), static_cast<unsigned long long>(drops),
+                static_cast<unsigned long long>(events));
+
+    bool ok = true;
+    if (connected != options.clients || lost > 0)
+    {
+        std::printf("  FAILED: %u bot(s) not connected, %u lost the connection\n", options.clients - connected, lost);
+        ok = false;
+    }
+    if (missedFraction > options.maxMissed)
+    {
+        std::printf("  FAILED: missed ticks %.2f%% > %.2f%%\n", missedFraction * 100.0, options.maxMissed * 100.0);
+        ok = false;
+    }
+    if (options.maxRttMs > 0.0 && rttP99 > options.maxRttMs)
+    {
+        std::printf("  FAILED: RTT p99 %.0fms > %.0fms\n", rttP99, options.maxRttMs);
+        ok = false;
+    }
+    std::printf("  Result: %s\n", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    LoadGenOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    std::printf("LoadGen: %u clients -> %s:%u, %.0fs at %uHz, %s inputs%s\n",
+                options.clients, options.host, options.port, options.duration, options.tickRate,
+                options.pattern == BotPattern::SCRIPTED ? "scripted" : "random",
+                options.ioThread ? ", IO threads" : "");
+
+    // 1ms sleeps for the tick loop
+    timeBeginPeriod(1);
+
+    // Connect one at a time (each blocks until the server answers)
+    std::vector<std::unique_ptr<LoadBot>> bots;
+    bots.reserve(options.clients);
+    for (uint32_t id = 0; id < options.clients; id++)
+    {
+        bots.push_back(std::make_unique<LoadBot>(id, options));
+        if (!bots.back()->Connect())
+            std::printf("  bot %u: connect failed\n", id);
+
+        // Keep the bots that are already up serviced while the rest connect
+        for (auto& bot : bots) bot->Poll();
+    }
+
+    // Drive the bots at the rate the server settled on (servers without
+    // TICK_RATE stay at the default)
+    uint32_t tickRate = options.tickRate;
+    for (const auto& bot : bots)
+    {
+        if (!bot->IsConnected()) continue;
+        tickRate = bot->GetTickRate();
+        break;
+    }
+    if (tickRate != options.tickRate)
+        std::printf("  server runs at %uHz (requested %uHz)\n", tickRate, options.tickRate);
+
+    const double tickInterval = 1.0 / tickRate;
+    const double start = NetClock::Now();
+    const double end = start + options.duration;
+    double nextTick = start;
+    double nextProgress = start + PROGRESS_INTERVAL;
+
+    for (double now = start; now < end; now = NetClock::Now())
+    {
+        for (auto& bot : bots) bot->Poll();
+
+        if (now >= nextTick)
+        {
+            for (auto& bot : bots) bot->Tick(now);
+            nextTick += tickInterval;
+            // Fell far behind (debugger, stall): resync instead of bursting
+            if (now - nextTick > 1.0) nextTick = now + tickInterval;
+        }
+
+        if (now >= nextProgress)
+        {
+            uint32_t up = 0;
+            for (const auto& bot : bots) up += bot->IsConnected() ? 1 : 0;
+            std::printf("  t=%3.0fs  connected %u/%u\n", now - start, up, options.clients);
+            nextProgress += PROGRESS_INTERVAL;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const double now = NetClock::Now();
+    for (auto& bot : bots) bot->Finish(now);
+    bool ok = Report(options, bots);
+
+    // Disconnect every bot at once so the server frees their slots in one go
+    for (auto& bot : bots) bot->Disconnect();
+    const double disconnectEnd = NetClock::Now() + ENetClientNetwork::DISCONNECT_TIMEOUT;
+    bool disconnecting = true;
+    while (disconnecting && NetClock::Now() < disconnectEnd)
+    {
+        disconnecting = false;
+        for (auto& bot : bots) disconnecting |= bot->PollDisconnect();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bots.clear();
+    timeEndPeriod(1);
+    return ok ? 0 : 1;
+}
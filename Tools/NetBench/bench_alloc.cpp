@@ -0,0 +1,302 @@
+//=============================================================================
+// bench_alloc.cpp
+//
+// Steady-state allocation check for the snapshot/input path.
+//
+// Global operator new/delete are replaced to count calls. After a warm-up,
+// the MockNetwork path (redundant input batches up, delta snapshots down,
+// read in place through SnapshotHandle, byte budget applied) must not
+// allocate at all, and real ENet traffic over loopback must be served
+// entirely by NetAllocator.
+//=============================================================================
+
+#include <WinSock2.h>
+#include <enet/enet.h>
+#include "net_bench.h"
+#include "mock_network.h"
+#include "net_allocator.h"
+#include "net_packet.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+//-----------------------------------------------------------------------------
+// Counting global allocator
+//-----------------------------------------------------------------------------
+namespace {
+std::atomic<uint64_t> g_NewCount{ 0 };
+}
+
+void* operator new(size_t size)
+{
+    g_NewCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+constexpr uint32_t WARMUP_TICKS = 256;
+constexpr uint32_t MEASURE_TICKS = 20000;
+constexpr uint32_t FRAMES_PER_TICK = 2;
+constexpr uint8_t PLAYER_COUNT = 4;
+
+//-----------------------------------------------------------------------------
+// One simulated tick: client frames send input, server drains inputs and
+// sends a snapshot, client reads snapshots in place
+//-----------------------------------------------------------------------------
+void RunTick(MockNetwork& network, Snapshot& serverSnap, uint32_t tick, uint32_t& outReceived)
+{
+    for (uint32_t f = 0; f < FRAMES_PER_TICK; f++)
+    {
+        InputCmd cmd = {};
+        cmd.tickId = tick;
+        cmd.moveAxisY = 1.0f;
+        cmd.yaw = tick * 0.01f;
+        network.SendInputCmd(cmd);
+    }
+
+    InputCmd received;
+    while (network.ReceiveInputCmd(received)) {}
+
+    FillSnapshot(serverSnap, PLAYER_COUNT, tick);
+    network.SendSnapshot(serverSnap);
+
+    SnapshotHandle handle;
+    while (network.AcquireSnapshot(handle))
+    {
+        if (handle->tickId == tick) outReceived++;
+    }
+}
+
+bool CheckMockNetwork()
+{
+    static MockNetwork network;   // Holds the snapshot pool: too big for the stack
+    network.SetSnapshotDeltaEnabled(true);
+    network.SetInputRedundancy(3);
+    network.SetSnapshotByteBudget(64);   // Forces deferral every tick
+    network.Initialize();
+
+    Snapshot serverSnap = {};
+    uint32_t received = 0;
+    uint32_t tick = 1;
+
+    for (; tick <= WARMUP_TICKS; tick++) RunTick(network, serverSnap, tick, received);
+
+    received = 0;
+    uint64_t newBefore = g_NewCount.load();
+    BenchTimer timer;
+    for (uint32_t i = 0; i < MEASURE_TICKS; i++, tick++) RunTick(network, serverSnap, tick, received);
+    double seconds = timer.GetSeconds();
+    uint64_t newCalls = g_NewCount.load() - newBefore;
+
+    network.Finalize();
+
+    std::printf("MockNetwork   %u ticks  %.2f us/tick  delivered %u  operator new %llu\n",
+                MEASURE_TICKS, seconds * 1e6 / MEASURE_TICKS, received,
+                static_cast<unsigned long long>(newCalls));
+
+    return newCalls == 0 && received == MEASURE_TICKS;
+}
+
+//-----------------------------------------------------------------------------
+// ENet loopback: a client and a server host on 127.0.0.1 with NetAllocator
+// installed, exchanging input packets up (pooled payloads, as
+// ENetClientNetwork sends them), snapshots down and a reliable event now
+// and then. Host setup may reach the heap; after the warm-up every packet,
+// command and acknowledgement must come from the block classes.
+//-----------------------------------------------------------------------------
+constexpr enet_uint16 LOOPBACK_PORT = 17777;
+constexpr uint32_t LOOPBACK_WARMUP_TICKS = 256;
+constexpr uint32_t LOOPBACK_MEASURE_TICKS = 4000;
+constexpr uint32_t LOOPBACK_EVENT_INTERVAL = 8;
+constexpr size_t INPUT_PACKET_BYTES = 101;      // Redundant batch of 3 inputs
+constexpr size_t SNAPSHOT_PACKET_BYTES = 480;   // Delta snapshot, a few players
+constexpr size_t EVENT_PACKET_BYTES = 24;
+
+void* ENET_CALLBACK LoopbackMalloc(size_t size) { return NetAllocator::Allocate(size); }
+void ENET_CALLBACK LoopbackFree(void* memory) { NetAllocator::Free(memory); }
+void ENET_CALLBACK FreePooledPayload(ENetPacket* packet) { NetAllocator::Free(packet->data); }
+
+void SendPooledInput(ENetPeer* peer, uint32_t tick)
+{
+    uint8_t* buffer = static_cast<uint8_t*>(NetAllocator::Allocate(INPUT_PACKET_BYTES));
+    if (!buffer) return;
+    std::memset(buffer, static_cast<int>(tick), INPUT_PACKET_BYTES);
+
+    ENetPacket* packet = enet_packet_create(buffer, INPUT_PACKET_BYTES,
+        ENET_PACKET_FLAG_UNSEQUENCED | ENET_PACKET_FLAG_NO_ALLOCATE);
+    if (!packet)
+    {
+        NetAllocator::Free(buffer);
+        return;
+    }
+    packet->freeCallback = FreePooledPayload;
+    if (enet_peer_send(peer, NetChannel::SNAPSHOT, packet) < 0) enet_packet_destroy(packet);
+}
+
+void SendCopied(ENetPeer* peer, uint8_t channel, size_t size, enet_uint32 flags, uint32_t tick)
+{
+    uint8_t payload[SNAPSHOT_PACKET_BYTES];
+    std::memset(payload, static_cast<int>(tick), size);
+    ENetPacket* packet = enet_packet_create(payload, size, flags);
+    if (packet && enet_peer_send(peer, channel, packet) < 0) enet_packet_destroy(packet);
+}
+
+// Services a host until it has nothing left; returns the packets received
+uint32_t Drain(ENetHost* host, ENetPeer** outPeer)
+{
+    uint32_t received = 0;
+    ENetEvent event;
+    while (enet_host_service(host, &event, 0) > 0)
+    {
+        if (event.type == ENET_EVENT_TYPE_CONNECT && outPeer) *outPeer = event.peer;
+        if (event.type == ENET_EVENT_TYPE_RECEIVE)
+        {
+            received++;
+            enet_packet_destroy(event.packet);
+        }
+    }
+    return received;
+}
+
+bool CheckENetLoopback()
+{
+    ENetCallbacks callbacks = {};
+    callbacks.malloc = LoopbackMalloc;
+    callbacks.free = LoopbackFree;
+    if (enet_initialize_with_callbacks(ENET_VERSION, &callbacks) != 0)
+    {
+        std::printf("ENet loopback  enet_initialize failed\n");
+        return false;
+    }
+
+    ENetAddress address = {};
+    enet_address_set_host(&address, "127.0.0.1");
+    address.port = LOOPBACK_PORT;
+    ENetHost* server = enet_host_create(&address, 1, NetChannel::COUNT, 0, 0);
+    ENetHost* client = enet_host_create(nullptr, 1, NetChannel::COUNT, 0, 0);
+    ENetPeer* serverPeer = client ? enet_host_connect(client, &address, NetChannel::COUNT, 0) : nullptr;
+    ENetPeer* clientPeer = nullptr;
+
+    // Handshake
+    BenchTimer connectTimer;
+    while (serverPeer && connectTimer.GetSeconds() < 2.0 &&
+           (!clientPeer || serverPeer->state != ENET_PEER_STATE_CONNECTED))
+    {
+        Drain(client, nullptr);
+        Drain(server, &clientPeer);
+    }
+    if (!clientPeer || !serverPeer || serverPeer->state != ENET_PEER_STATE_CONNECTED)
+    {
+        std::printf("ENet loopback  could not connect on 127.0.0.1:%u\n", LOOPBACK_PORT);
+        if (client) enet_host_destroy(client);
+        if (server) enet_host_destroy(server);
+        enet_deinitialize();
+        return false;
+    }
+
+    uint32_t upReceived = 0;
+    uint32_t downReceived = 0;
+    NetAllocator::Stats before = {};
+    uint64_t newBefore = 0;
+    BenchTimer timer;
+
+    const uint32_t totalTicks = LOOPBACK_WARMUP_TICKS + LOOPBACK_MEASURE_TICKS;
+    for (uint32_t tick = 1; tick <= totalTicks; tick++)
+    {
+        if (tick == LOOPBACK_WARMUP_TICKS + 1)
+        {
+            before = NetAllocator::GetStats();
+            newBefore = g_NewCount.load();
+            upReceived = 0;
+            downReceived = 0;
+            timer = BenchTimer();
+        }
+
+        // Each service flushes the host's sends and counts what reached it
+        SendPooledInput(serverPeer, tick);
+        downReceived += Drain(client, nullptr);
+        upReceived += Drain(server, nullptr);
+
+        SendCopied(clientPeer, NetChannel::SNAPSHOT, SNAPSHOT_PACKET_BYTES,
+                   ENET_PACKET_FLAG_UNSEQUENCED, tick);
+        if (tick % LOOPBACK_EVENT_INTERVAL == 0)
+        {
+            SendCopied(clientPeer, NetChannel::EVENTS, EVENT_PACKET_BYTES,
+                       ENET_PACKET_FLAG_RELIABLE, tick);
+        }
+        upReceived += Drain(server, nullptr);
+        downReceived += Drain(client, nullptr);
+    }
+    const double seconds = timer.GetSeconds();
+    const NetAllocator::Stats after = NetAllocator::GetStats();
+    const uint64_t newCalls = g_NewCount.load() - newBefore;
+
+    enet_peer_disconnect_now(serverPeer, 0);
+    enet_host_destroy(client);
+    enet_host_destroy(server);
+    enet_deinitialize();
+
+    const uint64_t heapAllocs = after.heapAllocs - before.heapAllocs;
+    const uint64_t poolAllocs = after.poolAllocs - before.poolAllocs;
+    std::printf("ENet loopback %u ticks  %.1f us/tick  packets %u up %u down  "
+                "pool allocs %llu  heap fallbacks %llu  operator new %llu\n",
+                LOOPBACK_MEASURE_TICKS, seconds * 1e6 / LOOPBACK_MEASURE_TICKS,
+                upReceived, downReceived,
+                static_cast<unsigned long long>(poolAllocs),
+                static_cast<unsigned long long>(heapAllocs),
+                static_cast<unsigned long long>(newCalls));
+
+    // Loopback loses nothing, but the last tick's packets may still be in
+    // flight when the loop ends
+    const uint32_t expectedDown = LOOPBACK_MEASURE_TICKS + LOOPBACK_MEASURE_TICKS / LOOPBACK_EVENT_INTERVAL;
+    return heapAllocs == 0 && newCalls == 0 && poolAllocs > 0 &&
+           upReceived + 1 >= LOOPBACK_MEASURE_TICKS && downReceived + 2 >= expectedDown;
+}
+
+//-----------------------------------------------------------------------------
+// Game holding every slot: new snapshots are dropped and counted, and the
+// pool recovers once the handles are released
+//-----------------------------------------------------------------------------
+bool CheckPoolExhaustion()
+{
+    static SnapshotPool pool;
+    pool.Reset();
+
+    static SnapshotHandle held[SnapshotPool::SLOT_COUNT];
+    for (size_t i = 0; i < SnapshotPool::SLOT_COUNT + 4; i++)
+    {
+        SnapshotPool::Slot* slot = pool.BeginWrite();
+        if (!slot) continue;
+        slot->snapshot.tickId = static_cast<uint32_t>(i);
+        slot->arrivalTime = 0.0;
+        pool.CommitWrite();
+        pool.Acquire(held[i]);
+    }
+    uint32_t drops = pool.GetDropCount();
+
+    for (SnapshotHandle& handle : held) handle.Release();
+    bool recovered = pool.BeginWrite() != nullptr;
+
+    std::printf("SnapshotPool  %zu slots held  dropped %u  recovered %s\n",
+                SnapshotPool::SLOT_COUNT, drops, recovered ? "yes" : "NO");
+
+    return drops == 4 && recovered;
+}
+
+} // namespace
+
+int Bench_Alloc()
+{
+    bool ok = true;
+    ok &= CheckMockNetwork();
+    ok &= CheckENetLoopback();
+    ok &= CheckPoolExhaustion();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+//=============================================================================
+// bench_bundle.cpp
+//
+// BUNDLE framing round trip, MTU splitting and malformed input, then the
+// upstream of a client at 32Hz (redundant INPUT_BATCH + SNAPSHOT_ACK every
+// tick): ENet send calls and command header bytes with and without bundling.
+//=============================================================================
+
+#include "net_bench.h"
+#include "input_batch.h"
+#include "net_bundle.h"
+#include "net_reflect.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// Deterministic message i: a PacketType byte, then a size-dependent pattern
+size_t MakeMessage(uint32_t i, uint8_t* out)
+{
+    const size_t size = 1 + (i * 37u) % 300u;
+    out[0] = static_cast<uint8_t>(1 + i % 7);                     // INPUT_CMD..EVENT_BATCH, never BUNDLE
+    for (size_t b = 1; b < size; b++) out[b] = static_cast<uint8_t>(i * 131u + b);
+    return size;
+}
+
+//-----------------------------------------------------------------------------
+// Framing: pack MESSAGES greedily, unpack every packet, compare
+//-----------------------------------------------------------------------------
+constexpr uint32_t MESSAGES = 10000;
+
+bool TestFraming()
+{
+    static PacketBundler bundler;
+    static uint8_t packets[MESSAGES][NET_BUNDLE_MAX_SIZE];
+    static size_t packetSizes[MESSAGES];
+    uint8_t message[NET_BUNDLE_MAX_SIZE];
+    uint8_t expected[NET_BUNDLE_MAX_SIZE];
+
+    bundler.SetMtu(NET_BUNDLE_DEFAULT_MTU);
+    size_t packetCount = 0, messageBytes = 0, packetBytes = 0, maxPacket = 0;
+
+    BenchTimer timer;
+    for (uint32_t i = 0; i <= MESSAGES; i++)
+    {
+        const size_t size = (i < MESSAGES) ? MakeMessage(i, message) : 0;
+        if (i < MESSAGES && bundler.Append(message, size)) continue;
+
+        // Full (or done): flush, then start the next bundle with this message
+        std::memcpy(packets[packetCount], bundler.GetData(), bundler.GetSize());
+        packetSizes[packetCount++] = bundler.GetSize();
+        bundler.Clear();
+        if (i < MESSAGES) bundler.Append(message, size);
+    }
+    const double packSeconds = timer.GetSeconds();
+
+    // Unpack in order: every message back, byte for byte
+    bool roundTripOk = true;
+    uint32_t next = 0;
+    BenchTimer unpackTimer;
+    for (size_t p = 0; p < packetCount && roundTripOk; p++)
+    {
+        const uint8_t* data = packets[p];
+        const size_t size = packetSizes[p];
+        packetBytes += size;
+        if (size > maxPacket) maxPacket = size;
+
+        if (static_cast<PacketType>(data[0]) != PacketType::BUNDLE)
+        {
+            // Lone message, sent unframed
+            const size_t expectedSize = MakeMessage(next++, expected);
+            roundTripOk = size == expectedSize && std::memcmp(data, expected, size) == 0;
+            continue;
+        }
+
+        BundleReader reader(data + 1, size - 1);
+        const uint8_t* inner = nullptr;
+        size_t innerSize = 0;
+        while (roundTripOk && reader.Next(inner, innerSize))
+        {
+            const size_t expectedSize = MakeMessage(next++, expected);
+            roundTripOk = innerSize == expectedSize && std::memcmp(inner, expected, innerSize) == 0;
+            messageBytes += innerSize;
+        }
+        roundTripOk &= !reader.HasError();
+    }
+    const double unpackSeconds = unpackTimer.GetSeconds();
+    roundTripOk &= next == MESSAGES && maxPacket <= NET_BUNDLE_DEFAULT_MTU;
+
+    // A lone message goes out as is; one larger than the MTU is refused
+    bundler.SetMtu(64);
+    const size_t loneSize = MakeMessage(3, message);                // 112 B
+    const bool bigRefused = !bundler.Append(message, loneSize) && bundler.IsEmpty();
+    const size_t smallSize = MakeMessage(1, message);               // 38 B
+    const bool loneOk = bundler.Append(message, smallSize) && bundler.GetSize() == smallSize &&
+                        std::memcmp(bundler.GetData(), message, smallSize) == 0 &&
+                        !bundler.Append(message, smallSize);        // Second would exceed 64
+    bundler.SetMtu(0);
+    const bool disabledOk = !bundler.IsEnabled() && !bundler.Append(message, smallSize);
+
+    // Malformed: truncated message, zero length, nested bundle, endless varint
+    const uint8_t truncated[] = { 5, 2, 1, 2 };
+    const uint8_t zero[] = { 1, 2, 0 };
+    const uint8_t nested[] = { 2, static_cast<uint8_t>(PacketType::BUNDLE), 0 };
+    const uint8_t endless[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 1 };
+    struct Malformed { const uint8_t* data; size_t size; uint32_t validBefore; };
+    const Malformed cases[] = {
+        { truncated, sizeof(truncated), 0 },
+        { zero, sizeof(zero), 1 },
+        { nested, sizeof(nested), 0 },
+        { endless, sizeof(endless), 0 },
+    };
+    bool rejectOk = true;
+    for (const Malformed& bad : cases)
+    {
+        BundleReader reader(bad.data, bad.size);
+        const uint8_t* inner = nullptr;
+        size_t innerSize = 0;
+        uint32_t count = 0;
+        while (reader.Next(inner, innerSize)) count++;
+        rejectOk &= reader.HasError() && count == bad.validBefore;
+    }
+
+    std::printf("Framing     %u messages -> %zu packets (max %zu B), framing %.2f%%  %s\n",
+                MESSAGES, packetCount, maxPacket,
+                100.0 * (packetBytes - messageBytes) / static_cast<double>(packetBytes), roundTripOk ? "ok" : "FAILED");
+    std::printf("Cost        pack %.1f ns, unpack %.1f ns per message\n",
+                packSeconds * 1e9 / MESSAGES, unpackSeconds * 1e9 / MESSAGES);
+    std::printf("Edges       lone unframed / oversized refused / disabled  %s\n",
+                (loneOk && bigRefused && disabledOk) ? "ok" : "FAILED");
+    std::printf("Malformed   truncated / zero / nested / long varint rejected  %s\n", rejectOk ? "ok" : "FAILED");
+    return roundTripOk && loneOk && bigRefused && disabledOk && rejectOk;
+}
+
+//-----------------------------------------------------------------------------
+// Upstream: one redundant input batch and one ack per tick
+//-----------------------------------------------------------------------------
+
+// ENet command header of an unsequenced send (ENetProtocolSendUnsequenced:
+// command header + group + length), paid once per enet_peer_send. The UDP
+// and ENet datagram headers are shared either way, since ENet already packs
+// the commands of one flush into a datagram.
+constexpr size_t ENET_SEND_COMMAND_BYTES = 8;
+constexpr uint32_t TICKS = 32 * 60;
+
+bool TestUpstream()
+{
+    static PacketBundler bundler;
+    InputBatchEncoder encoder;
+    encoder.SetRedundancy(3);
+    bundler.SetMtu(NET_BUNDLE_DEFAULT_MTU);
+
+    size_t separateSends = 0, separateBytes = 0;
+    size_t bundledSends = 0, bundledBytes = 0;
+    bool ok = true;
+
+    for (uint32_t tick = 1; tick <= TICKS; tick++)
+    {
+        InputCmd cmd = {};
+        cmd.tickId = tick;
+        cmd.yaw = tick * 0.01f;
+        cmd.moveAxisY = 1.0f;
+
+        uint8_t input[1 + INPUT_BATCH_MAX_SIZE];
+        input[0] = static_cast<uint8_t>(PacketType::INPUT_BATCH);
+        const size_t inputSize = 1 + encoder.Encode(cmd, input + 1, sizeof(input) - 1);
+
+        uint8_t ack[1 + sizeof(uint32_t)];
+        ack[0] = static_cast<uint8_t>(PacketType::SNAPSHOT_ACK);
+        NetReflect::StoreLE(ack + 1, tick - 1);
+
+        separateSends += 2;
+        separateBytes += inputSize + sizeof(ack) + 2 * ENET_SEND_COMMAND_BYTES;
+
+        ok &= bundler.Append(input, inputSize) && bundler.Append(ack, sizeof(ack));
+        bundledSends++;
+        bundledBytes += bundler.GetSize() + ENET_SEND_COMMAND_BYTES;
+        bundler.Clear();
+    }
+
+    const double separatePerTick = static_cast<double>(separateBytes) / TICKS;
+    const double bundledPerTick = static_cast<double>(bundledBytes) / TICKS;
+    ok &= bundledSends * 2 == separateSends && bundledBytes < separateBytes;
+
+    std::printf("Upstream    %u ticks, input batch + ack per tick:\n", TICKS);
+    std::printf("  separate  %.1f sends, %.1f B per tick\n", static_cast<double>(separateSends) / TICKS, separatePerTick);
+    std::printf("  bundled   %.1f sends, %.1f B per tick (-%.1f%%)  %s\n",
+                static_cast<double>(bundledSends) / TICKS, bundledPerTick,
+                100.0 * (1.0 - bundledPerTick / separatePerTick), ok ? "ok" : "FAILED");
+    return ok;
+}
+
+} // namespace
+
+int Bench_Bundle()
+{
+    bool ok = TestFraming();
+    ok &= TestUpstream();
+    return ok ? 0 : 1;
+}
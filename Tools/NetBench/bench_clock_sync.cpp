@@ -0,0 +1,205 @@
+//=============================================================================
+// bench_clock_sync.cpp
+//
+// ClockSync against a simulated server clock (offset, +200 ppm drift) over a
+// jittery path with occasional delay spikes and a mid-run latency change.
+//
+// Checks that the server clock estimate converges, that the published
+// timeline only ever changes rate within the slew limit, and compares
+// interpolation of a constant-speed object on the old timeline (arrival
+// stamps, 100ms delay) with the server timeline (server stamps, 75ms
+// delay): speed error per frame and frames that ran out of data.
+//=============================================================================
+
+#include "net_bench.h"
+#include "clock_sync.h"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+constexpr double TICK = 1.0 / 32.0;
+constexpr double FRAME = 1.0 / 144.0;
+constexpr double DURATION = 60.0;
+constexpr double WARMUP = 5.0;
+constexpr double SERVER_EPOCH = 500.0;
+constexpr double SERVER_DRIFT = 200e-6;
+constexpr double OLD_DELAY = 0.100;
+constexpr double NEW_DELAY = 0.075;
+
+double ServerClock(double local) { return SERVER_EPOCH + local * (1.0 + SERVER_DRIFT); }
+
+Lcg g_Random = { 12345u };
+
+// Base one-way delay: 30ms, 60ms for the middle third of the run
+double BaseDelay(double local) { return (local > DURATION / 3 && local < 2 * DURATION / 3) ? 0.060 : 0.030; }
+
+// The filter needs a window plus the slew time to follow a latency change
+bool SettlingAfterChange(double local)
+{
+    double sinceChange = std::fmod(local, DURATION / 3);
+    return local > DURATION / 3 && sinceChange < 2.0;
+}
+
+//-----------------------------------------------------------------------------
+// Minimal interpolation buffer: (timestamp, value) pairs, sorted by time
+//-----------------------------------------------------------------------------
+struct Sample
+{
+    double time;
+    double value;
+};
+
+class Timeline
+{
+public:
+    void Push(double time, double value)
+    {
+        if (m_Count == CAPACITY)
+        {
+            for (size_t i = 1; i < m_Count; i++) m_Samples[i - 1] = m_Samples[i];
+            m_Count--;
+        }
+        size_t i = m_Count;
+        while (i > 0 && m_Samples[i - 1].time > time)
+        {
+            m_Samples[i] = m_Samples[i - 1];
+            i--;
+        }
+        m_Samples[i] = { time, value };
+        m_Count++;
+    }
+
+    // Interpolated value at renderTime; flags when past the newest sample
+    double Sample(double renderTime, bool& outStarved) const
+    {
+        outStarved = false;
+        for (size_t i = 0; i + 1 < m_Count; i++)
+        {
+            const ::Sample& a = m_Samples[i];
+            const ::Sample& b = m_Samples[i + 1];
+            if (a.time <= renderTime && renderTime < b.time)
+                return a.value + (b.value - a.value) * (renderTime - a.time) / (b.time - a.time);
+        }
+        outStarved = renderTime >= m_Samples[m_Count - 1].time;
+        return outStarved ? m_Samples[m_Count - 1].value : m_Samples[0].value;
+    }
+
+    size_t Size() const { return m_Count; }
+
+private:
+    static constexpr size_t CAPACITY = 32;
+    ::Sample m_Samples[CAPACITY] = {};
+    size_t m_Count = 0;
+};
+
+struct InFlight
+{
+    double arrival;
+    double serverTime;
+};
+
+} // namespace
+
+int Bench_ClockSync()
+{
+    static ClockSync sync;
+    sync.Reset();
+
+    static Timeline oldLine;
+    static Timeline newLine;
+    static InFlight inFlight[64];
+    size_t inFlightCount = 0;
+
+    double nextSend = 0.0;
+    double maxServerError = 0.0;
+    double maxRateDeviation = 0.0;
+    double oldSpeedSq = 0.0, newSpeedSq = 0.0;
+    uint32_t oldStarved = 0, newStarved = 0;
+    uint32_t frames = 0;
+
+    double prevOld = 0.0, prevNew = 0.0, prevTimeline = 0.0;
+    bool havePrev = false;
+
+    for (double now = 0.0; now < DURATION; now += FRAME)
+    {
+        // Server sends at 32Hz of its own clock
+        while (nextSend <= now)
+        {
+            double delay = BaseDelay(nextSend) + g_Random.Next() * 0.025;
+            if (g_Random.Next() < 0.05) delay += 0.080;
+            if (inFlightCount < 64) inFlight[inFlightCount++] = { nextSend + delay, ServerClock(nextSend) };
+            nextSend += TICK / (1.0 + SERVER_DRIFT);
+        }
+
+        // Deliver in arrival order
+        for (;;)
+        {
+            size_t first = inFlightCount;
+            for (size_t i = 0; i < inFlightCount; i++)
+            {
+                if (inFlight[i].arrival <= now && (first == inFlightCount || inFlight[i].arrival < inFlight[first].arrival))
+                    first = i;
+            }
+            if (first == inFlightCount) break;
+
+            const InFlight packet = inFlight[first];
+            inFlight[first] = inFlight[--inFlightCount];
+
+            sync.AddSample(packet.serverTime, packet.arrival, 2.0 * BaseDelay(packet.arrival));
+            oldLine.Push(packet.arrival, packet.serverTime);     // value = position of a 1 m/s object
+            newLine.Push(packet.serverTime, packet.serverTime);
+        }
+        if (!sync.IsSynced() || oldLine.Size() < 2) continue;
+
+        bool oldStarve, newStarve;
+        double oldValue = oldLine.Sample(now - OLD_DELAY, oldStarve);
+        double timeline = sync.GetArrivalTimeline(now);
+        double newValue = newLine.Sample(timeline - NEW_DELAY, newStarve);
+
+        if (now > WARMUP && havePrev)
+        {
+            // Ideal: the object advances by exactly one frame of server time
+            double ideal = FRAME * (1.0 + SERVER_DRIFT);
+            double oldErr = (oldValue - prevOld - ideal) / FRAME;
+            double newErr = (newValue - prevNew - ideal) / FRAME;
+            oldSpeedSq += oldErr * oldErr;
+            newSpeedSq += newErr * newErr;
+            oldStarved += oldStarve;
+            newStarved += newStarve;
+
+            double rate = (timeline - prevTimeline) / FRAME;
+            double deviation = std::fabs(rate - 1.0);
+            if (deviation > maxRateDeviation) maxRateDeviation = deviation;
+
+            double serverError = std::fabs(sync.GetServerTime(now) - ServerClock(now));
+            if (!SettlingAfterChange(now) && serverError > maxServerError) maxServerError = serverError;
+            frames++;
+        }
+        prevOld = oldValue;
+        prevNew = newValue;
+        prevTimeline = timeline;
+        havePrev = true;
+    }
+
+    double oldRms = std::sqrt(oldSpeedSq / frames);
+    double newRms = std::sqrt(newSpeedSq / frames);
+
+    std::printf("Server clock  max error %.1f ms (settled)  drift %.0f ppm (true %.0f)  steps %u\n",
+                maxServerError * 1000.0, sync.GetDrift() * 1e6, SERVER_DRIFT * 1e6, sync.GetStepCount());
+    std::printf("Timeline      max rate deviation %.1f%% (limit %.1f%%)\n",
+                maxRateDeviation * 100.0, (ClockSync::MAX_SLEW + ClockSync::MAX_DRIFT) * 100.0);
+    std::printf("Interpolation arrival stamps @%.0fms: speed error %.3f rms, starved %u/%u frames\n",
+                OLD_DELAY * 1000.0, oldRms, oldStarved, frames);
+    std::printf("              server timeline @%.0fms: speed error %.3f rms, starved %u/%u frames\n",
+                NEW_DELAY * 1000.0, newRms, newStarved, frames);
+
+    // Only the latency increase may starve the shorter delay, while the
+    // timeline slews back; the rate limit must hold throughout
+    bool ok = maxServerError < 0.005 &&
+              maxRateDeviation <= ClockSync::MAX_SLEW + ClockSync::MAX_DRIFT + 1e-6 &&
+              sync.GetStepCount() == 0 &&
+              newRms * 3.0 < oldRms &&
+              newStarved * 100 < frames;
+    return ok ? 0 : 1;
+}
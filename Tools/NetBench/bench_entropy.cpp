@@ -0,0 +1,335 @@
+//=============================================================================
+// bench_entropy.cpp
+//
+// Range coder round trip and compression on skewed bits and integers, then
+// whole sessions of moving players through a bit-packed and an entropy
+// coding SnapshotDeltaEncoder/Decoder side by side: bytes per player per
+// tick, encode/decode cost, and lockstep models across packet loss and the
+// full snapshots that follow an ack outage.
+//=============================================================================
+
+#include "net_bench.h"
+#include "range_coder.h"
+#include "snapshot_delta.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+//-----------------------------------------------------------------------------
+// Coder: skewed bits, geometric integers, raw bits, truncation
+//-----------------------------------------------------------------------------
+bool TestCoder()
+{
+    constexpr uint32_t SYMBOLS = 200000;
+    static uint8_t stream[SYMBOLS * 8];
+    static uint32_t values[SYMBOLS];
+    static uint8_t bits[SYMBOLS];
+
+    Lcg rng = { 7 };
+    double idealBits = 0.0;
+    for (uint32_t i = 0; i < SYMBOLS; i++)
+    {
+        bits[i] = rng.Next() < 0.05 ? 1 : 0;
+        values[i] = static_cast<uint32_t>(-8.0 * std::log(1.0 - rng.Next()));
+    }
+    idealBits = SYMBOLS * (-(0.05 * std::log2(0.05) + 0.95 * std::log2(0.95)));
+
+    BitModel bitModel;
+    AdaptiveIntModel<16> intModel;
+    RangeEncoder enc(stream, sizeof(stream));
+    BenchTimer encodeTimer;
+    for (uint32_t i = 0; i < SYMBOLS; i++)
+    {
+        enc.EncodeBit(bitModel, bits[i]);
+        intModel.Encode(enc, values[i]);
+        enc.EncodeDirect(i & 0x3FF, 10);
+    }
+    const size_t size = enc.Finish();
+    const double encodeNs = encodeTimer.GetSeconds() * 1e9 / (SYMBOLS * 3.0);
+
+    BitModel bitModelDec;
+    AdaptiveIntModel<16> intModelDec;
+    RangeDecoder dec(stream, size);
+    bool ok = size > 0;
+    BenchTimer decodeTimer;
+    for (uint32_t i = 0; i < SYMBOLS && ok; i++)
+    {
+        ok &= dec.DecodeBit(bitModelDec) == bits[i];
+        ok &= intModelDec.Decode(dec) == values[i];
+        ok &= dec.DecodeDirect(10) == (i & 0x3FF);
+    }
+    const double decodeNs = decodeTimer.GetSeconds() * 1e9 / (SYMBOLS * 3.0);
+    ok &= dec.IsAtEnd();
+
+    // Skewed bits alone: close to their entropy
+    BitModel skewModel;
+    RangeEncoder skewEnc(stream, sizeof(stream));
+    for (uint32_t i = 0; i < SYMBOLS; i++) skewEnc.EncodeBit(skewModel, bits[i]);
+    const size_t skewSize = skewEnc.Finish();
+    const double overhead = skewSize * 8.0 / idealBits - 1.0;
+    ok &= overhead < 0.05;
+
+    // Short streams, including the empty one, and truncation
+    bool edgesOk = true;
+    for (uint32_t count = 0; count < 64; count++)
+    {
+        uint8_t small[64];
+        BitModel model;
+        RangeEncoder smallEnc(small, sizeof(small));
+        for (uint32_t i = 0; i < count; i++) smallEnc.EncodeBit(model, bits[i * 7]);
+        smallEnc.EncodeDirect(count, 8);
+        const size_t smallSize = smallEnc.Finish();
+
+        BitModel decModel;
+        RangeDecoder smallDec(small, smallSize);
+        bool same = true;
+        for (uint32_t i = 0; i < count; i++) same &= smallDec.DecodeBit(decModel) == bits[i * 7];
+        edgesOk &= same && smallDec.DecodeDirect(8) == count && smallDec.IsAtEnd() && !smallEnc.HasOverflow();
+    }
+    uint8_t tiny[2];
+    RangeEncoder full(tiny, sizeof(tiny));
+    full.EncodeDirect(0xABCDEF, 24);
+    edgesOk &= full.Finish() == 0 && full.HasOverflow();
+
+    RangeDecoder truncated(stream, size - 5);
+    BitModel truncBit;
+    AdaptiveIntModel<16> truncInt;
+    for (uint32_t i = 0; i < SYMBOLS; i++)
+    {
+        truncated.DecodeBit(truncBit);
+        truncInt.Decode(truncated);
+        truncated.DecodeDirect(10);
+    }
+    edgesOk &= truncated.HasOverflow() && !truncated.IsAtEnd();
+
+    std::printf("Coder       %u x (bit p=0.05, geometric int, 10 raw bits) -> %zu B, round trip  %s\n",
+                SYMBOLS, size, ok ? "ok" : "FAILED");
+    std::printf("            skewed bits %.1f%% above entropy, %.1f ns encode / %.1f ns decode per symbol\n",
+                overhead * 100.0, encodeNs, decodeNs);
+    std::printf("Edges       short streams / overflow / truncation  %s\n", edgesOk ? "ok" : "FAILED");
+    return ok && edgesOk;
+}
+
+//-----------------------------------------------------------------------------
+// Session: players run, strafe, turn, jump and shoot at 32Hz
+//-----------------------------------------------------------------------------
+constexpr uint32_t TICK_COUNT = 1500;
+constexpr double TICK = 1.0 / 32.0;
+constexpr double LOSS = 0.05;
+constexpr uint32_t ACK_DELAY = 2;              // Ticks until the server sees an ack
+constexpr uint32_t OUTAGE_PERIOD = 600;        // Every so often the acks stop for a while,
+constexpr uint32_t OUTAGE_TICKS = 40;          // long enough to force full snapshots
+const uint8_t PLAYER_COUNTS[] = { 8, 32, 64, 128 };
+
+struct SimPlayer
+{
+    float x, y, z;
+    float vx, vy, vz;
+    float yaw, pitch;
+    float turnRate;
+    uint32_t flags;
+    uint8_t health;
+    uint16_t fireCounter;
+    bool idle;
+};
+
+void InitPlayers(SimPlayer* players, uint32_t count, Lcg& rng)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        SimPlayer& p = players[i];
+        std::memset(&p, 0, sizeof(p));
+        p.x = static_cast<float>(rng.Next() * 200.0 - 100.0);
+        p.z = static_cast<float>(rng.Next() * 200.0 - 100.0);
+        p.yaw = static_cast<float>(rng.Next() * 6.0 - 3.0);
+        p.flags = NetStateFlags::IS_GROUNDED;
+        p.health = 100;
+        p.idle = (i % 4 == 3);                  // Campers, AFK, dead
+    }
+}
+
+void StepPlayer(SimPlayer& p, Lcg& rng)
+{
+    const float dt = static_cast<float>(TICK);
+    if (p.idle)
+    {
+        if (rng.Next() < 0.02) p.yaw += static_cast<float>(rng.Next() - 0.5) * 0.3f;
+        return;
+    }
+
+    // Steer: turn rate changes now and then, speed follows the facing
+    if (rng.Next() < 0.05) p.turnRate = static_cast<float>(rng.Next() - 0.5) * 3.0f;
+    p.yaw += p.turnRate * dt;
+    if (p.yaw > 3.14159f) p.yaw -= 6.28318f;
+    if (p.yaw < -3.14159f) p.yaw += 6.28318f;
+    p.pitch = 0.2f * std::sin(p.yaw * 3.0f);
+
+    const float speed = (rng.Next() < 0.9) ? 6.0f : 0.0f;
+    p.vx += (std::sin(p.yaw) * speed - p.vx) * 0.3f;
+    p.vz += (std::cos(p.yaw) * speed - p.vz) * 0.3f;
+
+    // Jumps and gravity
+    if ((p.flags & NetStateFlags::IS_GROUNDED) && rng.Next() < 0.01)
+    {
+        p.vy = 5.0f;
+        p.flags = (p.flags & ~NetStateFlags::IS_GROUNDED) | NetStateFlags::IS_JUMPING;
+    }
+    if (!(p.flags & NetStateFlags::IS_GROUNDED))
+    {
+        p.vy -= 9.8f * dt;
+        p.y += p.vy * dt;
+        if (p.y <= 0.0f)
+        {
+            p.y = 0.0f;
+            p.vy = 0.0f;
+            p.flags = (p.flags & ~NetStateFlags::IS_JUMPING) | NetStateFlags::IS_GROUNDED;
+        }
+    }
+    p.x += p.vx * dt;
+    p.z += p.vz * dt;
+    if (p.x < -120.0f || p.x > 120.0f) p.vx = -p.vx;
+    if (p.z < -120.0f || p.z > 120.0f) p.vz = -p.vz;
+
+    // Bursts of fire, occasional damage
+    if (rng.Next() < 0.03) p.flags ^= NetStateFlags::IS_FIRING;
+    if (p.flags & NetStateFlags::IS_FIRING) p.fireCounter++;
+    if (rng.Next() < 0.01) p.health = static_cast<uint8_t>(p.health > 20 ? p.health - 20 : 100);
+}
+
+void ToState(const SimPlayer& p, uint32_t tick, NetPlayerState& out)
+{
+    std::memset(&out, 0, sizeof(out));
+    out.tickId = tick;
+    out.position = { p.x, p.y, p.z };
+    out.velocity = { p.vx, p.vy, p.vz };
+    out.yaw = p.yaw;
+    out.pitch = p.pitch;
+    out.stateFlags = p.flags;
+    out.health = p.health;
+    out.fireCounter = p.fireCounter;
+}
+
+void FillSnapshot(Snapshot& snap, const SimPlayer* players, uint8_t playerCount, uint32_t tick)
+{
+    ::FillSnapshot(snap, playerCount, tick);
+    snap.serverTime = tick * TICK;
+    snap.inputBufferDepth = 2;
+    ToState(players[0], tick, snap.localPlayer);
+    for (uint8_t i = 0; i < snap.remotePlayerCount; i++)
+    {
+        ToState(players[i + 1], tick, snap.remotePlayers[i].state);
+    }
+}
+
+struct CodecStats
+{
+    size_t bytes = 0;
+    double encodeSeconds = 0.0;
+    double decodeSeconds = 0.0;
+};
+
+bool RunSession(uint8_t playerCount)
+{
+    static SnapshotDeltaEncoder packedEncoder, entropyEncoder;
+    static SnapshotDeltaDecoder packedDecoder, entropyDecoder;
+    static Snapshot serverSnap, expected, clientSnap;
+    static SimPlayer players[MAX_PLAYERS];
+    static uint8_t packed[SNAPSHOT_DELTA_MAX_SIZE];
+    static uint8_t coded[SNAPSHOT_DELTA_MAX_SIZE];
+
+    packedEncoder.Reset();
+    entropyEncoder.Reset();
+    packedDecoder.Reset();
+    entropyDecoder.Reset();
+    entropyEncoder.SetEntropyCoding(true);
+    entropyDecoder.SetEntropyCoding(true);
+
+    Lcg rng = { 1000u + playerCount };
+    Lcg lossRng = { 99u };
+    InitPlayers(players, playerCount, rng);
+
+    bool delivered[ACK_DELAY + 1] = {};
+    CodecStats packedStats, entropyStats;
+    uint32_t deliveredCount = 0, fullCount = 0;
+    bool ok = true, truncationOk = true;
+
+    for (uint32_t tick = 1; tick <= TICK_COUNT; tick++)
+    {
+        for (uint8_t i = 0; i < playerCount; i++) StepPlayer(players[i], rng);
+        FillSnapshot(serverSnap, players, playerCount, tick);
+
+        // Acks of delivered ticks reach the server ACK_DELAY ticks later
+        const bool outage = tick % OUTAGE_PERIOD >= OUTAGE_PERIOD - OUTAGE_TICKS;
+        if (tick > ACK_DELAY && delivered[(tick - ACK_DELAY) % (ACK_DELAY + 1)] && !outage)
+        {
+            packedEncoder.Acknowledge(tick - ACK_DELAY);
+            entropyEncoder.Acknowledge(tick - ACK_DELAY);
+        }
+
+        BenchTimer packedEncode;
+        const size_t packedSize = packedEncoder.Encode(serverSnap, packed, sizeof(packed));
+        packedStats.encodeSeconds += packedEncode.GetSeconds();
+
+        BenchTimer entropyEncode;
+        const size_t codedSize = entropyEncoder.Encode(serverSnap, coded, sizeof(coded));
+        entropyStats.encodeSeconds += entropyEncode.GetSeconds();
+        if (packedSize == 0 || codedSize == 0) return false;
+
+        packedStats.bytes += packedSize;
+        entropyStats.bytes += codedSize;
+        fullCount += (coded[0] & 1) ? 0 : 1;
+
+        const bool lost = lossRng.Next() < LOSS;
+        delivered[tick % (ACK_DELAY + 1)] = !lost;
+        if (lost) continue;
+        deliveredCount++;
+
+        // A truncated payload must be rejected without touching the state
+        if (tick % 97 == 0 && codedSize > 16)
+            truncationOk &= !entropyDecoder.Decode(coded, codedSize - 5, clientSnap);
+
+        CopySnapshot(expected, serverSnap);
+        NetCodec::QuantizeSnapshot(expected);
+
+        BenchTimer packedDecode;
+        bool decoded = packedDecoder.Decode(packed, packedSize, clientSnap);
+        packedStats.decodeSeconds += packedDecode.GetSeconds();
+        ok &= decoded && SameSnapshot(clientSnap, expected);
+
+        BenchTimer entropyDecode;
+        decoded = entropyDecoder.Decode(coded, codedSize, clientSnap);
+        entropyStats.decodeSeconds += entropyDecode.GetSeconds();
+        ok &= decoded && SameSnapshot(clientSnap, expected);
+    }
+
+    const double perPlayerTick = static_cast<double>(TICK_COUNT) * playerCount;
+    const double packedBpp = packedStats.bytes / perPlayerTick;
+    const double entropyBpp = entropyStats.bytes / perPlayerTick;
+    const double saved = 1.0 - entropyBpp / packedBpp;
+    const bool smaller = saved > 0.2;
+
+    std::printf("%3u players  bit-packed %5.2f B  entropy %5.2f B per player per tick (-%4.1f%%)  "
+                "%u full, %u/%u range coded  %s\n",
+                playerCount, packedBpp, entropyBpp, saved * 100.0, fullCount,
+                entropyEncoder.GetEntropyCodedCount(), TICK_COUNT,
+                (ok && truncationOk && smaller) ? "ok" : "FAILED");
+    std::printf("             encode %6.0f / %6.0f ns, decode %6.0f / %6.0f ns per snapshot (bit-packed / entropy)\n",
+                packedStats.encodeSeconds * 1e9 / TICK_COUNT, entropyStats.encodeSeconds * 1e9 / TICK_COUNT,
+                packedStats.decodeSeconds * 1e9 / deliveredCount, entropyStats.decodeSeconds * 1e9 / deliveredCount);
+    return ok && truncationOk && smaller;
+}
+
+} // namespace
+
+int Bench_Entropy()
+{
+    bool ok = TestCoder();
+
+    std::printf("Sessions    %u ticks at 32Hz, %.0f%% loss, acks %u ticks late, %u-tick ack outage every %u\n",
+                TICK_COUNT, LOSS * 100.0, ACK_DELAY, OUTAGE_TICKS, OUTAGE_PERIOD);
+    for (uint8_t count : PLAYER_COUNTS)
+        ok &= RunSession(count);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+//=============================================================================
+// bench_events.cpp
+//
+// EVENT_BATCH codec round trip and size, then MockServer end to end behind
+// a lossy NetSim link: a client kills a bot while a third of its snapshots
+// are dropped, and must still receive every hit, the kill, the respawn and
+// its reload completion exactly once, in tick order. Finally a client that
+// stops draining: the queue keeps the oldest events and counts the rest.
+//=============================================================================
+
+#include "net_bench.h"
+#include "mock_network.h"
+#include "mock_server.h"
+#include "net_event.h"
+#include "netsim_network.h"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+//-----------------------------------------------------------------------------
+// Codec: every type round-trips, a full batch fits, truncation is rejected
+//-----------------------------------------------------------------------------
+bool TestCodec()
+{
+    static NetEvent events[NET_EVENT_BATCH_MAX_EVENTS];
+    static NetEvent decoded[NET_EVENT_BATCH_MAX_EVENTS];
+    static uint8_t buffer[NET_EVENT_BATCH_MAX_SIZE];
+
+    const uint32_t tickId = 123456;
+    for (size_t i = 0; i < NET_EVENT_BATCH_MAX_EVENTS; i++)
+    {
+        NetEvent& e = events[i];
+        e = {};
+        e.tickId = tickId;
+        e.type = static_cast<NetEventType>(i % static_cast<size_t>(NetEventType::COUNT));
+        e.playerId = static_cast<uint8_t>(i % MAX_PLAYERS);
+        if (e.type == NetEventType::HIT || e.type == NetEventType::KILL)
+            e.targetId = static_cast<uint8_t>((i * 7 + 3) % MAX_PLAYERS);
+        if (e.type == NetEventType::HIT)
+            e.damage = static_cast<uint8_t>(i % 256);
+    }
+
+    // A full worst-case batch
+    const size_t fullSize = NetEvents::WriteBatch(tickId, events, NET_EVENT_BATCH_MAX_EVENTS, buffer, sizeof(buffer));
+    const size_t fullCount = NetEvents::ReadBatch(buffer, fullSize, decoded, NET_EVENT_BATCH_MAX_EVENTS);
+    bool roundTripOk = fullSize > 0 && fullCount == NET_EVENT_BATCH_MAX_EVENTS;
+    for (size_t i = 0; roundTripOk && i < fullCount; i++)
+    {
+        const NetEvent& a = events[i];
+        const NetEvent& b = decoded[i];
+        roundTripOk = a.tickId == b.tickId && a.type == b.type && a.playerId == b.playerId &&
+                      a.targetId == b.targetId && a.damage == b.damage;
+    }
+
+    // Typical tick: one kill (its last hit + the kill)
+    const size_t killSize = NetEvents::WriteBatch(tickId, events + 4, 2, buffer, sizeof(buffer));
+
+    // Truncated, over-long and unknown-type batches
+    const size_t eightSize = NetEvents::WriteBatch(tickId, events, 8, buffer, sizeof(buffer));
+    bool rejectOk = NetEvents::ReadBatch(buffer, eightSize - 1, decoded, NET_EVENT_BATCH_MAX_EVENTS) == 0 &&
+                    NetEvents::ReadBatch(buffer, eightSize, decoded, 4) == 0;
+    NetEvent bad = events[0];
+    bad.type = NetEventType::COUNT;
+    rejectOk &= NetEvents::WriteBatch(tickId, &bad, 1, buffer, sizeof(buffer)) == 0 &&
+                NetEvents::WriteBatch(tickId, events, 0, buffer, sizeof(buffer)) == 0;
+
+    std::printf("Codec       %zu events in %zu B (max %zu B)  %s\n", fullCount, fullSize,
+                NET_EVENT_BATCH_MAX_SIZE, roundTripOk ? "ok" : "FAILED");
+    std::printf("Size        hit + kill batch %zu B\n", killSize);
+    std::printf("Malformed   truncated / too many / bad type rejected  %s\n", rejectOk ? "ok" : "FAILED");
+    return roundTripOk && rejectOk && fullSize <= NET_EVENT_BATCH_MAX_SIZE;
+}
+
+//-----------------------------------------------------------------------------
+// MockServer behind a lossy link: shoot a bot dead, then wait for its respawn
+// and our reload
+//-----------------------------------------------------------------------------
+double g_VirtualNow = 0.0;
+double VirtualNow() { return g_VirtualNow; }
+
+constexpr uint32_t FIRE_TICKS = 40;         // ~1.25s of fire: kills a 200 HP bot, stops before its respawn
+constexpr uint32_t RUN_TICKS = 400;         // Reload (10s) completes at ~tick 320
+
+bool TestServer()
+{
+    static MockServer server;
+    static MockNetwork backend;
+    static NetSimNetwork client;
+
+    backend.SetSnapshotDeltaEnabled(true);
+    backend.Initialize();
+    server.Initialize(&backend);             // Client is player 0, bot is player 1
+
+    NetSimLinkSettings down;
+    down.latencyMs = 40.0f;
+    down.loss = 0.33f;
+    g_VirtualNow = 1000.0;
+    client.SetInner(&backend);
+    client.SetSeed(7);
+    client.SetTimeSource(VirtualNow);
+    client.SetDownstreamSettings(down);
+    client.Initialize();
+
+    uint32_t counts[static_cast<size_t>(NetEventType::COUNT)] = {};
+    uint32_t snapshots = 0, lastTick = 0, hitDamage = 0;
+    bool orderOk = true;
+
+    // Extra ticks at the end let in-flight events land
+    for (uint32_t tick = 1; tick <= RUN_TICKS + 8; tick++)
+    {
+        if (tick <= RUN_TICKS)
+        {
+            const NetPlayerState* me = server.GetPlayerState(0);
+            const NetPlayerState* bot = server.GetPlayerState(1);
+            const float dx = bot->position.x - me->position.x;
+            const float dy = (bot->position.y + 0.8f) - (me->position.y + 1.5f);
+            const float dz = bot->position.z - me->position.z;
+
+            InputCmd cmd = {};
+            cmd.tickId = tick;
+            cmd.yaw = std::atan2(dx, dz);
+            cmd.pitch = std::atan2(dy, std::sqrt(dx * dx + dz * dz));
+            if (tick <= FIRE_TICKS) cmd.buttons |= InputButtons::FIRE;
+            if (tick == 1) cmd.buttons |= InputButtons::RELOAD;
+            client.SendInputCmd(cmd);
+
+            server.Update(server.GetTickDuration());
+        }
+        g_VirtualNow += server.GetTickDuration();
+
+        SnapshotHandle handle;
+        while (client.AcquireSnapshot(handle)) snapshots++;
+
+        NetEvent event;
+        while (client.ReceiveEvent(event))
+        {
+            if (event.tickId < lastTick) orderOk = false;
+            lastTick = event.tickId;
+            counts[static_cast<size_t>(event.type)]++;
+            if (event.type == NetEventType::HIT) hitDamage += event.damage;
+        }
+    }
+
+    const uint32_t hits = counts[static_cast<size_t>(NetEventType::HIT)];
+    const uint32_t kills = counts[static_cast<size_t>(NetEventType::KILL)];
+    const uint32_t respawns = counts[static_cast<size_t>(NetEventType::RESPAWN)];
+    const uint32_t reloads = counts[static_cast<size_t>(NetEventType::RELOAD_COMPLETE)];
+
+    // 200 HP at 34 per hit: five hits, then a sixth for the last 30 kills
+    const bool ok = orderOk && hits == 6 && hitDamage == 200 && kills == 1 && respawns == 1 && reloads == 1 &&
+                    snapshots < RUN_TICKS * 3 / 4;
+    std::printf("Server      snapshots %u/%u delivered  events: hit %u (%u dmg)  kill %u  respawn %u  reload %u  %s\n",
+                snapshots, RUN_TICKS, hits, hitDamage, kills, respawns, reloads, ok ? "ok" : "FAILED");
+
+    client.Finalize();
+    server.Finalize();
+    backend.Finalize();
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// Queue full: events already queued survive, the newer ones are counted
+//-----------------------------------------------------------------------------
+bool TestQueueFull()
+{
+    static MockNetwork network;
+    network.Initialize();
+
+    constexpr uint32_t BATCHES = 40;
+    constexpr size_t PER_BATCH = 32;
+    NetEvent events[PER_BATCH] = {};
+    for (uint32_t tick = 1; tick <= BATCHES; tick++)
+    {
+        for (NetEvent& e : events)
+        {
+            e.tickId = tick;
+            e.type = NetEventType::RELOAD_COMPLETE;
+        }
+        network.SendEvents(tick, events, PER_BATCH);
+    }
+
+    uint32_t received = 0;
+    uint32_t firstTick = 0;
+    uint32_t lastTick = 0;
+    NetEvent e;
+    while (network.ReceiveEvent(e))
+    {
+        if (received++ == 0) firstTick = e.tickId;
+        lastTick = e.tickId;
+    }
+    const uint32_t sent = BATCHES * PER_BATCH;
+    const uint32_t dropped = network.GetEventDropCount();
+
+    const bool ok = received == MockNetwork::EVENT_CAPACITY && dropped == sent - received &&
+                    firstTick == 1 && lastTick == MockNetwork::EVENT_CAPACITY / PER_BATCH;
+    std::printf("Queue full  %u sent  %u received (ticks %u..%u)  %u dropped and counted  %s\n",
+                sent, received, firstTick, lastTick, dropped, ok ? "ok" : "FAILED");
+
+    network.Finalize();
+    return ok;
+}
+
+} // namespace
+
+int Bench_Events()
+{
+    bool ok = TestCodec();
+    ok &= TestServer();
+    ok &= TestQueueFull();
+    return ok ? 0 : 1;
+}
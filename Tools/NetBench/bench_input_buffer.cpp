@@ -0,0 +1,234 @@
+//=============================================================================
+// bench_input_buffer.cpp
+//
+// ServerInputBuffer playback under bursty, reordered, lossy and runaway input
+// streams, then MockServer end to end: the state after each acked input must be the
+// same whether the client's inputs arrive one per tick or in bursts, i.e.
+// no input is discarded and each is simulated as exactly one tick.
+//=============================================================================
+
+#include "net_bench.h"
+#include "mock_network.h"
+#include "mock_server.h"
+#include "server_input_buffer.h"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+constexpr uint32_t INPUT_COUNT = 320;           // 10 seconds
+
+InputCmd MakeInput(uint32_t tick)
+{
+    // Walk a wavy path so every input matters
+    InputCmd cmd = {};
+    cmd.tickId = tick;
+    cmd.moveAxisY = 1.0f;
+    cmd.moveAxisX = (tick % 16 < 8) ? 1.0f : -1.0f;
+    cmd.yaw = std::sin(tick * 0.05f) * 2.0f;
+    if (tick % 40 == 0) cmd.buttons |= InputButtons::RELOAD;
+    return cmd;
+}
+
+// Inputs delivered before server tick `tick` (burst = deliver every n ticks)
+uint32_t DeliveredBy(uint32_t tick, uint32_t burst)
+{
+    const uint32_t due = (tick / burst) * burst;
+    return due < INPUT_COUNT ? due : INPUT_COUNT;
+}
+
+//-----------------------------------------------------------------------------
+// Playback: bursts of n every n ticks are played one per tick with no repeat
+//-----------------------------------------------------------------------------
+bool TestBursts()
+{
+    bool ok = true;
+    for (uint32_t burst = 1; burst <= 4; burst++)
+    {
+        ServerInputBuffer buffer;
+        uint32_t sent = 0, expected = 1, repeats = 0, maxDepth = 0;
+
+        for (uint32_t tick = 1; expected <= INPUT_COUNT && tick < INPUT_COUNT * 2; tick++)
+        {
+            for (uint32_t due = DeliveredBy(tick, burst); sent < due;) buffer.Push(MakeInput(++sent));
+            if (buffer.GetDepth() > maxDepth) maxDepth = buffer.GetDepth();
+
+            InputCmd cmd;
+            if (!buffer.Pop(cmd)) continue;
+            if (cmd.tickId == expected) expected++;
+            else repeats++;
+        }
+
+        const bool burstOk = expected == INPUT_COUNT + 1 && repeats == 0 && buffer.GetLostCount() == 0 &&
+                             buffer.GetUnderflowCount() == 0 && maxDepth == burst;
+        std::printf("Burst %u     played %u/%u in order  repeats %u  max depth %u  %s\n",
+                    burst, expected - 1, INPUT_COUNT, repeats, maxDepth, burstOk ? "ok" : "FAILED");
+        ok &= burstOk;
+    }
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// Ticks 1..tickCount, one per server tick, except tick 10, which arrives at
+// server tick arrival (0 = never). Plays like MockServer (an extra input while
+// overfull) and checks that new ticks come out in order with only the lost
+// one missing; outLast is the newest played.
+//-----------------------------------------------------------------------------
+bool PlayServerTicks(ServerInputBuffer& buffer, uint32_t tickCount, uint32_t arrival, uint32_t& outLast)
+{
+    constexpr uint32_t LATE_TICK = 10;
+    bool ok = true;
+    outLast = 0;
+    for (uint32_t tick = 1; outLast < tickCount && tick <= tickCount * 2; tick++)
+    {
+        if (tick <= tickCount && tick != LATE_TICK) buffer.Push(MakeInput(tick));
+        if (tick == arrival) buffer.Push(MakeInput(LATE_TICK));
+
+        const int steps = buffer.IsOverfull() ? 2 : 1;
+        for (int step = 0; step < steps; step++)
+        {
+            InputCmd cmd;
+            if (!buffer.Pop(cmd) || cmd.tickId == outLast) continue;
+            const uint32_t expected = (outLast + 1 == LATE_TICK && arrival == 0) ? LATE_TICK + 1 : outLast + 1;
+            ok &= cmd.tickId == expected;
+            outLast = cmd.tickId;
+        }
+    }
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// Reorder / loss / underflow / overflow
+//-----------------------------------------------------------------------------
+bool TestEdgeCases()
+{
+    // Tick 10 overtaken by 11 and 12 (unsequenced): 9 repeats until it
+    // arrives, then everything plays in order and nothing is lost
+    ServerInputBuffer reordered;
+    uint32_t reorderedLast = 0;
+    bool reorderOk = PlayServerTicks(reordered, 20, 12, reorderedLast);
+    reorderOk &= reorderedLast == 20 && reordered.GetLostCount() == 0 && reordered.GetDroppedCount() == 0 &&
+                 reordered.GetUnderflowCount() == 2;
+
+    // Tick 10 never arrives: skipped once MAX_DEPTH inputs wait behind it
+    ServerInputBuffer lossy;
+    uint32_t lossyLast = 0;
+    bool lossOk = PlayServerTicks(lossy, 20, 0, lossyLast);
+    lossOk &= lossyLast == 20 && lossy.GetLostCount() == 1 && lossy.GetDroppedCount() == 0 &&
+              lossy.GetUnderflowCount() == ServerInputBuffer::MAX_DEPTH;
+
+    // Underflow: nothing new -> repeat of the last, RELOAD stripped, no gap
+    InputCmd cmd;
+    ServerInputBuffer starved;
+    starved.Push(MakeInput(40));
+    bool underflowOk = starved.Pop(cmd) && (cmd.buttons & InputButtons::RELOAD);
+    underflowOk &= starved.Pop(cmd) && cmd.tickId == 40 && !(cmd.buttons & InputButtons::RELOAD);
+    starved.Push(MakeInput(41));
+    underflowOk &= starved.Pop(cmd) && cmd.tickId == 41 && starved.GetUnderflowCount() == 1;
+    underflowOk &= !starved.Push(MakeInput(41)) && !starved.Push(MakeInput(39));
+
+    // Overflow: 12 queued, two per tick while over MAX_DEPTH
+    ServerInputBuffer flooded;
+    for (uint32_t tick = 1; tick <= 12; tick++) flooded.Push(MakeInput(tick));
+    uint32_t serverTicks = 0;
+    while (flooded.IsOverfull())
+    {
+        flooded.Pop(cmd);
+        flooded.Pop(cmd);
+        serverTicks++;
+    }
+    const uint32_t settledDepth = flooded.GetDepth();
+    const bool overflowOk = settledDepth == ServerInputBuffer::MAX_DEPTH && serverTicks == 4 &&
+                            flooded.GetDroppedCount() == 0;
+
+    // Client a whole buffer ahead: resume from its newest input
+    const uint32_t aheadTick = 12 + ServerInputBuffer::CAPACITY;
+    flooded.Push(MakeInput(aheadTick));
+    const bool jumpOk = flooded.Pop(cmd) && cmd.tickId == aheadTick && flooded.GetDroppedCount() == ServerInputBuffer::MAX_DEPTH;
+
+    std::printf("Reorder     tick 10 two late, lost %u  repeats %u  %s\n", reordered.GetLostCount(),
+                reordered.GetUnderflowCount(), reorderOk ? "ok" : "FAILED");
+    std::printf("Loss        lost %u  repeats %u  %s\n", lossy.GetLostCount(), lossy.GetUnderflowCount(),
+                lossOk ? "ok" : "FAILED");
+    std::printf("Underflow   repeats %u  %s\n", starved.GetUnderflowCount(), underflowOk ? "ok" : "FAILED");
+    std::printf("Overflow    12 queued, depth %u after %u ticks  %s\n", settledDepth, serverTicks,
+                overflowOk ? "ok" : "FAILED");
+    std::printf("Resync      jumped to tick %u  %s\n", aheadTick, jumpOk ? "ok" : "FAILED");
+    return reorderOk && lossOk && underflowOk && overflowOk && jumpOk;
+}
+
+//-----------------------------------------------------------------------------
+// MockServer: state after each acked input, steady vs. bursty delivery
+//-----------------------------------------------------------------------------
+DirectX::XMFLOAT3 g_StateAfter[INPUT_COUNT + 1];
+
+bool RunServer(uint32_t burst, bool compare, float& outMaxError)
+{
+    static MockServer server;
+    static MockNetwork client;
+    client.SetSnapshotDeltaEnabled(true);
+    client.SetInputRedundancy(3);
+    client.Initialize();
+    server.Initialize(nullptr);
+    server.AddClient(&client);
+
+    uint32_t sent = 0, lastAck = 0;
+    bool ok = true;
+    outMaxError = 0.0f;
+    for (uint32_t tick = 1; lastAck < INPUT_COUNT && tick < INPUT_COUNT * 2; tick++)
+    {
+        for (uint32_t due = DeliveredBy(tick, burst); sent < due;) client.SendInputCmd(MakeInput(++sent));
+        server.Update(server.GetTickDuration());
+
+        SnapshotHandle handle;
+        while (client.AcquireSnapshot(handle))
+        {
+            const uint32_t ack = handle->ackInputTick;
+            if (ack == lastAck) continue;
+            if (ack != lastAck + 1) ok = false;         // Skipped an input
+            lastAck = ack;
+
+            const DirectX::XMFLOAT3& p = handle->localPlayer.position;
+            if (!compare)
+            {
+                g_StateAfter[ack] = p;
+                continue;
+            }
+            const float dx = p.x - g_StateAfter[ack].x;
+            const float dy = p.y - g_StateAfter[ack].y;
+            const float dz = p.z - g_StateAfter[ack].z;
+            const float error = std::sqrt(dx * dx + dy * dy + dz * dz);
+            if (error > outMaxError) outMaxError = error;
+        }
+    }
+
+    server.Finalize();
+    client.Finalize();
+    return ok && lastAck == INPUT_COUNT;
+}
+
+bool TestServer()
+{
+    float error = 0.0f;
+    bool ok = RunServer(1, false, error);
+    std::printf("Server      steady   acked %u/%u in order  %s\n", INPUT_COUNT, INPUT_COUNT, ok ? "ok" : "FAILED");
+
+    for (uint32_t burst = 2; burst <= 4; burst++)
+    {
+        bool burstOk = RunServer(burst, true, error) && error == 0.0f;
+        std::printf("Server      burst %u  state after each input vs. steady: max error %.4fm  %s\n",
+                    burst, error, burstOk ? "ok" : "FAILED");
+        ok &= burstOk;
+    }
+    return ok;
+}
+
+} // namespace
+
+int Bench_InputBuffer()
+{
+    bool ok = TestBursts();
+    ok &= TestEdgeCases();
+    ok &= TestServer();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+//=============================================================================
+// bench_jitter_buffer.cpp
+//
+// JitterBuffer on ClockSync's timeline over a clean and a bad simulated link
+// (32Hz server, 144fps client). For each link, compares the adaptive delay
+// with the fixed 100ms it replaces: mean render delay and the fraction of
+// frames that ran past the newest snapshot (extrapolate/snap). Also checks
+// that the delay only ever changes by time dilation.
+//=============================================================================
+
+#include "net_bench.h"
+#include "clock_sync.h"
+#include "jitter_buffer.h"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+constexpr double TICK = 1.0 / 32.0;
+constexpr double FRAME = 1.0 / 144.0;
+constexpr double DURATION = 60.0;
+constexpr double WARMUP = 10.0;
+constexpr double FIXED_DELAY = 0.100;
+constexpr double LATE_TARGET = 0.01;
+
+struct Link
+{
+    const char* name;
+    double baseDelay;
+    double jitter;      // Uniform extra delay
+    double loss;
+    double spike;       // Chance of +spikeDelay
+    double spikeDelay;
+};
+
+struct RunResult
+{
+    double meanDelay;
+    double starved;         // Fraction of frames
+    double fixedStarved;
+    double maxStep;         // Largest delay change in one frame
+    double lossRate;
+};
+
+Lcg g_Random = { 777u };
+
+struct InFlight
+{
+    double arrival;
+    double serverTime;
+    uint32_t tickId;
+};
+
+RunResult Run(const Link& link)
+{
+    static ClockSync sync;
+    static JitterBuffer buffer;
+    static InFlight inFlight[128];
+    size_t inFlightCount = 0;
+
+    sync.Reset();
+    buffer.SetLateTarget(LATE_TARGET);
+    buffer.Reset();
+
+    RunResult result = {};
+    double nextSend = 0.0;
+    uint32_t nextTick = 1;
+    double newestArrived = -1.0;
+    double delaySum = 0.0;
+    double prevDelay = buffer.GetDelay();
+    uint32_t frames = 0, starved = 0, fixedStarved = 0;
+
+    for (double now = 0.0; now < DURATION; now += FRAME)
+    {
+        while (nextSend <= now)
+        {
+            double delay = link.baseDelay + g_Random.Next() * link.jitter;
+            if (g_Random.Next() < link.spike) delay += link.spikeDelay;
+            bool lost = g_Random.Next() < link.loss;
+            if (!lost && inFlightCount < 128) inFlight[inFlightCount++] = { nextSend + delay, nextSend, nextTick };
+            nextSend += TICK;
+            nextTick++;
+        }
+
+        // Deliver in arrival order
+        for (;;)
+        {
+            size_t first = inFlightCount;
+            for (size_t i = 0; i < inFlightCount; i++)
+            {
+                if (inFlight[i].arrival <= now && (first == inFlightCount || inFlight[i].arrival < inFlight[first].arrival))
+                    first = i;
+            }
+            if (first == inFlightCount) break;
+
+            const InFlight packet = inFlight[first];
+            inFlight[first] = inFlight[--inFlightCount];
+
+            sync.AddSample(packet.serverTime, packet.arrival, 2.0 * link.baseDelay);
+            buffer.AddSample(packet.tickId, packet.serverTime, sync.GetArrivalTimeline(packet.arrival));
+            if (packet.serverTime > newestArrived) newestArrived = packet.serverTime;
+        }
+        if (!sync.IsSynced()) continue;
+
+        buffer.Update(FRAME);
+        const double timeline = sync.GetArrivalTimeline(now);
+
+        if (now > WARMUP)
+        {
+            double step = std::fabs(buffer.GetDelay() - prevDelay);
+            if (step > result.maxStep) result.maxStep = step;
+
+            delaySum += buffer.GetDelay();
+            starved += (timeline - buffer.GetDelay() >= newestArrived);
+            fixedStarved += (timeline - FIXED_DELAY >= newestArrived);
+            frames++;
+        }
+        prevDelay = buffer.GetDelay();
+    }
+
+    result.meanDelay = delaySum / frames;
+    result.starved = static_cast<double>(starved) / frames;
+    result.fixedStarved = static_cast<double>(fixedStarved) / frames;
+    result.lossRate = buffer.GetLossRate();
+    return result;
+}
+
+} // namespace
+
+int Bench_JitterBuffer()
+{
+    const Link links[] = {
+        { "clean", 0.020, 0.004, 0.0, 0.0, 0.0 },
+        { "bad", 0.060, 0.080, 0.03, 0.03, 0.100 },
+    };
+    bool ok = true;
+
+    for (const Link& link : links)
+    {
+        RunResult r = Run(link);
+        std::printf("%-6s delay %.1f ms (fixed %.0f)  late frames %.2f%% (fixed %.2f%%)  loss %.1f%%  max step %.3f ms/frame\n",
+                    link.name, r.meanDelay * 1000.0, FIXED_DELAY * 1000.0,
+                    r.starved * 100.0, r.fixedStarved * 100.0, r.lossRate * 100.0, r.maxStep * 1000.0);
+
+        // Late frames stay near the target; the delay never jumps
+        ok &= r.starved <= 2.0 * LATE_TARGET;
+        ok &= r.maxStep <= JitterBuffer::GROW_RATE * FRAME + 1e-9;
+        if (&link == &links[0])
+            ok &= r.meanDelay + 0.030 <= FIXED_DELAY;    // Tens of ms saved
+        else
+            ok &= r.starved < r.fixedStarved;            // Smoother than fixed
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+//=============================================================================
+// bench_lag_comp.cpp
+//
+// LagCompHistory rewind cost and accuracy with 128 moving players, then
+// MockServer end to end: a shooter aiming at where it saw a strafing target
+// (its view ~156ms behind the server) must hit with lag compensation and
+// miss without it.
+//=============================================================================
+
+#include "net_bench.h"
+#include "lag_compensation.h"
+#include "mock_network.h"
+#include "mock_server.h"
+#include "net_codec.h"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+constexpr double TICK = 1.0 / 32.0;
+
+volatile float g_Sink;     // Keeps the timed rewinds from being optimized out
+
+// Every player moves on its own straight line, so a lerp is exact
+DirectX::XMFLOAT3 PlayerAt(uint32_t id, double time)
+{
+    const float t = static_cast<float>(time);
+    return { -50.0f + id * 0.7f + t * (1.0f + id % 7), 0.5f * (id % 3), 20.0f - t * (id % 5) };
+}
+
+//-----------------------------------------------------------------------------
+// History: accuracy, clamping and rewind cost
+//-----------------------------------------------------------------------------
+bool TestHistory()
+{
+    static LagCompHistory history;
+    static LagCompFrame frame;
+    history.Reset();
+
+    // More ticks than the history holds, player 3 dead from tick 50 on
+    constexpr uint32_t TICKS = LagCompHistory::CAPACITY + 32;
+    for (uint32_t tick = 1; tick <= TICKS; tick++)
+    {
+        history.BeginFrame(tick, tick * TICK);
+        for (uint32_t id = 0; id < MAX_PLAYERS; id++)
+        {
+            if (id == 3 && tick >= 50) continue;
+            history.Record(static_cast<uint8_t>(id), PlayerAt(id, tick * TICK));
+        }
+    }
+    const double now = TICKS * TICK;
+
+    // Between ticks, within the window: every player where it really was
+    float maxError = 0.0f;
+    const double probe = now - 0.2 - TICK * 0.37;
+    const double used = history.Rewind(probe, 0.5, frame);
+    for (uint32_t id = 0; id < MAX_PLAYERS; id++)
+    {
+        if (!frame.IsAlive(static_cast<uint8_t>(id))) continue;
+        const DirectX::XMFLOAT3 expected = PlayerAt(id, probe);
+        maxError = std::fmax(maxError, std::fabs(frame.x[id] - expected.x));
+        maxError = std::fmax(maxError, std::fabs(frame.y[id] - expected.y));
+        maxError = std::fmax(maxError, std::fabs(frame.z[id] - expected.z));
+    }
+    const bool accurateOk = used == probe && maxError < 1e-4f && frame.IsAlive(2) && !frame.IsAlive(3);
+
+    // Clamped to maxRewind, then to the history held; never into the future
+    const bool clampOk = history.Rewind(now - 0.8, 0.5, frame) == now - 0.5 &&
+                         history.Rewind(0.0, 10.0, frame) == now - (LagCompHistory::CAPACITY - 1) * TICK &&
+                         history.Rewind(now + 1.0, 0.5, frame) == now &&
+                         history.Rewind(now - 0.3, 0.0, frame) == now;
+
+    // Cost: rewind all 128 players to a different time each query
+    constexpr uint32_t QUERIES = 200000;
+    BenchTimer timer;
+    for (uint32_t q = 0; q < QUERIES; q++)
+    {
+        history.Rewind(now - (q % 1000) * 0.0004, 0.5, frame);
+        g_Sink = frame.x[q % MAX_PLAYERS];
+    }
+    const double ns = timer.GetSeconds() * 1e9 / QUERIES;
+
+    std::printf("History     %u ticks x %u players, %zu B per tick\n", TICKS, MAX_PLAYERS, sizeof(LagCompFrame));
+    std::printf("Rewind      max error %.2e m  dead excluded  %s\n", maxError, accurateOk ? "ok" : "FAILED");
+    std::printf("Clamp       max rewind / history / future  %s\n", clampOk ? "ok" : "FAILED");
+    std::printf("Cost        %.1f ns per rewind of %u players (%.2f ns per player)\n",
+                ns, MAX_PLAYERS, ns / MAX_PLAYERS);
+    return accurateOk && clampOk;
+}
+
+//-----------------------------------------------------------------------------
+// MockServer: shoot where the target was seen VIEW_TICKS ago
+//-----------------------------------------------------------------------------
+constexpr uint32_t VIEW_TICKS = 5;              // ~156ms interpolation + latency
+constexpr uint32_t FIRE_START = 40;
+constexpr uint32_t FIRE_END = 56;               // 0.5s of fire, ~5 shots
+constexpr uint32_t RUN_TICKS = 64;
+
+uint8_t RunDuel(double maxRewind)
+{
+    static MockServer server;
+    static MockNetwork targetNet, shooterNet;
+    static DirectX::XMFLOAT3 seen[RUN_TICKS + 1];
+
+    targetNet.Initialize();
+    shooterNet.Initialize();
+    server.Initialize(nullptr);
+    server.SetMaxRewind(maxRewind);
+    const uint8_t targetId = static_cast<uint8_t>(server.AddClient(&targetNet));    // RED
+    const uint8_t shooterId = static_cast<uint8_t>(server.AddClient(&shooterNet));  // BLUE
+
+    for (uint32_t tick = 1; tick <= RUN_TICKS; tick++)
+    {
+        // Target sprints sideways along +x the whole time
+        InputCmd move = {};
+        move.tickId = tick;
+        move.moveAxisX = 1.0f;
+        move.buttons = InputButtons::SPRINT;
+        targetNet.SendInputCmd(move);
+
+        // Shooter stands still and aims at the target as it saw it
+        InputCmd aim = {};
+        aim.tickId = tick;
+        if (tick >= FIRE_START && tick < FIRE_END)
+        {
+            const uint32_t viewTick = tick - VIEW_TICKS;
+            const DirectX::XMFLOAT3& eye = server.GetPlayerState(shooterId)->position;
+            const float dx = seen[viewTick].x - eye.x;
+            const float dy = (seen[viewTick].y + 0.8f) - (eye.y + 1.5f);
+            const float dz = seen[viewTick].z - eye.z;
+            aim.yaw = std::atan2(dx, dz);
+            aim.pitch = std::atan2(dy, std::sqrt(dx * dx + dz * dz));
+            aim.buttons = InputButtons::FIRE;
+            aim.viewTimeMs = static_cast<uint32_t>(viewTick * TICK * 1000.0 + 0.5);
+        }
+        shooterNet.SendInputCmd(NetCodec::RoundTrip(aim));
+
+        server.Update(server.GetTickDuration());
+        seen[tick] = server.GetPlayerState(targetId)->position;
+
+        SnapshotHandle handle;
+        while (targetNet.AcquireSnapshot(handle)) {}
+        while (shooterNet.AcquireSnapshot(handle)) {}
+    }
+
+    const uint8_t health = server.GetPlayerState(targetId)->health;
+    server.Finalize();
+    targetNet.Finalize();
+    shooterNet.Finalize();
+    return health;
+}
+
+bool TestDuel()
+{
+    const uint8_t compensated = RunDuel(0.5);
+    const uint8_t uncompensated = RunDuel(0.0);
+    const uint8_t tooFar = RunDuel(0.1);            // View is older than the limit
+
+    const bool ok = compensated <= 200 - 4 * 34 && uncompensated == 200 && tooFar == 200;
+    std::printf("Duel        target health after ~5 shots: rewind 500ms %u, off %u, 100ms limit %u  %s\n",
+                compensated, uncompensated, tooFar, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+} // namespace
+
+int Bench_LagComp()
+{
+    bool ok = TestHistory();
+    ok &= TestDuel();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+//=============================================================================
+// bench_mock_server.cpp
+//
+// Many in-process clients on one MockServer, each on its own MockNetwork
+// with delta snapshots. Every client walks in its own direction. Checks that
+// each client gets a snapshot per tick naming it as the local player with
+// every other player (and the bot) as remote entries and acking the input
+// sent that tick, that inputs only move their own player, and reports the server tick cost as the session grows.
+//=============================================================================
+
+#include "net_bench.h"
+#include "mock_network.h"
+#include "mock_server.h"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+constexpr uint32_t TICK_COUNT = 320;             // 10 seconds
+constexpr uint32_t MAX_CLIENTS = MAX_PLAYERS - 1;
+const uint32_t CLIENT_COUNTS[] = { 1, 8, 32, 127 };
+
+MockNetwork g_Clients[MAX_CLIENTS];
+
+struct ClientResult
+{
+    int playerId;
+    uint32_t snapshots;
+    uint32_t wrongLocal;        // localPlayerId was not this client
+    uint32_t wrongCount;        // remote entries != every other player
+    uint32_t wrongAck;          // ackInputTick was not this tick's input
+    DirectX::XMFLOAT3 start;
+    DirectX::XMFLOAT3 end;
+};
+
+ClientResult g_Results[MAX_CLIENTS];
+
+float ClientYaw(uint32_t client)
+{
+    return static_cast<float>(client) * 2.399963f;     // Golden angle
+}
+
+bool Run(uint32_t clientCount, double& outTickMs)
+{
+    static MockServer server;
+    server.Initialize(nullptr);
+    server.SetInterestManagementEnabled(false);
+
+    for (uint32_t c = 0; c < clientCount; c++)
+    {
+        g_Clients[c].SetSnapshotDeltaEnabled(true);
+        g_Clients[c].SetInputRedundancy(3);
+        g_Clients[c].Initialize();
+        g_Results[c] = {};
+        g_Results[c].playerId = server.AddClient(&g_Clients[c]);
+        g_Results[c].start = server.GetPlayerState(static_cast<uint8_t>(g_Results[c].playerId))->position;
+    }
+    const int botId = server.AddBot();
+    const DirectX::XMFLOAT3 botStart = server.GetPlayerState(static_cast<uint8_t>(botId))->position;
+    const uint32_t playerCount = clientCount + 1;
+
+    double serverSeconds = 0.0;
+    for (uint32_t tick = 1; tick <= TICK_COUNT; tick++)
+    {
+        for (uint32_t c = 0; c < clientCount; c++)
+        {
+            InputCmd cmd = {};
+            cmd.tickId = tick;
+            cmd.moveAxisY = 1.0f;
+            cmd.yaw = ClientYaw(c);
+            g_Clients[c].SendInputCmd(cmd);
+        }
+
+        // Server tick includes encoding each client's snapshot (and the mock
+        // wire's decode into its pool)
+        BenchTimer timer;
+        server.Update(server.GetTickDuration());
+        serverSeconds += timer.GetSeconds();
+
+        for (uint32_t c = 0; c < clientCount; c++)
+        {
+            ClientResult& result = g_Results[c];
+            SnapshotHandle handle;
+            while (g_Clients[c].AcquireSnapshot(handle))
+            {
+                result.snapshots++;
+                if (handle->localPlayerId != result.playerId) result.wrongLocal++;
+                if (handle->remotePlayerCount != playerCount - 1) result.wrongCount++;
+                if (handle->ackInputTick != tick) result.wrongAck++;
+                result.end = handle->localPlayer.position;
+            }
+        }
+    }
+    outTickMs = serverSeconds * 1000.0 / TICK_COUNT;
+
+    // Each player walked ~50m along its own yaw; the bot never moved
+    bool ok = true;
+    for (uint32_t c = 0; c < clientCount; c++)
+    {
+        const ClientResult& result = g_Results[c];
+        const float dx = result.end.x - result.start.x;
+        const float dz = result.end.z - result.start.z;
+        const float along = dx * std::sin(ClientYaw(c)) + dz * std::cos(ClientYaw(c));
+        const float distance = std::sqrt(dx * dx + dz * dz);
+        if (result.playerId < 0 || result.snapshots != TICK_COUNT || result.wrongLocal || result.wrongCount || result.wrongAck ||
+            distance < 40.0f || along < distance * 0.999f)
+        {
+            ok = false;
+        }
+        g_Clients[c].Finalize();
+    }
+
+    const DirectX::XMFLOAT3 botEnd = server.GetPlayerState(static_cast<uint8_t>(botId))->position;
+    if (botEnd.x != botStart.x || botEnd.z != botStart.z) ok = false;
+
+    server.Finalize();
+    return ok;
+}
+
+} // namespace
+
+int Bench_MockServer()
+{
+    bool allOk = true;
+    for (uint32_t clientCount : CLIENT_COUNTS)
+    {
+        double tickMs = 0.0;
+        bool ok = Run(clientCount, tickMs);
+        std::printf("Clients %3u  tick %7.3f ms  (%.1f us per client)  %s\n",
+                    clientCount, tickMs, tickMs * 1000.0 / clientCount, ok ? "ok" : "FAILED");
+        allOk &= ok;
+    }
+    return allOk ? 0 : 1;
+}
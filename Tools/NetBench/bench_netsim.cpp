@@ -0,0 +1,221 @@
+//=============================================================================
+// bench_netsim.cpp
+//
+// NetSimNetwork around MockNetwork on a virtual clock: 32Hz server, 128fps
+// client. Checks that observed one-way delay, loss, duplication and
+// reordering match the settings, that the bandwidth cap holds, and that the
+// same seed replays the exact same arrival sequence.
+//=============================================================================
+
+#include "net_bench.h"
+#include "mock_network.h"
+#include "netsim_network.h"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+constexpr uint32_t TICK_COUNT = 3200;            // 100 seconds
+constexpr uint32_t FRAMES_PER_TICK = 4;
+constexpr double FRAME_TIME = 1.0 / (32.0 * FRAMES_PER_TICK);
+
+double g_VirtualNow = 0.0;
+double VirtualNow() { return g_VirtualNow; }
+
+struct RunResult
+{
+    uint32_t snapshotsSent;
+    uint32_t snapshotsReceived;    // Including duplicates
+    uint32_t uniqueSnapshots;
+    uint32_t outOfOrder;           // Arrived after a newer tick
+    double meanDelayMs;
+    double minDelayMs;
+    double maxDelayMs;
+    uint32_t inputsSent;
+    uint32_t inputsReceived;
+    uint32_t wireBytes;            // Delivered snapshot bytes incl. UDP/IP headers
+    uint32_t maxSnapshotBytes;     // Largest encoded snapshot sent
+    uint64_t arrivalHash;          // FNV-1a over (tickId, arrival time)
+    NetSimStats down;
+};
+
+void HashValue(uint64_t& hash, uint64_t value)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= 0x100000001B3ull;
+    }
+}
+
+RunResult Run(uint64_t seed, const NetSimLinkSettings& up, const NetSimLinkSettings& down)
+{
+    static MockNetwork backend;
+    static NetSimNetwork netsim;
+    static bool seen[TICK_COUNT + 1];
+
+    backend.SetSnapshotDeltaEnabled(true);
+    backend.SetInputRedundancy(1);
+    backend.Initialize();
+
+    g_VirtualNow = 1000.0;
+    netsim.SetInner(&backend);
+    netsim.SetSeed(seed);
+    netsim.SetTimeSource(VirtualNow);
+    netsim.SetUpstreamSettings(up);
+    netsim.SetDownstreamSettings(down);
+    netsim.Initialize();
+
+    RunResult result = {};
+    result.arrivalHash = 0xCBF29CE484222325ull;
+    result.minDelayMs = 1e9;
+    for (bool& s : seen) s = false;
+
+    double delaySum = 0.0;
+    uint32_t newestTick = 0;
+    uint32_t lastInputTick = 0;
+    Snapshot serverSnap = {};
+
+    // Extra ticks at the end let in-flight packets land
+    for (uint32_t tick = 1; tick <= TICK_COUNT + 64; tick++)
+    {
+        for (uint32_t f = 0; f < FRAMES_PER_TICK; f++)
+        {
+            g_VirtualNow += FRAME_TIME;
+
+            if (tick <= TICK_COUNT)
+            {
+                InputCmd cmd = {};
+                cmd.tickId = tick * FRAMES_PER_TICK + f;
+                netsim.SendInputCmd(cmd);
+                result.inputsSent++;
+            }
+
+            SnapshotHandle handle;
+            while (netsim.AcquireSnapshot(handle))
+            {
+                const Snapshot& snap = *handle;
+                double delayMs = (handle.GetArrivalTime() - snap.serverTime) * 1000.0;
+                delaySum += delayMs;
+                if (delayMs < result.minDelayMs) result.minDelayMs = delayMs;
+                if (delayMs > result.maxDelayMs) result.maxDelayMs = delayMs;
+
+                result.snapshotsReceived++;
+                if (snap.tickId <= TICK_COUNT && !seen[snap.tickId])
+                {
+                    seen[snap.tickId] = true;
+                    result.uniqueSnapshots++;
+                }
+                if (snap.tickId < newestTick) result.outOfOrder++;
+                else newestTick = snap.tickId;
+
+                HashValue(result.arrivalHash, snap.tickId);
+                HashValue(result.arrivalHash, static_cast<uint64_t>(handle.GetArrivalTime() * 1e6));
+            }
+        }
+
+        // Server tick: drain inputs, send a snapshot stamped with the send time
+        InputCmd received;
+        while (backend.ReceiveInputCmd(received))
+        {
+            if (received.tickId != lastInputTick) result.inputsReceived++;
+            lastInputTick = received.tickId;
+        }
+
+        if (tick <= TICK_COUNT)
+        {
+            serverSnap.tickId = tick;
+            serverSnap.serverTime = g_VirtualNow;
+            serverSnap.localPlayer.tickId = tick;
+            backend.SendSnapshot(serverSnap);
+            result.snapshotsSent++;
+            if (backend.GetLastSnapshotBytes() > result.maxSnapshotBytes)
+                result.maxSnapshotBytes = backend.GetLastSnapshotBytes();
+        }
+    }
+
+    result.meanDelayMs = result.snapshotsReceived ? delaySum / result.snapshotsReceived : 0.0;
+    result.down = netsim.GetDownstreamStats();
+    result.wireBytes = result.down.delivered * (backend.GetLastSnapshotBytes() + 28);
+
+    netsim.Finalize();
+    backend.Finalize();
+    return result;
+}
+
+bool Near(double value, double expected, double tolerance)
+{
+    return std::fabs(value - expected) <= tolerance;
+}
+
+} // namespace
+
+int Bench_NetSim()
+{
+    bool ok = true;
+
+    NetSimLinkSettings up;
+    up.latencyMs = 30.0f;
+    up.jitterMs = 5.0f;
+    up.loss = 0.05f;
+
+    NetSimLinkSettings down;
+    down.latencyMs = 50.0f;
+    down.jitterMs = 10.0f;
+    down.loss = 0.05f;
+    down.duplicate = 0.02f;
+    down.reorder = 0.05f;
+    down.reorderMs = 40.0f;
+
+    // Conditions match the settings
+    RunResult a = Run(42, up, down);
+    double lossRate = 1.0 - static_cast<double>(a.uniqueSnapshots) / a.snapshotsSent;
+    double dupRate = static_cast<double>(a.snapshotsReceived - a.uniqueSnapshots) / a.snapshotsSent;
+    double upLossRate = 1.0 - static_cast<double>(a.inputsReceived) / a.inputsSent;
+
+    // Delay is measured from the server's send, so it includes up to one
+    // client frame before the decorator picks the snapshot up; duplicates
+    // trail by up to one jitter, and keeping order only ever adds delay
+    const double frameMs = FRAME_TIME * 1000.0;
+    const double maxDelayMs = down.latencyMs + 2.0 * down.jitterMs + down.reorderMs + frameMs;
+    const double baseMeanMs = down.latencyMs + down.reorder * down.reorderMs;
+    bool conditionsOk =
+        Near(lossRate, down.loss, 0.015) &&
+        Near(dupRate, down.duplicate, 0.01) &&
+        Near(upLossRate, up.loss, 0.01) &&
+        a.outOfOrder > 0 &&
+        a.minDelayMs >= down.latencyMs - down.jitterMs - 0.01 &&
+        a.maxDelayMs <= maxDelayMs + 0.01 &&
+        a.meanDelayMs >= baseMeanMs && a.meanDelayMs <= baseMeanMs + frameMs + down.jitterMs;
+    std::printf("Conditions  down loss %.1f%%  dup %.1f%%  out-of-order %u  delay %.1f/%.1f/%.1f ms  up loss %.1f%%  %s\n",
+                lossRate * 100.0, dupRate * 100.0, a.outOfOrder,
+                a.minDelayMs, a.meanDelayMs, a.maxDelayMs, upLossRate * 100.0,
+                conditionsOk ? "ok" : "FAILED");
+    ok &= conditionsOk;
+
+    // Same seed replays exactly, another seed does not
+    RunResult b = Run(42, up, down);
+    RunResult c = Run(43, up, down);
+    bool replayOk = a.arrivalHash == b.arrivalHash && a.arrivalHash != c.arrivalHash;
+    std::printf("Replay      seed 42 x2 %s, seed 43 %s  %s\n",
+                a.arrivalHash == b.arrivalHash ? "identical" : "DIFFERENT",
+                a.arrivalHash != c.arrivalHash ? "differs" : "IDENTICAL",
+                replayOk ? "ok" : "FAILED");
+    ok &= replayOk;
+
+    // Bandwidth cap: delivered rate stays under the cap, excess overflows
+    NetSimLinkSettings capped;
+    capped.bandwidthKbps = 8.0f;
+    RunResult d = Run(42, NetSimLinkSettings{}, capped);
+    double seconds = TICK_COUNT / 32.0;
+    double kbps = d.wireBytes * 8.0 / seconds / 1000.0;
+    // A packet accepted at the backlog limit still has to go out on the wire
+    double packetMs = (d.maxSnapshotBytes + 28) * 8.0 / capped.bandwidthKbps;
+    bool capOk = kbps <= capped.bandwidthKbps * 1.02 && d.down.overflowed > 0 &&
+                 d.maxDelayMs <= NetSimLink::MAX_BACKLOG * 1000.0 + packetMs;
+    std::printf("Bandwidth   cap %.0f kbps  delivered %.2f kbps  overflowed %u  max delay %.0f ms  %s\n",
+                capped.bandwidthKbps, kbps, d.down.overflowed, d.maxDelayMs, capOk ? "ok" : "FAILED");
+    ok &= capOk;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,302 @@
+//=============================================================================
+// bench_schema.cpp
+//
+// Reflected serializer (net_reflect.h): raw InputCmd/Snapshot layouts equal
+// the memcpy ones, field-by-field structs come out little-endian and
+// packed, quantized fields round trip within a step, malformed input is
+// rejected, schema hashes tell lists apart, and the cost against memcpy.
+//=============================================================================
+
+#include "net_bench.h"
+#include "net_schema.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+volatile uint32_t g_Sink;
+
+//-----------------------------------------------------------------------------
+// Test structs: implicit padding (field by field) and quantized fields
+//-----------------------------------------------------------------------------
+struct PaddedRecord
+{
+    uint8_t kind;           // 3 bytes of implicit padding follow
+    uint32_t value;
+    int16_t delta;
+    double time;
+};
+
+struct CompactInput
+{
+    uint32_t tickId;
+    float moveAxisX;
+    float moveAxisY;
+    float yaw;
+    float pitch;
+};
+
+struct CompactInputFine
+{
+    uint32_t tickId;
+    float moveAxisX;
+    float moveAxisY;
+    float yaw;
+    float pitch;
+};
+
+} // namespace
+
+template <>
+struct NetSchema<PaddedRecord>
+{
+    static constexpr const char* NAME = "PaddedRecord";
+    static constexpr auto FIELDS = std::make_tuple(
+        NET_FIELD(PaddedRecord, kind),
+        NET_FIELD(PaddedRecord, value),
+        NET_FIELD(PaddedRecord, delta),
+        NET_FIELD(PaddedRecord, time));
+};
+
+template <>
+struct NetSchema<CompactInput>
+{
+    static constexpr const char* NAME = "CompactInput";
+    static constexpr auto FIELDS = std::make_tuple(
+        NET_FIELD(CompactInput, tickId),
+        NET_FIELD_Q(CompactInput, moveAxisX, NetQuant::Fixed<-1, 1, 127>),
+        NET_FIELD_Q(CompactInput, moveAxisY, NetQuant::Fixed<-1, 1, 127>),
+        NET_FIELD_Q(CompactInput, yaw, NetQuant::Angle<uint16_t>),
+        NET_FIELD_Q(CompactInput, pitch, NetQuant::Fixed<-2, 2, 10000>));
+};
+
+// Same fields and names, finer stick quantization: must hash differently
+template <>
+struct NetSchema<CompactInputFine>
+{
+    static constexpr const char* NAME = "CompactInput";
+    static constexpr auto FIELDS = std::make_tuple(
+        NET_FIELD(CompactInputFine, tickId),
+        NET_FIELD_Q(CompactInputFine, moveAxisX, NetQuant::Fixed<-1, 1, 32767>),
+        NET_FIELD_Q(CompactInputFine, moveAxisY, NetQuant::Fixed<-1, 1, 32767>),
+        NET_FIELD_Q(CompactInputFine, yaw, NetQuant::Angle<uint16_t>),
+        NET_FIELD_Q(CompactInputFine, pitch, NetQuant::Fixed<-2, 2, 10000>));
+};
+
+namespace {
+
+static_assert(!NetReflect::IS_MEMCPY_LAYOUT<PaddedRecord>, "Implicit padding must be detected");
+static_assert(NetReflect::WIRE_SIZE<PaddedRecord> == 15, "Packed: 1 + 4 + 2 + 8");
+static_assert(NetReflect::WIRE_SIZE<CompactInput> == 4 + 1 + 1 + 2 + 2, "Smallest fitting wire types");
+static_assert(NetReflect::HASH<CompactInput> != NetReflect::HASH<CompactInputFine>, "Quantization is hashed");
+
+//-----------------------------------------------------------------------------
+// Layout: byte equality with memcpy, explicit little-endian packing
+//-----------------------------------------------------------------------------
+bool TestLayout()
+{
+    static Snapshot snapshot;
+    static Snapshot decoded;
+    static uint8_t buffer[NetReflect::MAX_WIRE_SIZE<Snapshot>];
+    Lcg rng = { 7u };
+
+    // InputCmd and Snapshot: Write output is the memcpy image
+    bool memcpyOk = true;
+    for (int i = 0; i < 100; i++)
+    {
+        InputCmd cmd = { rng.NextU32(), rng.NextFloat(1.0f), rng.NextFloat(1.0f), rng.NextFloat(3.14f),
+                         rng.NextFloat(1.5f), rng.NextU32() & 0x3F, rng.NextU32() };
+        InputCmd cmdOut = {};
+        memcpyOk &= NetReflect::Write(cmd, buffer, sizeof(buffer)) == sizeof(InputCmd) &&
+                    std::memcmp(buffer, &cmd, sizeof(InputCmd)) == 0 &&
+                    NetReflect::Read(buffer, sizeof(InputCmd), cmdOut) == sizeof(InputCmd) &&
+                    std::memcmp(&cmdOut, &cmd, sizeof(InputCmd)) == 0;
+
+        const uint8_t remoteCount = static_cast<uint8_t>(rng.NextU32() % MAX_PLAYERS);
+        FillRandomSnapshot(snapshot, rng, remoteCount);
+        const size_t size = GetSnapshotSize(remoteCount);
+        std::memset(&decoded, 0xCD, sizeof(decoded));
+        memcpyOk &= NetReflect::Write(snapshot, buffer, sizeof(buffer)) == size &&
+                    std::memcmp(buffer, &snapshot, size) == 0 &&
+                    NetReflect::Read(buffer, size, decoded) == size &&
+                    std::memcmp(&decoded, &snapshot, size) == 0;
+    }
+
+    // Field by field: packed, little-endian regardless of the host
+    const PaddedRecord record = { 0xA1, 0x04030201u, -2, 1.0 };
+    const uint8_t expected[15] = { 0xA1, 0x01, 0x02, 0x03, 0x04, 0xFE, 0xFF,
+                                   0, 0, 0, 0, 0, 0, 0xF0, 0x3F };
+    PaddedRecord recordOut = {};
+    const bool packedOk = NetReflect::Write(record, buffer, sizeof(buffer)) == sizeof(expected) &&
+                          std::memcmp(buffer, expected, sizeof(expected)) == 0 &&
+                          NetReflect::Read(buffer, sizeof(expected), recordOut) == sizeof(expected) &&
+                          recordOut.kind == record.kind && recordOut.value == record.value &&
+                          recordOut.delta == record.delta && recordOut.time == record.time;
+
+    // Malformed: short buffers, a count past the array, too little room
+    FillRandomSnapshot(snapshot, rng, 10);
+    const size_t size = NetReflect::Write(snapshot, buffer, sizeof(buffer));
+    bool rejectOk = size == GetSnapshotSize(10) &&
+                    NetReflect::Read(buffer, size - 1, decoded) == 0 &&
+                    NetReflect::Read(buffer, SNAPSHOT_HEADER_SIZE - 1, decoded) == 0 &&
+                    NetReflect::Write(snapshot, buffer, size - 1) == 0 &&
+                    NetReflect::Read(buffer, size + 100, decoded) == size;   // Trailing bytes ignored
+    buffer[offsetof(Snapshot, remotePlayerCount)] = MAX_PLAYERS;
+    rejectOk &= NetReflect::Read(buffer, sizeof(buffer), decoded) == 0;
+    snapshot.remotePlayerCount = MAX_PLAYERS;
+    rejectOk &= NetReflect::Write(snapshot, buffer, sizeof(buffer)) == 0;
+    InputCmd cmdOut = {};
+    rejectOk &= NetReflect::Read(buffer, sizeof(InputCmd) - 1, cmdOut) == 0;
+
+    std::printf("Layout      InputCmd %zu B, Snapshot %zu + %zu B per entry, equal to memcpy  %s\n",
+                NetReflect::WIRE_SIZE<InputCmd>, NetReflect::WIRE_SIZE<Snapshot>,
+                NetReflect::WIRE_SIZE<RemotePlayerEntry>, memcpyOk ? "ok" : "FAILED");
+    std::printf("            packed little-endian fields %s, malformed input rejected %s\n",
+                packedOk ? "ok" : "FAILED", rejectOk ? "ok" : "FAILED");
+    return memcpyOk && packedOk && rejectOk;
+}
+
+//-----------------------------------------------------------------------------
+// Quantized fields: error within half a step, clamping, angle wrap, NaN
+//-----------------------------------------------------------------------------
+bool TestQuantized()
+{
+    constexpr float TWO_PI = 6.28318530718f;
+    constexpr float AXIS_STEP = 1.0f / 127.0f;
+    constexpr float ANGLE_STEP = TWO_PI / 65536.0f;
+    constexpr float PITCH_STEP = 1.0f / 10000.0f;
+
+    uint8_t buffer[NetReflect::WIRE_SIZE<CompactInput>];
+    Lcg rng = { 11u };
+    float axisError = 0.0f, angleError = 0.0f, pitchError = 0.0f;
+    bool ok = true;
+    for (int i = 0; i < 100000; i++)
+    {
+        const CompactInput input = { rng.NextU32(), rng.NextFloat(1.0f), rng.NextFloat(1.0f),
+                                     rng.NextFloat(10.0f), rng.NextFloat(1.5f) };
+        CompactInput out = {};
+        ok &= NetReflect::Write(input, buffer, sizeof(buffer)) == sizeof(buffer) &&
+              NetReflect::Read(buffer, sizeof(buffer), out) == sizeof(buffer) && out.tickId == input.tickId;
+
+        axisError = std::fmax(axisError, std::fabs(out.moveAxisX - input.moveAxisX));
+        axisError = std::fmax(axisError, std::fabs(out.moveAxisY - input.moveAxisY));
+        pitchError = std::fmax(pitchError, std::fabs(out.pitch - input.pitch));
+        // Angles compare modulo a turn
+        const float turn = std::remainder(out.yaw - input.yaw, TWO_PI);
+        angleError = std::fmax(angleError, std::fabs(turn));
+        ok &= out.yaw >= -TWO_PI / 2 && out.yaw < TWO_PI / 2;
+    }
+    // Half a step, plus float rounding of the decoded value
+    constexpr float SLACK = 1e-6f;
+    ok &= axisError <= AXIS_STEP * 0.5f + SLACK && angleError <= ANGLE_STEP * 0.5f + SLACK &&
+          pitchError <= PITCH_STEP * 0.5f + SLACK;
+
+    // Out of range clamps, NaN goes to the lowest value
+    const CompactInput extreme = { 0, 5.0f, std::nanf(""), -TWO_PI / 2, -7.0f };
+    CompactInput out = {};
+    NetReflect::Write(extreme, buffer, sizeof(buffer));
+    NetReflect::Read(buffer, sizeof(buffer), out);
+    ok &= out.moveAxisX == 1.0f && out.moveAxisY == -1.0f && out.pitch == -2.0f &&
+          std::fabs(out.yaw + TWO_PI / 2) < ANGLE_STEP;
+
+    std::printf("Quantized   %zu B vs %zu B raw, max error axis %.2g pitch %.2g yaw %.2g (half steps)  %s\n",
+                NetReflect::WIRE_SIZE<CompactInput>, sizeof(CompactInput), axisError, pitchError, angleError,
+                ok ? "ok" : "FAILED");
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// Hash: every list is covered, and any change to one moves it
+//-----------------------------------------------------------------------------
+bool TestHash()
+{
+    const uint32_t hashes[] = {
+        NetReflect::HASH<DirectX::XMFLOAT3>, NetReflect::HASH<InputCmd>, NetReflect::HASH<NetPlayerState>,
+        NetReflect::HASH<RemotePlayerEntry>, NetReflect::HASH<Snapshot>, NetReflect::HASH<PaddedRecord>,
+        NetReflect::HASH<CompactInput>, NetReflect::HASH<CompactInputFine>, NET_SCHEMA_HASH,
+    };
+    const size_t count = sizeof(hashes) / sizeof(hashes[0]);
+    bool distinct = true;
+    for (size_t i = 0; i < count; i++)
+        for (size_t j = i + 1; j < count; j++)
+            distinct &= hashes[i] != hashes[j];
+
+    std::printf("Hash        NET_SCHEMA_HASH %08x, %zu lists all distinct  %s\n", NET_SCHEMA_HASH, count,
+                distinct ? "ok" : "FAILED");
+    return distinct;
+}
+
+//-----------------------------------------------------------------------------
+// Cost against memcpy
+//-----------------------------------------------------------------------------
+template <typename Fn>
+double MeasureNs(uint32_t iterations, Fn&& fn)
+{
+    BenchTimer timer;
+    for (uint32_t i = 0; i < iterations; i++) fn(i);
+    return timer.GetSeconds() * 1e9 / iterations;
+}
+
+void MeasureCost()
+{
+    constexpr uint32_t ITERATIONS = 200000;
+    constexpr uint32_t SNAPSHOT_ITERATIONS = 20000;
+    static Snapshot snapshot;
+    static Snapshot decoded;
+    static uint8_t buffer[NetReflect::MAX_WIRE_SIZE<Snapshot>];
+    Lcg rng = { 3u };
+    FillRandomSnapshot(snapshot, rng, MAX_PLAYERS - 1);
+    const size_t snapshotSize = GetSnapshotSize(snapshot.remotePlayerCount);
+
+    std::vector<InputCmd> cmds(1024);
+    for (InputCmd& cmd : cmds)
+        cmd = { rng.NextU32(), rng.NextFloat(1.0f), rng.NextFloat(1.0f), rng.NextFloat(3.0f), 0.0f, 0u, 0u };
+    std::vector<CompactInput> compact(1024);
+    for (CompactInput& input : compact)
+        input = { rng.NextU32(), rng.NextFloat(1.0f), rng.NextFloat(1.0f), rng.NextFloat(3.0f), 0.0f };
+
+    uint32_t sink = 0;
+    const double cmdMemcpy = MeasureNs(ITERATIONS, [&](uint32_t i) {
+        std::memcpy(buffer, &cmds[i & 1023], sizeof(InputCmd));
+        sink += buffer[i & 15];
+    });
+    const double cmdWrite = MeasureNs(ITERATIONS, [&](uint32_t i) {
+        sink += static_cast<uint32_t>(NetReflect::Write(cmds[i & 1023], buffer, sizeof(buffer)));
+        sink += buffer[i & 15];
+    });
+    const double compactWrite = MeasureNs(ITERATIONS, [&](uint32_t i) {
+        sink += static_cast<uint32_t>(NetReflect::Write(compact[i & 1023], buffer, sizeof(buffer)));
+        sink += buffer[i & 7];
+    });
+    const double snapMemcpy = MeasureNs(SNAPSHOT_ITERATIONS, [&](uint32_t i) {
+        snapshot.tickId = i;
+        std::memcpy(buffer, &snapshot, snapshotSize);
+        std::memcpy(&decoded, buffer, snapshotSize);
+        sink += decoded.tickId;
+    });
+    const double snapReflect = MeasureNs(SNAPSHOT_ITERATIONS, [&](uint32_t i) {
+        snapshot.tickId = i;
+        const size_t size = NetReflect::Write(snapshot, buffer, sizeof(buffer));
+        sink += static_cast<uint32_t>(NetReflect::Read(buffer, size, decoded));
+        sink += decoded.tickId;
+    });
+    g_Sink = sink;
+
+    std::printf("Cost        InputCmd write %.1f ns (memcpy %.1f), quantized %.1f ns\n", cmdWrite, cmdMemcpy,
+                compactWrite);
+    std::printf("            %u-entry Snapshot write+read %.0f ns (memcpy %.0f)\n", snapshot.remotePlayerCount,
+                snapReflect, snapMemcpy);
+}
+
+} // namespace
+
+int Bench_Schema()
+{
+    bool ok = TestLayout();
+    ok &= TestQuantized();
+    ok &= TestHash();
+    MeasureCost();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+//=============================================================================
+// bench_snapshot.cpp
+//
+// Snapshot encode/decode cost and size versus the number of players
+// present, through SnapshotDeltaEncoder/Decoder and SNAPSHOT_PART splitting.
+// Cost per player should stay flat as the session grows. Also checks that
+// every decoded snapshot matches what the server recorded as its baseline,
+// that a byte budget bounds the payload without starving anyone, and that
+// reassembly survives reordered, duplicated and lost parts.
+//=============================================================================
+
+#include "net_bench.h"
+#include "snapshot_delta.h"
+#include "snapshot_parts.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t TICK_COUNT = 2000;
+const uint8_t PLAYER_COUNTS[] = { 4, 16, 32, 64, 128 };
+
+//-----------------------------------------------------------------------------
+// Encode -> (split -> reassemble) -> decode, client acking every tick
+//-----------------------------------------------------------------------------
+bool RunPlayerCount(uint8_t playerCount)
+{
+    static SnapshotDeltaEncoder encoder;
+    static SnapshotDeltaDecoder decoder;
+    static SnapshotReassembler reassembler;
+    static Snapshot serverSnap;
+    static Snapshot expected;
+    static Snapshot clientSnap;
+    encoder.Reset();
+    decoder.Reset();
+    reassembler.Reset();
+
+    uint8_t payload[SNAPSHOT_DELTA_MAX_SIZE];
+    uint8_t part[SNAPSHOT_PACKET_MAX_SIZE];
+
+    double encodeSeconds = 0.0;
+    double decodeSeconds = 0.0;
+    size_t totalBytes = 0;
+    uint32_t splitTicks = 0;
+    bool ok = true;
+
+    for (uint32_t tick = 1; tick <= TICK_COUNT; tick++)
+    {
+        FillSnapshot(serverSnap, playerCount, tick);
+
+        BenchTimer encodeTimer;
+        size_t size = encoder.Encode(serverSnap, payload, sizeof(payload));
+        encodeSeconds += encodeTimer.GetSeconds();
+        if (size == 0) return false;
+
+        BenchTimer decodeTimer;
+        const uint8_t* data = payload;
+        size_t dataSize = size;
+        totalBytes += 1 + size;
+
+        if (1 + size > SNAPSHOT_PACKET_MAX_SIZE)
+        {
+            size_t partCount = SnapshotParts::GetPartCount(size);
+            totalBytes += partCount * (1 + SNAPSHOT_PART_HEADER_SIZE) - 1;
+            splitTicks++;
+
+            // Deliver last part first to exercise out-of-order reassembly
+            bool complete = false;
+            for (size_t n = 0; n < partCount; n++)
+            {
+                size_t index = (n == 0) ? partCount - 1 : n - 1;
+                size_t partSize = SnapshotParts::WritePart(payload, size, tick, index, part, sizeof(part));
+                complete = reassembler.AddPart(part, partSize);
+            }
+            if (!complete) return false;
+
+            data = reassembler.GetPayload();
+            dataSize = reassembler.GetPayloadSize();
+        }
+
+        bool decoded = decoder.Decode(data, dataSize, clientSnap);
+        decodeSeconds += decodeTimer.GetSeconds();
+
+        CopySnapshot(expected, serverSnap);
+        NetCodec::QuantizeSnapshot(expected);
+        ok &= decoded && SameSnapshot(clientSnap, expected);
+
+        encoder.Acknowledge(tick);
+    }
+
+    auto usPerPlayer = [&](double seconds) { return seconds * 1e6 / TICK_COUNT / playerCount; };
+
+    std::printf("%3u players  %6.1f B/tick  split %4u/%u  encode %5.3f us/player  decode %5.3f us/player  %s\n",
+                playerCount, static_cast<double>(totalBytes) / TICK_COUNT, splitTicks, TICK_COUNT,
+                usPerPlayer(encodeSeconds), usPerPlayer(decodeSeconds), ok ? "ok" : "MISMATCH");
+
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// Byte budget at full load: every payload fits, every decoded entry matches
+// the server's state for that tick, nobody waits too long, and a player who
+// starts firing goes out on the next snapshot
+//-----------------------------------------------------------------------------
+bool CheckBudget()
+{
+    constexpr size_t budget = 512;
+    constexpr uint8_t playerCount = MAX_PLAYERS;
+    constexpr uint8_t shooterId = 100;
+
+    static SnapshotDeltaEncoder encoder;
+    static SnapshotDeltaDecoder decoder;
+    static Snapshot serverSnap;
+    static Snapshot expected;
+    static Snapshot clientSnap;
+    encoder.Reset();
+    decoder.Reset();
+    encoder.SetByteBudget(budget);
+
+    uint8_t payload[SNAPSHOT_DELTA_MAX_SIZE];
+    uint32_t lastSeen[MAX_PLAYERS] = {};
+    uint32_t maxGap = 0;
+    size_t maxSize = 0;
+    size_t totalBytes = 0;
+    bool ok = true;
+
+    for (uint32_t tick = 1; tick <= TICK_COUNT; tick++)
+    {
+        FillSnapshot(serverSnap, playerCount, tick);
+        bool shooterFires = (tick % 100) >= 50;
+        if (shooterFires) serverSnap.remotePlayers[shooterId - 1].state.stateFlags |= NetStateFlags::IS_FIRING;
+
+        size_t size = encoder.Encode(serverSnap, payload, sizeof(payload));
+        if (size == 0 || !decoder.Decode(payload, size, clientSnap)) return false;
+        maxSize = (size > maxSize) ? size : maxSize;
+        totalBytes += size;
+
+        CopySnapshot(expected, serverSnap);
+        NetCodec::QuantizeSnapshot(expected);
+        for (uint8_t i = 0; i < clientSnap.remotePlayerCount; i++)
+        {
+            const RemotePlayerEntry& entry = clientSnap.remotePlayers[i];
+            ok &= std::memcmp(&entry, &expected.remotePlayers[entry.playerId - 1], sizeof(entry)) == 0;
+
+            // Skip the initial fill, when everyone needs a full entry
+            if (tick > SNAPSHOT_HISTORY_SIZE && lastSeen[entry.playerId] != 0)
+            {
+                uint32_t gap = tick - lastSeen[entry.playerId];
+                maxGap = (gap > maxGap) ? gap : maxGap;
+            }
+            lastSeen[entry.playerId] = tick;
+        }
+        if (tick % 100 == 50 && lastSeen[shooterId] != tick)
+            ok = false;
+
+        encoder.Acknowledge(tick);
+    }
+
+    std::printf("Budget %zu B  %u players  %6.1f B/tick  max %zu B  max gap %u ticks  %s\n",
+                budget, playerCount, static_cast<double>(totalBytes) / TICK_COUNT, maxSize, maxGap,
+                (ok && maxSize <= budget) ? "ok" : "FAILED");
+
+    return ok && maxSize <= budget;
+}
+
+//-----------------------------------------------------------------------------
+// Reassembly edge cases
+//-----------------------------------------------------------------------------
+bool CheckReassembly()
+{
+    static uint8_t payload[3 * SNAPSHOT_PART_DATA_SIZE - 100];
+    for (size_t i = 0; i < sizeof(payload); i++) payload[i] = static_cast<uint8_t>(i * 7);
+
+    uint8_t parts[3][SNAPSHOT_PACKET_MAX_SIZE];
+    size_t sizes[3];
+    for (size_t i = 0; i < 3; i++)
+        sizes[i] = SnapshotParts::WritePart(payload, sizeof(payload), 10, i, parts[i], sizeof(parts[i]));
+
+    static SnapshotReassembler reassembler;
+    reassembler.Reset();
+    bool ok = true;
+
+    // Duplicate part does not complete early; reordered parts complete once
+    ok &= !reassembler.AddPart(parts[1], sizes[1]);
+    ok &= !reassembler.AddPart(parts[1], sizes[1]);
+    ok &= !reassembler.AddPart(parts[2], sizes[2]);
+    ok &= reassembler.AddPart(parts[0], sizes[0]);
+    ok &= reassembler.GetPayloadSize() == sizeof(payload) &&
+          std::memcmp(reassembler.GetPayload(), payload, sizeof(payload)) == 0;
+
+    // Late duplicate of a finished tick is ignored
+    ok &= !reassembler.AddPart(parts[2], sizes[2]);
+
+    // Tick 11 loses a part; tick 12 abandons it and completes
+    uint8_t next[SNAPSHOT_PACKET_MAX_SIZE];
+    size_t nextSize = SnapshotParts::WritePart(payload, sizeof(payload), 11, 0, next, sizeof(next));
+    ok &= !reassembler.AddPart(next, nextSize);
+    bool complete = false;
+    for (size_t i = 0; i < 3; i++)
+    {
+        nextSize = SnapshotParts::WritePart(payload, sizeof(payload), 12, i, next, sizeof(next));
+        complete = reassembler.AddPart(next, nextSize);
+    }
+    ok &= complete && reassembler.GetIncompleteCount() == 1;
+
+    // Truncated part is rejected
+    ok &= !reassembler.AddPart(parts[0], sizes[0] - 1) && reassembler.GetMalformedCount() == 1;
+
+    std::printf("Reassembly   reorder/duplicate/loss/malformed  %s\n", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+} // namespace
+
+int Bench_Snapshot()
+{
+    bool ok = true;
+
+    std::printf("%u ticks per size, datagram limit %zu B\n", TICK_COUNT, SNAPSHOT_PACKET_MAX_SIZE);
+    for (uint8_t playerCount : PLAYER_COUNTS) ok &= RunPlayerCount(playerCount);
+    ok &= CheckBudget();
+    ok &= CheckReassembly();
+
+    return ok ? 0 : 1;
+}
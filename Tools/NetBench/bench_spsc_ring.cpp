@@ -0,0 +1,197 @@
+//=============================================================================
+// bench_spsc_ring.cpp
+//
+// SpscRing vs. the std::mutex + std::queue it replaced, with one producer
+// and one consumer thread, for InputCmd (24 bytes) and Snapshot (full-capacity struct).
+// Also checks ordering and drop accounting under both overflow policies.
+//=============================================================================
+
+#include "net_bench.h"
+#include "net_common.h"
+#include "spsc_ring.h"
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace {
+
+constexpr uint32_t ITEM_COUNT = 2000000;
+constexpr size_t RING_CAPACITY = 64;
+
+//-----------------------------------------------------------------------------
+// Baseline: the previous MockNetwork / ENetClientNetwork queue
+//-----------------------------------------------------------------------------
+template <typename T>
+class MutexQueue
+{
+public:
+    void Push(const T& value)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Queue.push(value);
+    }
+
+    bool Pop(T& outValue)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_Queue.empty()) return false;
+        outValue = m_Queue.front();
+        m_Queue.pop();
+        return true;
+    }
+
+private:
+    std::queue<T> m_Queue;
+    std::mutex m_Mutex;
+};
+
+// Every element type used here carries a uint32_t tickId
+template <typename T> T MakeItem(uint32_t seq) { T item = {}; item.tickId = seq; return item; }
+
+//-----------------------------------------------------------------------------
+// Producer pushes ITEM_COUNT items, consumer checks they arrive in order.
+// The ring producer waits instead of overflowing so nothing is dropped.
+//-----------------------------------------------------------------------------
+struct RunResult
+{
+    double seconds;
+    bool ordered;
+};
+
+template <typename T>
+RunResult RunMutexQueue()
+{
+    MutexQueue<T> queue;
+    bool ordered = true;
+
+    BenchTimer timer;
+    std::thread consumer([&]() {
+        T item;
+        uint32_t expected = 0;
+        while (expected < ITEM_COUNT)
+        {
+            if (!queue.Pop(item)) { std::this_thread::yield(); continue; }
+            if (item.tickId != expected) ordered = false;
+            expected++;
+        }
+    });
+
+    for (uint32_t i = 0; i < ITEM_COUNT; i++) queue.Push(MakeItem<T>(i));
+    consumer.join();
+
+    return { timer.GetSeconds(), ordered };
+}
+
+template <typename T>
+RunResult RunSpscRing()
+{
+    static SpscRing<T, RING_CAPACITY> ring;   // Snapshot ring is too big for the stack
+    ring.Clear();
+    bool ordered = true;
+
+    BenchTimer timer;
+    std::thread consumer([&]() {
+        T item;
+        uint32_t expected = 0;
+        while (expected < ITEM_COUNT)
+        {
+            if (!ring.Pop(item)) { std::this_thread::yield(); continue; }
+            if (item.tickId != expected) ordered = false;
+            expected++;
+        }
+    });
+
+    for (uint32_t i = 0; i < ITEM_COUNT; i++)
+    {
+        while (ring.Size() >= RING_CAPACITY) std::this_thread::yield();
+        ring.Push(MakeItem<T>(i));
+    }
+    consumer.join();
+
+    return { timer.GetSeconds(), ordered && ring.GetDropCount() == 0 };
+}
+
+template <typename T>
+bool CompareQueues(const char* label)
+{
+    RunResult mutexResult = RunMutexQueue<T>();
+    RunResult ringResult = RunSpscRing<T>();
+
+    auto nsPerItem = [](double seconds) { return seconds * 1e9 / ITEM_COUNT; };
+
+    std::printf("%-10s (%3zu B)  mutex+queue %7.1f ns/item   spsc ring %7.1f ns/item   x%.1f\n",
+                label, sizeof(T),
+                nsPerItem(mutexResult.seconds), nsPerItem(ringResult.seconds),
+                mutexResult.seconds / ringResult.seconds);
+
+    return mutexResult.ordered && ringResult.ordered;
+}
+
+//-----------------------------------------------------------------------------
+// Overflow: fast producer, slow consumer. Whatever is delivered must stay
+// in order, and delivered + dropped must account for every item.
+//-----------------------------------------------------------------------------
+template <RingOverflow Overflow>
+bool CheckOverflow(const char* label)
+{
+    constexpr uint32_t count = 200000;
+    static SpscRing<InputCmd, RING_CAPACITY, Overflow> ring;
+    ring.Clear();
+
+    std::atomic<bool> producerDone{ false };
+    uint32_t delivered = 0;
+    bool ordered = true;
+
+    std::thread consumer([&]() {
+        InputCmd cmd;
+        bool first = true;
+        uint32_t last = 0;
+        for (;;)
+        {
+            bool done = producerDone.load(std::memory_order_acquire);
+            if (!ring.Pop(cmd))
+            {
+                if (done) break;
+                continue;
+            }
+            if (!first && cmd.tickId <= last) ordered = false;
+            first = false;
+            last = cmd.tickId;
+            delivered++;
+
+            // Slow consumer: let the ring fill up
+            if ((delivered & 7) == 0) std::this_thread::yield();
+        }
+    });
+
+    for (uint32_t i = 0; i < count; i++) ring.Push(MakeItem<InputCmd>(i));
+    producerDone.store(true, std::memory_order_release);
+    consumer.join();
+
+    uint32_t dropped = ring.GetDropCount();
+    bool accounted = (delivered + dropped == count);
+
+    std::printf("%-12s delivered %6u  dropped %6u  ordered %s  accounted %s\n",
+                label, delivered, dropped, ordered ? "yes" : "NO", accounted ? "yes" : "NO");
+
+    return ordered && accounted;
+}
+
+} // namespace
+
+int Bench_SpscRing()
+{
+    bool ok = true;
+
+    std::printf("%u items, ring capacity %zu\n", ITEM_COUNT, RING_CAPACITY);
+    ok &= CompareQueues<InputCmd>("InputCmd");
+    ok &= CompareQueues<Snapshot>("Snapshot");
+
+    std::printf("\nOverflow (slow consumer):\n");
+    ok &= CheckOverflow<RingOverflow::DROP_NEWEST>("DROP_NEWEST");
+    ok &= CheckOverflow<RingOverflow::DROP_OLDEST>("DROP_OLDEST");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+//=============================================================================
+// bench_telemetry.cpp
+//
+// LogLinearHistogram bucket layout, percentile accuracy against exact
+// percentiles and recording cost, then NetTelemetry over ten virtual
+// seconds of steady traffic with CSV and JSON export.
+//=============================================================================
+
+#include "net_bench.h"
+#include "mock_network.h"
+#include "net_telemetry.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+volatile uint32_t g_Sink;
+
+//-----------------------------------------------------------------------------
+// Histogram: contiguous buckets, percentile error, cost
+//-----------------------------------------------------------------------------
+bool TestHistogram()
+{
+    // Buckets tile the uint32 range without gaps or overlap
+    bool layoutOk = LogLinearHistogram::GetBucketLower(0) == 0 &&
+                    LogLinearHistogram::GetBucketUpper(LogLinearHistogram::BUCKET_COUNT - 1) == 0xFFFFFFFFu;
+    for (uint32_t i = 0; layoutOk && i < LogLinearHistogram::BUCKET_COUNT; i++)
+    {
+        const uint32_t lower = LogLinearHistogram::GetBucketLower(i);
+        const uint32_t upper = LogLinearHistogram::GetBucketUpper(i);
+        layoutOk = LogLinearHistogram::GetBucketIndex(lower) == i && LogLinearHistogram::GetBucketIndex(upper) == i;
+        if (i + 1 < LogLinearHistogram::BUCKET_COUNT)
+            layoutOk &= LogLinearHistogram::GetBucketLower(i + 1) == upper + 1;
+    }
+
+    // Three shapes: uniform, exponential (RTT-like), heavy tail (jitter-like)
+    constexpr uint32_t SAMPLES = 1000000;
+    static LogLinearHistogram histogram;
+    std::vector<uint32_t> exact(SAMPLES);
+    const char* const names[] = { "uniform", "exponential", "pareto" };
+    const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+    double worstError = 0.0;
+    double recordNs = 0.0;
+
+    for (int shape = 0; shape < 3; shape++)
+    {
+        Lcg rng = { 12345u + static_cast<uint64_t>(shape) };
+        for (uint32_t i = 0; i < SAMPLES; i++)
+        {
+            const double u = rng.Next();
+            double value = 0.0;
+            if (shape == 0) value = u * 1000.0;
+            else if (shape == 1) value = 30.0 - 20.0 * std::log(1.0 - u);
+            else value = 200.0 / std::pow(1.0 - u, 1.0 / 1.5);
+            exact[i] = static_cast<uint32_t>(std::fmin(value, 4e9));
+        }
+
+        histogram.Reset();
+        BenchTimer timer;
+        for (uint32_t i = 0; i < SAMPLES; i++) histogram.Record(exact[i]);
+        recordNs += timer.GetSeconds() * 1e9 / SAMPLES / 3.0;
+
+        std::sort(exact.begin(), exact.end());
+        std::printf("%-11s", names[shape]);
+        for (double q : quantiles)
+        {
+            const uint32_t truth = exact[static_cast<size_t>(std::ceil(q * SAMPLES)) - 1];
+            const uint32_t estimate = histogram.GetPercentile(q);
+            const double error = std::fabs(static_cast<double>(estimate) - truth) / std::fmax(truth, 16.0);
+            worstError = std::fmax(worstError, error);
+            std::printf(" p%g %u/%u", q * 100.0, estimate, truth);
+        }
+        std::printf("\n");
+
+        layoutOk &= histogram.GetCount() == SAMPLES && histogram.GetMin() == exact.front() &&
+                    histogram.GetMax() == exact.back();
+    }
+    g_Sink = histogram.GetPercentile(0.5);
+
+    const bool accuracyOk = worstError <= 1.0 / 8.0;
+    std::printf("Layout      %u buckets, %zu B per histogram  %s\n", LogLinearHistogram::BUCKET_COUNT,
+                sizeof(LogLinearHistogram), layoutOk ? "ok" : "FAILED");
+    std::printf("Accuracy    worst percentile error %.2f%% (limit 12.5%%)  %s\n", worstError * 100.0,
+                accuracyOk ? "ok" : "FAILED");
+    std::printf("Cost        %.1f ns per sample\n", recordNs);
+    return layoutOk && accuracyOk;
+}
+
+//-----------------------------------------------------------------------------
+// Telemetry: 10s at 60fps, 32Hz snapshots with +-2ms jitter
+//-----------------------------------------------------------------------------
+class CountingNetwork : public MockNetwork
+{
+public:
+    uint64_t GetTotalBytesSent() const override { return bytesSent; }
+    uint64_t GetTotalBytesReceived() const override { return bytesReceived; }
+    uint64_t GetTotalPacketsSent() const override { return packetsSent; }
+    uint64_t GetTotalPacketsReceived() const override { return packetsReceived; }
+
+    uint64_t bytesSent = 0;
+    uint64_t bytesReceived = 0;
+    uint64_t packetsSent = 0;
+    uint64_t packetsReceived = 0;
+};
+
+constexpr double FRAME = 1.0 / 60.0;
+constexpr double TICK = 1.0 / 32.0;
+constexpr double RUN_SECONDS = 10.0;
+constexpr double DUMP_INTERVAL = 2.0;
+
+uint32_t RunSession(NetTelemetry& telemetry)
+{
+    static CountingNetwork network;
+    network.bytesSent = network.bytesReceived = network.packetsSent = network.packetsReceived = 0;
+    telemetry.Reset();
+
+    const char* const sync[] = { "INTERP", "INTERP", "INTERP", "EXTRAP" };
+    uint32_t tick = 0, snapshots = 0;
+    // Runs a quarter interval past the last periodic dump, so frame
+    // rounding cannot skip it
+    const uint32_t frames = static_cast<uint32_t>((RUN_SECONDS + DUMP_INTERVAL / 4) / FRAME);
+    for (uint32_t frame = 0; frame <= frames; frame++)
+    {
+        const double now = 1000.0 + frame * FRAME;
+        // Every snapshot due by now, each 40B up (input) and 400B down,
+        // arriving 30ms after its tick +-2ms
+        while (1000.0 + tick * TICK <= now)
+        {
+            const double jitter = (static_cast<int>(tick * 7 % 5) - 2) * 0.001;
+            network.bytesSent += 40;
+            network.bytesReceived += 400;
+            network.packetsSent++;
+            network.packetsReceived++;
+            telemetry.OnSnapshot(1000.0 + tick * TICK + 0.03 + jitter, tick * TICK, 50);
+            telemetry.CountCorrectionMode(tick % 10 == 0 ? "SOFT" : "OK");
+            snapshots++;
+            tick++;
+        }
+        telemetry.CountSyncMode(sync[frame % 4]);
+        telemetry.Update(now, &network);
+    }
+    return snapshots;
+}
+
+bool TestTelemetry()
+{
+    static NetTelemetry telemetry;
+    const char* csvPath = "netbench_telemetry.csv";
+    const char* jsonPath = "netbench_telemetry.jsonl";
+
+    // CSV
+    telemetry.Open(csvPath, NetTelemetryFormat::CSV, DUMP_INTERVAL);
+    const uint32_t snapshots = RunSession(telemetry);
+    telemetry.Close();
+    const uint32_t csvDumps = telemetry.GetDumpCount();
+
+    const LogLinearHistogram& up = telemetry.GetHistogram(NetTelemetry::BYTES_UP_PER_SEC);
+    const LogLinearHistogram& down = telemetry.GetHistogram(NetTelemetry::BYTES_DOWN_PER_SEC);
+    const LogLinearHistogram& packets = telemetry.GetHistogram(NetTelemetry::PACKETS_DOWN_PER_SEC);
+    const LogLinearHistogram& jitter = telemetry.GetHistogram(NetTelemetry::SNAPSHOT_JITTER_US);
+    const LogLinearHistogram& rtt = telemetry.GetHistogram(NetTelemetry::RTT_MS);
+
+    // 32 snapshots/s: 1280 B/s up, 12800 B/s down; frame quantization
+    // (a window closes up to a frame late) moves a sample by ~1/32
+    auto near = [](uint32_t value, double expected) { return std::fabs(value - expected) <= expected / 8.0; };
+    const bool rateOk = up.GetCount() >= 8 && near(up.GetPercentile(0.5), 1280.0) &&
+                        near(down.GetPercentile(0.5), 12800.0) && near(packets.GetPercentile(0.5), 32.0);
+    const bool jitterOk = jitter.GetCount() == snapshots - 1 && jitter.GetMax() <= 4001 &&
+                          rtt.GetCount() == snapshots && rtt.GetMin() == 50 && rtt.GetMax() == 50;
+
+    const NetModeCounter& corrections = telemetry.GetCorrectionModes();
+    const NetModeCounter& syncModes = telemetry.GetSyncModes();
+    uint64_t soft = 0, syncTotal = 0;
+    for (uint32_t i = 0; i < corrections.GetModeCount(); i++)
+        if (std::strcmp(corrections.GetName(i), "SOFT") == 0) soft = corrections.GetCount(i);
+    for (uint32_t i = 0; i < syncModes.GetModeCount(); i++) syncTotal += syncModes.GetCount(i);
+    const bool modesOk = corrections.GetModeCount() == 2 && soft == (snapshots + 9) / 10 &&
+                         syncModes.GetModeCount() == 2 && syncTotal > 590;
+
+    // Periodic dumps plus the one at Close; every dump writes a fixed set of rows
+    uint32_t csvLines = 0;
+    char line[4096];
+    if (std::FILE* file = std::fopen(csvPath, "r"))
+    {
+        while (std::fgets(line, sizeof(line), file)) csvLines++;
+        std::fclose(file);
+    }
+    const uint32_t rowsPerDump = NetTelemetry::METRIC_COUNT + corrections.GetModeCount() + syncModes.GetModeCount();
+    const uint32_t expectedDumps = static_cast<uint32_t>(RUN_SECONDS / DUMP_INTERVAL) + 1;
+    const bool csvOk = csvDumps == expectedDumps && csvLines == 1 + csvDumps * rowsPerDump;
+
+    // JSON lines: one object per dump
+    telemetry.Open(jsonPath, NetTelemetryFormat::JSON, DUMP_INTERVAL);
+    RunSession(telemetry);
+    telemetry.Close();
+    uint32_t jsonLines = 0;
+    bool jsonOk = true;
+    if (std::FILE* file = std::fopen(jsonPath, "r"))
+    {
+        while (std::fgets(line, sizeof(line), file))
+        {
+            const size_t length = std::strlen(line);
+            jsonOk &= length > 2 && line[0] == '{' && std::strcmp(line + length - 2, "}\n") == 0 &&
+                      std::strstr(line, "\"rtt_ms\":{\"count\":") && std::strstr(line, "\"sync_modes\":{\"INTERP\":");
+            jsonLines++;
+        }
+        std::fclose(file);
+    }
+    jsonOk &= jsonLines == telemetry.GetDumpCount() && jsonLines == expectedDumps;
+
+    std::remove(csvPath);
+    std::remove(jsonPath);
+
+    std::printf("Rates       up %u B/s  down %u B/s  %u pkt/s (p50 over %llu windows)  %s\n",
+                up.GetPercentile(0.5), down.GetPercentile(0.5), packets.GetPercentile(0.5),
+                static_cast<unsigned long long>(up.GetCount()), rateOk ? "ok" : "FAILED");
+    std::printf("Jitter      p50 %u us  p99 %u us  max %u us, RTT %u ms  %s\n", jitter.GetPercentile(0.5),
+                jitter.GetPercentile(0.99), jitter.GetMax(), rtt.GetPercentile(0.5), jitterOk ? "ok" : "FAILED");
+    std::printf("Modes       correction SOFT %llu/%u  sync samples %llu  %s\n",
+                static_cast<unsigned long long>(soft), snapshots, static_cast<unsigned long long>(syncTotal),
+                modesOk ? "ok" : "FAILED");
+    std::printf("Export      CSV %u dumps / %u lines, JSON %u lines  %s\n", csvDumps, csvLines, jsonLines,
+                (csvOk && jsonOk) ? "ok" : "FAILED");
+    return rateOk && jitterOk && modesOk && csvOk && jsonOk;
+}
+
+} // namespace
+
+int Bench_Telemetry()
+{
+    bool ok = TestHistogram();
+    ok &= TestTelemetry();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+//=============================================================================
+// bench_tickrate.cpp
+//
+// MockServer at every supported tick rate (net_tick.h) with a growing
+// number of MockNetwork clients walking for the same simulated time.
+// Reports the server tick cost, the CPU per simulated second (the share of
+// one core the rate needs) and the downstream bytes per client. Checks that
+// each client was told the server's rate and got a snapshot every tick, and
+// that the distance walked does not depend on the rate (movement is per
+// second, stepped by the tick duration).
+//=============================================================================
+
+#include "net_bench.h"
+#include "mock_network.h"
+#include "mock_server.h"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+constexpr double SIMULATED_SECONDS = 4.0;
+constexpr uint32_t MAX_CLIENTS = MAX_PLAYERS - 1;
+const uint32_t TICK_RATES[] = { 32, 64, 128 };
+const uint32_t CLIENT_COUNTS[] = { 8, 32, 127 };
+
+// Walked distances may differ by the integration step, not by the rate
+constexpr float MAX_DISTANCE_ERROR = 0.02f;
+
+MockNetwork g_Clients[MAX_CLIENTS];
+DirectX::XMFLOAT3 g_Start[MAX_CLIENTS];
+DirectX::XMFLOAT3 g_End[MAX_CLIENTS];
+
+struct RateResult
+{
+    double tickMs;              // Server cost per tick
+    double cpuMsPerSecond;      // Server cost per simulated second
+    double bytesPerClient;      // Downstream bytes per client per second
+    float walked;               // Mean distance walked per client
+    bool ok;
+};
+
+RateResult Run(uint32_t tickRate, uint32_t clientCount)
+{
+    static MockServer server;
+    server.SetTickRate(tickRate);
+    server.Initialize(nullptr);
+
+    RateResult result = {};
+    result.ok = server.GetTickRate() == tickRate;
+
+    for (uint32_t c = 0; c < clientCount; c++)
+    {
+        g_Clients[c].SetSnapshotDeltaEnabled(true);
+        g_Clients[c].SetInputRedundancy(3);
+        g_Clients[c].Initialize();
+        const int playerId = server.AddClient(&g_Clients[c]);
+        if (playerId < 0 || g_Clients[c].GetTickRate() != tickRate)
+        {
+            result.ok = false;
+            continue;
+        }
+        g_Start[c] = server.GetPlayerState(static_cast<uint8_t>(playerId))->position;
+        g_End[c] = g_Start[c];
+    }
+
+    const uint32_t tickCount = static_cast<uint32_t>(SIMULATED_SECONDS * tickRate);
+    uint32_t snapshots = 0;
+    uint64_t bytes = 0;
+    double serverSeconds = 0.0;
+    for (uint32_t tick = 1; tick <= tickCount; tick++)
+    {
+        for (uint32_t c = 0; c < clientCount; c++)
+        {
+            InputCmd cmd = {};
+            cmd.tickId = tick;
+            cmd.moveAxisY = 1.0f;
+            cmd.yaw = static_cast<float>(c) * 2.399963f;     // Golden angle
+            g_Clients[c].SendInputCmd(cmd);
+        }
+
+        BenchTimer timer;
+        server.Update(server.GetTickDuration());
+        serverSeconds += timer.GetSeconds();
+
+        for (uint32_t c = 0; c < clientCount; c++)
+        {
+            SnapshotHandle handle;
+            while (g_Clients[c].AcquireSnapshot(handle))
+            {
+                snapshots++;
+                bytes += g_Clients[c].GetLastSnapshotBytes();
+                g_End[c] = handle->localPlayer.position;
+            }
+        }
+    }
+
+    result.tickMs = serverSeconds * 1000.0 / tickCount;
+    result.cpuMsPerSecond = serverSeconds * 1000.0 / SIMULATED_SECONDS;
+    result.bytesPerClient = static_cast<double>(bytes) / clientCount / SIMULATED_SECONDS;
+    if (snapshots != tickCount * clientCount) result.ok = false;
+
+    float walked = 0.0f;
+    for (uint32_t c = 0; c < clientCount; c++)
+    {
+        const float dx = g_End[c].x - g_Start[c].x;
+        const float dz = g_End[c].z - g_Start[c].z;
+        walked += std::sqrt(dx * dx + dz * dz);
+        g_Clients[c].Finalize();
+    }
+    result.walked = walked / clientCount;
+
+    server.Finalize();
+    return result;
+}
+
+} // namespace
+
+int Bench_TickRate()
+{
+    bool allOk = true;
+    std::printf("Rate  Clients  tick ms   CPU ms/s  core   KB/s/client  walked m\n");
+    for (uint32_t clientCount : CLIENT_COUNTS)
+    {
+        float baseline = 0.0f;
+        for (uint32_t tickRate : TICK_RATES)
+        {
+            RateResult result = Run(tickRate, clientCount);
+            if (tickRate == TICK_RATES[0]) baseline = result.walked;
+            const bool sameDistance = baseline > 0.0f &&
+                std::fabs(result.walked - baseline) <= baseline * MAX_DISTANCE_ERROR;
+            const bool ok = result.ok && sameDistance;
+
+            std::printf("%4u  %7u  %7.3f  %9.2f  %4.1f%%  %11.1f  %8.2f  %s\n",
+                        tickRate, clientCount, result.tickMs, result.cpuMsPerSecond,
+                        result.cpuMsPerSecond / 10.0, result.bytesPerClient / 1024.0,
+                        result.walked, ok ? "ok" : "FAILED");
+            allOk &= ok;
+        }
+    }
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,324 @@
+//=============================================================================
+// bench_trace.cpp
+//
+// Records a session (MockNetwork with delta snapshots, 32 players, behind a
+// jittery NetSim link so arrival and consumption times differ, all on a
+// virtual clock) through TraceRecordNetwork, then replays the file through
+// TraceReplayNetwork. Checks that the replay hands the game the same
+// snapshots on the same frames with the same arrival times, the same
+// gameplay events on the same frames, the same inputs and the server's
+// tick rate. Reports trace size, and replay
+// throughput when unthrottled.
+//=============================================================================
+
+#include "net_bench.h"
+#include "mock_network.h"
+#include "netsim_network.h"
+#include "net_bitstream.h"
+#include "trace_network.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t TICK_COUNT = 1600;            // 50 seconds
+constexpr uint32_t FRAMES_PER_TICK = 4;
+constexpr double FRAME_TIME = 1.0 / (32.0 * FRAMES_PER_TICK);
+constexpr uint8_t PLAYER_COUNT = 32;
+constexpr double START_TIME = 1000.0;
+const char* const TRACE_PATH = "netbench_trace.tmp";
+constexpr uint32_t ANNOUNCED_TICK_RATE = 64;    // Only labels the trace
+constexpr uint32_t EVENT_INTERVAL = 8;          // Ticks between event batches
+
+double g_VirtualNow = 0.0;
+double VirtualNow() { return g_VirtualNow; }
+
+// What the game saw of one snapshot
+struct Seen
+{
+    uint32_t tickId;
+    uint32_t frame;
+    double arrivalTime;
+    uint64_t hash;
+};
+
+struct Session
+{
+    Seen snapshots[TICK_COUNT];
+    uint32_t snapshotCount;
+    uint64_t inputHash;
+    uint32_t inputCount;
+    uint64_t eventHash;         // Events and the frames they were read on
+    uint32_t eventCount;
+};
+
+uint64_t Fnv(const uint8_t* data, size_t size, uint64_t hash = 0xCBF29CE484222325ull)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= data[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+// Hash of the canonical (full, quantized) encoding, so padding is ignored
+uint64_t HashSnapshot(const Snapshot& snap)
+{
+    static uint8_t buffer[(NetCodec::SNAPSHOT_MAX_BITS + 7) / 8];
+    BitWriter w(buffer, sizeof(buffer));
+    NetCodec::WriteSnapshot(w, snap, nullptr);
+    uint64_t hash = Fnv(buffer, w.Finish());
+    return Fnv(reinterpret_cast<const uint8_t*>(&snap.tickId), sizeof(snap.tickId), hash);
+}
+
+void HashInput(uint64_t& hash, const InputCmd& cmd)
+{
+    uint8_t buffer[(NetCodec::INPUT_CMD_MAX_BITS + 7) / 8 + 8];
+    BitWriter w(buffer, sizeof(buffer));
+    w.WriteVarint(cmd.tickId);
+    NetCodec::WriteInputCmd(w, cmd);
+    hash = Fnv(buffer, w.Finish(), hash);
+}
+
+InputCmd MakeInput(uint32_t frame)
+{
+    InputCmd cmd = {};
+    cmd.tickId = frame;
+    cmd.moveAxisY = (frame / 64) % 2 ? 1.0f : 0.0f;
+    cmd.yaw = std::sin(frame * 0.01f) * 3.0f;
+    cmd.pitch = std::cos(frame * 0.013f) * 0.5f;
+    cmd.buttons = (frame % 50 < 5) ? 1u : 0u;
+    return cmd;
+}
+
+// A hit and, every other batch, a kill from the tick's "server"
+size_t MakeEvents(uint32_t tick, NetEvent* outEvents)
+{
+    outEvents[0] = {};
+    outEvents[0].tickId = tick;
+    outEvents[0].type = NetEventType::HIT;
+    outEvents[0].playerId = static_cast<uint8_t>(tick % PLAYER_COUNT);
+    outEvents[0].targetId = static_cast<uint8_t>((tick + 1) % PLAYER_COUNT);
+    outEvents[0].damage = static_cast<uint8_t>(tick % 100);
+    if ((tick / EVENT_INTERVAL) % 2) return 1;
+
+    outEvents[1] = outEvents[0];
+    outEvents[1].type = NetEventType::KILL;
+    outEvents[1].damage = 0;
+    return 2;
+}
+
+void Consume(INetwork& network, Session& session, uint32_t frame)
+{
+    NetEvent event;
+    while (network.ReceiveEvent(event))
+    {
+        const uint8_t fields[] = {
+            static_cast<uint8_t>(event.type), event.playerId, event.targetId, event.damage
+        };
+        session.eventHash = Fnv(fields, sizeof(fields), session.eventHash);
+        session.eventHash = Fnv(reinterpret_cast<const uint8_t*>(&event.tickId), sizeof(event.tickId), session.eventHash);
+        session.eventHash = Fnv(reinterpret_cast<const uint8_t*>(&frame), sizeof(frame), session.eventHash);
+        session.eventCount++;
+    }
+
+    SnapshotHandle handle;
+    while (network.AcquireSnapshot(handle))
+    {
+        if (session.snapshotCount == TICK_COUNT) continue;
+        Seen& seen = session.snapshots[session.snapshotCount++];
+        seen.tickId = handle->tickId;
+        seen.frame = frame;
+        seen.arrivalTime = handle.GetArrivalTime();
+        seen.hash = HashSnapshot(*handle);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Live session through the recorder: the game sends and consumes, the mock
+// server sends a snapshot every tick and drains inputs
+//-----------------------------------------------------------------------------
+bool Record(Session& session, uint64_t& outBytes)
+{
+    static MockNetwork backend;
+    static NetSimNetwork netsim;
+    static TraceRecordNetwork recorder;
+    static Snapshot serverSnap;
+
+    backend.SetSnapshotDeltaEnabled(true);
+    backend.Initialize();
+    backend.SendTickRate(ANNOUNCED_TICK_RATE);
+
+    NetSimLinkSettings link;
+    link.latencyMs = 30.0f;
+    link.jitterMs = 10.0f;
+    netsim.SetInner(&backend);
+    netsim.SetTimeSource(VirtualNow);
+    netsim.SetUpstreamSettings(link);
+    netsim.SetDownstreamSettings(link);
+    netsim.Initialize();
+
+    recorder.SetInner(&netsim);
+    recorder.SetTimeSource(VirtualNow);
+    if (!recorder.Open(TRACE_PATH)) return false;
+    recorder.Initialize();
+
+    g_VirtualNow = START_TIME;
+    uint32_t frame = 0;
+    for (uint32_t tick = 1; tick <= TICK_COUNT; tick++)
+    {
+        for (uint32_t f = 0; f < FRAMES_PER_TICK; f++, frame++)
+        {
+            g_VirtualNow += FRAME_TIME;
+            const InputCmd cmd = MakeInput(frame);
+            recorder.SendInputCmd(cmd);
+            HashInput(session.inputHash, cmd);
+            session.inputCount++;
+            Consume(recorder, session, frame);
+        }
+
+        InputCmd received;
+        while (backend.ReceiveInputCmd(received)) {}
+
+        FillSnapshot(serverSnap, PLAYER_COUNT, tick);
+        serverSnap.serverTime = g_VirtualNow;
+        backend.SendSnapshot(serverSnap);
+
+        if (tick % EVENT_INTERVAL == 0)
+        {
+            NetEvent events[2];
+            backend.SendEvents(tick, events, MakeEvents(tick, events));
+        }
+    }
+
+    outBytes = recorder.GetWriter().GetBytesWritten();
+    recorder.Finalize();
+    netsim.Finalize();
+    backend.Finalize();
+    return true;
+}
+
+// Same frame loop against the replay backend; the server side reads back the
+// inputs the game sent
+bool Replay(Session& session)
+{
+    static TraceReplayNetwork replay;
+    if (!replay.Open(TRACE_PATH)) return false;
+    replay.SetTimeSource(VirtualNow);
+    replay.SetSpeed(1.0);
+
+    // The first record was written on the first frame
+    g_VirtualNow = START_TIME + FRAME_TIME;
+    replay.Initialize();
+    g_VirtualNow = START_TIME;
+
+    uint32_t frame = 0;
+    for (uint32_t tick = 1; tick <= TICK_COUNT + 1; tick++)
+    {
+        for (uint32_t f = 0; f < FRAMES_PER_TICK; f++, frame++)
+        {
+            g_VirtualNow += FRAME_TIME;
+            replay.SendInputCmd(InputCmd{});
+            Consume(replay, session, frame);
+        }
+
+        InputCmd received;
+        while (replay.ReceiveInputCmd(received))
+        {
+            HashInput(session.inputHash, received);
+            session.inputCount++;
+        }
+    }
+
+    bool ok = replay.IsFinished() && !replay.HasError() && replay.GetTickRate() == ANNOUNCED_TICK_RATE;
+    replay.Finalize();
+    return ok;
+}
+
+// Unthrottled: decode throughput, content only
+bool ReplayFast(const Session& expected, double& outSeconds)
+{
+    static TraceReplayNetwork replay;
+    if (!replay.Open(TRACE_PATH)) return false;
+    replay.SetTimeSource(VirtualNow);
+    replay.SetSpeed(0.0);
+    replay.Initialize();
+
+    bool ok = true;
+    uint32_t count = 0;
+    uint64_t checksum = 0;
+
+    BenchTimer timer;
+    SnapshotHandle handle;
+    while (replay.AcquireSnapshot(handle))
+        checksum += handle->tickId + handle->remotePlayerCount;
+    outSeconds = timer.GetSeconds();
+
+    // Second pass for content (hashing is not part of the timing)
+    replay.Initialize();
+    while (replay.AcquireSnapshot(handle))
+    {
+        if (count >= expected.snapshotCount || HashSnapshot(*handle) != expected.snapshots[count].hash)
+            ok = false;
+        count++;
+    }
+
+    return ok && checksum != 0 && count == expected.snapshotCount && replay.IsFinished();
+}
+
+} // namespace
+
+int Bench_Trace()
+{
+    static Session recorded;
+    static Session replayed;
+    recorded = {};
+    replayed = {};
+
+    uint64_t fileBytes = 0;
+    if (!Record(recorded, fileBytes) || !Replay(replayed))
+    {
+        std::printf("Trace file %s could not be written or read\n", TRACE_PATH);
+        std::remove(TRACE_PATH);
+        return 1;
+    }
+
+    // Same snapshots, same frames, same arrival times (us precision)
+    uint32_t mismatches = 0;
+    double maxArrivalError = 0.0;
+    for (uint32_t i = 0; i < recorded.snapshotCount && i < replayed.snapshotCount; i++)
+    {
+        const Seen& a = recorded.snapshots[i];
+        const Seen& b = replayed.snapshots[i];
+        double arrivalError = std::fabs(a.arrivalTime - b.arrivalTime);
+        if (arrivalError > maxArrivalError) maxArrivalError = arrivalError;
+        if (a.tickId != b.tickId || a.frame != b.frame || a.hash != b.hash) mismatches++;
+    }
+    bool sameSnapshots = recorded.snapshotCount == replayed.snapshotCount && mismatches == 0 &&
+                         maxArrivalError <= 2e-6;
+    bool sameInputs = recorded.inputCount == replayed.inputCount && recorded.inputHash == replayed.inputHash;
+    bool sameEvents = recorded.eventCount > 0 && recorded.eventCount == replayed.eventCount &&
+                      recorded.eventHash == replayed.eventHash;
+
+    const double seconds = TICK_COUNT / 32.0;
+    const double rawPerSnapshot = static_cast<double>(GetSnapshotSize(PLAYER_COUNT - 1));
+    std::printf("Trace       %u snapshots + %u inputs in %.1f KB (%.1f KB/s, raw snapshots %.1f KB/s)\n",
+                recorded.snapshotCount, TICK_COUNT * FRAMES_PER_TICK, fileBytes / 1024.0,
+                fileBytes / 1024.0 / seconds, rawPerSnapshot * recorded.snapshotCount / 1024.0 / seconds);
+    std::printf("Replay 1x   snapshots %u/%u  mismatched %u  max arrival error %.2f us  inputs %u/%u %s  "
+                "events %u/%u %s  %s\n",
+                replayed.snapshotCount, recorded.snapshotCount, mismatches, maxArrivalError * 1e6,
+                replayed.inputCount, recorded.inputCount, sameInputs ? "identical" : "DIFFERENT",
+                replayed.eventCount, recorded.eventCount, sameEvents ? "identical" : "DIFFERENT",
+                (sameSnapshots && sameInputs && sameEvents) ? "ok" : "FAILED");
+
+    double fastSeconds = 0.0;
+    bool fastOk = ReplayFast(recorded, fastSeconds);
+    std::printf("Replay max  %.0f snapshots/s (%.1fx real time)  %s\n",
+                recorded.snapshotCount / fastSeconds, seconds / fastSeconds, fastOk ? "ok" : "FAILED");
+
+    std::remove(TRACE_PATH);
+    return (sameSnapshots && sameInputs && sameEvents && fastOk) ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+#pragma once
+//=============================================================================
+// net_bench.h
+//
+// NetBench - console microbenchmarks for the Network/ layer.
+// Each benchmark is a free function registered in net_bench_main.cpp.
+//
+// Usage:
+//   NetBench                 run every benchmark
+//   NetBench <name> [...]    run the named benchmarks
+//=============================================================================
+
+#include "net_common.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+//-----------------------------------------------------------------------------
+// Benchmarks (return 0 on success, non-zero if a sanity check failed)
+//-----------------------------------------------------------------------------
+int Bench_SpscRing();
+int Bench_Alloc();
+int Bench_Snapshot();
+int Bench_NetSim();
+int Bench_ClockSync();
+int Bench_JitterBuffer();
+int Bench_Trace();
+int Bench_MockServer();
+int Bench_InputBuffer();
+int Bench_LagComp();
+int Bench_Events();
+int Bench_Bundle();
+int Bench_Telemetry();
+int Bench_Entropy();
+int Bench_Schema();
+int Bench_TickRate();
+
+//-----------------------------------------------------------------------------
+// Timing helper
+//-----------------------------------------------------------------------------
+class BenchTimer
+{
+public:
+    BenchTimer() : m_Start(std::chrono::steady_clock::now()) {}
+
+    double GetSeconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_Start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_Start;
+};
+
+//-----------------------------------------------------------------------------
+// Deterministic random numbers (64-bit LCG): every bench seeds its own
+//-----------------------------------------------------------------------------
+struct Lcg
+{
+    uint64_t state;
+
+    uint32_t NextU32()
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<uint32_t>(state >> 32);
+    }
+
+    // Uniform [0, 1)
+    double Next()
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<double>(state >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Uniform [-range, range)
+    float NextFloat(float range) { return static_cast<float>(Next() * 2.0 - 1.0) * range; }
+};
+
+//-----------------------------------------------------------------------------
+// Snapshot fixtures
+//-----------------------------------------------------------------------------
+
+// Players wander around the map; roughly a third stand still each tick.
+// Acks jitter back and forth behind the tick.
+inline void FillSnapshot(Snapshot& snap, uint8_t playerCount, uint32_t tick)
+{
+    std::memset(&snap, 0, GetSnapshotSize(playerCount - 1));
+    snap.tickId = tick;
+    snap.serverTime = tick / 32.0;
+    snap.ackInputTick = (tick > 4) ? tick - 4 + (tick % 7 == 0 ? 2 : 0) : 0;
+    snap.localPlayer.tickId = tick;
+    snap.localPlayer.position = { std::sin(tick * 0.05f) * 10.0f, 0.0f, 5.0f };
+    snap.localPlayer.yaw = tick * 0.01f;
+    snap.localPlayer.health = 100;
+    snap.remotePlayerCount = static_cast<uint8_t>(playerCount - 1);
+
+    for (uint8_t i = 0; i < snap.remotePlayerCount; i++)
+    {
+        RemotePlayerEntry& entry = snap.remotePlayers[i];
+        entry.playerId = static_cast<uint8_t>(i + 1);
+        entry.teamId = i & 1;
+        entry.state.tickId = tick;
+        entry.state.health = 100;
+
+        float t = (i % 3 == 0) ? 0.0f : tick * 0.03f;
+        entry.state.position = { std::sin(t + i) * 20.0f, 0.0f, std::cos(t + i) * 20.0f };
+        entry.state.velocity = { std::cos(t + i) * 0.6f, 0.0f, -std::sin(t + i) * 0.6f };
+        entry.state.yaw = t;
+    }
+}
+
+// Every field random (padding zero): covers value ranges, not motion
+inline void FillRandomSnapshot(Snapshot& snap, Lcg& rng, uint8_t remoteCount)
+{
+    auto fillState = [&rng](NetPlayerState& state) {
+        state.tickId = rng.NextU32();
+        state.position = { rng.NextFloat(100.0f), rng.NextFloat(10.0f), rng.NextFloat(100.0f) };
+        state.velocity = { rng.NextFloat(8.0f), rng.NextFloat(8.0f), rng.NextFloat(8.0f) };
+        state.yaw = rng.NextFloat(3.14f);
+        state.pitch = rng.NextFloat(1.5f);
+        state.stateFlags = rng.NextU32() & 0x7F;
+        state.health = static_cast<uint8_t>(rng.NextU32() % 201);
+        state.padding = 0;
+        state.fireCounter = static_cast<uint16_t>(rng.NextU32());
+    };
+
+    snap.tickId = rng.NextU32();
+    snap.ackInputTick = rng.NextU32();
+    snap.serverTime = rng.NextU32() * 0.001;
+    fillState(snap.localPlayer);
+    snap.localPlayerId = 0;
+    snap.remotePlayerCount = remoteCount;
+    snap.localPlayerTeam = PlayerTeam::BLUE;
+    snap.inputBufferDepth = 2;
+    for (uint8_t i = 0; i < remoteCount; i++)
+    {
+        RemotePlayerEntry& entry = snap.remotePlayers[i];
+        entry.playerId = static_cast<uint8_t>(i + 1);
+        entry.teamId = i & 1;
+        entry.padding[0] = entry.padding[1] = 0;
+        fillState(entry.state);
+    }
+}
+
+// Byte-exact comparison of the used part of two snapshots
+inline bool SameSnapshot(const Snapshot& a, const Snapshot& b)
+{
+    return a.remotePlayerCount == b.remotePlayerCount &&
+           std::memcmp(&a, &b, GetSnapshotSize(a.remotePlayerCount)) == 0;
+}
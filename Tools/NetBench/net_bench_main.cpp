@@ -0,0 +1,73 @@
+//=============================================================================
+// net_bench_main.cpp
+//
+// NetBench entry point: runs all or the named benchmarks.
+//=============================================================================
+
+#include "net_bench.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+struct BenchEntry
+{
+    const char* name;
+    int (*run)();
+};
+
+const BenchEntry BENCHES[] = {
+    { "spsc", Bench_SpscRing },
+    { "alloc", Bench_Alloc },
+    { "snapshot", Bench_Snapshot },
+    { "netsim", Bench_NetSim },
+    { "clocksync", Bench_ClockSync },
+    { "jitter", Bench_JitterBuffer },
+    { "trace", Bench_Trace },
+    { "mockserver", Bench_MockServer },
+    { "inputbuffer", Bench_InputBuffer },
+    { "lagcomp", Bench_LagComp },
+    { "events", Bench_Events },
+    { "bundle", Bench_Bundle },
+    { "telemetry", Bench_Telemetry },
+    { "entropy", Bench_Entropy },
+    { "schema", Bench_Schema },
+    { "tickrate", Bench_TickRate },
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int failures = 0;
+    bool ranAny = false;
+
+    for (const BenchEntry& bench : BENCHES)
+    {
+        bool selected = (argc < 2);
+        for (int i = 1; i < argc; i++)
+        {
+            if (std::strcmp(argv[i], bench.name) == 0) selected = true;
+        }
+        if (!selected) continue;
+
+        std::printf("=== %s ===\n", bench.name);
+        if (bench.run() != 0)
+        {
+            std::printf("*** %s: sanity check FAILED\n", bench.name);
+            failures++;
+        }
+        std::printf("\n");
+        ranAny = true;
+    }
+
+    if (!ranAny)
+    {
+        std::printf("Unknown benchmark. Available:");
+        for (const BenchEntry& bench : BENCHES) std::printf(" %s", bench.name);
+        std::printf("\n");
+        return 1;
+    }
+
+    return failures;
+}
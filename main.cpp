@@ -44,6 +44,8 @@
 #include "mock_server.h"
 #include "mock_network.h"
 #include "enet_client_network.h"
+#include "netsim_network.h"
+#include "trace_network.h"
 #include "input_producer.h"
 #include "remote_player.h"
 #include "i_network.h"
@@ -60,9 +62,27 @@ MockServer* g_pMockServer = nullptr;
 // Global network interface pointer (used by game.cpp etc.)
 INetwork* g_pNetwork = nullptr;
 
-// Network mode: "mock", "local", or "remote" (read from config.toml)
+// Network condition simulator wrapped around g_pNetwork ([netsim] enabled)
+NetSimNetwork* g_pNetSim = nullptr;
+
+// Network mode: "mock", "local", "remote" or "replay" (read from config.toml)
 static std::string g_NetworkMode;
 
+// One [netsim] direction: keys are prefix + "_latency_ms" etc.
+static NetSimLinkSettings LoadNetSimLink(const std::string& prefix)
+{
+	const Config& config = Config::GetInstance();
+	NetSimLinkSettings link;
+	link.latencyMs     = static_cast<float>(config.GetDouble("netsim", prefix + "_latency_ms", 0.0));
+	link.jitterMs      = static_cast<float>(config.GetDouble("netsim", prefix + "_jitter_ms", 0.0));
+	link.loss          = static_cast<float>(config.GetDouble("netsim", prefix + "_loss", 0.0));
+	link.duplicate     = static_cast<float>(config.GetDouble("netsim", prefix + "_duplicate", 0.0));
+	link.reorder       = static_cast<float>(config.GetDouble("netsim", prefix + "_reorder", 0.0));
+	link.reorderMs     = static_cast<float>(config.GetDouble("netsim", prefix + "_reorder_ms", 40.0));
+	link.bandwidthKbps = static_cast<float>(config.GetDouble("netsim", prefix + "_bandwidth_kbps", 0.0));
+	return link;
+}
+
 int APIENTRY WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE,_In_ LPSTR lpCmdLine, _In_ int nCmdShow)
 {
 	(void)CoInitializeEx(nullptr, COINIT_MULTITHREADED);
@@ -119,6 +139,7 @@ int APIENTRY WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE,_In_ LPSTR lpC
 	//   "mock"   — in-process mock server
 	//   "local"  — ENet to local machine
 	//   "remote" — ENet to remote server
+	//   "replay" — play back a recorded trace ([trace] replay)
 	// ========================================================================
 
 	g_NetworkMode = Config::GetInstance().GetString("network", "mode", "mock");
@@ -126,8 +147,16 @@ int APIENTRY WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE,_In_ LPSTR lpC
 	static MockNetwork g_MockNetwork;
 	static MockServer g_MockServer;
 	static ENetClientNetwork g_ENetNetwork;
+	static TraceReplayNetwork g_TraceReplay;
 
-	if (g_NetworkMode == "local" || g_NetworkMode == "remote")
+	if (g_NetworkMode == "replay" && g_TraceReplay.Open(Config::GetInstance().TraceReplayPath().c_str()))
+	{
+		g_TraceReplay.SetSpeed(Config::GetInstance().TraceReplaySpeed());
+		g_TraceReplay.Initialize();
+		g_pNetwork = &g_TraceReplay;
+		g_pMockServer = nullptr;
+	}
+	else if (g_NetworkMode == "local" || g_NetworkMode == "remote")
 	{
 		// ENet mode: pick host from config based on mode
 		std::string serverHost = (g_NetworkMode == "remote")
@@ -136,34 +165,69 @@ int APIENTRY WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE,_In_ LPSTR lpC
 		uint16_t serverPort = static_cast<uint16_t>(Config::GetInstance().ServerPort());
 
 		g_ENetNetwork.SetServerAddress(serverHost.c_str(), serverPort);
+		g_ENetNetwork.SetSnapshotDeltaEnabled(Config::GetInstance().SnapshotDelta());
+		g_ENetNetwork.SetSnapshotEntropyEnabled(Config::GetInstance().SnapshotEntropy());
+		g_ENetNetwork.SetInputRedundancy(Config::GetInstance().InputRedundancy());
+		g_ENetNetwork.SetIoThreadEnabled(Config::GetInstance().NetIoThread());
+		g_ENetNetwork.SetBundleMtu(static_cast<size_t>(Config::GetInstance().BundleMtu()));
+		g_ENetNetwork.SetTickRate(static_cast<uint32_t>(Config::GetInstance().TickRate()));
 		g_ENetNetwork.Initialize();
 		g_pNetwork = &g_ENetNetwork;
 		g_pMockServer = nullptr;
 	}
 	else
 	{
-		// Mock mode: local in-process server (default)
+		// Mock mode: local in-process server (default, also when the
+		// replay trace cannot be opened)
+		g_NetworkMode = "mock";
+		g_MockNetwork.SetSnapshotDeltaEnabled(Config::GetInstance().SnapshotDelta());
+		g_MockNetwork.SetSnapshotEntropyEnabled(Config::GetInstance().SnapshotEntropy());
+		g_MockNetwork.SetInputRedundancy(Config::GetInstance().InputRedundancy());
+		int snapshotBudget = Config::GetInstance().SnapshotBudget();
+		g_MockNetwork.SetSnapshotByteBudget(snapshotBudget > 0 ? static_cast<size_t>(snapshotBudget) : 0);
 		g_MockNetwork.Initialize();
+		g_MockServer.SetTickRate(static_cast<uint32_t>(Config::GetInstance().TickRate()));
 		g_MockServer.Initialize(&g_MockNetwork, Game_GetCollisionWorld());
+		g_MockServer.SetInterestManagementEnabled(Config::GetInstance().InterestManagement());
+		int lagCompensationMs = Config::GetInstance().LagCompensationMs();
+		g_MockServer.SetMaxRewind(lagCompensationMs > 0 ? lagCompensationMs / 1000.0 : 0.0);
 		g_pNetwork = &g_MockNetwork;
 		g_pMockServer = &g_MockServer;
 	}
 
+	// Optional: latency / loss / jitter between the game and the backend
+	static NetSimNetwork g_NetSim;
+	if (Config::GetInstance().NetSimEnabled())
+	{
+		g_NetSim.SetInner(g_pNetwork);
+		g_NetSim.SetSeed(static_cast<uint64_t>(Config::GetInstance().NetSimSeed()));
+		g_NetSim.SetUpstreamSettings(LoadNetSimLink("up"));
+		g_NetSim.SetDownstreamSettings(LoadNetSimLink("down"));
+		g_NetSim.Initialize();
+		g_pNetwork = &g_NetSim;
+		g_pNetSim = &g_NetSim;
+	}
+
+	// Optional: capture the session as the game sees it (outermost)
+	static TraceRecordNetwork g_TraceRecord;
+	static bool g_TraceRecording = false;
+	std::string tracePath = Config::GetInstance().TraceRecordPath();
+	if (!tracePath.empty() && g_TraceRecord.Open(tracePath.c_str()))
+	{
+		g_TraceRecord.SetInner(g_pNetwork);
+		g_TraceRecord.Initialize();
+		g_pNetwork = &g_TraceRecord;
+		g_TraceRecording = true;
+	}
+
 	// Initialize Input Producer (Client-side input sampling)
 	static InputProducer g_InputProducer;
 	g_InputProducer.Initialize(g_pNetwork);
 	extern InputProducer* g_pInputProducer;
 	g_pInputProducer = &g_InputProducer;
 
-	// Initialize Remote Players (pre-allocate MAX_PLAYERS slots, all inactive)
-	extern RemotePlayer g_RemotePlayers[];
-	extern bool g_RemotePlayerActive[];
-	for (int i = 0; i < MAX_PLAYERS; i++)
-	{
-		g_RemotePlayers[i].Initialize({ 0.0f, 0.0f, 0.0f });
-		g_RemotePlayers[i].SetActive(false);
-		g_RemotePlayerActive[i] = false;
-	}
+	// Remote players are created on demand (RemotePlayers_Acquire) as their
+	// playerIds appear in snapshots
 
 	Cube_Initialize(Direct3D_GetDevice(), Direct3D_GetDeviceContext());
 
@@ -248,13 +312,13 @@ int APIENTRY WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE,_In_ LPSTR lpC
 				g_InputProducer.Update();
 
 				// ====================================================================
-				// Network: Poll events (ENet) or run local server (Mock)
+				// Network: Poll events (ENet, no-op with io_thread) or run local server (Mock)
 				// ====================================================================
 				if (g_NetworkMode == "local" || g_NetworkMode == "remote")
 				{
 					g_ENetNetwork.PollEvents();
 				}
-				else
+				else if (g_NetworkMode == "mock")
 				{
 					g_MockServer.Update(elapsed_time);
 				}
@@ -293,7 +357,21 @@ int APIENTRY WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE,_In_ LPSTR lpC
 	//Game_Finalize();
 
 	// Network cleanup
-	if (g_NetworkMode == "local" || g_NetworkMode == "remote")
+	if (g_TraceRecording)
+	{
+		g_TraceRecord.Finalize();
+		g_TraceRecording = false;
+	}
+	if (g_pNetSim)
+	{
+		g_NetSim.Finalize();
+		g_pNetSim = nullptr;
+	}
+	if (g_NetworkMode == "replay")
+	{
+		g_TraceReplay.Finalize();
+	}
+	else if (g_NetworkMode == "local" || g_NetworkMode == "remote")
 	{
 		g_ENetNetwork.Finalize();
 	}